@@ -1246,6 +1246,7 @@ m4_include([m4/libcsplit.m4])
 m4_include([m4/libcstring.m4])
 m4_include([m4/libcsystem.m4])
 m4_include([m4/libcthreads.m4])
+m4_include([m4/libdeflate.m4])
 m4_include([m4/libfcache.m4])
 m4_include([m4/libfdata.m4])
 m4_include([m4/libfuse.m4])
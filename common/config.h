@@ -28,6 +28,9 @@
 /* Define to 1 if you have the `chdir' function. */
 #define HAVE_CHDIR 1
 
+/* Define to 1 if you have the `closedir' function. */
+#define HAVE_CLOSEDIR 1
+
 /* Define to 1 if you have the `close' function. */
 #define HAVE_CLOSE 1
 
@@ -67,6 +70,9 @@
    don't. */
 #define HAVE_DECL_STRERROR_R 1
 
+/* Define to 1 if you have the <dirent.h> header file. */
+#define HAVE_DIRENT_H 1
+
 /* Define to 1 if you have the <dlfcn.h> header file. */
 #define HAVE_DLFCN_H 1
 
@@ -88,6 +94,9 @@
 /* Define to 1 if you have the `EVP_sha512' function". */
 #define HAVE_EVP_SHA512 1
 
+/* Define to 1 if you have the `fallocate' function. */
+#define HAVE_FALLOCATE 1
+
 /* Define to 1 if you have the `fclose' function. */
 #define HAVE_FCLOSE 1
 
@@ -124,6 +133,9 @@
 /* Define to 1 if you have the `fstat' function. */
 #define HAVE_FSTAT 1
 
+/* Define to 1 if you have the `fsync' function. */
+#define HAVE_FSYNC 1
+
 /* Define to 1 if you have the `ftello' function. */
 #define HAVE_FTELLO 1
 
@@ -469,6 +481,9 @@
 /* Define to 1 if you have the `nl_langinfo' function. */
 #define HAVE_NL_LANGINFO 1
 
+/* Define to 1 if you have the `opendir' function. */
+#define HAVE_OPENDIR 1
+
 /* Define to 1 if you have the `open' function. */
 #define HAVE_OPEN 1
 
@@ -493,6 +508,12 @@
 /* Define to 1 if you have the posix_fadvise function. */
 #define HAVE_POSIX_FADVISE 1
 
+/* Define to 1 if you have the `posix_memalign' function. */
+#define HAVE_POSIX_MEMALIGN 1
+
+/* Define to 1 if you have the `pread' function. */
+#define HAVE_PREAD 1
+
 /* Define to 1 whether printf supports the conversion specifier "%jd". */
 #define HAVE_PRINTF_JD 1
 
@@ -514,6 +535,9 @@
 /* Define to 1 if you have the `read' function. */
 #define HAVE_READ 1
 
+/* Define to 1 if you have the `readdir' function. */
+#define HAVE_READDIR 1
+
 /* Define to 1 if you have the `realloc' function. */
 #define HAVE_REALLOC 1
 
@@ -598,6 +622,9 @@
 /* Define to 1 if you have the `swprintf' function. */
 /* #undef HAVE_SWPRINTF */
 
+/* Define to 1 if you have the `sync_file_range' function. */
+#define HAVE_SYNC_FILE_RANGE 1
+
 /* Define to 1 if you have the <sys/disklabel.h> header file. */
 /* #undef HAVE_SYS_DISKLABEL_H */
 
@@ -631,6 +658,9 @@
 /* Define to 1 if you have the <unistd.h> header file. */
 #define HAVE_UNISTD_H 1
 
+/* Define to 1 if you have the `unlink' function. */
+#define HAVE_UNLINK 1
+
 /* Define to 1 if uuid_generate_random funtion is available in libuuid. */
 /* #undef HAVE_UUID_GENERATE_RANDOM */
 
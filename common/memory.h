@@ -61,6 +61,14 @@ extern "C" {
 #define memory_allocate_structure_as_value( type ) \
 	(intptr_t *) memory_allocate( sizeof( type ) )
 
+/* Aligned memory allocation, the buffer is freed with memory_free
+ * Returns 0 if successful
+ */
+#if defined( HAVE_POSIX_MEMALIGN ) && !defined( HAVE_GLIB_H )
+#define memory_allocate_aligned( buffer, size, alignment ) \
+	posix_memalign( buffer, alignment, size )
+#endif
+
 /* Memory reallocation
  */
 #if defined( HAVE_GLIB_H )
@@ -1,5 +1,5 @@
 /*
- * Thread safe FiFo-Queue which supports ordered filling with multiple producers
+ * Thread safe FiFo-Queue which supports out of order filling with multiple producers
  *
  * Copyright (c) 2013-2014, Bernhard Zach <bernhard.zach@justbits.at>
  *
@@ -104,7 +104,8 @@ bool fifo_queue::deposit_with_generated_id(
 	return true;
 }
 
-// Deposits with a specific, ordered id. Function blocks until earlier id's are filled in
+// Deposits with a specific id. The buffers are reordered in the queue, so a producer does not wait for the earlier ids
+// Function only blocks if the id is outside the window of slots following the id of the first packet
 // IMPORTANT: the locking mechanism only works if one thread calls deposit_with_generated_id() OR deposit()
 // returns true when data is stored
 // return false on error or shutdown-abort
@@ -115,11 +116,13 @@ bool fifo_queue::deposit(
       libcerror_error_t **error )
 {
 	static char *function = "fifo_queue::deposit";
+	int slot_index        = 0;
 
 	std::unique_lock<std::mutex> l(lock); // queuewide lock is needed in wait() below, mutex releases on function exit
 
-	// wait, till conditon is set, the lambda function prevents "spurious wakeup" and if the id is not the correct one.
-	not_full.wait(l, [this, &required_slot_id]() { return ((fill_count != slot_count) && (next_read_id == required_slot_id) || (shutdown_mode.load() == 2)); });
+	// wait, till the id is inside the window of slots, the lambda function prevents "spurious wakeup"
+	// the distance is calculated modulo 256 because the ids wrap around
+	not_full.wait(l, [this, &required_slot_id]() { return ((uint8_t) (required_slot_id - current_front_id) < slot_count) || (shutdown_mode.load() == 2); });
 
 	// we are the only thread which has access to queue now
 	*current_shutdown_mode = shutdown_mode.load();
@@ -129,18 +132,29 @@ bool fifo_queue::deposit(
 	{
 		return false;
 	}
+	slot_index = (front + (uint8_t) (required_slot_id - current_front_id)) % slot_count;
+
+	if( buffers[ slot_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: slot for id: %d already contains data.",
+		 function,
+		 (int) required_slot_id );
+		return false;
+	}
 	// store the pointer
-	buffers[ rear ] = source_buffer;
-	// update index of next free slot
-	rear = (rear + 1) % slot_count;
-	// update next free id
-	next_read_id++;
+	buffers[ slot_index ] = source_buffer;
 	// increase fill counter
 	fill_count++;
 
-	// one consumer could read something
-	not_empty.notify_one();
-
+	// the consumer could read something if the first packet was stored
+	if( slot_index == front )
+	{
+		not_empty.notify_one();
+	}
 	return true;
 }
 
@@ -157,8 +171,9 @@ bool fifo_queue::fetch(
 	// queuewide lock is needed in wait() below, mutex releases on function exit
 	std::unique_lock<std::mutex> l(lock);
 
-	// wait, till conditon is set, the lambda function prevents "spurious wakeup"
-	not_empty.wait(l, [this](){return ((fill_count != 0) || (shutdown_mode.load() != 0)); });
+	// wait, till the first packet is available, the lambda function prevents "spurious wakeup"
+	// with deposit() the other slots can already contain data
+	not_empty.wait(l, [this](){return ((buffers[ front ] != NULL) || (shutdown_mode.load() != 0)); });
 
 	// we are the only thread which has access to queue now
 	*current_shutdown_mode = shutdown_mode.load();
@@ -169,6 +184,11 @@ bool fifo_queue::fetch(
 		*target_buffer = buffers[ front ];
 		if (*target_buffer == NULL)
 		{
+			if( shutdown_mode.load() == 2 )
+			{
+				// aborting
+				return false;
+			}
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
@@ -177,6 +197,8 @@ bool fifo_queue::fetch(
 			 function );		
 			return false;
 		}
+		buffers[ front ] = NULL;
+
 		// get the slot id of the buffer
 		*read_slot_id = current_front_id;
 				
@@ -187,9 +209,15 @@ bool fifo_queue::fetch(
 		// update fill counter
 		fill_count--;
 
-		// notify all waiting producers (because they fill in ordered)
+		// notify all waiting producers (because the window of deposit() moved)
 		not_full.notify_all();
 
+		// the next packet could already be available
+		if( buffers[ front ] != NULL )
+		{
+			not_empty.notify_one();
+		}
+
 		return true;
 	}
 	// no data available
@@ -1,5 +1,5 @@
 /*
- * Thread safe FiFo-Queue which supports ordered filling with multiple producers
+ * Thread safe FiFo-Queue which supports out of order filling with multiple producers
  *
  * Copyright (c) 2013-2014, Bernhard Zach <bernhard.zach@justbits.at>
  *
@@ -31,7 +31,8 @@
 #include "storage_media_buffer.h"
 
 #ifdef __cplusplus
-// Thread safe FiFo-Queue which supports ordered filling with multiple producers
+// Thread safe FiFo-Queue which supports out of order filling with multiple producers
+// the packets are reordered in the queue and fetched in order of their id
 class fifo_queue 
 {
 	public:
@@ -44,7 +45,7 @@ class fifo_queue
 
 		// One thread is only allowed to use ONE of the functions below, otherwise the locking will not work
 		
-		// deposit to a specific slot to allow ordered processing
+		// deposit to a specific slot to allow ordered processing, the earlier slots do not need to be filled in
 		bool deposit(
 		      uint8_t required_slot_id,
 		      storage_media_buffer_t *source_buffer,
@@ -81,7 +82,7 @@ class fifo_queue
 		int fill_count;
 		// id of the next free packet
 		uint8_t next_read_id;
-		// id of the first packet in the queue (only valid if count > 0)
+		// id of the first packet in the queue, the packets with the next ids are stored in the following slots
 		uint8_t current_front_id;
 		// 0=continue, 1=finishing, 2=aborting
 		std::atomic<int> shutdown_mode;
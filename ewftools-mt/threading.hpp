@@ -56,6 +56,7 @@ int init_threading_data_and_start_threads(
      imaging_handle_t *imaging_handle,
      size_t storage_media_buffer_size,
      threading_support_data_t **threading_data,
+     int verbose_messages,
      libcerror_error_t **error );
 
 /* returns -1 on error
@@ -0,0 +1,478 @@
+/*
+ * Automatic compression level control functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "byte_size_string.h"
+#include "compression_level_control.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcstring.h"
+
+/* Creates compression level control
+ * Make sure the value compression_level_control is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_control_initialize(
+     compression_level_control_t **compression_level_control,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_control_initialize";
+
+	if( compression_level_control == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level control.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_level_control != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression level control value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_level_control = memory_allocate_structure(
+	                              compression_level_control_t );
+
+	if( *compression_level_control == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression level control.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_level_control,
+	     0,
+	     sizeof( compression_level_control_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression level control.",
+		 function );
+
+		goto on_error;
+	}
+	/* The first batch measures the reference throughput
+	 */
+	( *compression_level_control )->compression_level = COMPRESSION_LEVEL_CONTROL_MINIMUM_LEVEL;
+
+	return( 1 );
+
+on_error:
+	if( *compression_level_control != NULL )
+	{
+		memory_free(
+		 *compression_level_control );
+
+		*compression_level_control = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees compression level control
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_control_free(
+     compression_level_control_t **compression_level_control,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_control_free";
+
+	if( compression_level_control == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level control.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_level_control != NULL )
+	{
+		memory_free(
+		 *compression_level_control );
+
+		*compression_level_control = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the current value of a monotonic clock in nanoseconds
+ * The value is only meaningful relative to another value of the same clock
+ * Returns the time or 0 if no clock is available
+ */
+uint64_t compression_level_control_get_time(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) counter.QuadPart / (uint64_t) frequency.QuadPart ) * 1000000000UL
+	      + ( ( (uint64_t) counter.QuadPart % (uint64_t) frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+
+#elif defined( HAVE_SYS_TIME_H )
+	struct timeval time_value;
+
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + ( (uint64_t) time_value.tv_usec * 1000UL ) );
+
+#else
+	return( 0 );
+#endif
+}
+
+/* Updates the compression level control with data that was processed
+ * The time between the end of the previous processing and the start of this processing
+ * is the time spent waiting for the source, e.g. reading the input
+ *
+ * At the end of every batch the throughput of the batch is compared with the reference
+ * throughput, which is measured at the minimum level. If the throughput is within the
+ * tolerated loss the pipeline is still limited by the source or the output and a higher
+ * level is tried, otherwise the compression became the bottleneck and the level is lowered.
+ *
+ * Returns 1 if the compression level changed, 0 if not or -1 on error
+ */
+int compression_level_control_update(
+     compression_level_control_t *compression_level_control,
+     size_t process_size,
+     uint64_t process_start_time,
+     uint64_t process_end_time,
+     int *compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_control_update";
+	uint64_t batch_time   = 0;
+	uint64_t throughput   = 0;
+	int previous_level    = 0;
+
+	if( compression_level_control == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level control.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_end_time < process_start_time )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid process end time value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_level_control->process_end_time != 0 )
+	 && ( compression_level_control->process_end_time <= process_start_time ) )
+	{
+		compression_level_control->batch_source_time += process_start_time - compression_level_control->process_end_time;
+	}
+	compression_level_control->batch_process_time += process_end_time - process_start_time;
+	compression_level_control->batch_size         += process_size;
+	compression_level_control->process_end_time    = process_end_time;
+
+	*compression_level = compression_level_control->compression_level;
+
+	if( compression_level_control->batch_size < (size64_t) COMPRESSION_LEVEL_CONTROL_BATCH_SIZE )
+	{
+		return( 0 );
+	}
+	batch_time = compression_level_control->batch_source_time
+	           + compression_level_control->batch_process_time;
+
+	if( batch_time == 0 )
+	{
+		batch_time = 1;
+	}
+	throughput = ( compression_level_control->batch_size * 1000000000UL ) / batch_time;
+
+	compression_level_control->number_of_batches[ compression_level_control->compression_level ] += 1;
+
+	compression_level_control->total_size         += compression_level_control->batch_size;
+	compression_level_control->total_source_time  += compression_level_control->batch_source_time;
+	compression_level_control->total_process_time += compression_level_control->batch_process_time;
+
+	compression_level_control->batch_size         = 0;
+	compression_level_control->batch_source_time  = 0;
+	compression_level_control->batch_process_time = 0;
+
+	previous_level = compression_level_control->compression_level;
+
+	if( compression_level_control->is_reference_batch != 0 )
+	{
+		compression_level_control->reference_throughput = throughput;
+		compression_level_control->compression_level    = compression_level_control->resume_compression_level;
+		compression_level_control->is_reference_batch   = 0;
+	}
+	else if( compression_level_control->compression_level == COMPRESSION_LEVEL_CONTROL_MINIMUM_LEVEL )
+	{
+		compression_level_control->reference_throughput              = throughput;
+		compression_level_control->number_of_batches_since_reference = 0;
+
+		if( compression_level_control->hold_count > 0 )
+		{
+			compression_level_control->hold_count -= 1;
+		}
+		else
+		{
+			compression_level_control->compression_level += 1;
+		}
+	}
+	else if( ( throughput * 100 ) >= ( compression_level_control->reference_throughput * ( 100 - COMPRESSION_LEVEL_CONTROL_TOLERATED_LOSS ) ) )
+	{
+		if( compression_level_control->hold_count > 0 )
+		{
+			compression_level_control->hold_count -= 1;
+		}
+		else if( compression_level_control->compression_level < COMPRESSION_LEVEL_CONTROL_MAXIMUM_LEVEL )
+		{
+			compression_level_control->compression_level += 1;
+		}
+	}
+	else
+	{
+		compression_level_control->compression_level -= 1;
+		compression_level_control->hold_count         = COMPRESSION_LEVEL_CONTROL_HOLD_BATCHES;
+	}
+	/* The reference throughput changes with the source and the data,
+	 * hence it is measured again periodically
+	 */
+	if( compression_level_control->compression_level > COMPRESSION_LEVEL_CONTROL_MINIMUM_LEVEL )
+	{
+		compression_level_control->number_of_batches_since_reference += 1;
+
+		if( compression_level_control->number_of_batches_since_reference >= COMPRESSION_LEVEL_CONTROL_REFERENCE_INTERVAL )
+		{
+			compression_level_control->resume_compression_level          = compression_level_control->compression_level;
+			compression_level_control->compression_level                 = COMPRESSION_LEVEL_CONTROL_MINIMUM_LEVEL;
+			compression_level_control->is_reference_batch                = 1;
+			compression_level_control->number_of_batches_since_reference = 0;
+		}
+	}
+	*compression_level = compression_level_control->compression_level;
+
+	if( compression_level_control->compression_level == previous_level )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Prints a rate to a stream
+ */
+void compression_level_control_fprint_rate(
+      FILE *stream,
+      const char *description,
+      uint64_t size,
+      uint64_t time )
+{
+	libcstring_system_character_t bytes_per_second_string[ 16 ];
+
+	uint64_t bytes_per_second = 0;
+	int result                = 0;
+
+	if( time == 0 )
+	{
+		return;
+	}
+	bytes_per_second = (uint64_t) ( ( (double) size * 1000000000.0 ) / (double) time );
+
+	if( bytes_per_second > 1024 )
+	{
+		result = byte_size_string_create(
+		          bytes_per_second_string,
+		          16,
+		          bytes_per_second,
+		          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
+		          NULL );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stream,
+		 "%s%" PRIs_LIBCSTRING_SYSTEM "/s (%" PRIu64 " bytes/second)\n",
+		 description,
+		 bytes_per_second_string,
+		 bytes_per_second );
+	}
+	else
+	{
+		fprintf(
+		 stream,
+		 "%s%" PRIu64 " bytes/second\n",
+		 description,
+		 bytes_per_second );
+	}
+}
+
+/* Prints the compression level control summary
+ * The compression and write values are those measured by libewf
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_control_fprint(
+     compression_level_control_t *compression_level_control,
+     FILE *stream,
+     uint64_t number_of_bytes_compressed,
+     uint64_t compression_time,
+     uint64_t number_of_bytes_written,
+     uint64_t write_time,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_control_fprint";
+	int compression_level = 0;
+
+	if( compression_level_control == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level control.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* Include the data of the batch that is not yet complete
+	 */
+	compression_level_control_fprint_rate(
+	 stream,
+	 "Source rate:\t\t\t\t",
+	 compression_level_control->total_size + compression_level_control->batch_size,
+	 compression_level_control->total_source_time + compression_level_control->batch_source_time );
+
+	compression_level_control_fprint_rate(
+	 stream,
+	 "Compression rate:\t\t\t",
+	 number_of_bytes_compressed,
+	 compression_time );
+
+	compression_level_control_fprint_rate(
+	 stream,
+	 "Write rate:\t\t\t\t",
+	 number_of_bytes_written,
+	 write_time );
+
+	fprintf(
+	 stream,
+	 "Batches per compression level:\t" );
+
+	for( compression_level = COMPRESSION_LEVEL_CONTROL_MINIMUM_LEVEL;
+	     compression_level <= COMPRESSION_LEVEL_CONTROL_MAXIMUM_LEVEL;
+	     compression_level++ )
+	{
+		fprintf(
+		 stream,
+		 " %d:%" PRIu64 "",
+		 compression_level,
+		 compression_level_control->number_of_batches[ compression_level ] );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
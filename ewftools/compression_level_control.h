@@ -0,0 +1,156 @@
+/*
+ * Automatic compression level control functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _COMPRESSION_LEVEL_CONTROL_H )
+#define _COMPRESSION_LEVEL_CONTROL_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The minimum and maximum zlib compression level
+ */
+#define COMPRESSION_LEVEL_CONTROL_MINIMUM_LEVEL			1
+#define COMPRESSION_LEVEL_CONTROL_MAXIMUM_LEVEL			9
+
+/* The amount of data processed with the same level before the level is reconsidered
+ */
+#define COMPRESSION_LEVEL_CONTROL_BATCH_SIZE			( 32 * 1024 * 1024 )
+
+/* The throughput loss, in percent of the reference throughput, that is tolerated
+ */
+#define COMPRESSION_LEVEL_CONTROL_TOLERATED_LOSS		10
+
+/* The number of batches the level is held after it was lowered
+ */
+#define COMPRESSION_LEVEL_CONTROL_HOLD_BATCHES			4
+
+/* The number of batches after which the reference throughput is measured again
+ */
+#define COMPRESSION_LEVEL_CONTROL_REFERENCE_INTERVAL		32
+
+typedef struct compression_level_control compression_level_control_t;
+
+struct compression_level_control
+{
+	/* The current zlib compression level
+	 */
+	int compression_level;
+
+	/* The level to continue with after the reference batch
+	 */
+	int resume_compression_level;
+
+	/* Value to indicate the current batch measures the reference throughput
+	 */
+	uint8_t is_reference_batch;
+
+	/* The number of batches the level is held before a higher level is tried
+	 */
+	int hold_count;
+
+	/* The number of batches since the reference throughput was measured
+	 */
+	int number_of_batches_since_reference;
+
+	/* The reference throughput in bytes per second, measured at the minimum level
+	 */
+	uint64_t reference_throughput;
+
+	/* The time the previous processing ended
+	 */
+	uint64_t process_end_time;
+
+	/* The size of the data processed in the current batch
+	 */
+	size64_t batch_size;
+
+	/* The time spent waiting for the source in the current batch
+	 */
+	uint64_t batch_source_time;
+
+	/* The time spent processing (compressing and writing) in the current batch
+	 */
+	uint64_t batch_process_time;
+
+	/* The total size of the data processed
+	 */
+	size64_t total_size;
+
+	/* The total time spent waiting for the source
+	 */
+	uint64_t total_source_time;
+
+	/* The total time spent processing
+	 */
+	uint64_t total_process_time;
+
+	/* The number of batches per compression level
+	 */
+	uint64_t number_of_batches[ COMPRESSION_LEVEL_CONTROL_MAXIMUM_LEVEL + 1 ];
+};
+
+int compression_level_control_initialize(
+     compression_level_control_t **compression_level_control,
+     libcerror_error_t **error );
+
+int compression_level_control_free(
+     compression_level_control_t **compression_level_control,
+     libcerror_error_t **error );
+
+uint64_t compression_level_control_get_time(
+          void );
+
+int compression_level_control_update(
+     compression_level_control_t *compression_level_control,
+     size_t process_size,
+     uint64_t process_start_time,
+     uint64_t process_end_time,
+     int *compression_level,
+     libcerror_error_t **error );
+
+void compression_level_control_fprint_rate(
+      FILE *stream,
+      const char *description,
+      uint64_t size,
+      uint64_t time );
+
+int compression_level_control_fprint(
+     compression_level_control_t *compression_level_control,
+     FILE *stream,
+     uint64_t number_of_bytes_compressed,
+     uint64_t compression_time,
+     uint64_t number_of_bytes_written,
+     uint64_t write_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -510,6 +510,7 @@ int device_handle_open_smdev_input(
      libcerror_error_t **error )
 {
 	static char *function = "device_handle_open_smdev_input";
+	int access_flags      = LIBSMDEV_OPEN_READ;
 
 	if( device_handle == NULL )
 	{
@@ -568,17 +569,21 @@ int device_handle_open_smdev_input(
 
 		goto on_error;
 	}
+	if( device_handle->use_direct_access != 0 )
+	{
+		access_flags = LIBSMDEV_OPEN_READ_DIRECT;
+	}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libsmdev_handle_open_wide(
 	     device_handle->smdev_input_handle,
 	     filenames[ 0 ],
-	     LIBSMDEV_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libsmdev_handle_open(
 	     device_handle->smdev_input_handle,
 	     filenames[ 0 ],
-	     LIBSMDEV_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -2312,6 +2317,100 @@ int device_handle_set_error_values(
 	return( 1 );
 }
 
+/* Sets the number of device reads to keep in flight
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int device_handle_set_read_queue_depth(
+     device_handle_t *device_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "device_handle_set_read_queue_depth";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = libcstring_system_string_length(
+	                 string );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &size_variable,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine read queue depth.",
+		 function );
+
+		return( -1 );
+	}
+	if( size_variable <= (uint64_t) DEVICE_HANDLE_MAXIMUM_READ_QUEUE_DEPTH )
+	{
+		device_handle->read_queue_depth = (int) size_variable;
+
+		result = 1;
+	}
+	return( result );
+}
+
+/* Sets the read queue values
+ * The read size is the size of a single queued device read
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_set_read_queue_values(
+     device_handle_t *device_handle,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_set_read_queue_values";
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	{
+		if( libsmdev_handle_set_read_queue_values(
+		     device_handle->smdev_input_handle,
+		     device_handle->read_queue_depth,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set read queue values in device input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves the number of read errors
  * Returns 1 if successful or -1 on error
  */
@@ -45,6 +45,10 @@ enum DEVICE_HANDLE_TYPES
 	DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE		= (uint8_t) 'o'
 };
 
+/* The maximum number of device reads that can be kept in flight
+ */
+#define DEVICE_HANDLE_MAXIMUM_READ_QUEUE_DEPTH		64
+
 /* The media type definitions
  */
 enum DEVICE_HANDLE_MEDIA_TYPES
@@ -112,6 +116,14 @@ struct device_handle
 	 */
 	uint8_t zero_buffer_on_error;
 
+	/* Value to indicate the device should be read directly bypassing the system cache
+	 */
+	uint8_t use_direct_access;
+
+	/* The number of device reads to keep in flight, 0 if reads are not queued
+	 */
+	int read_queue_depth;
+
 	/* The nofication output stream
 	 */
 	FILE *notify_stream;
@@ -259,6 +271,16 @@ int device_handle_set_error_values(
      size_t error_granularity,
      libcerror_error_t **error );
 
+int device_handle_set_read_queue_depth(
+     device_handle_t *device_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
+int device_handle_set_read_queue_values(
+     device_handle_t *device_handle,
+     size_t read_size,
+     libcerror_error_t **error );
+
 int device_handle_get_number_of_read_errors(
      device_handle_t *device_handle,
      int *number_of_errors,
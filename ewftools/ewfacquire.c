@@ -41,6 +41,7 @@
 #include "imaging_handle.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "rescue_map.h"
 #include "storage_media_buffer.h"
 
 #if defined( __BORLANDC__ ) && ( __BORLANDC__ < 0x0560 )
@@ -51,6 +52,21 @@
 
 #define EWFACQUIRE_INPUT_BUFFER_SIZE		64
 
+/* The minimum and maximum number of bytes the first pass of a rescue
+ * skips after a read error, the skip size doubles for every consecutive read error
+ */
+#define EWFACQUIRE_MINIMUM_SKIP_SIZE		( 64 * 1024 )
+#define EWFACQUIRE_MAXIMUM_SKIP_SIZE		( 64 * 1024 * 1024 )
+
+/* The default process buffer size when reading a device directly,
+ * direct access bypasses the read-ahead of the system cache
+ */
+#define EWFACQUIRE_DIRECT_ACCESS_PROCESS_BUFFER_SIZE	( 4 * 1024 * 1024 )
+
+/* The maximum number of stripe targets
+ */
+#define EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_TARGETS	15
+
 device_handle_t *ewfacquire_device_handle   = NULL;
 imaging_handle_t *ewfacquire_imaging_handle = NULL;
 int ewfacquire_abort                        = 0;
@@ -112,15 +128,21 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -l log_filename ]\n"
+	                 "                  [ -F rescue_map_file ] [ -g number_of_sectors ]\n"
+	                 "                  [ -j number_of_chunks ] [ -l log_filename ]\n"
 	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
 	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
-	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -P bytes_per_sector ] [ -Q queue_depth ]\n"
+	                 "                  [ -r read_error_retries ] [ -S segment_file_size ]\n"
+	                 "                  [ -t target ] [ -T toc_file ] [ -X stripe_target ]\n"
+	                 "                  [ -Z zlib_compression_values ]\n"
+	                 "                  [ -2 secondary_target ] [ -ahIqRsuvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
+	fprintf( stream, "\t-a:     preallocate the segment files to the segment file size, so\n"
+	                 "\t        that they are stored contiguously. The unused part is released\n"
+	                 "\t        when a segment file is completed\n" );
 	fprintf( stream, "\t-A:     codepage of header section, options: ascii (default),\n"
 	                 "\t        windows-874, windows-932, windows-936, windows-949,\n"
 	                 "\t        windows-950, windows-1250, windows-1251, windows-1252,\n"
@@ -134,7 +156,12 @@ void ewfacquire_usage_fprint(
 	                 "\t        compression method options: deflate (default), bzip2\n"
 	                 "\t        (bzip2 is only supported by EWF2 formats)\n"
 	                 "\t        compression level options: none (default), empty-block,\n"
-	                 "\t        fast or best\n" );
+	                 "\t        fast, best, adaptive (fast, but chunks that are estimated\n"
+	                 "\t        to be incompressible are stored uncompressed), auto\n"
+	                 "\t        (the zlib level is adjusted while acquiring to the highest\n"
+	                 "\t        level that does not reduce the acquiry speed) or a zlib\n"
+	                 "\t        compression level from 1 to 9 (1 to 5 are stored as fast,\n"
+	                 "\t        6 to 9 as best)\n" );
 	fprintf( stream, "\t-C:     specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d:     calculate additional digest (hash) types besides md5, options:\n"
 	                 "\t        sha1, sha256\n" );
@@ -144,8 +171,26 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-f:     specify the EWF file format to write to, options: ewf, smart,\n"
 	                 "\t        ftk, encase2, encase3, encase4, encase5, encase6 (default),\n"
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
+	fprintf( stream, "\t-F:     specify the rescue map file to acquire a failing device in\n"
+	                 "\t        multiple passes. The first pass skips ahead on a read error,\n"
+	                 "\t        the following passes retry the unresolved ranges with\n"
+	                 "\t        decreasing read sizes and store the rescued data in delta\n"
+	                 "\t        segment files. If the first pass of the rescue map file\n"
+	                 "\t        was completed only the remaining passes are run on the image\n"
+	                 "\t        specified with -t (with extension). The digest hash(es)\n"
+	                 "\t        stored in the image remain those of the first pass, the\n"
+	                 "\t        hash(es) of the rescued image are printed and logged.\n"
+	                 "\t        The rescue map file uses the ddrescue map file format.\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-I:     read the device directly bypassing the system cache (direct I/O)\n"
+	                 "\t        the default process buffer size is 4 MiB in this mode\n" );
+	fprintf( stream, "\t-j:     write a checkpoint to a journal file (target.journal) every\n"
+	                 "\t        number_of_chunks chunks (default is 0, which disables the\n"
+	                 "\t        journal). An acquiry resumed with -R restarts from the last\n"
+	                 "\t        checkpoint instead of discarding the last chunks section,\n"
+	                 "\t        the segment files are still read to determine the chunks\n"
+	                 "\t        written before it\n" );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable,\n"
 	                 "\t        optical, memory\n" );
@@ -156,6 +201,8 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
 	fprintf( stream, "\t-q:     quiet shows minimal status information\n" );
+	fprintf( stream, "\t-Q:     specify the number of device reads to keep in flight (default\n"
+	                 "\t        is 0, which disables read ahead, maximum is 64)\n" );
 	fprintf( stream, "\t-r:     specify the number of retries when a read error occurs (default\n"
 	                 "\t        is 2)\n" );
 	fprintf( stream, "\t-R:     resume acquiry at a safe point\n" );
@@ -192,6 +239,19 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-w:     zero sectors on read error (mimic EnCase like behavior)\n" );
 	fprintf( stream, "\t-x:     use the chunk data instead of the buffered read and write\n"
 	                 "\t        functions.\n" );
+	fprintf( stream, "\t-X:     specify an additional target file (without extension) to\n"
+	                 "\t        write to, e.g. on another storage device. The segment files\n"
+	                 "\t        are distributed round-robin over the target and the stripe\n"
+	                 "\t        targets. This option can be specified multiple times.\n"
+	                 "\t        A striped image is not found from its first segment file\n"
+	                 "\t        alone, all the segment files must be specified to read it,\n"
+	                 "\t        these are listed when the acquiry completes. Not supported\n"
+	                 "\t        in combination with -R or -F\n" );
+	fprintf( stream, "\t-Z:     specify the zlib compression values as:\n"
+	                 "\t        strategy[:window_bits[:memory_level]]\n"
+	                 "\t        strategy options: default (default), filtered, huffman-only,\n"
+	                 "\t        rle or fixed, window bits: 9 to 15 (default), memory level:\n"
+	                 "\t        1 to 9 (default is 8)\n" );
 	fprintf( stream, "\t-2:     specify the secondary target file (without extension) to write\n"
 	                 "\t        to\n" );
 }
@@ -549,12 +609,82 @@ int ewfacquire_determine_sessions(
 	return( 1 );
 }
 
+/* Updates the rescue map after a range of the input was read
+ * The range is marked as rescued if the device handle reported no additional read errors,
+ * otherwise the range is marked with the error status
+ * Returns 1 if the range was read without errors, 0 if not or -1 on error
+ */
+int ewfacquire_update_rescue_map(
+     rescue_map_t *rescue_map,
+     device_handle_t *device_handle,
+     off64_t offset,
+     size64_t size,
+     uint8_t error_status,
+     int *number_of_read_errors,
+     libcerror_error_t **error )
+{
+	static char *function             = "ewfacquire_update_rescue_map";
+	int current_number_of_read_errors = 0;
+	int result                        = 1;
+
+	if( number_of_read_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle_get_number_of_read_errors(
+	     device_handle,
+	     &current_number_of_read_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of read errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( current_number_of_read_errors > *number_of_read_errors )
+	{
+		result = 0;
+	}
+	*number_of_read_errors = current_number_of_read_errors;
+
+	if( rescue_map_set_range(
+	     rescue_map,
+	     offset,
+	     size,
+	     ( result == 1 ) ? RESCUE_MAP_STATUS_FINISHED : error_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set range: 0x%08" PRIx64 " in rescue map.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Reads the input
  * Returns 1 if successful or -1 on error
  */
 int ewfacquire_read_input(
      imaging_handle_t *imaging_handle,
      device_handle_t *device_handle,
+     rescue_map_t *rescue_map,
      off64_t resume_acquiry_offset,
      uint8_t swap_byte_pairs,
      uint8_t print_status_information,
@@ -566,9 +696,12 @@ int ewfacquire_read_input(
 	storage_media_buffer_t *storage_media_buffer = NULL;
 	uint8_t *data                                = NULL;
 	static char *function                        = "ewfacquire_read_input";
+	off64_t input_offset                         = 0;
 	off64_t read_error_offset                    = 0;
 	size64_t acquiry_count                       = 0;
 	size64_t read_error_size                     = 0;
+	size64_t skip_remainder                      = 0;
+	size64_t skip_size                           = 0;
 	size_t data_size                             = 0;
 	size_t process_buffer_size                   = 0;
 	size_t read_size                             = 0;
@@ -576,9 +709,11 @@ int ewfacquire_read_input(
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
 	uint32_t chunk_size                          = 0;
+	uint8_t number_of_error_retries              = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int number_of_read_errors                    = 0;
 	int read_error_iterator                      = 0;
+	int result                                   = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -780,6 +915,62 @@ int ewfacquire_read_input(
 
 		goto on_error;
         }
+	if( rescue_map != NULL )
+	{
+		/* The first pass of a rescue does not retry or split a failing read
+		 * and skips ahead after it, the rescue passes handle the unresolved ranges
+		 */
+		number_of_error_retries = device_handle->number_of_error_retries;
+
+		device_handle->number_of_error_retries = 0;
+
+		result = device_handle_set_error_values(
+		          device_handle,
+		          process_buffer_size,
+		          error );
+
+		device_handle->number_of_error_retries = number_of_error_retries;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set error values.",
+			 function );
+
+			goto on_error;
+		}
+		if( device_handle_get_number_of_read_errors(
+		     device_handle,
+		     &number_of_read_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of read errors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( device_handle_set_read_queue_values(
+	     device_handle,
+	     process_buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read queue values.",
+		 function );
+
+		goto on_error;
+	}
 	if( process_status_initialize(
 	     &process_status,
 	     _LIBCSTRING_SYSTEM_STRING( "Acquiry" ),
@@ -821,12 +1012,132 @@ int ewfacquire_read_input(
 		}
 		if( (off64_t) acquiry_count >= resume_acquiry_offset )
 		{
-			read_count = device_handle_read_buffer(
-				      device_handle,
-				      storage_media_buffer->raw_buffer,
-				      read_size,
-				      error );
+			input_offset = (off64_t) ( imaging_handle->acquiry_offset + acquiry_count );
+
+			if( skip_remainder > 0 )
+			{
+				/* Skip the input after a read error, the skipped data is stored as 0-byte values
+				 * and marked as non-tried in the rescue map
+				 */
+				if( device_handle_seek_offset(
+				     device_handle,
+				     (off64_t) read_size,
+				     SEEK_CUR,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to skip input.",
+					 function );
+
+					goto on_error;
+				}
+				if( memory_set(
+				     storage_media_buffer->raw_buffer,
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear storage media buffer.",
+					 function );
+
+					goto on_error;
+				}
+				if( rescue_map_set_range(
+				     rescue_map,
+				     input_offset,
+				     (size64_t) read_size,
+				     RESCUE_MAP_STATUS_NON_TRIED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set skipped range in rescue map.",
+					 function );
+
+					goto on_error;
+				}
+				if( imaging_handle_append_read_error(
+				     imaging_handle,
+				     input_offset,
+				     (size64_t) read_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append skipped range to imaging handle.",
+					 function );
 
+					goto on_error;
+				}
+				if( skip_remainder > (size64_t) read_size )
+				{
+					skip_remainder -= read_size;
+				}
+				else
+				{
+					skip_remainder = 0;
+				}
+				read_count = (ssize_t) read_size;
+			}
+			else
+			{
+				read_count = device_handle_read_buffer(
+					      device_handle,
+					      storage_media_buffer->raw_buffer,
+					      read_size,
+					      error );
+
+				if( ( read_count > 0 )
+				 && ( rescue_map != NULL ) )
+				{
+					result = ewfacquire_update_rescue_map(
+						  rescue_map,
+						  device_handle,
+						  input_offset,
+						  (size64_t) read_count,
+						  RESCUE_MAP_STATUS_NON_TRIMMED,
+						  &number_of_read_errors,
+						  error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to update rescue map.",
+						 function );
+
+						goto on_error;
+					}
+					else if( result == 0 )
+					{
+						if( skip_size == 0 )
+						{
+							skip_size = EWFACQUIRE_MINIMUM_SKIP_SIZE;
+						}
+						else if( skip_size < EWFACQUIRE_MAXIMUM_SKIP_SIZE )
+						{
+							skip_size *= 2;
+						}
+						skip_remainder = skip_size;
+					}
+					else
+					{
+						skip_size = 0;
+					}
+				}
+			}
 			if( read_count < 0 )
 			{
 				libcerror_error_set(
@@ -1043,6 +1354,15 @@ int ewfacquire_read_input(
 			break;
 		}
 	}
+	if( rescue_map != NULL )
+	{
+		rescue_map->current_offset = (off64_t) ( imaging_handle->acquiry_offset + acquiry_count );
+
+		if( acquiry_count >= (size64_t) imaging_handle->acquiry_size )
+		{
+			rescue_map->current_status = RESCUE_MAP_STATUS_NON_TRIMMED;
+		}
+	}
 	if( storage_media_buffer_free(
 	     &storage_media_buffer,
 	     error ) != 1 )
@@ -1188,6 +1508,20 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_statistics(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( imaging_handle_print_hashes(
 		     imaging_handle,
 		     imaging_handle->notify_stream,
@@ -1202,6 +1536,25 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		/* A striped image cannot be globbed from its first segment file
+		 */
+		if( imaging_handle->number_of_stripe_target_filenames > 0 )
+		{
+			if( imaging_handle_print_segment_files(
+			     imaging_handle,
+			     imaging_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print segment files.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( log_handle != NULL )
 		{
 			if( device_handle_read_errors_fprint(
@@ -1216,10 +1569,683 @@ int ewfacquire_read_input(
 				 "%s: unable to print device read errors in log handle.",
 				 function );
 
-				goto on_error;
-			}
-			if( imaging_handle_print_hashes(
+				goto on_error;
+			}
+			if( imaging_handle_print_compression_statistics(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression statistics in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( imaging_handle_print_hashes(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hashes in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( imaging_handle->number_of_stripe_target_filenames > 0 )
+			{
+				if( imaging_handle_print_segment_files(
+				     imaging_handle,
+				     log_handle->log_stream,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+					 "%s: unable to print segment files in log handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( process_status != NULL )
+	{
+		process_status_stop(
+		 process_status,
+		 (size64_t) write_count,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &process_status,
+		 NULL );
+	}
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints the read errors and digest hash(es) of the image after a rescue
+ * The image itself still contains the read errors and digest hash(es) of the first pass,
+ * since the rescued data is stored in delta segment files and the segment files
+ * of the first pass are not modified
+ * Returns 1 if successful or -1 on error
+ */
+int ewfacquire_rescue_print_results(
+     imaging_handle_t *imaging_handle,
+     rescue_map_t *rescue_map,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "ewfacquire_rescue_print_results";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map_errors_fprint(
+	     rescue_map,
+	     imaging_handle->bytes_per_sector,
+	     stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print rescue map errors.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Digest hash(es) calculated over the rescued image:\n" );
+
+	if( imaging_handle_print_hashes(
+	     imaging_handle,
+	     stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print hashes.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "\nWARNING: the image is inconsistent, the digest hash(es) and read errors\n"
+	 "stored in the image describe the data of the first pass. The rescued data\n"
+	 "is stored in delta segment files, verify the image including the delta\n"
+	 "segment files against the digest hash(es) calculated over the rescued image.\n\n" );
+
+	return( 1 );
+}
+
+/* Rescues the unresolved ranges of the rescue map
+ * Every pass retries the unresolved ranges with half the read size of the previous pass,
+ * starting at the chunk size, only the last pass reads per sector and retries on error
+ * The rescued data is written to delta segment files of the output
+ * Returns 1 if successful or -1 on error
+ */
+int ewfacquire_rescue_input(
+     imaging_handle_t *imaging_handle,
+     device_handle_t *device_handle,
+     rescue_map_t *rescue_map,
+     const libcstring_system_character_t *rescue_map_filename,
+     uint8_t reopen_output,
+     uint8_t format,
+     uint8_t swap_byte_pairs,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "ewfacquire_rescue_input";
+	off64_t block_offset                         = 0;
+	off64_t range_end                            = 0;
+	off64_t range_offset                         = 0;
+	size64_t range_size                          = 0;
+	size64_t rescued_size                        = 0;
+	size_t block_size                            = 0;
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+	ssize_t write_count                          = 0;
+	uint32_t chunk_size                          = 0;
+	uint8_t error_status                         = 0;
+	uint8_t number_of_error_retries              = 0;
+	int number_of_read_errors                    = 0;
+	int read_queue_depth                         = 0;
+	int result                                   = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( reopen_output != 0 )
+	{
+		if( imaging_handle_close(
+		     imaging_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle_open_output_read_write(
+	     imaging_handle,
+	     imaging_handle->target_filename,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output for reading and writing.",
+		 function );
+
+		goto on_error;
+	}
+	if( reopen_output == 0 )
+	{
+		if( imaging_handle_get_output_values(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve output values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( rescue_map->media_size != (size64_t) imaging_handle->acquiry_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: rescue map does not match the media size of the output.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_get_chunk_size(
+	     imaging_handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( chunk_size == 0 )
+	 || ( imaging_handle->bytes_per_sector == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size or bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_initialize(
+	     &storage_media_buffer,
+	     STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	     (size_t) chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( device_handle_get_number_of_read_errors(
+	     device_handle,
+	     &number_of_read_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of read errors.",
+		 function );
+
+		goto on_error;
+	}
+	/* The rescue passes read scattered ranges, which does not benefit from read ahead
+	 */
+	read_queue_depth = device_handle->read_queue_depth;
+
+	device_handle->read_queue_depth = 0;
+
+	result = device_handle_set_read_queue_values(
+	          device_handle,
+	          0,
+	          error );
+
+	device_handle->read_queue_depth = read_queue_depth;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read queue values.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_error_retries = device_handle->number_of_error_retries;
+
+	for( block_size = (size_t) chunk_size;
+	     block_size >= (size_t) imaging_handle->bytes_per_sector;
+	     block_size /= 2 )
+	{
+		if( ( block_size / 2 ) < (size_t) imaging_handle->bytes_per_sector )
+		{
+			error_status = RESCUE_MAP_STATUS_BAD_SECTOR;
+		}
+		else
+		{
+			error_status = RESCUE_MAP_STATUS_NON_TRIMMED;
+
+			device_handle->number_of_error_retries = 0;
+		}
+		rescue_map->current_status = error_status;
+
+		result = device_handle_set_error_values(
+		          device_handle,
+		          block_size,
+		          error );
+
+		device_handle->number_of_error_retries = number_of_error_retries;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set error values.",
+			 function );
+
+			goto on_error;
+		}
+		if( print_status_information != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Rescue pass with read size: %" PRIzd " bytes.\n",
+			 block_size );
+		}
+		block_offset = rescue_map->media_offset;
+
+		while( ewfacquire_abort == 0 )
+		{
+			result = rescue_map_get_unresolved_range(
+			          rescue_map,
+			          block_offset,
+			          &range_offset,
+			          &range_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve unresolved range.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			range_end = range_offset + (off64_t) range_size;
+
+			for( block_offset = range_offset;
+			     block_offset < range_end;
+			     block_offset += (off64_t) read_size )
+			{
+				read_size = block_size;
+
+				if( (size64_t) ( range_end - block_offset ) < (size64_t) read_size )
+				{
+					read_size = (size_t) ( range_end - block_offset );
+				}
+				if( device_handle_seek_offset(
+				     device_handle,
+				     block_offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek input offset: 0x%08" PRIx64 ".",
+					 function,
+					 block_offset );
+
+					goto on_error;
+				}
+				read_count = device_handle_read_buffer(
+					      device_handle,
+					      storage_media_buffer->raw_buffer,
+					      read_size,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read data from input at offset: 0x%08" PRIx64 ".",
+					 function,
+					 block_offset );
+
+					goto on_error;
+				}
+				result = ewfacquire_update_rescue_map(
+					  rescue_map,
+					  device_handle,
+					  block_offset,
+					  (size64_t) read_size,
+					  error_status,
+					  &number_of_read_errors,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update rescue map.",
+					 function );
+
+					goto on_error;
+				}
+				else if( result == 1 )
+				{
+					storage_media_buffer->raw_buffer_data_size = read_size;
+
+					if( swap_byte_pairs == 1 )
+					{
+						if( imaging_handle_swap_byte_pairs(
+						     imaging_handle,
+						     storage_media_buffer,
+						     read_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+							 LIBCERROR_CONVERSION_ERROR_GENERIC,
+							 "%s: unable to swap byte pairs.",
+							 function );
+
+							goto on_error;
+						}
+					}
+					if( imaging_handle_seek_offset(
+					     imaging_handle,
+					     block_offset - rescue_map->media_offset,
+					     error ) == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_SEEK_FAILED,
+						 "%s: unable to seek output offset.",
+						 function );
+
+						goto on_error;
+					}
+					write_count = imaging_handle_write_buffer(
+						       imaging_handle,
+						       storage_media_buffer,
+						       read_size,
+						       error );
+
+					if( write_count != (ssize_t) read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write rescued data to output.",
+						 function );
+
+						goto on_error;
+					}
+					rescued_size += (size64_t) write_count;
+				}
+				rescue_map->current_offset = block_offset;
+
+				if( ewfacquire_abort != 0 )
+				{
+					break;
+				}
+			}
+			/* Store the progress after every range so that an interrupted rescue can be continued
+			 */
+			if( rescue_map_write(
+			     rescue_map,
+			     rescue_map_filename,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write rescue map file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( ewfacquire_abort != 0 )
+		{
+			break;
+		}
+	}
+	/* The digest hash(es) stored in the image were calculated over the data of the first pass
+	 */
+	if( ( rescued_size > 0 )
+	 && ( ewfacquire_abort == 0 ) )
+	{
+		if( print_status_information != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Calculating digest hash(es) over the rescued image.\n" );
+		}
+		if( imaging_handle_calculate_output_integrity_hash(
+		     imaging_handle,
+		     storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate digest hash(es) over rescued image.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( storage_media_buffer_free(
+	     &storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewfacquire_abort == 0 )
+	{
+		rescue_map->current_offset = rescue_map->media_offset;
+		rescue_map->current_status = RESCUE_MAP_STATUS_FINISHED;
+	}
+	if( rescue_map_write(
+	     rescue_map,
+	     rescue_map_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write rescue map file.",
+		 function );
+
+		goto on_error;
+	}
+	if( rescue_map_fprint(
+	     rescue_map,
+	     imaging_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print rescue map.",
+		 function );
+
+		goto on_error;
+	}
+	if( log_handle != NULL )
+	{
+		if( rescue_map_fprint(
+		     rescue_map,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print rescue map in log handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( rescued_size > 0 )
+	 && ( ewfacquire_abort == 0 ) )
+	{
+		if( ewfacquire_rescue_print_results(
+		     imaging_handle,
+		     rescue_map,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print rescue results.",
+			 function );
+
+			goto on_error;
+		}
+		if( log_handle != NULL )
+		{
+			if( ewfacquire_rescue_print_results(
 			     imaging_handle,
+			     rescue_map,
 			     log_handle->log_stream,
 			     error ) != 1 )
 			{
@@ -1227,7 +2253,7 @@ int ewfacquire_read_input(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print hashes in log handle.",
+				 "%s: unable to print rescue results in log handle.",
 				 function );
 
 				goto on_error;
@@ -1237,17 +2263,6 @@ int ewfacquire_read_input(
 	return( 1 );
 
 on_error:
-	if( process_status != NULL )
-	{
-		process_status_stop(
-		 process_status,
-		 (size64_t) write_count,
-		 PROCESS_STATUS_FAILED,
-		 NULL );
-		process_status_free(
-		 &process_status,
-		 NULL );
-	}
 	if( storage_media_buffer != NULL )
 	{
 		storage_media_buffer_free(
@@ -1281,6 +2296,7 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_evidence_number           = NULL;
 	libcstring_system_character_t *option_format                    = NULL;
 	libcstring_system_character_t *option_header_codepage           = NULL;
+	libcstring_system_character_t *option_checkpoint_interval       = NULL;
 	libcstring_system_character_t *option_maximum_segment_size      = NULL;
 	libcstring_system_character_t *option_media_flags               = NULL;
 	libcstring_system_character_t *option_media_type                = NULL;
@@ -1288,30 +2304,42 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_number_of_error_retries   = NULL;
 	libcstring_system_character_t *option_offset                    = NULL;
 	libcstring_system_character_t *option_process_buffer_size       = NULL;
+	libcstring_system_character_t *option_read_queue_depth          = NULL;
+	libcstring_system_character_t *option_rescue_map_filename       = NULL;
 	libcstring_system_character_t *option_secondary_target_filename = NULL;
 	libcstring_system_character_t *option_sector_error_granularity  = NULL;
 	libcstring_system_character_t *option_sectors_per_chunk         = NULL;
 	libcstring_system_character_t *option_size                      = NULL;
 	libcstring_system_character_t *option_target_filename           = NULL;
 	libcstring_system_character_t *option_toc_filename              = NULL;
+	libcstring_system_character_t *option_stripe_target_filenames[ EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_TARGETS ];
+	libcstring_system_character_t *option_zlib_compression_values   = NULL;
 	libcstring_system_character_t *program                          = _LIBCSTRING_SYSTEM_STRING( "ewfacquire" );
 	libcstring_system_character_t *request_string                   = NULL;
 
 	log_handle_t *log_handle                                        = NULL;
+	rescue_map_t *rescue_map                                        = NULL;
 
 	libcstring_system_integer_t option                              = 0;
 	off64_t resume_acquiry_offset                                   = 0;
 	size_t string_length                                            = 0;
 	uint8_t calculate_md5                                           = 1;
 	uint8_t print_status_information                                = 1;
+	uint8_t rescue_format                                           = 0;
+	uint8_t rescue_map_exists                                       = 0;
+	uint8_t rescue_only                                             = 0;
 	uint8_t resume_acquiry                                          = 0;
+	uint8_t segment_file_write_flags                                = 0;
 	uint8_t swap_byte_pairs                                         = 0;
 	uint8_t use_chunk_data_functions                                = 0;
 	uint8_t verbose                                                 = 0;
+	uint8_t use_direct_access                                       = 0;
 	uint8_t zero_buffer_on_error                                    = 0;
 	int8_t acquiry_parameters_confirmed                             = 0;
 	int interactive_mode                                            = 1;
+	int number_of_stripe_targets                                    = 0;
 	int result                                                      = 0;
+	int stripe_index                                                = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1346,7 +2374,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hl:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "aA:b:B:c:C:d:D:e:E:f:F:g:hIj:l:m:M:N:o:p:P:qQ:r:RsS:t:T:uvVwxX:Z:2:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1366,6 +2394,11 @@ int main( int argc, char * const argv[] )
 
 				goto on_error;
 
+			case (libcstring_system_integer_t) 'a':
+				segment_file_write_flags |= LIBEWF_SEGMENT_FILE_WRITE_FLAG_PREALLOCATE;
+
+				break;
+
 			case (libcstring_system_integer_t) 'A':
 				option_header_codepage = optarg;
 
@@ -1416,6 +2449,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'F':
+				option_rescue_map_filename = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'g':
 				option_sector_error_granularity = optarg;
 
@@ -1431,6 +2469,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'j':
+				option_checkpoint_interval = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -1471,6 +2514,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'Q':
+				option_read_queue_depth = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'r':
 				option_number_of_error_retries = optarg;
 
@@ -1521,6 +2569,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'I':
+				use_direct_access = 1;
+
+				break;
+
 			case (libcstring_system_integer_t) 'w':
 				zero_buffer_on_error = 1;
 
@@ -1531,6 +2584,25 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'X':
+				if( number_of_stripe_targets >= EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_TARGETS )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of stripe targets, maximum is: %d.\n",
+					 EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_TARGETS );
+
+					goto on_error;
+				}
+				option_stripe_target_filenames[ number_of_stripe_targets++ ] = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'Z':
+				option_zlib_compression_values = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) '2':
 				option_secondary_target_filename = optarg;
 
@@ -1602,6 +2674,78 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	if( number_of_stripe_targets > 0 )
+	{
+		if( resume_acquiry != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Resume acquiry not supported in combination with stripe targets.\n" );
+
+			goto on_error;
+		}
+		if( option_rescue_map_filename != NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Rescue map file not supported in combination with stripe targets.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_rescue_map_filename != NULL )
+	{
+		if( option_secondary_target_filename != NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Rescue map file not supported in combination with a secondary target.\n" );
+
+			goto on_error;
+		}
+		if( rescue_map_initialize(
+		     &rescue_map,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create rescue map.\n" );
+
+			goto on_error;
+		}
+		result = rescue_map_read(
+		          rescue_map,
+		          option_rescue_map_filename,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read rescue map file.\n" );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			rescue_map_exists = 1;
+
+			/* If the first pass was completed only the rescue passes are run
+			 */
+			if( rescue_map->current_status != RESCUE_MAP_STATUS_NON_TRIED )
+			{
+				if( option_target_filename == NULL )
+				{
+					fprintf(
+					 stderr,
+					 "Missing target image filename (with extension) to continue rescue.\n" );
+
+					goto on_error;
+				}
+				rescue_only = 1;
+			}
+		}
+	}
 	if( device_handle_initialize(
 	     &ewfacquire_device_handle,
 	     &error ) != 1 )
@@ -1651,10 +2795,37 @@ int main( int argc, char * const argv[] )
 			 ewfacquire_device_handle->number_of_error_retries );
 		}
 	}
+	if( option_read_queue_depth != NULL )
+	{
+		result = device_handle_set_read_queue_depth(
+			  ewfacquire_device_handle,
+			  option_read_queue_depth,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read queue depth.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported read queue depth defaulting to: %d.\n",
+			 ewfacquire_device_handle->read_queue_depth );
+		}
+	}
 	if( zero_buffer_on_error != 0 )
 	{
 		ewfacquire_device_handle->zero_buffer_on_error = 1;
 	}
+	if( use_direct_access != 0 )
+	{
+		ewfacquire_device_handle->use_direct_access = 1;
+	}
 	/* Open the input file or device size
 	 */
 	if( device_handle_open_input(
@@ -1669,6 +2840,13 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ( use_direct_access != 0 )
+	 && ( ewfacquire_device_handle->type != DEVICE_HANDLE_TYPE_DEVICE ) )
+	{
+		fprintf(
+		 stderr,
+		 "Direct access is only supported for devices, reading the input via the system cache.\n" );
+	}
 	if( device_handle_media_information_fprint(
 	     ewfacquire_device_handle,
 	     stdout,
@@ -1780,6 +2958,32 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	for( stripe_index = 0;
+	     stripe_index < number_of_stripe_targets;
+	     stripe_index++ )
+	{
+		if( imaging_handle_append_stripe_target_filename(
+		     ewfacquire_imaging_handle,
+		     option_stripe_target_filenames[ stripe_index ],
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to append stripe target filename.\n" );
+
+			goto on_error;
+		}
+	}
+	/* Start writing back a completed segment file while the next one is written
+	 * when the segment files are preallocated or distributed over multiple targets
+	 */
+	if( ( segment_file_write_flags != 0 )
+	 || ( number_of_stripe_targets > 0 ) )
+	{
+		segment_file_write_flags |= LIBEWF_SEGMENT_FILE_WRITE_FLAG_FLUSH_ON_CLOSE;
+	}
+	ewfacquire_imaging_handle->segment_file_write_flags = segment_file_write_flags;
+
 	if( option_case_number != NULL )
 	{
 		if( imaging_handle_set_string(
@@ -1904,6 +3108,28 @@ int main( int argc, char * const argv[] )
 			 "Unsupported compression values defaulting to method: deflate with level: none.\n" );
 		}
 	}
+	if( option_zlib_compression_values != NULL )
+	{
+		result = imaging_handle_set_zlib_compression_values(
+			  ewfacquire_imaging_handle,
+			  option_zlib_compression_values,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set zlib compression values.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported zlib compression values defaulting to strategy: default.\n" );
+		}
+	}
 	if( option_media_type != NULL )
 	{
 		result = imaging_handle_set_media_type(
@@ -2068,6 +3294,29 @@ int main( int argc, char * const argv[] )
 			 ewfacquire_imaging_handle->maximum_segment_size );
 		}
 	}
+	if( option_checkpoint_interval != NULL )
+	{
+		result = imaging_handle_set_checkpoint_interval(
+			  ewfacquire_imaging_handle,
+			  option_checkpoint_interval,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set checkpoint interval.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported checkpoint interval defaulting to: %" PRIu32 ".\n",
+			 ewfacquire_imaging_handle->checkpoint_interval );
+		}
+	}
 	if( option_offset != NULL )
 	{
 		result = imaging_handle_set_acquiry_offset(
@@ -2140,6 +3389,10 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
+	else if( use_direct_access != 0 )
+	{
+		ewfacquire_imaging_handle->process_buffer_size = EWFACQUIRE_DIRECT_ACCESS_PROCESS_BUFFER_SIZE;
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = imaging_handle_set_additional_digest_types(
@@ -2166,6 +3419,7 @@ int main( int argc, char * const argv[] )
 	/* Request the necessary case data
 	 */
 	while( ( interactive_mode != 0 )
+	    && ( rescue_only == 0 )
 	    && ( acquiry_parameters_confirmed == 0 ) )
 	{
 		fprintf(
@@ -2715,7 +3969,8 @@ int main( int argc, char * const argv[] )
 	{
 		goto on_abort;
 	}
-	if( resume_acquiry == 0 )
+	if( ( resume_acquiry == 0 )
+	 && ( rescue_only == 0 ) )
 	{
 		result = device_handle_get_information_value(
 			  ewfacquire_device_handle,
@@ -2868,26 +4123,124 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = ewfacquire_read_input(
-		  ewfacquire_imaging_handle,
-		  ewfacquire_device_handle,
-		  resume_acquiry_offset,
-		  swap_byte_pairs,
-		  print_status_information,
-	          use_chunk_data_functions,
-		  log_handle,
-		  &error );
+	if( ( rescue_map != NULL )
+	 && ( rescue_only == 0 ) )
+	{
+		if( ( resume_acquiry == 0 )
+		 || ( rescue_map_exists == 0 )
+		 || ( rescue_map->media_offset != (off64_t) ewfacquire_imaging_handle->acquiry_offset )
+		 || ( rescue_map->media_size != (size64_t) ewfacquire_imaging_handle->acquiry_size ) )
+		{
+			result = rescue_map_set_media(
+			          rescue_map,
+			          (off64_t) ewfacquire_imaging_handle->acquiry_offset,
+			          (size64_t) ewfacquire_imaging_handle->acquiry_size,
+			          &error );
+		}
+		else
+		{
+			result = rescue_map_set_range(
+			          rescue_map,
+			          rescue_map->media_offset + resume_acquiry_offset,
+			          rescue_map->media_size - (size64_t) resume_acquiry_offset,
+			          RESCUE_MAP_STATUS_NON_TRIED,
+			          &error );
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize rescue map.\n" );
 
-	if( result != 1 )
+			goto on_error;
+		}
+	}
+	if( rescue_only == 0 )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to acquire input.\n" );
+		result = ewfacquire_read_input(
+			  ewfacquire_imaging_handle,
+			  ewfacquire_device_handle,
+			  rescue_map,
+			  resume_acquiry_offset,
+			  swap_byte_pairs,
+			  print_status_information,
+			  use_chunk_data_functions,
+			  log_handle,
+			  &error );
 
-		libcnotify_print_error_backtrace(
-		 error );
-		libcerror_error_free(
-		 &error );
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to acquire input.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( rescue_map != NULL )
+		{
+			if( rescue_map_write(
+			     rescue_map,
+			     option_rescue_map_filename,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to write rescue map file.\n" );
+
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+
+				result = -1;
+			}
+		}
+	}
+	else
+	{
+		result = 1;
+	}
+	if( ( result == 1 )
+	 && ( rescue_map != NULL )
+	 && ( ewfacquire_abort == 0 ) )
+	{
+		/* The target filename of an acquiry that was not resumed has no extension
+		 */
+		if( ( rescue_only == 0 )
+		 && ( resume_acquiry == 0 ) )
+		{
+			rescue_format = ewfacquire_imaging_handle->ewf_format;
+		}
+		else
+		{
+			rescue_format = LIBEWF_FORMAT_UNKNOWN;
+		}
+		result = ewfacquire_rescue_input(
+			  ewfacquire_imaging_handle,
+			  ewfacquire_device_handle,
+			  rescue_map,
+			  option_rescue_map_filename,
+			  (uint8_t) ( rescue_only == 0 ),
+			  rescue_format,
+			  swap_byte_pairs,
+			  print_status_information,
+			  log_handle,
+			  &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to rescue input.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
 	}
 	if( log_handle != NULL )
 	{
@@ -2965,6 +4318,19 @@ on_abort:
 
 		goto on_error;
 	}
+	if( rescue_map != NULL )
+	{
+		if( rescue_map_free(
+		     &rescue_map,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free rescue map.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewfacquire_abort != 0 )
 	{
 		fprintf(
@@ -3025,6 +4391,12 @@ on_error:
 		 &ewfacquire_device_handle,
 		 NULL );
 	}
+	if( rescue_map != NULL )
+	{
+		rescue_map_free(
+		 &rescue_map,
+		 NULL );
+	}
 	return( EXIT_FAILURE );
 }
 
@@ -19,6 +19,12 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+/* F_SETPIPE_SZ is only defined by glibc when _GNU_SOURCE is defined
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -27,6 +33,10 @@
 #include <errno.h>
 #endif
 
+#if defined( HAVE_FCNTL_H ) && !defined( WINAPI )
+#include <fcntl.h>
+#endif
+
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
@@ -46,6 +56,15 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 
+/* The default process buffer size, which is independent of the chunk size
+ * so that the input is read with few large reads
+ */
+#define EWFACQUIRESTREAM_DEFAULT_PROCESS_BUFFER_SIZE	( 4 * 1024 * 1024 )
+
+/* The minimum size the input pipe is resized to
+ */
+#define EWFACQUIRESTREAM_MINIMUM_PIPE_SIZE		( 64 * 1024 )
+
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
 int ewfacquirestream_abort                        = 0;
 
@@ -111,8 +130,8 @@ void usage_fprint(
 	                 "                        [ -M media_flags ] [ -N notes ]\n"
 	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                        [ -P bytes_per_sector ] [ -S segment_file_size ]\n"
-	                 "                        [ -t target ] [ -2 secondary_target ]\n"
-	                 "                        [ -hqsvVx ]\n\n" );
+	                 "                        [ -t target ] [ -Z zlib_compression_values ]\n"
+	                 "                        [ -2 secondary_target ] [ -hqsvVx ]\n\n" );
 
 	fprintf( stream, "\tReads data from stdin\n\n" );
 
@@ -129,7 +148,12 @@ void usage_fprint(
 	                 "\t    compression method options: deflate (default), bzip2\n"
 	                 "\t    (bzip2 is only supported by EWF2 formats)\n"
 	                 "\t    compression level options: none (default), empty-block,\n"
-	                 "\t    fast or best\n" );
+	                 "\t    fast, best, adaptive (fast, but chunks that are estimated\n"
+	                 "\t    to be incompressible are stored uncompressed), auto\n"
+	                 "\t    (the zlib level is adjusted while acquiring to the highest\n"
+	                 "\t    level that does not reduce the acquiry speed) or a zlib\n"
+	                 "\t    compression level from 1 to 9 (1 to 5 are stored as fast,\n"
+	                 "\t    6 to 9 as best)\n" );
 	fprintf( stream, "\t-C: specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d: calculate additional digest (hash) types besides md5, options:\n"
 	                 "\t    sha1, sha256\n" );
@@ -146,7 +170,8 @@ void usage_fprint(
 	fprintf( stream, "\t-M: specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N: specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o: specify the offset to start to acquire (default is 0)\n" );
-	fprintf( stream, "\t-p: specify the process buffer size (default is the chunk size)\n" );
+	fprintf( stream, "\t-p: specify the process buffer size (default is 4 MiB or the chunk size\n"
+	                 "\t    if larger)\n" );
 	fprintf( stream, "\t-P: specify the number of bytes per sector (default is 512)\n" );
 	fprintf( stream, "\t-q: quiet shows minimal status information\n" );
 	fprintf( stream, "\t-s: swap byte pairs of the media data (from AB to BA)\n"
@@ -177,6 +202,11 @@ void usage_fprint(
 	fprintf( stream, "\t-v: verbose output to stderr\n" );
 	fprintf( stream, "\t-V: print version\n" );
 	fprintf( stream, "\t-x: use the chunk data instead of the buffered read and write functions.\n" );
+	fprintf( stream, "\t-Z: specify the zlib compression values as:\n"
+	                 "\t    strategy[:window_bits[:memory_level]]\n"
+	                 "\t    strategy options: default (default), filtered, huffman-only, rle\n"
+	                 "\t    or fixed, window bits: 9 to 15 (default), memory level: 1 to 9\n"
+	                 "\t    (default is 8)\n" );
 	fprintf( stream, "\t-2: specify the secondary target file (without extension) to write to\n" );
 }
 
@@ -219,38 +249,75 @@ void ewfacquirestream_signal_handler(
 	}
 }
 
-/* Reads a chunk of data from the file descriptor into the buffer
- * Returns the number of bytes read, 0 if at end of input or -1 on error
+/* Resizes the input pipe to hold a process buffer, if the input is a pipe
+ * A larger pipe allows the producer to write ahead and the process buffer
+ * to be filled with fewer reads. Since the maximum size of a pipe can be
+ * restricted smaller sizes are tried as well
+ * Returns 1 if successful, 0 if the input pipe was not resized or -1 on error
  */
-ssize_t ewfacquirestream_read_chunk(
-         libewf_handle_t *handle,
-         int input_file_descriptor,
-         uint8_t *buffer,
-         size_t buffer_size,
-         size32_t chunk_size,
-         ssize64_t total_read_count,
-         uint8_t read_error_retries,
-         libcerror_error_t **error )
+int ewfacquirestream_set_input_pipe_size(
+     int input_file_descriptor,
+     size_t pipe_size,
+     libcerror_error_t **error )
 {
-	static char *function         = "ewfacquirestream_read_chunk";
-	ssize_t read_count            = 0;
-	ssize_t buffer_offset         = 0;
-	size_t read_size              = 0;
-	size_t bytes_to_read          = 0;
-	int32_t read_number_of_errors = 0;
-	uint32_t read_error_offset    = 0;
+	static char *function = "ewfacquirestream_set_input_pipe_size";
 
-	if( handle == NULL )
+	if( input_file_descriptor == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid input file descriptor.",
 		 function );
 
 		return( -1 );
 	}
+	if( pipe_size > (size_t) INT_MAX )
+	{
+		pipe_size = (size_t) INT_MAX;
+	}
+#if defined( F_SETPIPE_SZ )
+	while( pipe_size >= EWFACQUIRESTREAM_MINIMUM_PIPE_SIZE )
+	{
+		if( fcntl(
+		     input_file_descriptor,
+		     F_SETPIPE_SZ,
+		     (int) pipe_size ) != -1 )
+		{
+			return( 1 );
+		}
+		/* The input is not a pipe
+		 */
+		if( ( errno != EPERM )
+		 && ( errno != EBUSY ) )
+		{
+			break;
+		}
+		pipe_size /= 2;
+	}
+#endif
+	return( 0 );
+}
+
+/* Reads a buffer of data from the file descriptor
+ * The buffer is filled with as few reads as possible, a short read,
+ * as returned by a pipe, does not indicate the end of the input
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t ewfacquirestream_read_buffer(
+         int input_file_descriptor,
+         uint8_t *buffer,
+         size_t read_size,
+         ssize64_t total_read_count,
+         uint8_t read_error_retries,
+         libcerror_error_t **error )
+{
+	static char *function         = "ewfacquirestream_read_buffer";
+	size_t buffer_offset          = 0;
+	ssize_t read_count            = 0;
+	int32_t read_number_of_errors = 0;
+
 	if( input_file_descriptor == -1 )
 	{
 		libcerror_error_set(
@@ -273,24 +340,13 @@ ssize_t ewfacquirestream_read_chunk(
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( read_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	if( chunk_size == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid chunk size value zero or less.",
+		 "%s: invalid read size value exceeds maximum.",
 		 function );
 
 		return( -1 );
@@ -306,155 +362,103 @@ ssize_t ewfacquirestream_read_chunk(
 
 		return( -1 );
 	}
-	while( buffer_size > 0 )
+	while( buffer_offset < read_size )
 	{
-		/* Determine the number of bytes to read from the input
-		 * Read as much as possible in chunk sizes
-		 */
-		if( buffer_size < (size_t) chunk_size )
+		read_count = libcsystem_file_io_read(
+		              input_file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              read_size - buffer_offset );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
-			read_size = buffer_size;
+			libcnotify_printf(
+			 "%s: read buffer at: %" PRIi64 " of size: %" PRIzd ".\n",
+			 function,
+			 total_read_count + (ssize64_t) buffer_offset,
+			 read_count );
 		}
-		else
+#endif
+		if( read_count <= -1 )
 		{
-			read_size = chunk_size;
-		}
-		bytes_to_read = read_size;
+			if( errno == ESPIPE )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: error reading data: invalid seek.",
+				 function );
 
-		while( read_number_of_errors <= read_error_retries )
-		{
-			read_count = libcsystem_file_io_read(
-			              input_file_descriptor,
-			              &( buffer[ buffer_offset + read_error_offset ] ),
-			              bytes_to_read );
+				return( -1 );
+			}
+			else if( errno == EPERM )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: error reading data: operation not permitted.",
+				 function );
 
+				return( -1 );
+			}
+			else if( errno == ENXIO )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: error reading data: no such device or address.",
+				 function );
+
+				return( -1 );
+			}
+			else if( errno == ENODEV )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: error reading data: no such device.",
+				 function );
+
+				return( -1 );
+			}
 #if defined( HAVE_VERBOSE_OUTPUT )
 			if( libcnotify_verbose != 0 )
 			{
 				libcnotify_printf(
-				 "%s: read buffer at: %" PRIu64 " of size: %" PRIzd ".\n",
+				 "%s: read error at offset %" PRIi64 ".\n",
 				 function,
-				 total_read_count,
-				 read_count );
+				 total_read_count + (ssize64_t) buffer_offset );
 			}
 #endif
-			if( read_count <= -1 )
-			{
-				if( ( errno == ESPIPE )
-				 || ( errno == EPERM )
-				 || ( errno == ENXIO )
-				 || ( errno == ENODEV ) )
-				{
-					if( errno == ESPIPE )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: invalid seek.",
-						 function );
-					}
-					else if( errno == EPERM )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: operation not permitted.",
-						 function );
-					}
-					else if( errno == ENXIO )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: no such device or address.",
-						 function );
-					}
-					else if( errno == ENODEV )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: no such device.",
-						 function );
-					}
-					else
-					{
-						libcerror_system_set_error(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 errno,
-						 "%s: error reading data.",
-						 function );
-					}
-					return( -1 );
-				}
-			}
-			else
-			{
-				/* The last read is OK, correct read_count
-				 */
-				if( read_count == (ssize_t) bytes_to_read )
-				{
-					read_count = read_error_offset + bytes_to_read;
-				}
-				/* The entire read is OK
-				 */
-				if( read_count == (ssize_t) read_size )
-				{
-					break;
-				}
-				/* If no end of input can be determined
-				 */
-				/* If some bytes were read it is possible that the end of the input reached
-				 */
-				if( read_count > 0 )
-				{
-					return( (ssize32_t) ( buffer_offset + read_count ) );
-				}
-				/* No bytes were read
-				 */
-				if( read_count == 0 )
-				{
-					return( 0 );
-				}
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: read error at offset %" PRIjd " after reading %" PRIzd " bytes.\n",
-					 function,
-					 total_read_count,
-					 read_count );
-				}
-#endif
-				/* There was a read error at a certain offset
-				 */
-				read_error_offset += (uint32_t) read_count;
-				bytes_to_read     -= read_count;
-			}
 			read_number_of_errors++;
 
-			if( read_number_of_errors > read_error_retries )
+			/* The data read so far is returned and the end of the input is assumed
+			 */
+			if( read_number_of_errors > (int32_t) read_error_retries )
 			{
-				return( 0 );
+				break;
 			}
+			continue;
 		}
-		buffer_size   -= read_count;
-		buffer_offset += read_count;
-
 		/* At the end of the input
 		 */
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset        += (size_t) read_count;
+		read_number_of_errors = 0;
+
 		if( ewfacquirestream_abort != 0 )
 		{
 			break;
 		}
 	}
-	return( buffer_offset );
+	return( (ssize_t) buffer_offset );
 }
 
 /* Reads the input
@@ -552,7 +556,12 @@ int ewfacquirestream_read_input(
 	{
 		if( imaging_handle->process_buffer_size == 0 )
 		{
-			process_buffer_size = (size_t) chunk_size;
+			process_buffer_size = EWFACQUIRESTREAM_DEFAULT_PROCESS_BUFFER_SIZE;
+
+			if( process_buffer_size < (size_t) chunk_size )
+			{
+				process_buffer_size = (size_t) chunk_size;
+			}
 		}
 		else
 		{
@@ -560,6 +569,20 @@ int ewfacquirestream_read_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
+	if( ewfacquirestream_set_input_pipe_size(
+	     input_file_descriptor,
+	     process_buffer_size,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set input pipe size.",
+		 function );
+
+		goto on_error;
+	}
 	if( storage_media_buffer_initialize(
 	     &storage_media_buffer,
 	     storage_media_buffer_mode,
@@ -636,14 +659,10 @@ int ewfacquirestream_read_input(
 		{
 			read_size = (size_t) ( (ssize64_t) imaging_handle->acquiry_size - acquiry_count );
 		}
-		/* Read a chunk from the file descriptor
-		 */
-		read_count = ewfacquirestream_read_chunk(
-		              imaging_handle->output_handle,
+		read_count = ewfacquirestream_read_buffer(
 		              input_file_descriptor,
 		              storage_media_buffer->raw_buffer,
-		              storage_media_buffer->raw_buffer_size,
-		              (size32_t) read_size,
+		              read_size,
 		              acquiry_count,
 		              read_error_retries,
 		              error );
@@ -860,6 +879,20 @@ int ewfacquirestream_read_input(
 	}
 	if( ewfacquirestream_abort == 0 )
 	{
+		if( imaging_handle_print_compression_statistics(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( imaging_handle_print_hashes(
 		     imaging_handle,
 		     imaging_handle->notify_stream,
@@ -876,6 +909,20 @@ int ewfacquirestream_read_input(
 		}
 		if( log_handle != NULL )
 		{
+			if( imaging_handle_print_compression_statistics(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression statistics in log handle.",
+				 function );
+
+				goto on_error;
+			}
 			if( imaging_handle_print_hashes(
 			     imaging_handle,
 			     log_handle->log_stream,
@@ -945,6 +992,7 @@ int main( int argc, char * const argv[] )
         libcstring_system_character_t *option_sectors_per_chunk         = NULL;
 	libcstring_system_character_t *option_size                      = NULL;
         libcstring_system_character_t *option_target_filename           = NULL;
+	libcstring_system_character_t *option_zlib_compression_values   = NULL;
 	libcstring_system_character_t *program                          = _LIBCSTRING_SYSTEM_STRING( "ewfacquirestream" );
 
 	log_handle_t *log_handle                                        = NULL;
@@ -1020,7 +1068,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hl:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hl:m:M:N:o:p:P:qsS:t:vVxZ:2:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1175,6 +1223,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'Z':
+				option_zlib_compression_values = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) '2':
 				option_secondary_target_filename = optarg;
 
@@ -1436,6 +1489,28 @@ int main( int argc, char * const argv[] )
 			 "Unsupported compression values defaulting to method: deflate with level: none.\n" );
 		}
 	}
+	if( option_zlib_compression_values != NULL )
+	{
+		result = imaging_handle_set_zlib_compression_values(
+			  ewfacquirestream_imaging_handle,
+			  option_zlib_compression_values,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set zlib compression values.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported zlib compression values defaulting to strategy: default.\n" );
+		}
+	}
 	if( option_media_type != NULL )
 	{
 		result = imaging_handle_set_media_type(
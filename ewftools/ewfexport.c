@@ -108,7 +108,8 @@ void usage_fprint(
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                 [ -d digest_type ] [ -f format ] [ -l log_filename ]\n"
 	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
+	                 "                 [ -S segment_file_size ] [ -t target ]\n"
+	                 "                 [ -Z zlib_compression_values ] [ -hqsuvVwxz ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -126,7 +127,10 @@ void usage_fprint(
 	                 "\t           compression method options: deflate (default), bzip2\n"
 	                 "\t           (bzip2 is only supported by EWF2 formats)\n"
 	                 "\t           compression level options: none (default), empty-block,\n"
-	                 "\t           fast or best\n" );
+	                 "\t           fast, best, adaptive (fast, but chunks that are\n"
+	                 "\t           estimated to be incompressible are stored uncompressed)\n"
+	                 "\t           or a zlib compression level from 1 to 9 (1 to 5 are\n"
+	                 "\t           stored as fast, 6 to 9 as best)\n" );
 	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5,\n"
 	                 "\t           options: sha1, sha256 (not used for raw and files format)\n" );
 	fprintf( stream, "\t-f:        specify the output format to write to, options:\n"
@@ -174,6 +178,13 @@ void usage_fprint(
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
 	fprintf( stream, "\t-x:        use the chunk data instead of the buffered read and write\n"
 	                 "\t           functions.\n" );
+	fprintf( stream, "\t-z:        write sparse raw output, blocks of 0-byte values are not written\n"
+	                 "\t           but left as holes in the target file(s)\n" );
+	fprintf( stream, "\t-Z:        specify the zlib compression values as:\n"
+	                 "\t           strategy[:window_bits[:memory_level]]\n"
+	                 "\t           strategy options: default (default), filtered, huffman-only,\n"
+	                 "\t           rle or fixed, window bits: 9 to 15 (default), memory level:\n"
+	                 "\t           1 to 9 (default is 8) (not used for raw and files formats)\n" );
 }
 
 /* Signal handler for ewfexport
@@ -248,6 +259,7 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_sectors_per_chunk       = NULL;
 	libcstring_system_character_t *option_size                    = NULL;
 	libcstring_system_character_t *option_target_path             = NULL;
+	libcstring_system_character_t *option_zlib_compression_values = NULL;
 	libcstring_system_character_t *program                        = _LIBCSTRING_SYSTEM_STRING( "ewfexport" );
 	libcstring_system_character_t *request_string                 = NULL;
 
@@ -259,6 +271,7 @@ int main( int argc, char * const argv[] )
 	uint8_t swap_byte_pairs                                       = 0;
 	uint8_t use_chunk_data_functions                              = 0;
 	uint8_t verbose                                               = 0;
+	uint8_t write_sparse                                          = 0;
 	uint8_t zero_chunk_on_error                                   = 0;
 	int interactive_mode                                          = 1;
 	int number_of_filenames                                       = 0;
@@ -321,7 +334,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:d:f:hl:o:p:qsS:t:uvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:d:f:hl:o:p:qsS:t:uvVwxzZ:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -444,6 +457,16 @@ int main( int argc, char * const argv[] )
 			case (libcstring_system_integer_t) 'x':
 				use_chunk_data_functions = 1;
 
+				break;
+
+			case (libcstring_system_integer_t) 'z':
+				write_sparse = 1;
+
+				break;
+
+			case (libcstring_system_integer_t) 'Z':
+				option_zlib_compression_values = optarg;
+
 				break;
 		}
 	}
@@ -519,6 +542,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfexport_export_handle->write_sparse = write_sparse;
+
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -691,6 +716,28 @@ int main( int argc, char * const argv[] )
 			 "Unsupported compression values defaulting to method: deflate with level: none.\n" );
 		}
 	}
+	if( option_zlib_compression_values != NULL )
+	{
+		result = export_handle_set_zlib_compression_values(
+			  ewfexport_export_handle,
+			  option_zlib_compression_values,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set zlib compression values.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported zlib compression values defaulting to strategy: default.\n" );
+		}
+	}
 	if( option_sectors_per_chunk != NULL )
 	{
 		result = export_handle_set_sectors_per_chunk(
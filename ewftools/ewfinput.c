@@ -43,11 +43,27 @@
 libcstring_system_character_t *ewfinput_compression_methods[ 1 ] = {
 	_LIBCSTRING_SYSTEM_STRING( "deflate" ) };
 
-libcstring_system_character_t *ewfinput_compression_levels[ 4 ] = {
+libcstring_system_character_t *ewfinput_compression_levels[ 5 ] = {
 	_LIBCSTRING_SYSTEM_STRING( "none" ),
 	_LIBCSTRING_SYSTEM_STRING( "empty-block" ),
 	_LIBCSTRING_SYSTEM_STRING( "fast" ),
-	_LIBCSTRING_SYSTEM_STRING( "best" ) };
+	_LIBCSTRING_SYSTEM_STRING( "best" ),
+	_LIBCSTRING_SYSTEM_STRING( "adaptive" ) };
+
+libcstring_system_character_t *ewfinput_imaging_compression_levels[ 6 ] = {
+	_LIBCSTRING_SYSTEM_STRING( "none" ),
+	_LIBCSTRING_SYSTEM_STRING( "empty-block" ),
+	_LIBCSTRING_SYSTEM_STRING( "fast" ),
+	_LIBCSTRING_SYSTEM_STRING( "best" ),
+	_LIBCSTRING_SYSTEM_STRING( "adaptive" ),
+	_LIBCSTRING_SYSTEM_STRING( "auto" ) };
+
+libcstring_system_character_t *ewfinput_zlib_strategies[ 5 ] = {
+	_LIBCSTRING_SYSTEM_STRING( "default" ),
+	_LIBCSTRING_SYSTEM_STRING( "filtered" ),
+	_LIBCSTRING_SYSTEM_STRING( "huffman-only" ),
+	_LIBCSTRING_SYSTEM_STRING( "rle" ),
+	_LIBCSTRING_SYSTEM_STRING( "fixed" ) };
 
 libcstring_system_character_t *ewfinput_format_types[ 12 ] = {
 	_LIBCSTRING_SYSTEM_STRING( "ewf" ),
@@ -430,12 +446,16 @@ int ewfinput_determine_compression_method(
 }
 
 /* Determines the compression values from a string
+ * Besides the named compression levels this supports the zlib compression levels 1 to 9,
+ * where 1 to 5 are stored as the fast and 6 to 9 as the best compression level.
+ * The zlib compression level is set to 0 for the named compression levels
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
 int ewfinput_determine_compression_values(
      const libcstring_system_character_t *string,
      int8_t *compression_level,
      uint8_t *compression_flags,
+     int *zlib_compression_level,
      libcerror_error_t **error )
 {
 	static char *function = "ewfinput_determine_compression_values";
@@ -475,10 +495,41 @@ int ewfinput_determine_compression_values(
 
 		return( -1 );
 	}
+	if( zlib_compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib compression level.",
+		 function );
+
+		return( -1 );
+	}
 	string_length = libcstring_system_string_length(
 	                 string );
 
-	if( string_length == 4 )
+	if( string_length == 1 )
+	{
+		if( ( string[ 0 ] >= (libcstring_system_character_t) '1' )
+		 && ( string[ 0 ] <= (libcstring_system_character_t) '9' ) )
+		{
+			*zlib_compression_level = (int) ( string[ 0 ] - (libcstring_system_character_t) '0' );
+
+			if( *zlib_compression_level <= 5 )
+			{
+				*compression_level = LIBEWF_COMPRESSION_FAST;
+			}
+			else
+			{
+				*compression_level = LIBEWF_COMPRESSION_BEST;
+			}
+			*compression_flags = 0;
+
+			return( 1 );
+		}
+	}
+	else if( string_length == 4 )
 	{
 		if( libcstring_system_string_compare(
 		     string,
@@ -508,6 +559,18 @@ int ewfinput_determine_compression_values(
 			result             = 1;
 		}
 	}
+	else if( string_length == 8 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "adaptive" ),
+		     8 ) == 0 )
+		{
+			*compression_level = LIBEWF_COMPRESSION_FAST;
+			*compression_flags = LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+			result             = 1;
+		}
+	}
 	else if( string_length == 11 )
 	{
 		if( libcstring_system_string_compare(
@@ -529,9 +592,271 @@ int ewfinput_determine_compression_values(
 			result             = 1;
 		}
 	}
+	if( result != 0 )
+	{
+		*zlib_compression_level = 0;
+	}
 	return( result );
 }
 
+/* Determines a small decimal value from a (sub) string
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int ewfinput_determine_small_decimal(
+     const libcstring_system_character_t *string,
+     size_t string_length,
+     int *value,
+     libcerror_error_t **error )
+{
+	static char *function = "ewfinput_determine_small_decimal";
+	size_t string_index   = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( string_length == 0 )
+	 || ( string_length > 2 ) )
+	{
+		return( 0 );
+	}
+	*value = 0;
+
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (libcstring_system_character_t) '0' )
+		 || ( string[ string_index ] > (libcstring_system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		*value *= 10;
+		*value += (int) ( string[ string_index ] - (libcstring_system_character_t) '0' );
+	}
+	return( 1 );
+}
+
+/* Determines the zlib compression values from a string
+ * The string is formatted as: strategy[:window_bits[:memory_level]]
+ * where strategy is one of default, filtered, huffman-only, rle or fixed,
+ * window bits ranges from 9 to 15 and memory level from 1 to 9
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int ewfinput_determine_zlib_compression_values(
+     const libcstring_system_character_t *string,
+     int *zlib_strategy,
+     int *zlib_window_bits,
+     int *zlib_memory_level,
+     libcerror_error_t **error )
+{
+	int *values[ 2 ]      = { NULL, NULL };
+	static char *function = "ewfinput_determine_zlib_compression_values";
+	size_t segment_length = 0;
+	size_t segment_start  = 0;
+	size_t string_index   = 0;
+	size_t string_length  = 0;
+	int memory_level      = 0;
+	int result            = 0;
+	int strategy          = 0;
+	int value_index       = 0;
+	int window_bits       = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_strategy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib strategy.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_window_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib window bits.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_memory_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib memory level.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = libcstring_system_string_length(
+	                 string );
+
+	for( segment_length = 0;
+	     segment_length < string_length;
+	     segment_length++ )
+	{
+		if( string[ segment_length ] == (libcstring_system_character_t) ':' )
+		{
+			break;
+		}
+	}
+	if( segment_length == 3 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "rle" ),
+		     3 ) == 0 )
+		{
+			strategy = LIBEWF_COMPRESSION_STRATEGY_RLE;
+			result   = 1;
+		}
+	}
+	else if( segment_length == 5 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "fixed" ),
+		     5 ) == 0 )
+		{
+			strategy = LIBEWF_COMPRESSION_STRATEGY_FIXED;
+			result   = 1;
+		}
+	}
+	else if( segment_length == 7 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "default" ),
+		     7 ) == 0 )
+		{
+			strategy = LIBEWF_COMPRESSION_STRATEGY_DEFAULT;
+			result   = 1;
+		}
+	}
+	else if( segment_length == 8 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "filtered" ),
+		     8 ) == 0 )
+		{
+			strategy = LIBEWF_COMPRESSION_STRATEGY_FILTERED;
+			result   = 1;
+		}
+	}
+	else if( segment_length == 12 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "huffman-only" ),
+		     12 ) == 0 )
+		{
+			strategy = LIBEWF_COMPRESSION_STRATEGY_HUFFMAN_ONLY;
+			result   = 1;
+		}
+	}
+	values[ 0 ] = &window_bits;
+	values[ 1 ] = &memory_level;
+
+	string_index = segment_length;
+
+	while( ( result == 1 )
+	    && ( string_index < string_length ) )
+	{
+		if( value_index >= 2 )
+		{
+			result = 0;
+
+			break;
+		}
+		/* Skip the : separator
+		 */
+		string_index++;
+
+		segment_start = string_index;
+
+		while( ( string_index < string_length )
+		    && ( string[ string_index ] != (libcstring_system_character_t) ':' ) )
+		{
+			string_index++;
+		}
+		result = ewfinput_determine_small_decimal(
+		          &( string[ segment_start ] ),
+		          string_index - segment_start,
+		          values[ value_index ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine value: %d.",
+			 function,
+			 value_index );
+
+			return( -1 );
+		}
+		value_index++;
+	}
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( ( window_bits != 0 )
+	 && ( ( window_bits < 9 )
+	  || ( window_bits > 15 ) ) )
+	{
+		return( 0 );
+	}
+	if( memory_level > 9 )
+	{
+		return( 0 );
+	}
+	*zlib_strategy     = strategy;
+	*zlib_window_bits  = window_bits;
+	*zlib_memory_level = memory_level;
+
+	return( 1 );
+}
+
 /* Determines the media type value from a string
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
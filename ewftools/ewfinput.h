@@ -35,9 +35,12 @@ extern "C" {
 #define EWFINPUT_COMPRESSION_METHODS_AMOUNT		1
 #define EWFINPUT_COMPRESSION_METHODS_DEFAULT		0
 
-#define EWFINPUT_COMPRESSION_LEVELS_AMOUNT		4
+#define EWFINPUT_COMPRESSION_LEVELS_AMOUNT		5
 #define EWFINPUT_COMPRESSION_LEVELS_DEFAULT		0
 
+#define EWFINPUT_IMAGING_COMPRESSION_LEVELS_AMOUNT	6
+#define EWFINPUT_IMAGING_COMPRESSION_LEVELS_DEFAULT	0
+
 #define EWFINPUT_FORMAT_TYPES_AMOUNT			12
 #define EWFINPUT_FORMAT_TYPES_DEFAULT			8
 
@@ -51,7 +54,9 @@ extern "C" {
 #define EWFINPUT_SECTOR_PER_BLOCK_SIZES_DEFAULT		2
 
 extern libcstring_system_character_t *ewfinput_compression_methods[ 1 ];
-extern libcstring_system_character_t *ewfinput_compression_levels[ 4 ];
+extern libcstring_system_character_t *ewfinput_compression_levels[ 5 ];
+extern libcstring_system_character_t *ewfinput_imaging_compression_levels[ 6 ];
+extern libcstring_system_character_t *ewfinput_zlib_strategies[ 5 ];
 extern libcstring_system_character_t *ewfinput_format_types[ 12 ];
 extern libcstring_system_character_t *ewfinput_media_types[ 4 ];
 extern libcstring_system_character_t *ewfinput_media_flags[ 2 ];
@@ -77,6 +82,20 @@ int ewfinput_determine_compression_values(
      const libcstring_system_character_t *string,
      int8_t *compression_level,
      uint8_t *compression_flags,
+     int *zlib_compression_level,
+     libcerror_error_t **error );
+
+int ewfinput_determine_small_decimal(
+     const libcstring_system_character_t *string,
+     size_t string_length,
+     int *value,
+     libcerror_error_t **error );
+
+int ewfinput_determine_zlib_compression_values(
+     const libcstring_system_character_t *string,
+     int *zlib_strategy,
+     int *zlib_window_bits,
+     int *zlib_memory_level,
      libcerror_error_t **error );
 
 int ewfinput_determine_media_type(
@@ -61,7 +61,7 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
 	                 "                 [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	                 "                 [ -hqTvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -79,6 +79,7 @@ void usage_fprint(
 	                 "\t           log_filename\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-T:        trace the chunk I/O and print latency histograms\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
@@ -156,6 +157,7 @@ int main( int argc, char * const argv[] )
 	libcstring_system_integer_t option                            = 0;
 	uint8_t calculate_md5                                         = 1;
 	uint8_t print_status_information                              = 1;
+	uint8_t trace_chunk_io                                        = 0;
 	uint8_t use_chunk_data_functions                              = 0;
 	uint8_t verbose                                               = 0;
 	uint8_t zero_chunk_on_error                                   = 0;
@@ -195,7 +197,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:d:f:hl:p:qvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:d:f:hl:p:qTvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -247,6 +249,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'T':
+				trace_chunk_io = 1;
+
+				break;
+
 			case (libcstring_system_integer_t) 'v':
 				verbose = 1;
 
@@ -501,6 +508,17 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( verification_handle_set_trace_chunk_io(
+	     ewfverify_verification_handle,
+	     trace_chunk_io,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set trace chunk I/O.\n" );
+
+		goto on_error;
+	}
 	if( log_filename != NULL )
 	{
 		if( log_handle_initialize(
@@ -2184,6 +2184,7 @@ int export_handle_prompt_for_compression_level(
 			  fixed_string_variable,
 			  &( export_handle->compression_level ),
 			  &( export_handle->compression_flags ),
+			  &( export_handle->zlib_compression_level ),
 			  error );
 
 		if( result == -1 )
@@ -2835,6 +2836,7 @@ int export_handle_set_compression_values(
 
 			goto on_error;
 		}
+
 /* experimental version only
 		if( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
 */
@@ -2890,6 +2892,7 @@ int export_handle_set_compression_values(
 	          string_segment,
 	          &( export_handle->compression_level ),
 	          &( export_handle->compression_flags ),
+	          &( export_handle->zlib_compression_level ),
 	          error );
 
 	if( result == -1 )
@@ -3007,6 +3010,53 @@ int export_handle_set_output_format(
 
 			return( -1 );
 		}
+		else if( result != 0 )
+		{
+			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_EWF;
+		}
+	}
+	return( result );
+}
+
+/* Sets the zlib compression values
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_zlib_compression_values(
+     export_handle_t *export_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_zlib_compression_values";
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_zlib_compression_values(
+	          string,
+	          &( export_handle->zlib_strategy ),
+	          &( export_handle->zlib_window_bits ),
+	          &( export_handle->zlib_memory_level ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine zlib compression values.",
+		 function );
+
+		return( -1 );
 	}
 	return( result );
 }
@@ -3977,6 +4027,23 @@ int export_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( libewf_handle_set_zlib_compression_values(
+		     export_handle->ewf_output_handle,
+		     export_handle->zlib_compression_level,
+		     export_handle->zlib_strategy,
+		     export_handle->zlib_window_bits,
+		     export_handle->zlib_memory_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zlib compression values.",
+			 function );
+
+			return( -1 );
+		}
 		if( ( export_handle->compression_level != LIBEWF_COMPRESSION_NONE )
 		 || ( ( export_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 ) )
 		{
@@ -4114,6 +4181,23 @@ int export_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( export_handle->write_sparse != 0 )
+		{
+			if( libsmraw_handle_set_write_sparse(
+			     export_handle->raw_output_handle,
+			     export_handle->write_sparse,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set write sparse.",
+				 function );
+
+				return( -1 );
+			}
+		}
 	}
 	return( 1 );
 }
@@ -5022,6 +5106,20 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
+		if( export_handle_sparse_bytes_fprint(
+		     export_handle,
+		     export_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print sparse bytes.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( export_handle_hash_values_fprint(
@@ -6390,3 +6488,64 @@ on_error:
 	return( -1 );
 }
 
+/* Print the number of bytes that were not written to the sparse output to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_sparse_bytes_fprint(
+     export_handle_t *export_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function           = "export_handle_sparse_bytes_fprint";
+	size64_t number_of_sparse_bytes = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->write_sparse == 0 )
+	 || ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	 || ( export_handle->use_stdout != 0 ) )
+	{
+		return( 1 );
+	}
+	if( libsmraw_handle_get_number_of_sparse_bytes(
+	     export_handle->raw_output_handle,
+	     &number_of_sparse_bytes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sparse bytes.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Sparse output: skipped writing %" PRIu64 " bytes of 0-byte values.\n\n",
+	 number_of_sparse_bytes );
+
+	return( 1 );
+}
+
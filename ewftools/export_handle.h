@@ -73,6 +73,22 @@ struct export_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The zlib compression level, 0 if determined by the compression level
+	 */
+	int zlib_compression_level;
+
+	/* The zlib strategy
+	 */
+	int zlib_strategy;
+
+	/* The zlib window bits, 0 if the zlib default
+	 */
+	int zlib_window_bits;
+
+	/* The zlib memory level, 0 if the zlib default
+	 */
+	int zlib_memory_level;
+
 	/* The output format
 	 */
 	uint8_t output_format;
@@ -165,6 +181,11 @@ struct export_handle
 	 */
 	uint8_t use_stdout;
 
+	/* Value to indicate if blocks of 0-byte values should be skipped
+	 * instead of written to the raw output
+	 */
+	uint8_t write_sparse;
+
 	/* The libewf output handle
 	 */
 	libewf_handle_t *ewf_output_handle;
@@ -355,6 +376,11 @@ int export_handle_set_output_format(
      const libcstring_system_character_t *string,
      libcerror_error_t **error );
 
+int export_handle_set_zlib_compression_values(
+     export_handle_t *export_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
 int export_handle_set_sectors_per_chunk(
      export_handle_t *export_handle,
      const libcstring_system_character_t *string,
@@ -465,6 +491,11 @@ int export_handle_checksum_errors_fprint(
      FILE *stream,
      libcerror_error_t **error );
 
+int export_handle_sparse_bytes_fprint(
+     export_handle_t *export_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -31,6 +31,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "compression_level_control.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -232,6 +233,7 @@ int imaging_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "imaging_handle_free";
+	int stripe_index      = 0;
 	int result            = 1;
 
 	if( imaging_handle == NULL )
@@ -260,6 +262,21 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->secondary_target_filename );
 		}
+		if( ( *imaging_handle )->stripe_target_filenames != NULL )
+		{
+			for( stripe_index = 0;
+			     stripe_index < ( *imaging_handle )->number_of_stripe_target_filenames;
+			     stripe_index++ )
+			{
+				if( ( *imaging_handle )->stripe_target_filenames[ stripe_index ] != NULL )
+				{
+					memory_free(
+					 ( *imaging_handle )->stripe_target_filenames[ stripe_index ] );
+				}
+			}
+			memory_free(
+			 ( *imaging_handle )->stripe_target_filenames );
+		}
 		if( ( *imaging_handle )->case_number != NULL )
 		{
 			memory_free(
@@ -377,6 +394,22 @@ int imaging_handle_free(
 				result = -1;
 			}
 		}
+		if( ( *imaging_handle )->compression_level_control != NULL )
+		{
+			if( compression_level_control_free(
+			     &( ( *imaging_handle )->compression_level_control ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression level control.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *imaging_handle );
 
@@ -449,9 +482,11 @@ int imaging_handle_open_output(
 	libcstring_system_character_t **libewf_filenames = NULL;
 	libcstring_system_character_t *filenames[ 1 ]    = { NULL };
 	static char *function                            = "imaging_handle_open_output";
+	size_t filename_length                           = 0;
 	size_t first_filename_length                     = 0;
 	int access_flags                                 = 0;
 	int number_of_filenames                          = 0;
+	int stripe_index                                 = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -580,7 +615,208 @@ int imaging_handle_open_output(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->checkpoint_interval != 0 )
+	{
+		if( libewf_handle_set_write_checkpoint_interval(
+		     imaging_handle->output_handle,
+		     imaging_handle->checkpoint_interval,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set write checkpoint interval.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->segment_file_write_flags != 0 )
+	{
+		if( libewf_handle_set_segment_file_write_flags(
+		     imaging_handle->output_handle,
+		     imaging_handle->segment_file_write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment file write flags.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( resume == 0 )
+	{
+		for( stripe_index = 0;
+		     stripe_index < imaging_handle->number_of_stripe_target_filenames;
+		     stripe_index++ )
+		{
+			filename_length = libcstring_system_string_length(
+			                   imaging_handle->stripe_target_filenames[ stripe_index ] );
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+			if( libewf_handle_append_segment_filename_wide(
+			     imaging_handle->output_handle,
+			     imaging_handle->stripe_target_filenames[ stripe_index ],
+			     filename_length,
+			     error ) != 1 )
+#else
+			if( libewf_handle_append_segment_filename(
+			     imaging_handle->output_handle,
+			     imaging_handle->stripe_target_filenames[ stripe_index ],
+			     filename_length,
+			     error ) != 1 )
+#endif
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append stripe target filename: %d.",
+				 function,
+				 stripe_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the (finished) output of the imaging handle for reading and writing
+ * Changes are written to delta segment files
+ * The filename is the first segment filename or, if format is not LIBEWF_FORMAT_UNKNOWN,
+ * the filename without extension
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_open_output_read_write(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *filename,
+     uint8_t format,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t **libewf_filenames = NULL;
+	static char *function                            = "imaging_handle_open_output_read_write";
+	size_t filename_length                           = 0;
+	int number_of_filenames                          = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = libcstring_system_string_length(
+	                   filename );
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     filename,
+	     filename_length,
+	     format,
+	     &libewf_filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     filename,
+	     filename_length,
+	     format,
+	     &libewf_filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     imaging_handle->output_handle,
+	     libewf_filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     imaging_handle->output_handle,
+	     libewf_filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     libewf_filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     libewf_filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
+
+on_error:
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	libewf_glob_wide_free(
+	 libewf_filenames,
+	 number_of_filenames,
+	 NULL );
+#else
+	libewf_glob_free(
+	 libewf_filenames,
+	 number_of_filenames,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Opens the secondary output of the imaging handle
@@ -772,6 +1008,40 @@ int imaging_handle_open_secondary_output(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->checkpoint_interval != 0 )
+	{
+		if( libewf_handle_set_write_checkpoint_interval(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle->checkpoint_interval,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set write checkpoint interval in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->segment_file_write_flags != 0 )
+	{
+		if( libewf_handle_set_segment_file_write_flags(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle->segment_file_write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment file write flags in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -1098,6 +1368,7 @@ ssize_t imaging_handle_write_buffer(
 	size_t raw_write_buffer_size  = 0;
 	ssize_t secondary_write_count = 0;
 	ssize_t write_count           = 0;
+	uint64_t process_start_time   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1125,6 +1396,10 @@ ssize_t imaging_handle_write_buffer(
 	{
 		return( 0 );
 	}
+	if( imaging_handle->use_automatic_compression_level != 0 )
+	{
+		process_start_time = compression_level_control_get_time();
+	}
 	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 	{
 		if( storage_media_buffer->is_compressed == 0 )
@@ -1231,9 +1506,125 @@ ssize_t imaging_handle_write_buffer(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->use_automatic_compression_level != 0 )
+	{
+		if( imaging_handle_update_compression_level(
+		     imaging_handle,
+		     write_size,
+		     process_start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update compression level.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( write_count );
 }
 
+/* Updates the automatic compression level after a buffer was written
+ * The zlib compression level is changed in the output handles
+ * and applies to the chunks that are written afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_update_compression_level(
+     imaging_handle_t *imaging_handle,
+     size_t process_size,
+     uint64_t process_start_time,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_update_compression_level";
+	int compression_level = 0;
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->compression_level_control == NULL )
+	{
+		if( compression_level_control_initialize(
+		     &( imaging_handle->compression_level_control ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression level control.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = compression_level_control_update(
+	          imaging_handle->compression_level_control,
+	          process_size,
+	          process_start_time,
+	          compression_level_control_get_time(),
+	          &compression_level,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update compression level control.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libewf_handle_set_zlib_compression_level(
+		     imaging_handle->output_handle,
+		     compression_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zlib compression level.",
+			 function );
+
+			return( -1 );
+		}
+		if( imaging_handle->secondary_output_handle != NULL )
+		{
+			if( libewf_handle_set_zlib_compression_level(
+			     imaging_handle->secondary_output_handle,
+			     compression_level,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set zlib compression level in secondary output handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
 /* Seeks the offset in the input file
  * Returns the new offset if successful or -1 on error
  */
@@ -1462,6 +1853,59 @@ int imaging_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
+	/* Contexts of a previous calculation are replaced
+	 */
+	if( imaging_handle->md5_context != NULL )
+	{
+		if( libhmac_md5_free(
+		     &( imaging_handle->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+		imaging_handle->md5_context_initialized = 0;
+	}
+	if( imaging_handle->sha1_context != NULL )
+	{
+		if( libhmac_sha1_free(
+		     &( imaging_handle->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 context.",
+			 function );
+
+			return( -1 );
+		}
+		imaging_handle->sha1_context_initialized = 0;
+	}
+	if( imaging_handle->sha256_context != NULL )
+	{
+		if( libhmac_sha256_free(
+		     &( imaging_handle->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 context.",
+			 function );
+
+			return( -1 );
+		}
+		imaging_handle->sha256_context_initialized = 0;
+	}
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_initialize(
@@ -1760,37 +2204,175 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
-		     imaging_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
+		if( libhmac_sha256_finalize(
+		     imaging_handle->sha256_context,
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     imaging_handle->calculated_sha256_hash_string,
+		     65,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Calculates the integrity hash(es) over the data stored in the output
+ * This reads back the output including the data stored in delta segment files
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_calculate_output_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_calculate_output_integrity_hash";
+	size64_t media_size   = 0;
+	size64_t read_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     imaging_handle->output_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle_initialize_integrity_hash(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize integrity hash(es).",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_seek_offset(
+	     imaging_handle->output_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_offset < media_size )
+	{
+		read_size = storage_media_buffer->raw_buffer_size;
+
+		if( ( media_size - read_offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( media_size - read_offset );
+		}
+		read_count = libewf_handle_read_buffer(
+		              imaging_handle->output_handle,
+		              storage_media_buffer->raw_buffer,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIu64 ".",
+			 function,
+			 read_offset );
 
 			return( -1 );
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     imaging_handle->calculated_sha256_hash_string,
-		     65,
+		if( imaging_handle_update_integrity_hash(
+		     imaging_handle,
+		     storage_media_buffer->raw_buffer,
+		     read_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
 			 function );
 
 			return( -1 );
 		}
+		read_offset += (size64_t) read_size;
+	}
+	if( imaging_handle_finalize_integrity_hash(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash(es).",
+		 function );
+
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -2069,9 +2651,9 @@ int imaging_handle_prompt_for_compression_level(
 	          imaging_handle->input_buffer,
 	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
 	          request_string,
-	          ewfinput_compression_levels,
-	          EWFINPUT_COMPRESSION_LEVELS_AMOUNT,
-	          EWFINPUT_COMPRESSION_LEVELS_DEFAULT,
+	          ewfinput_imaging_compression_levels,
+	          EWFINPUT_IMAGING_COMPRESSION_LEVELS_AMOUNT,
+	          EWFINPUT_IMAGING_COMPRESSION_LEVELS_DEFAULT,
 	          &fixed_string_variable,
 	          error );
 
@@ -2088,10 +2670,9 @@ int imaging_handle_prompt_for_compression_level(
 	}
 	else if( result != 0 )
 	{
-		result = ewfinput_determine_compression_values(
+		result = imaging_handle_determine_compression_values(
+			  imaging_handle,
 			  fixed_string_variable,
-			  &( imaging_handle->compression_level ),
-			  &( imaging_handle->compression_flags ),
 			  error );
 
 		if( result == -1 )
@@ -3042,6 +3623,83 @@ on_error:
 	return( -1 );
 }
 
+/* Determines the compression values from a string
+ * Besides the compression levels supported by ewfinput this supports
+ * auto, the fast compression level with an automatically determined zlib level
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_determine_compression_values(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_determine_compression_values";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = libcstring_system_string_length(
+	                 string );
+
+	if( ( string_length == 4 )
+	 && ( libcstring_system_string_compare(
+	       string,
+	       _LIBCSTRING_SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
+	{
+		imaging_handle->compression_level               = LIBEWF_COMPRESSION_FAST;
+		imaging_handle->compression_flags               = 0;
+		imaging_handle->zlib_compression_level          = 0;
+		imaging_handle->use_automatic_compression_level = 1;
+
+		return( 1 );
+	}
+	result = ewfinput_determine_compression_values(
+	          string,
+	          &( imaging_handle->compression_level ),
+	          &( imaging_handle->compression_flags ),
+	          &( imaging_handle->zlib_compression_level ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine compression values.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		imaging_handle->use_automatic_compression_level = 0;
+	}
+	return( result );
+}
+
 /* Sets the compression values
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -3243,10 +3901,9 @@ int imaging_handle_set_compression_values(
 
 		goto on_error;
 	}
-	result = ewfinput_determine_compression_values(
+	result = imaging_handle_determine_compression_values(
+	          imaging_handle,
 	          string_segment,
-	          &( imaging_handle->compression_level ),
-	          &( imaging_handle->compression_flags ),
 	          error );
 
 	if( result == -1 )
@@ -3297,6 +3954,49 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the zlib compression values
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_zlib_compression_values(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_zlib_compression_values";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_zlib_compression_values(
+	          string,
+	          &( imaging_handle->zlib_strategy ),
+	          &( imaging_handle->zlib_window_bits ),
+	          &( imaging_handle->zlib_memory_level ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine zlib compression values.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Sets the format
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -3613,39 +4313,165 @@ int imaging_handle_set_maximum_segment_size(
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine maximum segment size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine maximum segment size.",
+		 function );
+
+		return( -1 );
+	}
+        else if( result != 0 )
+	{
+		if( imaging_handle->maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
+		{
+			result = 0;
+		}
+		else if( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+		{
+			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT )
+			{
+				result = 0;
+			}
+		}
+		else
+		{
+			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT )
+			{
+				result = 0;
+			}
+		}
+		if( result == 0 )
+		{
+			imaging_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+		}
+	}
+	return( result );
+}
+
+/* Sets the write checkpoint interval
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_checkpoint_interval(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_set_checkpoint_interval";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = libcstring_system_string_length(
+	                 string );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &size_variable,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine checkpoint interval.",
+		 function );
+
+		return( -1 );
+	}
+	if( size_variable <= (uint64_t) INT32_MAX )
+	{
+		imaging_handle->checkpoint_interval = (uint32_t) size_variable;
+
+		result = 1;
+	}
+	return( result );
+}
+
+/* Appends a stripe target filename
+ * The segment files are distributed round-robin over the target and the stripe targets
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_append_stripe_target_filename(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t **stripe_target_filenames = NULL;
+	static char *function                                   = "imaging_handle_append_stripe_target_filename";
+	size_t stripe_target_filename_size                      = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	stripe_target_filenames = (libcstring_system_character_t **) memory_reallocate(
+	                                                              imaging_handle->stripe_target_filenames,
+	                                                              sizeof( libcstring_system_character_t * ) * ( imaging_handle->number_of_stripe_target_filenames + 1 ) );
+
+	if( stripe_target_filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize stripe target filenames.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->stripe_target_filenames = stripe_target_filenames;
+
+	imaging_handle->stripe_target_filenames[ imaging_handle->number_of_stripe_target_filenames ] = NULL;
+
+	if( imaging_handle_set_string(
+	     imaging_handle,
+	     string,
+	     &( imaging_handle->stripe_target_filenames[ imaging_handle->number_of_stripe_target_filenames ] ),
+	     &stripe_target_filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set stripe target filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->stripe_target_filenames[ imaging_handle->number_of_stripe_target_filenames ] == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stripe target filename.",
 		 function );
 
 		return( -1 );
 	}
-        else if( result != 0 )
-	{
-		if( imaging_handle->maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
-		{
-			result = 0;
-		}
-		else if( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
-		{
-			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT )
-			{
-				result = 0;
-			}
-		}
-		else
-		{
-			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT )
-			{
-				result = 0;
-			}
-		}
-		if( result == 0 )
-		{
-			imaging_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
-		}
-	}
-	return( result );
+	imaging_handle->number_of_stripe_target_filenames += 1;
+
+	return( 1 );
 }
 
 /* Sets the acquiry offset
@@ -4540,6 +5366,23 @@ int imaging_handle_set_output_values(
 
 		return( -1 );
 	}
+	if( libewf_handle_set_zlib_compression_values(
+	     imaging_handle->output_handle,
+	     imaging_handle->zlib_compression_level,
+	     imaging_handle->zlib_strategy,
+	     imaging_handle->zlib_window_bits,
+	     imaging_handle->zlib_memory_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set zlib compression values.",
+		 function );
+
+		return( -1 );
+	}
 	if( libewf_handle_set_maximum_segment_size(
 	     imaging_handle->output_handle,
 	     imaging_handle->maximum_segment_size,
@@ -4706,6 +5549,23 @@ int imaging_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( libewf_handle_set_zlib_compression_values(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle->zlib_compression_level,
+		     imaging_handle->zlib_strategy,
+		     imaging_handle->zlib_window_bits,
+		     imaging_handle->zlib_memory_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zlib compression values in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
 		if( libewf_handle_set_maximum_segment_size(
 		     imaging_handle->secondary_output_handle,
 		     imaging_handle->maximum_segment_size,
@@ -5520,6 +6380,7 @@ int imaging_handle_print_parameters(
 	libcstring_system_character_t maximum_segment_size_string[ 16 ];
 
 	static char *function = "imaging_handle_print_parameters";
+	int stripe_index      = 0;
 	int result            = 0;
 
 	if( imaging_handle == NULL )
@@ -5586,6 +6447,15 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "\n" );
 
+	for( stripe_index = 0;
+	     stripe_index < imaging_handle->number_of_stripe_target_filenames;
+	     stripe_index++ )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "Stripe target:\t\t\t\t%" PRIs_LIBCSTRING_SYSTEM "\n",
+		 imaging_handle->stripe_target_filenames[ stripe_index ] );
+	}
 	if( imaging_handle->secondary_target_filename != NULL )
 	{
 		fprintf(
@@ -5878,11 +6748,33 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "Compression level:\t\t\t" );
 
-	if( imaging_handle->compression_level == LIBEWF_COMPRESSION_FAST )
+	if( imaging_handle->zlib_compression_level != 0 )
 	{
 		fprintf(
 		 imaging_handle->notify_stream,
-		 "fast" );
+		 "%d",
+		 imaging_handle->zlib_compression_level );
+	}
+	else if( imaging_handle->compression_level == LIBEWF_COMPRESSION_FAST )
+	{
+		if( imaging_handle->use_automatic_compression_level != 0 )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "auto" );
+		}
+		else if( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "adaptive" );
+		}
+		else
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "fast" );
+		}
 	}
 	else if( imaging_handle->compression_level == LIBEWF_COMPRESSION_BEST )
 	{
@@ -5909,6 +6801,31 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "\n" );
 
+	if( ( imaging_handle->zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_DEFAULT )
+	 || ( imaging_handle->zlib_window_bits != 0 )
+	 || ( imaging_handle->zlib_memory_level != 0 ) )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "Compression strategy:\t\t\t%" PRIs_LIBCSTRING_SYSTEM "\n",
+		 ewfinput_zlib_strategies[ imaging_handle->zlib_strategy ] );
+
+		if( imaging_handle->zlib_window_bits != 0 )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "Compression window bits:\t\t%d\n",
+			 imaging_handle->zlib_window_bits );
+		}
+		if( imaging_handle->zlib_memory_level != 0 )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "Compression memory level:\t\t%d\n",
+			 imaging_handle->zlib_memory_level );
+		}
+	}
+
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "Acquiry start offset:\t\t\t%" PRIi64 "\n",
@@ -6038,6 +6955,108 @@ int imaging_handle_print_parameters(
 	return( 1 );
 }
 
+/* Prints the compression statistics
+ * The statistics are only printed when adaptive compression or
+ * the automatic compression level is used
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_print_compression_statistics(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	uint64_t statistics[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	static char *function = "imaging_handle_print_compression_statistics";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) == 0 )
+	 && ( imaging_handle->compression_level_control == NULL ) )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_get_statistics(
+	     imaging_handle->output_handle,
+	     statistics,
+	     LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+	{
+		fprintf(
+		 stream,
+		 "Chunks stored compressed:\t\t%" PRIu64 "\n",
+		 statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSED ] );
+
+		fprintf(
+		 stream,
+		 "Chunks stored uncompressed:\t\t%" PRIu64 "\n",
+		 statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_UNCOMPRESSED ] );
+
+		fprintf(
+		 stream,
+		 "Chunks estimated incompressible:\t%" PRIu64 "\n",
+		 statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSION_SKIPPED ] );
+	}
+	if( imaging_handle->compression_level_control != NULL )
+	{
+		if( compression_level_control_fprint(
+		     imaging_handle->compression_level_control,
+		     stream,
+		     statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_COMPRESSED ],
+		     statistics[ LIBEWF_STATISTICS_VALUE_COMPRESSION_TIME ],
+		     statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_WRITTEN ],
+		     statistics[ LIBEWF_STATISTICS_VALUE_WRITE_TIME ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression level control.",
+			 function );
+
+			return( -1 );
+		}
+	}
+
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
 /* Prints the hashes
  * Returns 1 if successful or -1 on error
  */
@@ -6094,3 +7113,157 @@ int imaging_handle_print_hashes(
 	return( 1 );
 }
 
+/* Prints the filenames of the (delta) segment files of the output handle
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_print_segment_files(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t *filename = NULL;
+	static char *function                   = "imaging_handle_print_segment_files";
+	size_t filename_size                    = 0;
+	uint32_t number_of_segment_files        = 0;
+	uint32_t segment_file_index             = 0;
+	int result                              = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_segment_files(
+	     imaging_handle->output_handle,
+	     &number_of_segment_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment files.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stream,
+	 "Segment files written:\n" );
+
+	for( segment_file_index = 0;
+	     segment_file_index < number_of_segment_files;
+	     segment_file_index++ )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_get_segment_file_name_size_wide(
+		          imaging_handle->output_handle,
+		          segment_file_index,
+		          &filename_size,
+		          error );
+#else
+		result = libewf_handle_get_segment_file_name_size(
+		          imaging_handle->output_handle,
+		          segment_file_index,
+		          &filename_size,
+		          error );
+#endif
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename size of segment file: %" PRIu32 ".",
+			 function,
+			 segment_file_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		filename = libcstring_system_string_allocate(
+		            filename_size );
+
+		if( filename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create filename.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_get_segment_file_name_wide(
+		          imaging_handle->output_handle,
+		          segment_file_index,
+		          filename,
+		          filename_size,
+		          error );
+#else
+		result = libewf_handle_get_segment_file_name(
+		          imaging_handle->output_handle,
+		          segment_file_index,
+		          filename,
+		          filename_size,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename of segment file: %" PRIu32 ".",
+			 function,
+			 segment_file_index );
+
+			goto on_error;
+		}
+		fprintf(
+		 stream,
+		 "\t%" PRIs_LIBCSTRING_SYSTEM "\n",
+		 filename );
+
+		memory_free(
+		 filename );
+
+		filename = NULL;
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
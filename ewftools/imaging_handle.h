@@ -26,6 +26,7 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "compression_level_control.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcstring.h"
 #include "ewftools_libewf.h"
@@ -60,6 +61,14 @@ struct imaging_handle
 	 */
 	size_t secondary_target_filename_size;
 
+	/* The stripe target filenames
+	 */
+	libcstring_system_character_t **stripe_target_filenames;
+
+	/* The number of stripe target filenames
+	 */
+	int number_of_stripe_target_filenames;
+
 	/* The header codepage
 	 */
 	int header_codepage;
@@ -116,6 +125,30 @@ struct imaging_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The zlib compression level, 0 if determined by the compression level
+	 */
+	int zlib_compression_level;
+
+	/* The zlib strategy
+	 */
+	int zlib_strategy;
+
+	/* The zlib window bits, 0 if the zlib default
+	 */
+	int zlib_window_bits;
+
+	/* The zlib memory level, 0 if the zlib default
+	 */
+	int zlib_memory_level;
+
+	/* Value to indicate the zlib compression level should be determined automatically
+	 */
+	uint8_t use_automatic_compression_level;
+
+	/* The automatic compression level control
+	 */
+	compression_level_control_t *compression_level_control;
+
 	/* The EWF format
 	 */
 	uint8_t ewf_format;
@@ -144,6 +177,14 @@ struct imaging_handle
 	 */
 	size64_t maximum_segment_size;
 
+	/* The write checkpoint interval in number of chunks, 0 if disabled
+	 */
+	uint32_t checkpoint_interval;
+
+	/* The segment file write flags
+	 */
+	uint8_t segment_file_write_flags;
+
 	/* The acquiry offset
 	 */
 	uint64_t acquiry_offset;
@@ -249,6 +290,12 @@ int imaging_handle_open_output(
      uint8_t resume,
      libcerror_error_t **error );
 
+int imaging_handle_open_output_read_write(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *filename,
+     uint8_t format,
+     libcerror_error_t **error );
+
 int imaging_handle_open_secondary_output(
      imaging_handle_t *imaging_handle,
      const libcstring_system_character_t *filename,
@@ -281,6 +328,12 @@ ssize_t imaging_handle_write_buffer(
          size_t write_size,
          libcerror_error_t **error );
 
+int imaging_handle_update_compression_level(
+     imaging_handle_t *imaging_handle,
+     size_t process_size,
+     uint64_t process_start_time,
+     libcerror_error_t **error );
+
 off64_t imaging_handle_seek_offset(
          imaging_handle_t *imaging_handle,
          off64_t offset,
@@ -311,6 +364,11 @@ int imaging_handle_finalize_integrity_hash(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+int imaging_handle_calculate_output_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
 int imaging_handle_get_chunk_size(
      imaging_handle_t *imaging_handle,
      size32_t *chunk_size,
@@ -389,11 +447,21 @@ int imaging_handle_set_string(
      size_t *internal_string_size,
      libcerror_error_t **error );
 
+int imaging_handle_determine_compression_values(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_compression_values(
      imaging_handle_t *imaging_handle,
      const libcstring_system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_zlib_compression_values(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_format(
      imaging_handle_t *imaging_handle,
      const libcstring_system_character_t *string,
@@ -429,6 +497,16 @@ int imaging_handle_set_maximum_segment_size(
      const libcstring_system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_checkpoint_interval(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
+int imaging_handle_append_stripe_target_filename(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_acquiry_offset(
      imaging_handle_t *imaging_handle,
      const libcstring_system_character_t *string,
@@ -515,11 +593,21 @@ int imaging_handle_print_parameters(
      uint8_t resume_acquiry,
      libcerror_error_t **error );
 
+int imaging_handle_print_compression_statistics(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 int imaging_handle_print_hashes(
      imaging_handle_t *imaging_handle,
      FILE *stream,
      libcerror_error_t **error );
 
+int imaging_handle_print_segment_files(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
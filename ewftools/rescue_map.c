@@ -0,0 +1,1363 @@
+/*
+ * Rescue map
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcstring.h"
+#include "ewftools_libcsystem.h"
+#include "rescue_map.h"
+
+#define RESCUE_MAP_LINE_SIZE		256
+
+/* Creates a rescue map
+ * Make sure the value rescue_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_initialize(
+     rescue_map_t **rescue_map,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_initialize";
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rescue_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rescue map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*rescue_map = memory_allocate_structure(
+	               rescue_map_t );
+
+	if( *rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create rescue map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *rescue_map,
+	     0,
+	     sizeof( rescue_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear rescue map.",
+		 function );
+
+		goto on_error;
+	}
+	( *rescue_map )->current_status = RESCUE_MAP_STATUS_NON_TRIED;
+
+	return( 1 );
+
+on_error:
+	if( *rescue_map != NULL )
+	{
+		memory_free(
+		 *rescue_map );
+
+		*rescue_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a rescue map
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_free(
+     rescue_map_t **rescue_map,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_free";
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rescue_map != NULL )
+	{
+		if( ( *rescue_map )->ranges != NULL )
+		{
+			memory_free(
+			 ( *rescue_map )->ranges );
+		}
+		memory_free(
+		 *rescue_map );
+
+		*rescue_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Makes sure there is room for an additional range
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_grow_ranges(
+     rescue_map_t *rescue_map,
+     libcerror_error_t **error )
+{
+	rescue_map_range_t *ranges   = NULL;
+	static char *function        = "rescue_map_grow_ranges";
+	int maximum_number_of_ranges = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map->number_of_ranges < rescue_map->maximum_number_of_ranges )
+	{
+		return( 1 );
+	}
+	if( rescue_map->maximum_number_of_ranges == 0 )
+	{
+		maximum_number_of_ranges = 16;
+	}
+	else if( rescue_map->maximum_number_of_ranges < ( INT32_MAX / 2 ) )
+	{
+		maximum_number_of_ranges = rescue_map->maximum_number_of_ranges * 2;
+	}
+	if( ( maximum_number_of_ranges == 0 )
+	 || ( (size_t) maximum_number_of_ranges > ( (size_t) SSIZE_MAX / sizeof( rescue_map_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of ranges value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	ranges = (rescue_map_range_t *) memory_reallocate(
+	                                 rescue_map->ranges,
+	                                 sizeof( rescue_map_range_t ) * maximum_number_of_ranges );
+
+	if( ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize ranges.",
+		 function );
+
+		return( -1 );
+	}
+	rescue_map->ranges                   = ranges;
+	rescue_map->maximum_number_of_ranges = maximum_number_of_ranges;
+
+	return( 1 );
+}
+
+/* Appends a range
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_append_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_append_range";
+	int range_index       = 0;
+
+	if( rescue_map_grow_ranges(
+	     rescue_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize ranges.",
+		 function );
+
+		return( -1 );
+	}
+	range_index = rescue_map->number_of_ranges;
+
+	rescue_map->ranges[ range_index ].offset = offset;
+	rescue_map->ranges[ range_index ].size   = size;
+	rescue_map->ranges[ range_index ].status = status;
+
+	rescue_map->number_of_ranges += 1;
+
+	return( 1 );
+}
+
+/* Removes a number of ranges starting at a specific index
+ */
+void rescue_map_remove_ranges(
+      rescue_map_t *rescue_map,
+      int range_index,
+      int number_of_ranges )
+{
+	int iterator = 0;
+
+	for( iterator = range_index + number_of_ranges;
+	     iterator < rescue_map->number_of_ranges;
+	     iterator++ )
+	{
+		rescue_map->ranges[ iterator - number_of_ranges ] = rescue_map->ranges[ iterator ];
+	}
+	rescue_map->number_of_ranges -= number_of_ranges;
+}
+
+/* Retrieves the index of the range that contains the offset
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int rescue_map_get_range_index(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     int *range_index,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_get_range_index";
+	int first_index       = 0;
+	int last_index        = 0;
+	int middle_index      = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < rescue_map->media_offset )
+	 || ( (size64_t) ( offset - rescue_map->media_offset ) >= rescue_map->media_size ) )
+	{
+		return( 0 );
+	}
+	last_index = rescue_map->number_of_ranges - 1;
+
+	while( first_index < last_index )
+	{
+		middle_index = first_index + ( ( last_index - first_index + 1 ) / 2 );
+
+		if( rescue_map->ranges[ middle_index ].offset <= offset )
+		{
+			first_index = middle_index;
+		}
+		else
+		{
+			last_index = middle_index - 1;
+		}
+	}
+	*range_index = first_index;
+
+	return( 1 );
+}
+
+/* Makes sure a range starts at the offset, splitting the range that contains it if necessary
+ * Sets range index to the number of ranges if the offset is the end of the media
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_split_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     int *range_index,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_split_range";
+	off64_t range_end     = 0;
+	int iterator          = 0;
+	int result            = 0;
+
+	result = rescue_map_get_range_index(
+	          rescue_map,
+	          offset,
+	          range_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range index.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*range_index = rescue_map->number_of_ranges;
+
+		return( 1 );
+	}
+	if( rescue_map->ranges[ *range_index ].offset == offset )
+	{
+		return( 1 );
+	}
+	if( rescue_map_grow_ranges(
+	     rescue_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize ranges.",
+		 function );
+
+		return( -1 );
+	}
+	for( iterator = rescue_map->number_of_ranges;
+	     iterator > ( *range_index + 1 );
+	     iterator-- )
+	{
+		rescue_map->ranges[ iterator ] = rescue_map->ranges[ iterator - 1 ];
+	}
+	rescue_map->number_of_ranges += 1;
+
+	range_end = rescue_map->ranges[ *range_index ].offset
+	          + (off64_t) rescue_map->ranges[ *range_index ].size;
+
+	rescue_map->ranges[ *range_index ].size = (size64_t) ( offset - rescue_map->ranges[ *range_index ].offset );
+
+	*range_index += 1;
+
+	rescue_map->ranges[ *range_index ].offset = offset;
+	rescue_map->ranges[ *range_index ].size   = (size64_t) ( range_end - offset );
+	rescue_map->ranges[ *range_index ].status = rescue_map->ranges[ *range_index - 1 ].status;
+
+	return( 1 );
+}
+
+/* Sets the media covered by the rescue map
+ * All the media is marked as non-tried
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_set_media(
+     rescue_map_t *rescue_map,
+     off64_t media_offset,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_set_media";
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid media offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size > (size64_t) ( INT64_MAX - media_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	rescue_map->media_offset     = media_offset;
+	rescue_map->media_size       = media_size;
+	rescue_map->current_offset   = media_offset;
+	rescue_map->current_status   = RESCUE_MAP_STATUS_NON_TRIED;
+	rescue_map->number_of_ranges = 0;
+
+	if( media_size > 0 )
+	{
+		if( rescue_map_append_range(
+		     rescue_map,
+		     media_offset,
+		     media_size,
+		     RESCUE_MAP_STATUS_NON_TRIED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append range.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the status of a range of the media
+ * Adjacent ranges with the same status are merged
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_set_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_set_range";
+	int first_range_index = 0;
+	int last_range_index  = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < rescue_map->media_offset )
+	 || ( (size64_t) ( offset - rescue_map->media_offset ) > rescue_map->media_size )
+	 || ( size > ( rescue_map->media_size - (size64_t) ( offset - rescue_map->media_offset ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	if( rescue_map_split_range(
+	     rescue_map,
+	     offset,
+	     &first_range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to split range at start offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map_split_range(
+	     rescue_map,
+	     offset + (off64_t) size,
+	     &last_range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to split range at end offset.",
+		 function );
+
+		return( -1 );
+	}
+	rescue_map->ranges[ first_range_index ].size   = size;
+	rescue_map->ranges[ first_range_index ].status = status;
+
+	if( last_range_index > ( first_range_index + 1 ) )
+	{
+		rescue_map_remove_ranges(
+		 rescue_map,
+		 first_range_index + 1,
+		 last_range_index - first_range_index - 1 );
+	}
+	if( ( ( first_range_index + 1 ) < rescue_map->number_of_ranges )
+	 && ( rescue_map->ranges[ first_range_index + 1 ].status == status ) )
+	{
+		rescue_map->ranges[ first_range_index ].size += rescue_map->ranges[ first_range_index + 1 ].size;
+
+		rescue_map_remove_ranges(
+		 rescue_map,
+		 first_range_index + 1,
+		 1 );
+	}
+	if( ( first_range_index > 0 )
+	 && ( rescue_map->ranges[ first_range_index - 1 ].status == status ) )
+	{
+		rescue_map->ranges[ first_range_index - 1 ].size += rescue_map->ranges[ first_range_index ].size;
+
+		rescue_map_remove_ranges(
+		 rescue_map,
+		 first_range_index,
+		 1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the first unresolved range at or after the offset
+ * A range is unresolved if it is non-tried, non-trimmed or non-scraped
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int rescue_map_get_unresolved_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_get_unresolved_range";
+	int range_index       = 0;
+	int result            = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < rescue_map->media_offset )
+	{
+		offset = rescue_map->media_offset;
+	}
+	result = rescue_map_get_range_index(
+	          rescue_map,
+	          offset,
+	          &range_index,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	while( range_index < rescue_map->number_of_ranges )
+	{
+		if( ( rescue_map->ranges[ range_index ].status == RESCUE_MAP_STATUS_NON_TRIED )
+		 || ( rescue_map->ranges[ range_index ].status == RESCUE_MAP_STATUS_NON_TRIMMED )
+		 || ( rescue_map->ranges[ range_index ].status == RESCUE_MAP_STATUS_NON_SCRAPED ) )
+		{
+			if( rescue_map->ranges[ range_index ].offset > offset )
+			{
+				offset = rescue_map->ranges[ range_index ].offset;
+			}
+			*range_offset = offset;
+			*range_size   = rescue_map->ranges[ range_index ].size
+			              - (size64_t) ( offset - rescue_map->ranges[ range_index ].offset );
+
+			return( 1 );
+		}
+		range_index++;
+	}
+	return( 0 );
+}
+
+/* Retrieves the number of bytes with a specific status
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_get_status_size(
+     rescue_map_t *rescue_map,
+     uint8_t status,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_get_status_size";
+	int range_index       = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = 0;
+
+	for( range_index = 0;
+	     range_index < rescue_map->number_of_ranges;
+	     range_index++ )
+	{
+		if( rescue_map->ranges[ range_index ].status == status )
+		{
+			*size += rescue_map->ranges[ range_index ].size;
+		}
+	}
+	return( 1 );
+}
+
+/* Copies a number from a map file line, both 0x prefixed hexadecimal and decimal notations are supported
+ * Leading white space is skipped
+ * Returns 1 if successful, 0 if no number was found or -1 on error
+ */
+int rescue_map_copy_string_to_64_bit(
+     const libcstring_system_character_t *string,
+     size_t string_size,
+     size_t *string_index,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_copy_string_to_64_bit";
+	size_t safe_index     = 0;
+	uint64_t base         = 10;
+	uint64_t digit        = 0;
+	uint8_t has_digits    = 0;
+
+	if( ( string == NULL )
+	 || ( string_index == NULL )
+	 || ( value_64bit == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string, string index or value.",
+		 function );
+
+		return( -1 );
+	}
+	safe_index = *string_index;
+
+	while( ( safe_index < string_size )
+	    && ( ( string[ safe_index ] == (libcstring_system_character_t) ' ' )
+	     || ( string[ safe_index ] == (libcstring_system_character_t) '\t' ) ) )
+	{
+		safe_index++;
+	}
+	if( ( ( safe_index + 1 ) < string_size )
+	 && ( string[ safe_index ] == (libcstring_system_character_t) '0' )
+	 && ( ( string[ safe_index + 1 ] == (libcstring_system_character_t) 'x' )
+	  || ( string[ safe_index + 1 ] == (libcstring_system_character_t) 'X' ) ) )
+	{
+		base        = 16;
+		safe_index += 2;
+	}
+	*value_64bit = 0;
+
+	while( safe_index < string_size )
+	{
+		if( ( string[ safe_index ] >= (libcstring_system_character_t) '0' )
+		 && ( string[ safe_index ] <= (libcstring_system_character_t) '9' ) )
+		{
+			digit = (uint64_t) ( string[ safe_index ] - (libcstring_system_character_t) '0' );
+		}
+		else if( ( base == 16 )
+		      && ( string[ safe_index ] >= (libcstring_system_character_t) 'a' )
+		      && ( string[ safe_index ] <= (libcstring_system_character_t) 'f' ) )
+		{
+			digit = (uint64_t) ( string[ safe_index ] - (libcstring_system_character_t) 'a' + 10 );
+		}
+		else if( ( base == 16 )
+		      && ( string[ safe_index ] >= (libcstring_system_character_t) 'A' )
+		      && ( string[ safe_index ] <= (libcstring_system_character_t) 'F' ) )
+		{
+			digit = (uint64_t) ( string[ safe_index ] - (libcstring_system_character_t) 'A' + 10 );
+		}
+		else
+		{
+			break;
+		}
+		if( *value_64bit > ( ( (uint64_t) INT64_MAX - digit ) / base ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit = ( *value_64bit * base ) + digit;
+		has_digits   = 1;
+
+		safe_index++;
+	}
+	*string_index = safe_index;
+
+	return( (int) has_digits );
+}
+
+/* Copies a status character from a map file line
+ * Leading white space is skipped
+ * Returns 1 if successful, 0 if no status was found
+ */
+int rescue_map_copy_string_to_status(
+     const libcstring_system_character_t *string,
+     size_t string_size,
+     size_t *string_index,
+     uint8_t *status )
+{
+	size_t safe_index = *string_index;
+
+	while( ( safe_index < string_size )
+	    && ( ( string[ safe_index ] == (libcstring_system_character_t) ' ' )
+	     || ( string[ safe_index ] == (libcstring_system_character_t) '\t' ) ) )
+	{
+		safe_index++;
+	}
+	if( ( safe_index >= string_size )
+	 || ( string[ safe_index ] <= (libcstring_system_character_t) ' ' )
+	 || ( string[ safe_index ] > (libcstring_system_character_t) '~' ) )
+	{
+		return( 0 );
+	}
+	*status       = (uint8_t) string[ safe_index ];
+	*string_index = safe_index + 1;
+
+	return( 1 );
+}
+
+/* Reads the rescue map from a file
+ * The file uses the format of the ddrescue map file
+ * Returns 1 if successful, 0 if the file could not be opened or -1 on error
+ */
+int rescue_map_read(
+     rescue_map_t *rescue_map,
+     const libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t line[ RESCUE_MAP_LINE_SIZE ];
+
+	FILE *stream          = NULL;
+	static char *function = "rescue_map_read";
+	size_t line_length    = 0;
+	size_t line_index     = 0;
+	uint64_t range_offset = 0;
+	uint64_t range_size   = 0;
+	off64_t media_end     = 0;
+	uint8_t has_current   = 0;
+	uint8_t status        = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	stream = libcsystem_file_stream_open(
+	          filename,
+	          _LIBCSTRING_SYSTEM_STRING( FILE_STREAM_OPEN_READ ) );
+
+	if( stream == NULL )
+	{
+		return( 0 );
+	}
+	rescue_map->number_of_ranges = 0;
+
+	while( libcsystem_file_stream_get_string(
+	        stream,
+	        line,
+	        RESCUE_MAP_LINE_SIZE ) != NULL )
+	{
+		line_length = libcstring_system_string_length(
+		               line );
+
+		line_index = 0;
+
+		while( ( line_index < line_length )
+		    && ( ( line[ line_index ] == (libcstring_system_character_t) ' ' )
+		     || ( line[ line_index ] == (libcstring_system_character_t) '\t' ) ) )
+		{
+			line_index++;
+		}
+		if( ( line_index >= line_length )
+		 || ( line[ line_index ] == (libcstring_system_character_t) '#' )
+		 || ( line[ line_index ] == (libcstring_system_character_t) '\n' )
+		 || ( line[ line_index ] == (libcstring_system_character_t) '\r' ) )
+		{
+			continue;
+		}
+		if( rescue_map_copy_string_to_64_bit(
+		     line,
+		     line_length,
+		     &line_index,
+		     &range_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported line - missing offset.",
+			 function );
+
+			goto on_error;
+		}
+		if( has_current == 0 )
+		{
+			if( rescue_map_copy_string_to_status(
+			     line,
+			     line_length,
+			     &line_index,
+			     &status ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported line - missing current status.",
+				 function );
+
+				goto on_error;
+			}
+			rescue_map->current_offset = (off64_t) range_offset;
+			rescue_map->current_status = status;
+
+			has_current = 1;
+
+			continue;
+		}
+		if( rescue_map_copy_string_to_64_bit(
+		     line,
+		     line_length,
+		     &line_index,
+		     &range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported line - missing size.",
+			 function );
+
+			goto on_error;
+		}
+		if( rescue_map_copy_string_to_status(
+		     line,
+		     line_length,
+		     &line_index,
+		     &status ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported line - missing status.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( status != RESCUE_MAP_STATUS_BAD_SECTOR )
+		 && ( status != RESCUE_MAP_STATUS_FINISHED )
+		 && ( status != RESCUE_MAP_STATUS_NON_SCRAPED )
+		 && ( status != RESCUE_MAP_STATUS_NON_TRIED )
+		 && ( status != RESCUE_MAP_STATUS_NON_TRIMMED ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported status: %c.",
+			 function,
+			 (char) status );
+
+			goto on_error;
+		}
+		if( rescue_map->number_of_ranges == 0 )
+		{
+			media_end = (off64_t) range_offset;
+
+			rescue_map->media_offset = (off64_t) range_offset;
+		}
+		if( ( (off64_t) range_offset != media_end )
+		 || ( range_size == 0 )
+		 || ( range_size > (uint64_t) ( INT64_MAX - media_end ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range at offset: 0x%08" PRIx64 " value out of bounds.",
+			 function,
+			 range_offset );
+
+			goto on_error;
+		}
+		if( rescue_map_append_range(
+		     rescue_map,
+		     (off64_t) range_offset,
+		     (size64_t) range_size,
+		     status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append range.",
+			 function );
+
+			goto on_error;
+		}
+		media_end += (off64_t) range_size;
+	}
+	if( rescue_map->number_of_ranges == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing ranges.",
+		 function );
+
+		goto on_error;
+	}
+	rescue_map->media_size = (size64_t) ( media_end - rescue_map->media_offset );
+
+	if( libcsystem_file_stream_close(
+	     stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	rescue_map->number_of_ranges = 0;
+
+	libcsystem_file_stream_close(
+	 stream );
+
+	return( -1 );
+}
+
+/* Writes the rescue map to a file
+ * The file uses the format of the ddrescue map file
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_write(
+     rescue_map_t *rescue_map,
+     const libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	FILE *stream          = NULL;
+	static char *function = "rescue_map_write";
+	int range_index       = 0;
+	int print_count       = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	stream = libcsystem_file_stream_open(
+	          filename,
+	          _LIBCSTRING_SYSTEM_STRING( FILE_STREAM_OPEN_WRITE ) );
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = fprintf(
+	               stream,
+	               "# Rescue map file\n"
+	               "# current_pos  current_status\n"
+	               "0x%08" PRIx64 "     %c\n"
+	               "#      pos        size  status\n",
+	               (uint64_t) rescue_map->current_offset,
+	               (char) rescue_map->current_status );
+
+	for( range_index = 0;
+	     range_index < rescue_map->number_of_ranges;
+	     range_index++ )
+	{
+		if( print_count < 0 )
+		{
+			break;
+		}
+		print_count = fprintf(
+		               stream,
+		               "0x%08" PRIx64 "  0x%08" PRIx64 "  %c\n",
+		               (uint64_t) rescue_map->ranges[ range_index ].offset,
+		               (uint64_t) rescue_map->ranges[ range_index ].size,
+		               (char) rescue_map->ranges[ range_index ].status );
+	}
+	if( print_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write ranges.",
+		 function );
+
+		libcsystem_file_stream_close(
+		 stream );
+
+		return( -1 );
+	}
+	if( libcsystem_file_stream_close(
+	     stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints a summary of the rescue map to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_fprint(
+     rescue_map_t *rescue_map,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function     = "rescue_map_fprint";
+	size64_t bad_sector_size  = 0;
+	size64_t finished_size    = 0;
+	size64_t non_scraped_size = 0;
+	size64_t non_tried_size   = 0;
+	size64_t non_trimmed_size = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( rescue_map_get_status_size(
+	       rescue_map,
+	       RESCUE_MAP_STATUS_FINISHED,
+	       &finished_size,
+	       error ) != 1 )
+	 || ( rescue_map_get_status_size(
+	       rescue_map,
+	       RESCUE_MAP_STATUS_NON_TRIED,
+	       &non_tried_size,
+	       error ) != 1 )
+	 || ( rescue_map_get_status_size(
+	       rescue_map,
+	       RESCUE_MAP_STATUS_NON_TRIMMED,
+	       &non_trimmed_size,
+	       error ) != 1 )
+	 || ( rescue_map_get_status_size(
+	       rescue_map,
+	       RESCUE_MAP_STATUS_NON_SCRAPED,
+	       &non_scraped_size,
+	       error ) != 1 )
+	 || ( rescue_map_get_status_size(
+	       rescue_map,
+	       RESCUE_MAP_STATUS_BAD_SECTOR,
+	       &bad_sector_size,
+	       error ) != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve status sizes.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Rescue map:\n" );
+	fprintf(
+	 stream,
+	 "\trescued:\t\t%" PRIu64 " bytes\n",
+	 finished_size );
+	fprintf(
+	 stream,
+	 "\tnon-tried:\t\t%" PRIu64 " bytes\n",
+	 non_tried_size );
+	fprintf(
+	 stream,
+	 "\tnon-trimmed:\t\t%" PRIu64 " bytes\n",
+	 non_trimmed_size );
+	fprintf(
+	 stream,
+	 "\tnon-scraped:\t\t%" PRIu64 " bytes\n",
+	 non_scraped_size );
+	fprintf(
+	 stream,
+	 "\tbad sectors:\t\t%" PRIu64 " bytes\n",
+	 bad_sector_size );
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+
+/* Prints the ranges of the rescue map that could not be rescued to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_errors_fprint(
+     rescue_map_t *rescue_map,
+     uint32_t bytes_per_sector,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function      = "rescue_map_errors_fprint";
+	uint64_t first_sector      = 0;
+	uint64_t number_of_sectors = 0;
+	int number_of_errors       = 0;
+	int range_index            = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid bytes per sector value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < rescue_map->number_of_ranges;
+	     range_index++ )
+	{
+		if( rescue_map->ranges[ range_index ].status != RESCUE_MAP_STATUS_FINISHED )
+		{
+			number_of_errors++;
+		}
+	}
+	if( number_of_errors == 0 )
+	{
+		return( 1 );
+	}
+	fprintf(
+	 stream,
+	 "Errors remaining after rescue:\n" );
+	fprintf(
+	 stream,
+	 "\ttotal number: %d\n",
+	 number_of_errors );
+
+	for( range_index = 0;
+	     range_index < rescue_map->number_of_ranges;
+	     range_index++ )
+	{
+		if( rescue_map->ranges[ range_index ].status == RESCUE_MAP_STATUS_FINISHED )
+		{
+			continue;
+		}
+		first_sector      = (uint64_t) rescue_map->ranges[ range_index ].offset / bytes_per_sector;
+		number_of_sectors = ( rescue_map->ranges[ range_index ].size + bytes_per_sector - 1 ) / bytes_per_sector;
+
+		fprintf(
+		 stream,
+		 "\tat sector(s): %" PRIu64 " - %" PRIu64 " number: %" PRIu64 " (offset: 0x%08" PRIx64 " of size: %" PRIu64 ")\n",
+		 first_sector,
+		 first_sector + number_of_sectors - 1,
+		 number_of_sectors,
+		 rescue_map->ranges[ range_index ].offset,
+		 rescue_map->ranges[ range_index ].size );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
@@ -0,0 +1,199 @@
+/*
+ * Rescue map
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _RESCUE_MAP_H )
+#define _RESCUE_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcstring.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The rescue map status definitions
+ * The values are the characters used by ddrescue in its map file
+ */
+enum RESCUE_MAP_STATUSES
+{
+	RESCUE_MAP_STATUS_BAD_SECTOR			= (uint8_t) '-',
+	RESCUE_MAP_STATUS_FINISHED			= (uint8_t) '+',
+	RESCUE_MAP_STATUS_NON_SCRAPED			= (uint8_t) '/',
+	RESCUE_MAP_STATUS_NON_TRIED			= (uint8_t) '?',
+	RESCUE_MAP_STATUS_NON_TRIMMED			= (uint8_t) '*'
+};
+
+typedef struct rescue_map_range rescue_map_range_t;
+
+struct rescue_map_range
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct rescue_map rescue_map_t;
+
+struct rescue_map
+{
+	/* The media offset
+	 */
+	off64_t media_offset;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The current status
+	 * RESCUE_MAP_STATUS_NON_TRIED while the first pass is in progress
+	 */
+	uint8_t current_status;
+
+	/* The ranges, sorted by offset and covering the media without gaps
+	 */
+	rescue_map_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The number of allocated ranges
+	 */
+	int maximum_number_of_ranges;
+};
+
+int rescue_map_initialize(
+     rescue_map_t **rescue_map,
+     libcerror_error_t **error );
+
+int rescue_map_free(
+     rescue_map_t **rescue_map,
+     libcerror_error_t **error );
+
+int rescue_map_grow_ranges(
+     rescue_map_t *rescue_map,
+     libcerror_error_t **error );
+
+int rescue_map_append_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error );
+
+void rescue_map_remove_ranges(
+      rescue_map_t *rescue_map,
+      int range_index,
+      int number_of_ranges );
+
+int rescue_map_get_range_index(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     int *range_index,
+     libcerror_error_t **error );
+
+int rescue_map_split_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     int *range_index,
+     libcerror_error_t **error );
+
+int rescue_map_set_media(
+     rescue_map_t *rescue_map,
+     off64_t media_offset,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+int rescue_map_set_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error );
+
+int rescue_map_get_unresolved_range(
+     rescue_map_t *rescue_map,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int rescue_map_get_status_size(
+     rescue_map_t *rescue_map,
+     uint8_t status,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int rescue_map_copy_string_to_64_bit(
+     const libcstring_system_character_t *string,
+     size_t string_size,
+     size_t *string_index,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int rescue_map_copy_string_to_status(
+     const libcstring_system_character_t *string,
+     size_t string_size,
+     size_t *string_index,
+     uint8_t *status );
+
+int rescue_map_read(
+     rescue_map_t *rescue_map,
+     const libcstring_system_character_t *filename,
+     libcerror_error_t **error );
+
+int rescue_map_write(
+     rescue_map_t *rescue_map,
+     const libcstring_system_character_t *filename,
+     libcerror_error_t **error );
+
+int rescue_map_fprint(
+     rescue_map_t *rescue_map,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int rescue_map_errors_fprint(
+     rescue_map_t *rescue_map,
+     uint32_t bytes_per_sector,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -126,13 +126,14 @@ int storage_media_buffer_initialize(
 			 */
 			raw_buffer_size += 4;
 		}
-/* TODO can low level functions and direct IO be combined ? */
 #if defined( memory_allocate_aligned )
 		if( memory_allocate_aligned(
 		     (void **) &( ( *buffer )->raw_buffer ),
 		     raw_buffer_size,
-		     512 ) != 0 )
+		     STORAGE_MEDIA_BUFFER_ALIGNMENT ) != 0 )
 		{
+			( *buffer )->raw_buffer = NULL;
+
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
@@ -266,10 +267,27 @@ int storage_media_buffer_resize(
 	}
 	if( size > buffer->raw_buffer_size )
 	{
+#if defined( memory_allocate_aligned )
+		/* The data is not retained, so allocate a new aligned buffer
+		 * instead of reallocating which does not retain the alignment
+		 */
+		if( memory_allocate_aligned(
+		     &reallocation,
+		     sizeof( uint8_t ) * size,
+		     STORAGE_MEDIA_BUFFER_ALIGNMENT ) != 0 )
+		{
+			reallocation = NULL;
+		}
+		else if( buffer->raw_buffer != NULL )
+		{
+			memory_free(
+			 buffer->raw_buffer );
+		}
+#else
 		reallocation = memory_reallocate(
 				buffer->raw_buffer,
 				sizeof( uint8_t ) * size );
-
+#endif
 		if( reallocation == NULL )
 		{
 			libcerror_error_set(
@@ -37,6 +37,11 @@ enum STORAGE_MEDIA_BUFFER_MODES
 	STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA	= 1
 };
 
+/* The alignment of the raw buffer, the page size of most systems
+ * which satisfies the buffer alignment required by direct access
+ */
+#define STORAGE_MEDIA_BUFFER_ALIGNMENT		4096
+
 typedef struct storage_media_buffer storage_media_buffer_t;
 
 struct storage_media_buffer
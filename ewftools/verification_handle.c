@@ -876,6 +876,22 @@ ssize_t verification_handle_read_buffer(
 	{
 		storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
 	}
+	if( verification_handle->trace_chunk_io != 0 )
+	{
+		if( verification_handle_update_trace_histograms(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update trace histograms.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( read_count );
 }
 
@@ -1680,6 +1696,23 @@ int verification_handle_verify_input(
 		 verification_handle->notify_stream,
 		 "\n" );
 
+		if( verification_handle->trace_chunk_io != 0 )
+		{
+			if( verification_handle_trace_histograms_fprint(
+			     verification_handle,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print trace histograms.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( log_handle != NULL )
 		{
 			if( verification_handle_checksum_errors_fprint(
@@ -3348,6 +3381,160 @@ int verification_handle_set_zero_chunk_on_error(
 	return( 1 );
 }
 
+/* Sets the trace chunk I/O
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_trace_chunk_io(
+     verification_handle_t *verification_handle,
+     uint8_t trace_chunk_io,
+     libcerror_error_t **error )
+{
+	static char *function              = "verification_handle_set_trace_chunk_io";
+	int maximum_number_of_trace_events = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_chunk_io != 0 )
+	{
+		maximum_number_of_trace_events = VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_TRACE_EVENTS;
+	}
+	if( libewf_handle_set_maximum_number_of_trace_events(
+	     verification_handle->input_handle,
+	     maximum_number_of_trace_events,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of trace events in input handle.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->trace_chunk_io = trace_chunk_io;
+
+	return( 1 );
+}
+
+/* Adds the trace events of the input handle to the trace histograms
+ * The trace events are emptied afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_update_trace_histograms(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function      = "verification_handle_update_trace_histograms";
+	uint64_t chunk_index       = 0;
+	uint64_t duration          = 0;
+	uint64_t microseconds      = 0;
+	uint64_t start_time        = 0;
+	uint8_t stage              = 0;
+	int bucket_index           = 0;
+	int file_io_pool_entry     = 0;
+	int number_of_trace_events = 0;
+	int trace_event_index      = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_trace_events(
+	     verification_handle->input_handle,
+	     &number_of_trace_events,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of trace events.",
+		 function );
+
+		return( -1 );
+	}
+	for( trace_event_index = 0;
+	     trace_event_index < number_of_trace_events;
+	     trace_event_index++ )
+	{
+		if( libewf_handle_get_trace_event(
+		     verification_handle->input_handle,
+		     trace_event_index,
+		     &stage,
+		     &chunk_index,
+		     &file_io_pool_entry,
+		     &start_time,
+		     &duration,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve trace event: %d.",
+			 function,
+			 trace_event_index );
+
+			return( -1 );
+		}
+		if( stage >= VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES )
+		{
+			continue;
+		}
+		microseconds = duration / 1000;
+
+		for( bucket_index = 0;
+		     bucket_index < ( VERIFICATION_HANDLE_NUMBER_OF_TRACE_BUCKETS - 1 );
+		     bucket_index++ )
+		{
+			if( microseconds == 0 )
+			{
+				break;
+			}
+			microseconds >>= 1;
+		}
+		verification_handle->trace_histograms[ stage ][ bucket_index ] += 1;
+
+		if( duration > verification_handle->trace_maximum_durations[ stage ] )
+		{
+			verification_handle->trace_maximum_durations[ stage ]                     = duration;
+			verification_handle->trace_maximum_duration_chunk_indexes[ stage ]        = chunk_index;
+			verification_handle->trace_maximum_duration_file_io_pool_entries[ stage ] = file_io_pool_entry;
+		}
+	}
+	if( libewf_handle_empty_trace_events(
+	     verification_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to empty trace events.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Appends a read error to the output handle
  * Returns 1 if successful or -1 on error
  */
@@ -3958,3 +4145,124 @@ on_error:
 	return( -1 );
 }
 
+/* Prints the trace histograms to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_trace_histograms_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static const char *stage_names[ VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES ] = {
+		NULL,
+		"open",
+		"seek",
+		"read",
+		"decompress",
+		"checksum",
+		"unpack",
+		"compress",
+		"write" };
+
+	static char *function     = "verification_handle_trace_histograms_fprint";
+	uint64_t number_of_events = 0;
+	int bucket_index          = 0;
+	int stage                 = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Chunk I/O latency:\n" );
+
+	for( stage = 1;
+	     stage < VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES;
+	     stage++ )
+	{
+		number_of_events = 0;
+
+		for( bucket_index = 0;
+		     bucket_index < VERIFICATION_HANDLE_NUMBER_OF_TRACE_BUCKETS;
+		     bucket_index++ )
+		{
+			number_of_events += verification_handle->trace_histograms[ stage ][ bucket_index ];
+		}
+		if( number_of_events == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 stream,
+		 "\t%s (number of events: %" PRIu64 "):\n",
+		 stage_names[ stage ],
+		 number_of_events );
+
+		for( bucket_index = 0;
+		     bucket_index < VERIFICATION_HANDLE_NUMBER_OF_TRACE_BUCKETS;
+		     bucket_index++ )
+		{
+			if( verification_handle->trace_histograms[ stage ][ bucket_index ] == 0 )
+			{
+				continue;
+			}
+			if( bucket_index < ( VERIFICATION_HANDLE_NUMBER_OF_TRACE_BUCKETS - 1 ) )
+			{
+				fprintf(
+				 stream,
+				 "\t\t< %" PRIu64 " us: %" PRIu64 "\n",
+				 (uint64_t) 1 << bucket_index,
+				 verification_handle->trace_histograms[ stage ][ bucket_index ] );
+			}
+			else
+			{
+				fprintf(
+				 stream,
+				 "\t\t>= %" PRIu64 " us: %" PRIu64 "\n",
+				 (uint64_t) 1 << ( bucket_index - 1 ),
+				 verification_handle->trace_histograms[ stage ][ bucket_index ] );
+			}
+		}
+		fprintf(
+		 stream,
+		 "\t\tslowest: %" PRIu64 " us at chunk: %" PRIu64,
+		 verification_handle->trace_maximum_durations[ stage ] / 1000,
+		 verification_handle->trace_maximum_duration_chunk_indexes[ stage ] );
+
+		if( verification_handle->trace_maximum_duration_file_io_pool_entries[ stage ] >= 0 )
+		{
+			fprintf(
+			 stream,
+			 " in segment file entry: %d",
+			 verification_handle->trace_maximum_duration_file_io_pool_entries[ stage ] );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
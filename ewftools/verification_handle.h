@@ -43,6 +43,16 @@ enum VERIFICATION_HANDLE_INPUT_FORMATS
 	VERIFICATION_HANDLE_INPUT_FORMAT_RAW	= (int) 'r'
 };
 
+/* The trace stages are used as index into the trace histograms
+ */
+#define VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES		9
+
+/* The trace histogram bucket N contains the durations less than 2^N microseconds
+ */
+#define VERIFICATION_HANDLE_NUMBER_OF_TRACE_BUCKETS		24
+
+#define VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_TRACE_EVENTS	65536
+
 typedef struct verification_handle verification_handle_t;
 
 struct verification_handle
@@ -155,6 +165,26 @@ struct verification_handle
 	 */
 	size_t process_buffer_size;
 
+	/* Value to indicate if the chunk I/O should be traced
+	 */
+	uint8_t trace_chunk_io;
+
+	/* The chunk I/O latency histograms per trace stage
+	 */
+	uint64_t trace_histograms[ VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES ][ VERIFICATION_HANDLE_NUMBER_OF_TRACE_BUCKETS ];
+
+	/* The maximum duration per trace stage
+	 */
+	uint64_t trace_maximum_durations[ VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES ];
+
+	/* The chunk index of the maximum duration per trace stage
+	 */
+	uint64_t trace_maximum_duration_chunk_indexes[ VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES ];
+
+	/* The file IO pool entry of the maximum duration per trace stage
+	 */
+	int trace_maximum_duration_file_io_pool_entries[ VERIFICATION_HANDLE_NUMBER_OF_TRACE_STAGES ];
+
 	/* The nofication output stream
 	 */
 	FILE *notify_stream;
@@ -280,6 +310,15 @@ int verification_handle_set_zero_chunk_on_error(
      uint8_t zero_chunk_on_error,
      libcerror_error_t **error );
 
+int verification_handle_set_trace_chunk_io(
+     verification_handle_t *verification_handle,
+     uint8_t trace_chunk_io,
+     libcerror_error_t **error );
+
+int verification_handle_update_trace_histograms(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
 int verification_handle_append_read_error(
       verification_handle_t *verification_handle,
       off64_t start_offset,
@@ -301,6 +340,11 @@ int verification_handle_checksum_errors_fprint(
      FILE *stream,
      libcerror_error_t **error );
 
+int verification_handle_trace_histograms_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
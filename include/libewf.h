@@ -91,6 +91,24 @@ int libewf_set_codepage(
      int codepage,
      libewf_error_t **error );
 
+/* Retrieves the compression backend
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_get_compression_backend(
+     int *compression_backend,
+     libewf_error_t **error );
+
+/* Sets the compression backend
+ * The compression backend is used for all handles
+ * LIBEWF_COMPRESSION_BACKEND_DEFAULT selects zlib
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_set_compression_backend(
+     int compression_backend,
+     libewf_error_t **error );
+
 /* Determines if a file is an EWF file (check for the EWF file signature)
  * Returns 1 if true, 0 if not or -1 on error
  */
@@ -410,6 +428,29 @@ ssize_t libewf_handle_read_chunk(
          int8_t *read_checksum,
          libewf_error_t **error );
 
+/* Reads multiple chunks of (media) data as they are stored in the segment files
+ * The chunks are identified by their index, adjacent chunks are read at once
+ * The chunk data is stored consecutively in the chunks buffer, chunk_data_offsets
+ * and chunk_data_sizes are set to the offset and size of the data of every chunk
+ * chunk_flags contains LIBEWF_CHUNK_FLAG values, chunk_checksums contains
+ * the stored checksum of chunks that have LIBEWF_CHUNK_FLAG_HAS_CHECKSUM set
+ * Fewer chunks than requested are read if the chunks buffer is too small
+ * This function does not change the current offset
+ * Returns the number of chunks read or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_read_chunks(
+     libewf_handle_t *handle,
+     const uint64_t *chunk_indexes,
+     int number_of_chunks,
+     void *chunks_buffer,
+     size_t chunks_buffer_size,
+     size_t *chunk_data_offsets,
+     size_t *chunk_data_sizes,
+     uint32_t *chunk_checksums,
+     uint8_t *chunk_flags,
+     libewf_error_t **error );
+
 /* Reads (media) data at the current offset into a buffer
  * Returns the number of bytes read or -1 on error
  */
@@ -431,6 +472,66 @@ ssize_t libewf_handle_read_random(
          off64_t offset,
          libewf_error_t **error );
 
+/* Sets the number of threads used to process asynchronous read requests
+ * The number of threads cannot be changed after the first asynchronous read request was submitted
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_read_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libewf_error_t **error );
+
+/* Submits an asynchronous request to read (media) data at a specific offset
+ * The handle must be opened for reading only. Every read thread reads the segment files
+ * using its own file handles, the chunk table is shared and accessed in turn.
+ * If a callback function is provided it is called from a read thread when the request completes,
+ * otherwise the completion must be retrieved using libewf_handle_get_read_completion.
+ * The buffer must remain valid until the request completes and other handle functions
+ * must not be called while requests are outstanding.
+ * Returns 1 if successful, 0 if the maximum number of outstanding requests was reached or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_submit_read_random(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libewf_handle_t *handle,
+            ssize_t read_count,
+            intptr_t *user_data ),
+     intptr_t *user_data,
+     libewf_error_t **error );
+
+/* Retrieves the user data and read count of an asynchronous read request
+ * that was submitted without a callback function
+ * The read count is -1 if the request failed
+ * If wait for completion is set the function blocks until a request completes
+ * Returns 1 if successful, 0 if no completion is available or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_read_completion(
+     libewf_handle_t *handle,
+     intptr_t **user_data,
+     ssize_t *read_count,
+     uint8_t wait_for_completion,
+     libewf_error_t **error );
+
+/* Sets the number of threads used to pack (compress) chunks while writing
+ * If set the chunks written by libewf_handle_write_buffer are packed concurrently
+ * and written to the segment files in order. The chunks that are still being packed
+ * are written by libewf_handle_write_finalize at the latest.
+ * 0 (the default) packs the chunks in the writing thread
+ * The number of threads cannot be changed after the first chunk was packed
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libewf_error_t **error );
+
 /* Prepares a chunk of (media) data before writing according to the handle settings
  * This function should be used before libewf_handle_write_chunk
  * The chunk_buffer_size should contain the actual chunk size
@@ -521,6 +622,99 @@ int libewf_handle_get_offset(
      off64_t *offset,
      libewf_error_t **error );
 
+/* Retrieves the extent of the (media) data that contains the offset
+ * An extent is a range of chunks that either all contain data or all only contain 0-byte values
+ * The extent flags contain LIBEWF_EXTENT_FLAG_IS_SPARSE if the extent only contains 0-byte values
+ * Chunks that only contain 0-byte values are detected when they are stored
+ * as the same compressed block, e.g. written with empty-block compression,
+ * other chunks are considered to contain data
+ * This function does not change the current offset
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_media_extent(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libewf_error_t **error );
+
+/* Retrieves the chunk data pool statistics
+ * The chunk data pool keeps the chunk data buffers of the handle for reuse,
+ * so that reading and writing chunks does not require heap allocations per chunk
+ * The number of allocations is the number of chunk data buffers and values allocated from the heap,
+ * the number of reuses the number taken from the pool and the number of frees the number freed to the heap
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_data_pool_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     uint64_t *number_of_frees,
+     libewf_error_t **error );
+
+/* Retrieves the statistics
+ * Fills the statistics array with up to number of statistics values indexed by LIBEWF_STATISTICS_VALUES
+ * The times are in nanoseconds, the cache and file IO pool values cover the currently open segment files
+ * The cache and file IO pool values are LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE if libewf was built
+ * against a system installed libmfdata or libbfio
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_statistics(
+     libewf_handle_t *handle,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libewf_error_t **error );
+
+/* Sets the maximum number of trace events
+ * The chunk I/O is traced into a ring buffer of the maximum number of events
+ * A value of 0 disables tracing, existing trace events are discarded
+ * Reads submitted with libewf_handle_submit_read_random are not traced
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_number_of_trace_events(
+     libewf_handle_t *handle,
+     int maximum_number_of_trace_events,
+     libewf_error_t **error );
+
+/* Retrieves the number of trace events
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_trace_events(
+     libewf_handle_t *handle,
+     int *number_of_trace_events,
+     libewf_error_t **error );
+
+/* Retrieves a specific trace event
+ * The trace events are ordered from oldest to newest
+ * The stage contains a LIBEWF_TRACE_STAGES value, the file IO pool entry is -1 if the stage
+ * does not access a segment file and the start time and duration are in nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_trace_event(
+     libewf_handle_t *handle,
+     int trace_event_index,
+     uint8_t *stage,
+     uint64_t *chunk_index,
+     int *file_io_pool_entry,
+     uint64_t *start_time,
+     uint64_t *duration,
+     libewf_error_t **error );
+
+/* Empties the trace events
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_empty_trace_events(
+     libewf_handle_t *handle,
+     libewf_error_t **error );
+
 /* Sets the maximum number of (concurrent) open file handles
  * Returns 1 if successful or -1 on error
  */
@@ -561,6 +755,18 @@ int libewf_handle_set_segment_filename(
      size_t filename_length,
      libewf_error_t **error );
 
+/* Appends a segment filename
+ * The additional segment filenames are used round-robin with the segment filename
+ * for the segment files that are created, e.g. to distribute them over multiple storage devices
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_append_segment_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libewf_error_t **error );
+
 #if defined( LIBEWF_HAVE_WIDE_CHARACTER_TYPE )
 /* Retrieves the segment filename size
  * The filename size includes the end of string character
@@ -592,6 +798,18 @@ int libewf_handle_set_segment_filename_wide(
      const wchar_t *filename,
      size_t filename_length,
      libewf_error_t **error );
+
+/* Appends a segment filename
+ * The additional segment filenames are used round-robin with the segment filename
+ * for the segment files that are created, e.g. to distribute them over multiple storage devices
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_append_segment_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libewf_error_t **error );
 #endif
 
 /* Retrieves the maximum segment file size
@@ -615,6 +833,55 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libewf_error_t **error );
 
+/* Retrieves the write checkpoint interval
+ * The interval is the maximum number of chunks written between checkpoints of the write journal
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_write_checkpoint_interval(
+     libewf_handle_t *handle,
+     uint32_t *number_of_chunks,
+     libewf_error_t **error );
+
+/* Sets the write checkpoint interval
+ * The interval is the maximum number of chunks written between checkpoints of the write journal
+ * At every checkpoint the current chunks section is closed, the segment file is flushed
+ * to the storage device and the checkpoint is recorded in the write journal,
+ * which is stored next to the segment files with the extension .journal
+ * An interrupted write that is resumed continues from the last checkpoint
+ * The write journal is removed when the write is finalized
+ * An interval of 0 disables the write journal
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_write_checkpoint_interval(
+     libewf_handle_t *handle,
+     uint32_t number_of_chunks,
+     libewf_error_t **error );
+
+/* Retrieves the segment file write flags
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_write_flags(
+     libewf_handle_t *handle,
+     uint8_t *write_flags,
+     libewf_error_t **error );
+
+/* Sets the segment file write flags
+ * LIBEWF_SEGMENT_FILE_WRITE_FLAG_PREALLOCATE preallocates every segment file to the maximum
+ * segment file size when it is created, so that it is stored contiguously,
+ * the unused part is released when the segment file is closed
+ * LIBEWF_SEGMENT_FILE_WRITE_FLAG_FLUSH_ON_CLOSE starts writing back a segment file
+ * when it is closed, while the next segment file is being written
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_segment_file_write_flags(
+     libewf_handle_t *handle,
+     uint8_t write_flags,
+     libewf_error_t **error );
+
 /* Retrieves the delta segment filename size
  * The filename size includes the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
@@ -760,6 +1027,67 @@ int libewf_handle_get_file_io_handle(
      libewf_error_t **error );
 #endif
 
+/* Retrieves the number of (delta) segment files
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_segment_files(
+     libewf_handle_t *handle,
+     uint32_t *number_of_segment_files,
+     libewf_error_t **error );
+
+/* Retrieves the filename size of a specific (delta) segment file
+ * The segment files are followed by the delta segment files
+ * The filename size includes the end of string character
+ * Returns 1 if successful, 0 if no such filename or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name_size(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     size_t *filename_size,
+     libewf_error_t **error );
+
+/* Retrieves the filename of a specific (delta) segment file
+ * The segment files are followed by the delta segment files
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if no such filename or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     char *filename,
+     size_t filename_size,
+     libewf_error_t **error );
+
+#if defined( LIBEWF_HAVE_WIDE_CHARACTER_TYPE )
+/* Retrieves the filename size of a specific (delta) segment file
+ * The segment files are followed by the delta segment files
+ * The filename size includes the end of string character
+ * Returns 1 if successful, 0 if no such filename or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name_size_wide(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     size_t *filename_size,
+     libewf_error_t **error );
+
+/* Retrieves the filename of a specific (delta) segment file
+ * The segment files are followed by the delta segment files
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if no such filename or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name_wide(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     wchar_t *filename,
+     size_t filename_size,
+     libewf_error_t **error );
+#endif
+
 /* -------------------------------------------------------------------------
  * File/Handle functions - deprecated
  * ------------------------------------------------------------------------- */
@@ -944,6 +1272,56 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libewf_error_t **error );
 
+/* Retrieves the zlib compression level
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_zlib_compression_level(
+     libewf_handle_t *handle,
+     int *zlib_compression_level,
+     libewf_error_t **error );
+
+/* Sets the zlib compression level
+ * The level (1 to 9) overrides the zlib level that corresponds with the compression level
+ * for chunks that are compressed, 0 removes the override
+ * Unlike the compression values the level can be changed while writing,
+ * it applies to the chunks that are written afterwards
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_zlib_compression_level(
+     libewf_handle_t *handle,
+     int zlib_compression_level,
+     libewf_error_t **error );
+
+/* Retrieves the zlib compression values
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_zlib_compression_values(
+     libewf_handle_t *handle,
+     int *zlib_compression_level,
+     int *zlib_strategy,
+     int *zlib_window_bits,
+     int *zlib_memory_level,
+     libewf_error_t **error );
+
+/* Sets the zlib compression values
+ * The level (1 to 9) overrides the zlib level that corresponds with the compression level, 0 removes the override
+ * The strategy is one of the LIBEWF_COMPRESSION_STRATEGY definitions
+ * The window bits (9 to 15) and memory level (1 to 9) are passed to zlib deflate, 0 represents the zlib default
+ * Like the zlib compression level the values can be changed while writing
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_zlib_compression_values(
+     libewf_handle_t *handle,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libewf_error_t **error );
+
 /* Retrieves the size of the contained (media) data
  * This function will compensate for a media_size that is not a multitude of bytes_per_sector
  * Returns 1 if successful or -1 on error
@@ -191,6 +191,11 @@ int libbfio_file_initialize(
 
 		goto on_error;
 	}
+	( (libbfio_internal_handle_t *) *handle )->sync     = (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_sync;
+	( (libbfio_internal_handle_t *) *handle )->allocate = (int (*)(intptr_t *, size64_t, libcerror_error_t **)) libbfio_file_allocate;
+	( (libbfio_internal_handle_t *) *handle )->truncate = (int (*)(intptr_t *, size64_t, libcerror_error_t **)) libbfio_file_truncate;
+	( (libbfio_internal_handle_t *) *handle )->flush    = (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_flush;
+
 	return( 1 );
 
 on_error:
@@ -2243,3 +2248,206 @@ int libbfio_file_get_size(
 	return( 1 );
 }
 
+/* Flushes the data written to the file to the storage device
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_sync(
+     libbfio_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_sync";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_sync(
+	     file_io_handle->file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to sync file: %" PRIs_LIBCSTRING_SYSTEM ".",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Allocates storage space for the file without changing the size of the file
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libbfio_file_allocate(
+     libbfio_file_io_handle_t *file_io_handle,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_allocate";
+	int result            = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcfile_file_allocate(
+	          file_io_handle->file,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to allocate file: %" PRIs_LIBCSTRING_SYSTEM ".",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Truncates the file to a specific size
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_truncate(
+     libbfio_file_io_handle_t *file_io_handle,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_truncate";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_resize(
+	     file_io_handle->file,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to truncate file: %" PRIs_LIBCSTRING_SYSTEM ".",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Starts writing the data written to the file to the storage device
+ * without waiting for the data to be written
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libbfio_file_flush(
+     libbfio_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_flush";
+	int result            = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcfile_file_flush(
+	          file_io_handle->file,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to flush file: %" PRIs_LIBCSTRING_SYSTEM ".",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	return( result );
+}
+
@@ -191,6 +191,24 @@ int libbfio_file_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int libbfio_file_sync(
+     libbfio_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_allocate(
+     libbfio_file_io_handle_t *file_io_handle,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libbfio_file_truncate(
+     libbfio_file_io_handle_t *file_io_handle,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libbfio_file_flush(
+     libbfio_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -153,6 +153,32 @@ struct libbfio_internal_handle
 	       size64_t *size,
 	       libcerror_error_t **error );
 
+	/* The sync function, which is optional
+	 */
+	int (*sync)(
+	       intptr_t *io_handle,
+	       libcerror_error_t **error );
+
+	/* The allocate function, which is optional
+	 */
+	int (*allocate)(
+	       intptr_t *io_handle,
+	       size64_t size,
+	       libcerror_error_t **error );
+
+	/* The truncate function, which is optional
+	 */
+	int (*truncate)(
+	       intptr_t *io_handle,
+	       size64_t size,
+	       libcerror_error_t **error );
+
+	/* The flush function, which is optional
+	 */
+	int (*flush)(
+	       intptr_t *io_handle,
+	       libcerror_error_t **error );
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	/* The read/write lock
 	 */
@@ -289,6 +315,28 @@ int libbfio_handle_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+int libbfio_handle_sync(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_handle_allocate(
+     libbfio_handle_t *handle,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_handle_truncate(
+     libbfio_handle_t *handle,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_handle_flush(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 int libbfio_handle_get_offset(
      libbfio_handle_t *handle,
@@ -589,6 +589,8 @@ int libbfio_pool_open_handle(
 
 		return( -1 );
 	}
+	internal_pool->number_of_opens += 1;
+
 	internal_handle = (libbfio_internal_handle_t *) handle;
 
 	if( libbfio_handle_seek_offset(
@@ -724,6 +726,8 @@ int libbfio_pool_append_handle_to_last_used_list(
 			}
 			internal_handle->pool_last_used_list_element = NULL;
 
+			internal_pool->number_of_evictions += 1;
+
 			/* Make sure the truncate flag is removed from the handle
 			 */
 			internal_handle->access_flags &= ~( LIBBFIO_ACCESS_FLAG_TRUNCATE );
@@ -2382,6 +2386,467 @@ int libbfio_pool_get_size(
 	return( 1 );
 }
 
+/* Flushes the data written to a handle in the pool to the storage device
+ * Returns 1 if successful, 0 if the handle does not support sync or -1 on error
+ */
+int libbfio_pool_sync(
+     libbfio_pool_t *pool,
+     int entry,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_sync";
+	int access_flags                       = 0;
+	int is_open                            = 0;
+	int result                             = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_pool->handles_array,
+	     entry,
+	     (intptr_t **) &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           handle,
+	           error );
+
+	if( is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_access_flags(
+		     handle,
+		     &access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	result = libbfio_handle_sync(
+	          handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to sync entry: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Allocates storage space for a handle in the pool without changing its size
+ * Returns 1 if successful, 0 if the handle does not support allocate or -1 on error
+ */
+int libbfio_pool_allocate(
+     libbfio_pool_t *pool,
+     int entry,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_allocate";
+	int access_flags                       = 0;
+	int is_open                            = 0;
+	int result                             = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_pool->handles_array,
+	     entry,
+	     (intptr_t **) &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           handle,
+	           error );
+
+	if( is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_access_flags(
+		     handle,
+		     &access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	result = libbfio_handle_allocate(
+	          handle,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to allocate entry: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Truncates a handle in the pool to a specific size
+ * Returns 1 if successful, 0 if the handle does not support truncate or -1 on error
+ */
+int libbfio_pool_truncate(
+     libbfio_pool_t *pool,
+     int entry,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_truncate";
+	int access_flags                       = 0;
+	int is_open                            = 0;
+	int result                             = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_pool->handles_array,
+	     entry,
+	     (intptr_t **) &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           handle,
+	           error );
+
+	if( is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_access_flags(
+		     handle,
+		     &access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	result = libbfio_handle_truncate(
+	          handle,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to truncate entry: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Starts writing the data written to a handle in the pool to the storage device
+ * without waiting for the data to be written
+ * Returns 1 if successful, 0 if the handle does not support flush or -1 on error
+ */
+int libbfio_pool_flush(
+     libbfio_pool_t *pool,
+     int entry,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_flush";
+	int access_flags                       = 0;
+	int is_open                            = 0;
+	int result                             = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_pool->handles_array,
+	     entry,
+	     (intptr_t **) &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           handle,
+	           error );
+
+	if( is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_access_flags(
+		     handle,
+		     &access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	result = libbfio_handle_flush(
+	          handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to flush entry: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Retrieves the current offset in a handle in the pool
  * Returns 1 if successful or -1 on error
  */
@@ -2667,3 +3132,56 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the number of handle opens and evictions of the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_pool_get_open_statistics(
+     libbfio_pool_t *pool,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error )
+{
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_get_open_statistics";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( number_of_opens == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of opens.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_evictions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of evictions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_opens     = internal_pool->number_of_opens;
+	*number_of_evictions = internal_pool->number_of_evictions;
+
+	return( 1 );
+}
+
@@ -51,6 +51,14 @@ struct libbfio_internal_pool
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The number of times a handle was opened by the pool
+	 */
+	uint64_t number_of_opens;
+
+	/* The number of times a handle was closed to make room for another
+	 */
+	uint64_t number_of_evictions;
+
 	/* The handles array
 	 */
 	libcdata_array_t *handles_array;
@@ -193,6 +201,32 @@ int libbfio_pool_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+int libbfio_pool_sync(
+     libbfio_pool_t *pool,
+     int entry,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_pool_allocate(
+     libbfio_pool_t *pool,
+     int entry,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_pool_truncate(
+     libbfio_pool_t *pool,
+     int entry,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_pool_flush(
+     libbfio_pool_t *pool,
+     int entry,
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 int libbfio_pool_get_offset(
      libbfio_pool_t *pool,
@@ -212,6 +246,13 @@ int libbfio_pool_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+int libbfio_pool_get_open_statistics(
+     libbfio_pool_t *pool,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
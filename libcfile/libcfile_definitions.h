@@ -45,13 +45,15 @@
  * bit 1	set to 1 for read access
  * bit 2	set to 1 for write access
  * bit 3	set to 1 to truncate an existing file on write
- * bit 4-8	not used
+ * bit 4	set to 1 to read directly from the storage bypassing the system cache
+ * bit 5-8	not used
  */
 enum LIBCFILE_ACCESS_FLAGS
 {
 	LIBCFILE_ACCESS_FLAG_READ			= 0x01,
 	LIBCFILE_ACCESS_FLAG_WRITE			= 0x02,
-	LIBCFILE_ACCESS_FLAG_TRUNCATE			= 0x04
+	LIBCFILE_ACCESS_FLAG_TRUNCATE			= 0x04,
+	LIBCFILE_ACCESS_FLAG_DIRECT			= 0x08
 };
 
 /* The file access macros
@@ -61,6 +63,7 @@ enum LIBCFILE_ACCESS_FLAGS
 #define LIBCFILE_OPEN_READ_WRITE			( LIBCFILE_ACCESS_FLAG_READ | LIBCFILE_ACCESS_FLAG_WRITE )
 #define LIBCFILE_OPEN_WRITE_TRUNCATE			( LIBCFILE_ACCESS_FLAG_WRITE | LIBCFILE_ACCESS_FLAG_TRUNCATE )
 #define LIBCFILE_OPEN_READ_WRITE_TRUNCATE		( LIBCFILE_ACCESS_FLAG_READ | LIBCFILE_ACCESS_FLAG_WRITE | LIBCFILE_ACCESS_FLAG_TRUNCATE )
+#define LIBCFILE_OPEN_READ_DIRECT			( LIBCFILE_ACCESS_FLAG_READ | LIBCFILE_ACCESS_FLAG_DIRECT )
 
 /* The access behavior types
  */
@@ -73,6 +76,11 @@ enum LIBCFILE_ACCESS_BEHAVIOR
 
 #endif /* !defined( HAVE_LOCAL_LIBCFILE ) */
 
+/* The alignment of the block data, a multiple of the page size of most systems
+ * that also satisfies the buffer alignment required by direct access
+ */
+#define LIBCFILE_BLOCK_DATA_ALIGNMENT			4096
+
 /* Platform specific macros
  */
 #if defined( WINAPI )
@@ -19,6 +19,12 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+/* O_DIRECT is only defined by glibc when _GNU_SOURCE is defined
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -419,6 +425,19 @@ int libcfile_file_open_with_error_code(
 	{
 		file_io_creation_flags = CREATE_ALWAYS;
 	}
+	if( ( ( access_flags & LIBCFILE_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags: 0x%02x.",
+		 function,
+		 access_flags );
+
+		return( -1 );
+	}
 	if( error_code == NULL )
 	{
 		libcerror_error_set(
@@ -607,6 +626,25 @@ int libcfile_file_open_with_error_code(
 	{
 		file_io_flags |= O_TRUNC;
 	}
+	if( ( ( access_flags & LIBCFILE_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags: 0x%02x.",
+		 function,
+		 access_flags );
+
+		return( -1 );
+	}
+#if defined( O_DIRECT )
+	if( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) != 0 )
+	{
+		file_io_flags |= O_DIRECT;
+	}
+#endif
 	if( error_code == NULL )
 	{
 		libcerror_error_set(
@@ -871,6 +909,19 @@ int libcfile_file_open_wide_with_error_code(
 	{
 		file_io_creation_flags = CREATE_ALWAYS;
 	}
+	if( ( ( access_flags & LIBCFILE_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags: 0x%02x.",
+		 function,
+		 access_flags );
+
+		return( -1 );
+	}
 	if( error_code == NULL )
 	{
 		libcerror_error_set(
@@ -1060,6 +1111,25 @@ int libcfile_file_open_wide_with_error_code(
 	{
 		file_io_flags |= O_TRUNC;
 	}
+	if( ( ( access_flags & LIBCFILE_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags: 0x%02x.",
+		 function,
+		 access_flags );
+
+		return( -1 );
+	}
+#if defined( O_DIRECT )
+	if( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) != 0 )
+	{
+		file_io_flags |= O_DIRECT;
+	}
+#endif
 	if( error_code == NULL )
 	{
 		libcerror_error_set(
@@ -2266,7 +2336,10 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 		              internal_file->block_data,
 		              internal_file->block_size );
 
-		if( read_count != (ssize_t) internal_file->block_size )
+		/* The last block of the file can be smaller than the block size
+		 */
+		if( ( read_count < 0 )
+		 || ( (size_t) read_count <= internal_file->block_data_offset ) )
 		{
 			*error_code = (uint32_t) errno;
 
@@ -2323,6 +2396,61 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 		read_size_remainder = size % internal_file->block_size;
 		read_size           = size - read_size_remainder;
 	}
+	if( ( read_size > 0 )
+	 && ( internal_file->block_size != 0 )
+	 && ( ( internal_file->access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) != 0 )
+	 && ( ( (intptr_t) &( buffer[ buffer_offset ] ) % internal_file->block_size ) != 0 ) )
+	{
+		/* Direct access requires a block aligned buffer
+		 * read the blocks via the block data instead
+		 */
+		while( read_size > 0 )
+		{
+			read_count = read(
+			              internal_file->descriptor,
+			              internal_file->block_data,
+			              internal_file->block_size );
+
+			if( read_count < 0 )
+			{
+				*error_code = (uint32_t) errno;
+
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 *error_code,
+				 "%s: unable to read from file.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     internal_file->block_data,
+			     (size_t) read_count ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy block data.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset                 += (size_t) read_count;
+			internal_file->current_offset += read_count;
+
+			/* The read was cut short, e.g. by a partial last block at the end of the file
+			 */
+			if( read_count != (ssize_t) internal_file->block_size )
+			{
+				return( (ssize_t) buffer_offset );
+			}
+			read_size -= internal_file->block_size;
+		}
+	}
 	if( read_size > 0 )
 	{
 		read_count = read(
@@ -2365,7 +2493,8 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 	{
 		/* The read was cut short
 		 */
-		if( read_count != (size_t) read_size )
+		if( ( read_size > 0 )
+		 && ( read_count != (ssize_t) read_size ) )
 		{
 			return( (ssize_t) buffer_offset );
 		}
@@ -2388,7 +2517,9 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 		              internal_file->block_data,
 		              internal_file->block_size );
 
-		if( read_count != (ssize_t) internal_file->block_size )
+		/* The last block of the file can be smaller than the block size
+		 */
+		if( read_count < (ssize_t) read_size_remainder )
 		{
 			*error_code = (uint32_t) errno;
 
@@ -2430,6 +2561,110 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 #error Missing file read function
 #endif
 
+#if !defined( WINAPI ) && defined( HAVE_PREAD )
+
+/* Reads a buffer from the file at a specific offset
+ * This function uses the POSIX pread function or equivalent
+ * The current offset and block data of the file are not changed,
+ * which allows the function to be called from multiple threads
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_buffer_at_offset(
+         libcfile_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_read_buffer_at_offset";
+	ssize_t read_count                      = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+	if( internal_file->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	read_count = pread(
+	              internal_file->descriptor,
+	              (void *) buffer,
+	              size,
+	              (off_t) offset );
+
+	if( read_count < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 errno,
+		 "%s: unable to read from file at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+#endif /* !defined( WINAPI ) && defined( HAVE_PREAD ) */
+
 /* Writes a buffer to the file
  * Returns the number of bytes written if successful, or -1 on error
  */
@@ -3394,6 +3629,287 @@ int libcfile_file_resize(
 #error Missing file truncate function
 #endif
 
+#if defined( WINAPI )
+
+/* Flushes the data written to the file to the storage device
+ * This function uses the WINAPI function FlushFileBuffers
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_file_sync(
+     libcfile_file_t *file,
+     libcerror_error_t **error )
+{
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_sync";
+	DWORD error_code                        = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+	if( internal_file->handle == INVALID_HANDLE_VALUE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( FlushFileBuffers(
+	     internal_file->handle ) == 0 )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 error_code,
+		 "%s: unable to flush file buffers.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#elif defined( HAVE_FSYNC )
+
+/* Flushes the data written to the file to the storage device
+ * This function uses the POSIX fsync function or equivalent
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_file_sync(
+     libcfile_file_t *file,
+     libcerror_error_t **error )
+{
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_sync";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+	if( internal_file->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( fsync(
+	     internal_file->descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to sync file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#else
+#error Missing file sync function
+#endif
+
+/* Allocates storage space for the file without changing the size of the file
+ * This function uses the Linux fallocate function with FALLOC_FL_KEEP_SIZE
+ * The allocated space beyond the end of the file is released by libcfile_file_resize
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libcfile_file_allocate(
+     libcfile_file_t *file,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_allocate";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+#if defined( WINAPI )
+	if( internal_file->handle == INVALID_HANDLE_VALUE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( internal_file->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( WINAPI ) && defined( HAVE_FALLOCATE ) && defined( FALLOC_FL_KEEP_SIZE )
+	if( fallocate(
+	     internal_file->descriptor,
+	     FALLOC_FL_KEEP_SIZE,
+	     0,
+	     (off_t) size ) != 0 )
+	{
+		if( ( errno == EOPNOTSUPP )
+		 || ( errno == ENOSYS ) )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to allocate file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Starts writing the data written to the file to the storage device
+ * Unlike libcfile_file_sync this function does not wait for the data to be written
+ * This function uses the Linux sync_file_range function
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libcfile_file_flush(
+     libcfile_file_t *file,
+     libcerror_error_t **error )
+{
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_flush";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+#if defined( WINAPI )
+	if( internal_file->handle == INVALID_HANDLE_VALUE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( internal_file->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if !defined( WINAPI ) && defined( HAVE_SYNC_FILE_RANGE ) && defined( SYNC_FILE_RANGE_WRITE )
+	if( sync_file_range(
+	     internal_file->descriptor,
+	     0,
+	     0,
+	     SYNC_FILE_RANGE_WRITE ) != 0 )
+	{
+		if( ( errno == EOPNOTSUPP )
+		 || ( errno == ENOSYS ) )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to flush file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
 /* Checks if the file is open
  * Returns 1 if open, 0 if not or -1 on error
  */
@@ -4816,7 +5332,15 @@ int libcfile_file_set_block_size(
 		}
 		if( block_size > 0 )
 		{
+#if !defined( WINAPI )
+			/* The last block of a file opened for direct access can be smaller
+			 * than the block size, other files must consist of whole blocks
+			 */
+			if( ( ( internal_file->access_flags & LIBCFILE_ACCESS_FLAG_DIRECT ) == 0 )
+			 && ( ( internal_file->size % block_size ) != 0 ) )
+#else
 			if( ( internal_file->size % block_size ) != 0 )
+#endif
 			{
 				libcerror_error_set(
 				 error,
@@ -4827,16 +5351,27 @@ int libcfile_file_set_block_size(
 
 				return( -1 );
 			}
+#if defined( memory_allocate_aligned )
+			/* The block data is aligned since direct access reads into it
+			 */
+			if( memory_allocate_aligned(
+			     (void **) &( internal_file->block_data ),
+			     sizeof( uint8_t ) * block_size,
+			     LIBCFILE_BLOCK_DATA_ALIGNMENT ) != 0 )
+			{
+				internal_file->block_data = NULL;
+			}
+#else
 			internal_file->block_data = (uint8_t *) memory_allocate(
 			                                         sizeof( uint8_t ) * block_size );
-
-			if( internal_file == NULL )
+#endif
+			if( internal_file->block_data == NULL )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_MEMORY,
 				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create file.",
+				 "%s: unable to create block data.",
 				 function );
 
 				return( -1 );
@@ -192,6 +192,18 @@ ssize_t libcfile_file_read_buffer_with_error_code(
          uint32_t *error_code,
          libcerror_error_t **error );
 
+#if !defined( WINAPI ) && defined( HAVE_PREAD )
+
+LIBCFILE_EXTERN \
+ssize_t libcfile_file_read_buffer_at_offset(
+         libcfile_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif
+
 LIBCFILE_EXTERN \
 ssize_t libcfile_file_write_buffer(
          libcfile_file_t *file,
@@ -242,6 +254,22 @@ int libcfile_file_resize(
      size64_t size,
      libcerror_error_t **error );
 
+LIBCFILE_EXTERN \
+int libcfile_file_sync(
+     libcfile_file_t *file,
+     libcerror_error_t **error );
+
+LIBCFILE_EXTERN \
+int libcfile_file_allocate(
+     libcfile_file_t *file,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBCFILE_EXTERN \
+int libcfile_file_flush(
+     libcfile_file_t *file,
+     libcerror_error_t **error );
+
 LIBCFILE_EXTERN \
 int libcfile_file_is_open(
      libcfile_file_t *file,
@@ -31,6 +31,10 @@
 #include <errno.h>
 #endif
 
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "libcfile_definitions.h"
 #include "libcfile_libcerror.h"
 #include "libcfile_libclocale.h"
@@ -469,3 +473,349 @@ int libcfile_file_exists_wide(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+#if defined( WINAPI ) && ( WINVER > 0x0500 )
+
+/* Removes a file
+ * This function uses the WINAPI functions for Windows XP or later
+ * Returns 1 if successful, 0 if the file does not exist or -1 on error
+ */
+int libcfile_file_remove(
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libcfile_file_remove";
+	DWORD error_code      = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( DeleteFileA(
+	     (LPCSTR) filename ) == 0 )
+	{
+		error_code = GetLastError();
+
+		switch( error_code )
+		{
+			case ERROR_FILE_NOT_FOUND:
+			case ERROR_PATH_NOT_FOUND:
+				return( 0 );
+
+			default:
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+				 error_code,
+				 "%s: unable to remove file: %s.",
+				 function,
+				 filename );
+
+				return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#elif defined( WINAPI )
+
+/* TODO */
+#error WINAPI file remove function for Windows 2000 or earlier NOT implemented yet
+
+#elif defined( HAVE_UNLINK )
+
+/* Removes a file
+ * This function uses the POSIX unlink function or equivalent
+ * Returns 1 if successful, 0 if the file does not exist or -1 on error
+ */
+int libcfile_file_remove(
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libcfile_file_remove";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( unlink(
+	     filename ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 errno,
+		 "%s: unable to remove file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#else
+#error Missing file remove function
+#endif
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+#if defined( WINAPI ) && ( WINVER > 0x0500 )
+
+/* Removes a file
+ * This function uses the WINAPI functions for Windows XP or later
+ * Returns 1 if successful, 0 if the file does not exist or -1 on error
+ */
+int libcfile_file_remove_wide(
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libcfile_file_remove_wide";
+	DWORD error_code      = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( DeleteFileW(
+	     (LPCWSTR) filename ) == 0 )
+	{
+		error_code = GetLastError();
+
+		switch( error_code )
+		{
+			case ERROR_FILE_NOT_FOUND:
+			case ERROR_PATH_NOT_FOUND:
+				return( 0 );
+
+			default:
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+				 error_code,
+				 "%s: unable to remove file: %ls.",
+				 function,
+				 filename );
+
+				return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#elif defined( WINAPI )
+
+/* TODO */
+#error WINAPI file remove function for Windows 2000 or earlier NOT implemented yet
+
+#elif defined( HAVE_UNLINK )
+
+/* Removes a file
+ * This function uses the POSIX unlink function or equivalent
+ * Returns 1 if successful, 0 if the file does not exist or -1 on error
+ */
+int libcfile_file_remove_wide(
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	char *narrow_filename       = NULL;
+	static char *function       = "libcfile_file_remove_wide";
+	size_t narrow_filename_size = 0;
+	size_t filename_size        = 0;
+	int result                  = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_size = 1 + libcstring_wide_string_length(
+	                     filename );
+
+	/* Convert the filename to a narrow string
+	 * if the platform has no wide character open function
+	 */
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_size_from_utf32(
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          &narrow_filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_size_from_utf16(
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          &narrow_filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_size_from_utf32(
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          libclocale_codepage,
+		          &narrow_filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_size_from_utf16(
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          libclocale_codepage,
+		          &narrow_filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine narrow character filename size.",
+		 function );
+
+		return( -1 );
+	}
+	narrow_filename = libcstring_narrow_string_allocate(
+	                   narrow_filename_size );
+
+	if( narrow_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create narrow character filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_copy_from_utf32(
+		          (libuna_utf8_character_t *) narrow_filename,
+		          narrow_filename_size,
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_copy_from_utf16(
+		          (libuna_utf8_character_t *) narrow_filename,
+		          narrow_filename_size,
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_copy_from_utf32(
+		          (uint8_t *) narrow_filename,
+		          narrow_filename_size,
+		          libclocale_codepage,
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_copy_from_utf16(
+		          (uint8_t *) narrow_filename,
+		          narrow_filename_size,
+		          libclocale_codepage,
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set narrow character filename.",
+		 function );
+
+		memory_free(
+		 narrow_filename );
+
+		return( -1 );
+	}
+	result = unlink(
+	          narrow_filename );
+
+	memory_free(
+	 narrow_filename );
+
+	if( result != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 errno,
+		 "%s: unable to remove file: %ls.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#else
+#error Missing file remove wide function
+#endif
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
@@ -54,6 +54,20 @@ int libcfile_file_exists_wide(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+LIBCFILE_EXTERN \
+int libcfile_file_remove(
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBCFILE_EXTERN \
+int libcfile_file_remove_wide(
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 #if defined( __cplusplus )
 }
 #endif
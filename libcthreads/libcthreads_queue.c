@@ -301,6 +301,11 @@ int libcthreads_queue_free(
 
 			result = -1;
 		}
+		if( internal_queue->values_array != NULL )
+		{
+			memory_free(
+			 internal_queue->values_array );
+		}
 		memory_free(
 		 internal_queue );
 	}
@@ -421,6 +421,12 @@ int libcthreads_thread_pool_create(
 	}
 	internal_thread_pool->allocated_number_of_values = maximum_number_of_values;
 
+	/* The callback function must be set before the threads are created
+	 * otherwise a thread that starts immediately exits
+	 */
+	internal_thread_pool->callback_function           = callback_function;
+	internal_thread_pool->callback_function_arguments = callback_function_arguments;
+
 	if( libcthreads_mutex_initialize(
 	     &( internal_thread_pool->condition_mutex ),
 	     error ) != 1 )
@@ -652,8 +658,6 @@ int libcthreads_thread_pool_create(
 		}
 	}
 #endif
-	internal_thread_pool->callback_function           = callback_function;
-	internal_thread_pool->callback_function_arguments = callback_function_arguments;
 #endif
 	*thread_pool = (libcthreads_thread_pool_t *) internal_thread_pool;
 
@@ -1221,6 +1225,11 @@ int libcthreads_thread_pool_join(
 
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
+	if( internal_thread_pool->values_array != NULL )
+	{
+		memory_free(
+		 internal_thread_pool->values_array );
+	}
 	memory_free(
 	 internal_thread_pool );
 
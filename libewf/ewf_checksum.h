@@ -25,16 +25,14 @@
 #include <common.h>
 #include <types.h>
 
-#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
-#include <zlib.h>
-#endif
+#include "libewf_checksum.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
 #define ewf_checksum_calculate( buffer, size, previous_key ) \
-	(uint32_t) adler32( (uLong) previous_key, (const Bytef *) buffer, (uInt) size );
+	libewf_checksum_calculate_adler32( (const uint8_t *) buffer, (size_t) size, (uint32_t) previous_key );
 
 #if defined( __cplusplus )
 }
@@ -0,0 +1,73 @@
+/*
+ * EWFX write journal
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWFX_WRITE_JOURNAL_H )
+#define _EWFX_WRITE_JOURNAL_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct ewfx_write_journal_record ewfx_write_journal_record_t;
+
+struct ewfx_write_journal_record
+{
+	/* The signature
+	 * consists of 8 bytes
+	 * "EWFJRNL\x00"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The segment number
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The number of chunks written to the segment file
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t number_of_chunks_in_segment[ 4 ];
+
+	/* The segment file offset directly after the last complete chunks section
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t segment_file_offset[ 8 ];
+
+	/* The number of chunks written
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t number_of_chunks[ 8 ];
+
+	/* The checksum of all (previous) journal record data
+	 * consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
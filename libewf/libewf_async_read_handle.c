@@ -0,0 +1,1413 @@
+/*
+ * Asynchronous read handle functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_async_read_handle.h"
+#include "libewf_chunk_table.h"
+#include "libewf_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libmfdata.h"
+#include "libewf_read_io_handle.h"
+#include "libewf_statistics.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates an asynchronous read worker
+ * The worker takes over the management of the file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_worker_initialize(
+     libewf_async_read_worker_t **worker,
+     libbfio_pool_t *file_io_pool,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_worker_initialize";
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *worker != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid worker value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*worker = memory_allocate_structure(
+	           libewf_async_read_worker_t );
+
+	if( *worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create worker.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *worker,
+	     0,
+	     sizeof( libewf_async_read_worker_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear worker.",
+		 function );
+
+		memory_free(
+		 *worker );
+
+		*worker = NULL;
+
+		return( -1 );
+	}
+	( *worker )->chunk_data = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * chunk_size );
+
+	if( ( *worker )->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	( *worker )->chunk_data_size = (size_t) chunk_size;
+	( *worker )->file_io_pool    = file_io_pool;
+
+	return( 1 );
+
+on_error:
+	if( *worker != NULL )
+	{
+		memory_free(
+		 *worker );
+
+		*worker = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an asynchronous read worker
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_worker_free(
+     libewf_async_read_worker_t **worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_worker_free";
+	int result            = 1;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *worker != NULL )
+	{
+		if( ( *worker )->file_io_pool != NULL )
+		{
+			if( libbfio_pool_close_all(
+			     ( *worker )->file_io_pool,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close all file IO pool handles.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_pool_free(
+			     &( ( *worker )->file_io_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *worker )->stored_chunk_data != NULL )
+		{
+			memory_free(
+			 ( *worker )->stored_chunk_data );
+		}
+		if( ( *worker )->chunk_data != NULL )
+		{
+			memory_free(
+			 ( *worker )->chunk_data );
+		}
+		memory_free(
+		 *worker );
+
+		*worker = NULL;
+	}
+	return( result );
+}
+
+/* Creates an asynchronous read handle
+ * Every worker thread reads from a clone of the file IO pool of the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_handle_initialize(
+     libewf_async_read_handle_t **async_read_handle,
+     libewf_handle_t *handle,
+     int number_of_threads,
+     int maximum_number_of_requests,
+     libcerror_error_t **error )
+{
+	libewf_async_read_worker_t *worker        = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	static char *function                     = "libewf_async_read_handle_initialize";
+	int thread_index                          = 0;
+
+	if( async_read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async read handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_read_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid async read handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_requests <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of requests value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*async_read_handle = memory_allocate_structure(
+	                      libewf_async_read_handle_t );
+
+	if( *async_read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create async read handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *async_read_handle,
+	     0,
+	     sizeof( libewf_async_read_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear async read handle.",
+		 function );
+
+		memory_free(
+		 *async_read_handle );
+
+		*async_read_handle = NULL;
+
+		return( -1 );
+	}
+	( *async_read_handle )->handle                     = handle;
+	( *async_read_handle )->maximum_number_of_requests = maximum_number_of_requests;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *async_read_handle )->handle_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *async_read_handle )->requests_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create requests mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( ( *async_read_handle )->workers_queue ),
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create workers queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( ( *async_read_handle )->completions_queue ),
+	     maximum_number_of_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completions queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libbfio_pool_clone(
+		     &file_io_pool,
+		     internal_handle->file_io_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone file IO pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_async_read_worker_initialize(
+		     &worker,
+		     file_io_pool,
+		     internal_handle->media_values->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker: %d.",
+			 function,
+			 thread_index );
+
+			goto on_error;
+		}
+		file_io_pool = NULL;
+
+		if( libcthreads_queue_push(
+		     ( *async_read_handle )->workers_queue,
+		     (intptr_t *) worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push worker: %d onto queue.",
+			 function,
+			 thread_index );
+
+			goto on_error;
+		}
+		worker = NULL;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *async_read_handle )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_requests,
+	     (int (*)(intptr_t *, void *)) &libewf_async_read_handle_process_request,
+	     (void *) *async_read_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( worker != NULL )
+	{
+		libewf_async_read_worker_free(
+		 &worker,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( *async_read_handle != NULL )
+	{
+		libewf_async_read_handle_free(
+		 async_read_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees an asynchronous read handle
+ * Waits for the outstanding requests to be processed before the worker threads are stopped
+ * The completions that were not retrieved are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_handle_free(
+     libewf_async_read_handle_t **async_read_handle,
+     libcerror_error_t **error )
+{
+	libewf_async_read_request_t *request = NULL;
+	libewf_async_read_worker_t *worker   = NULL;
+	static char *function                = "libewf_async_read_handle_free";
+	int result                           = 1;
+	int pop_result                       = 0;
+
+	if( async_read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async read handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_read_handle != NULL )
+	{
+		if( ( *async_read_handle )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *async_read_handle )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *async_read_handle )->completions_queue != NULL )
+		{
+			do
+			{
+				pop_result = libcthreads_queue_try_pop(
+				              ( *async_read_handle )->completions_queue,
+				              (intptr_t **) &request,
+				              error );
+
+				if( pop_result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to pop request from completions queue.",
+					 function );
+
+					result = -1;
+				}
+				else if( pop_result != 0 )
+				{
+					memory_free(
+					 request );
+				}
+			}
+			while( pop_result == 1 );
+
+			if( libcthreads_queue_free(
+			     &( ( *async_read_handle )->completions_queue ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free completions queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *async_read_handle )->workers_queue != NULL )
+		{
+			do
+			{
+				pop_result = libcthreads_queue_try_pop(
+				              ( *async_read_handle )->workers_queue,
+				              (intptr_t **) &worker,
+				              error );
+
+				if( pop_result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to pop worker from workers queue.",
+					 function );
+
+					result = -1;
+				}
+				else if( pop_result != 0 )
+				{
+					if( libewf_async_read_worker_free(
+					     &worker,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free worker.",
+						 function );
+
+						result = -1;
+					}
+				}
+			}
+			while( pop_result == 1 );
+
+			if( libcthreads_queue_free(
+			     &( ( *async_read_handle )->workers_queue ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free workers queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *async_read_handle )->requests_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *async_read_handle )->requests_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free requests mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *async_read_handle )->handle_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *async_read_handle )->handle_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free handle mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *async_read_handle );
+
+		*async_read_handle = NULL;
+	}
+	return( result );
+}
+
+/* Submits an asynchronous read request
+ * If a callback function is provided it is called from a worker thread on completion,
+ * otherwise the completion must be retrieved with libewf_async_read_handle_get_completion
+ * Returns 1 if successful, 0 if the maximum number of outstanding requests was reached or -1 on error
+ */
+int libewf_async_read_handle_submit(
+     libewf_async_read_handle_t *async_read_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libewf_handle_t *handle,
+            ssize_t read_count,
+            intptr_t *user_data ),
+     intptr_t *user_data,
+     libcerror_error_t **error )
+{
+	libewf_async_read_request_t *request = NULL;
+	static char *function                = "libewf_async_read_handle_submit";
+	int result                           = 0;
+
+	if( async_read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async read handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	request = memory_allocate_structure(
+	           libewf_async_read_request_t );
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		return( -1 );
+	}
+	request->buffer            = buffer;
+	request->buffer_size       = buffer_size;
+	request->offset            = offset;
+	request->read_count        = 0;
+	request->callback_function = callback_function;
+	request->user_data         = user_data;
+
+	if( libcthreads_mutex_grab(
+	     async_read_handle->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab requests mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( async_read_handle->number_of_requests < async_read_handle->maximum_number_of_requests )
+	{
+		async_read_handle->number_of_requests += 1;
+
+		if( callback_function == NULL )
+		{
+			async_read_handle->number_of_unretrieved_requests += 1;
+		}
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     async_read_handle->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release requests mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		memory_free(
+		 request );
+
+		return( 0 );
+	}
+	/* The thread pool queue can hold the maximum number of outstanding requests
+	 * so pushing a request does not block
+	 */
+	if( libcthreads_thread_pool_push(
+	     async_read_handle->thread_pool,
+	     (intptr_t *) request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push request onto thread pool queue.",
+		 function );
+
+		if( libcthreads_mutex_grab(
+		     async_read_handle->requests_mutex,
+		     NULL ) == 1 )
+		{
+			async_read_handle->number_of_requests -= 1;
+
+			if( callback_function == NULL )
+			{
+				async_read_handle->number_of_unretrieved_requests -= 1;
+			}
+			libcthreads_mutex_release(
+			 async_read_handle->requests_mutex,
+			 NULL );
+		}
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		memory_free(
+		 request );
+	}
+	return( -1 );
+}
+
+/* Retrieves the completion of a request that was submitted without a callback function
+ * If wait for completion is set the function blocks until a request completes
+ * Returns 1 if successful, 0 if no completion is available or -1 on error
+ */
+int libewf_async_read_handle_get_completion(
+     libewf_async_read_handle_t *async_read_handle,
+     intptr_t **user_data,
+     ssize_t *read_count,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error )
+{
+	libewf_async_read_request_t *request = NULL;
+	static char *function                = "libewf_async_read_handle_get_completion";
+	int number_of_unretrieved_requests   = 0;
+	int result                           = 0;
+
+	if( async_read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async read handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( user_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid user data.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read count.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     async_read_handle->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_unretrieved_requests = async_read_handle->number_of_unretrieved_requests;
+
+	if( libcthreads_mutex_release(
+	     async_read_handle->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Do not wait when there are no requests for which a completion can be retrieved
+	 */
+	if( number_of_unretrieved_requests == 0 )
+	{
+		return( 0 );
+	}
+	if( wait_for_completion != 0 )
+	{
+		result = libcthreads_queue_pop(
+		          async_read_handle->completions_queue,
+		          (intptr_t **) &request,
+		          error );
+	}
+	else
+	{
+		result = libcthreads_queue_try_pop(
+		          async_read_handle->completions_queue,
+		          (intptr_t **) &request,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop request from completions queue.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	*user_data  = request->user_data;
+	*read_count = request->read_count;
+
+	memory_free(
+	 request );
+
+	if( libcthreads_mutex_grab(
+	     async_read_handle->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	async_read_handle->number_of_requests             -= 1;
+	async_read_handle->number_of_unretrieved_requests -= 1;
+
+	if( libcthreads_mutex_release(
+	     async_read_handle->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Processes a request, this function is the thread pool callback function
+ * Errors are reported by the read count of the request
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_handle_process_request(
+     libewf_async_read_request_t *request,
+     libewf_async_read_handle_t *async_read_handle )
+{
+	libcerror_error_t *error           = NULL;
+	libewf_async_read_worker_t *worker = NULL;
+	static char *function              = "libewf_async_read_handle_process_request";
+	int result                         = 1;
+
+	if( request == NULL )
+	{
+		return( -1 );
+	}
+	if( async_read_handle == NULL )
+	{
+		return( -1 );
+	}
+	request->read_count = -1;
+
+	/* There are as many workers as threads so popping a worker does not block
+	 */
+	if( libcthreads_queue_pop(
+	     async_read_handle->workers_queue,
+	     (intptr_t **) &worker,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop worker from workers queue.",
+		 function );
+
+		worker = NULL;
+		result = -1;
+	}
+	else
+	{
+		request->read_count = libewf_async_read_handle_read_buffer(
+		                       async_read_handle,
+		                       worker,
+		                       request->buffer,
+		                       request->buffer_size,
+		                       request->offset,
+		                       &error );
+
+		if( libcthreads_queue_push(
+		     async_read_handle->workers_queue,
+		     (intptr_t *) worker,
+		     ( error == NULL ) ? &error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( request->callback_function != NULL )
+	{
+		request->callback_function(
+		 async_read_handle->handle,
+		 request->read_count,
+		 request->user_data );
+
+		memory_free(
+		 request );
+
+		if( libcthreads_mutex_grab(
+		     async_read_handle->requests_mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		async_read_handle->number_of_requests -= 1;
+
+		if( libcthreads_mutex_release(
+		     async_read_handle->requests_mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	else
+	{
+		/* The completions queue can hold the maximum number of outstanding requests
+		 * so pushing a completion does not block
+		 */
+		if( libcthreads_queue_push(
+		     async_read_handle->completions_queue,
+		     (intptr_t *) request,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Reads media data at a specific offset using the file IO pool of a worker
+ * The chunk data ranges are looked up with the handle mutex grabbed, the chunk data
+ * is read and decompressed without it so that multiple workers can read concurrently
+ * Chunks that cannot be read directly, such as sparse, delta or corrupted chunks,
+ * are read by the handle with the handle mutex grabbed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_async_read_handle_read_buffer(
+     libewf_async_read_handle_t *async_read_handle,
+     libewf_async_read_worker_t *worker,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle       = NULL;
+	const uint8_t *compressed_zero_byte_empty_block = NULL;
+	uint8_t *chunk_buffer                           = NULL;
+	static char *function                           = "libewf_async_read_handle_read_buffer";
+	size_t buffer_offset                            = 0;
+	size_t chunk_data_offset                        = 0;
+	size_t compressed_zero_byte_empty_block_size    = 0;
+	size_t read_size                                = 0;
+	size64_t chunk_data_size                        = 0;
+	size32_t chunk_size                             = 0;
+	off64_t chunk_data_range_offset                 = 0;
+	off64_t chunk_offset                            = 0;
+	off64_t current_offset                          = 0;
+	ssize_t read_count                              = 0;
+	uint64_t chunk_index                            = 0;
+	uint32_t chunk_data_flags                       = 0;
+	int file_io_pool_entry                          = 0;
+	int result                                      = 0;
+
+	if( async_read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async read handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) async_read_handle->handle;
+
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) > internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		chunk_index       = (uint64_t) offset / internal_handle->media_values->chunk_size;
+		chunk_offset      = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+		chunk_data_offset = (size_t) ( offset - chunk_offset );
+		chunk_size        = internal_handle->media_values->chunk_size;
+
+		if( (size64_t) ( chunk_offset + chunk_size ) > internal_handle->media_values->media_size )
+		{
+			chunk_size = (size32_t) ( internal_handle->media_values->media_size - chunk_offset );
+		}
+		read_size = (size_t) chunk_size - chunk_data_offset;
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		if( libcthreads_mutex_grab(
+		     async_read_handle->handle_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab handle mutex.",
+			 function );
+
+			return( -1 );
+		}
+		result = libewf_chunk_table_get_chunk_data_range(
+		          internal_handle->chunk_table_list,
+		          internal_handle->file_io_pool,
+		          internal_handle->chunk_table_cache,
+		          (int) chunk_index,
+		          &file_io_pool_entry,
+		          &chunk_data_range_offset,
+		          &chunk_data_size,
+		          &chunk_data_flags,
+		          error );
+
+		compressed_zero_byte_empty_block      = internal_handle->read_io_handle->compressed_zero_byte_empty_block;
+		compressed_zero_byte_empty_block_size = internal_handle->read_io_handle->compressed_zero_byte_empty_block_size;
+
+		if( libcthreads_mutex_release(
+		     async_read_handle->handle_mutex,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range of chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( read_size == (size_t) chunk_size )
+		{
+			chunk_buffer = &( buffer[ buffer_offset ] );
+		}
+		else
+		{
+			chunk_buffer = worker->chunk_data;
+		}
+		result = libewf_read_io_handle_read_chunk_data_range_to_buffer(
+		          worker->file_io_pool,
+		          internal_handle->media_values,
+		          (int) chunk_index,
+		          file_io_pool_entry,
+		          chunk_data_range_offset,
+		          chunk_data_size,
+		          chunk_data_flags,
+		          compressed_zero_byte_empty_block,
+		          compressed_zero_byte_empty_block_size,
+		          &( worker->stored_chunk_data ),
+		          &( worker->stored_chunk_data_size ),
+		          chunk_buffer,
+		          (size_t) chunk_size,
+		          &( worker->statistics ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( chunk_buffer != &( buffer[ buffer_offset ] ) )
+			{
+				if( memory_copy(
+				     &( buffer[ buffer_offset ] ),
+				     &( chunk_buffer[ chunk_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		else
+		{
+			/* Leave the chunks that cannot be read directly to the handle
+			 * which does not change the current offset of the handle
+			 */
+			if( libcthreads_mutex_grab(
+			     async_read_handle->handle_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab handle mutex.",
+				 function );
+
+				return( -1 );
+			}
+			current_offset = internal_handle->io_handle->current_offset;
+
+			read_count = libewf_handle_read_random(
+			              async_read_handle->handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              offset,
+			              error );
+
+			internal_handle->io_handle->current_offset = current_offset;
+
+			if( libcthreads_mutex_release(
+			     async_read_handle->handle_mutex,
+			     ( read_count == (ssize_t) read_size ) ? error : NULL ) != 1 )
+			{
+				read_count = -1;
+			}
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data: %" PRIu64 " using handle.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		buffer_offset += read_size;
+		offset        += (off64_t) read_size;
+	}
+	if( internal_handle->statistics != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     async_read_handle->handle_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab handle mutex.",
+			 function );
+
+			return( -1 );
+		}
+		result = libewf_statistics_merge(
+		          internal_handle->statistics,
+		          &( worker->statistics ),
+		          error );
+
+		if( libcthreads_mutex_release(
+		     async_read_handle->handle_mutex,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to merge worker statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
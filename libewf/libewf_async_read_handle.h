@@ -0,0 +1,202 @@
+/*
+ * Asynchronous read handle functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ASYNC_READ_HANDLE_H )
+#define _LIBEWF_ASYNC_READ_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_statistics.h"
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_async_read_request libewf_async_read_request_t;
+
+struct libewf_async_read_request
+{
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The number of bytes read or -1 on error
+	 */
+	ssize_t read_count;
+
+	/* The completion callback function or NULL if the completion is retrieved
+	 */
+	void (*callback_function)(
+	       libewf_handle_t *handle,
+	       ssize_t read_count,
+	       intptr_t *user_data );
+
+	/* The user data
+	 */
+	intptr_t *user_data;
+};
+
+typedef struct libewf_async_read_worker libewf_async_read_worker_t;
+
+struct libewf_async_read_worker
+{
+	/* The (private) file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The stored chunk data
+	 */
+	uint8_t *stored_chunk_data;
+
+	/* The stored chunk data size
+	 */
+	size_t stored_chunk_data_size;
+
+	/* The chunk data used for partial chunk reads
+	 */
+	uint8_t *chunk_data;
+
+	/* The chunk data size
+	 */
+	size_t chunk_data_size;
+
+	/* The statistics of the reads since the last merge with the handle statistics
+	 */
+	libewf_statistics_t statistics;
+};
+
+typedef struct libewf_async_read_handle libewf_async_read_handle_t;
+
+struct libewf_async_read_handle
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The maximum number of outstanding requests
+	 */
+	int maximum_number_of_requests;
+
+	/* The number of outstanding requests
+	 */
+	int number_of_requests;
+
+	/* The number of outstanding requests without a callback function
+	 * whose completion has not yet been retrieved
+	 */
+	int number_of_unretrieved_requests;
+
+	/* The mutex that serializes access to the handle
+	 */
+	libcthreads_mutex_t *handle_mutex;
+
+	/* The mutex that protects the request counters
+	 */
+	libcthreads_mutex_t *requests_mutex;
+
+	/* The idle workers queue
+	 */
+	libcthreads_queue_t *workers_queue;
+
+	/* The completed requests queue
+	 */
+	libcthreads_queue_t *completions_queue;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+int libewf_async_read_worker_initialize(
+     libewf_async_read_worker_t **worker,
+     libbfio_pool_t *file_io_pool,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_async_read_worker_free(
+     libewf_async_read_worker_t **worker,
+     libcerror_error_t **error );
+
+int libewf_async_read_handle_initialize(
+     libewf_async_read_handle_t **async_read_handle,
+     libewf_handle_t *handle,
+     int number_of_threads,
+     int maximum_number_of_requests,
+     libcerror_error_t **error );
+
+int libewf_async_read_handle_free(
+     libewf_async_read_handle_t **async_read_handle,
+     libcerror_error_t **error );
+
+int libewf_async_read_handle_submit(
+     libewf_async_read_handle_t *async_read_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libewf_handle_t *handle,
+            ssize_t read_count,
+            intptr_t *user_data ),
+     intptr_t *user_data,
+     libcerror_error_t **error );
+
+int libewf_async_read_handle_get_completion(
+     libewf_async_read_handle_t *async_read_handle,
+     intptr_t **user_data,
+     ssize_t *read_count,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error );
+
+int libewf_async_read_handle_process_request(
+     libewf_async_read_request_t *request,
+     libewf_async_read_handle_t *async_read_handle );
+
+ssize_t libewf_async_read_handle_read_buffer(
+     libewf_async_read_handle_t *async_read_handle,
+     libewf_async_read_worker_t *worker,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,328 @@
+/*
+ * Checksum functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+#include <immintrin.h>
+#endif
+
+/* The largest prime smaller than 65536
+ */
+#define LIBEWF_CHECKSUM_ADLER32_BASE	65521
+
+/* The largest number of bytes that can be processed before
+ * the 32-bit sums need to be reduced modulo the base
+ */
+#define LIBEWF_CHECKSUM_ADLER32_NMAX	5552
+
+/* The number of bytes processed per iteration by the vector implementations
+ */
+#define LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE	32
+
+typedef uint32_t (*libewf_checksum_adler32_function_t)(
+                   const uint8_t *buffer,
+                   size_t size,
+                   uint32_t initial_value );
+
+/* The Adler-32 implementation selected for the current CPU
+ */
+static libewf_checksum_adler32_function_t libewf_checksum_adler32_function = NULL;
+
+/* Calculates the Adler-32 of the buffer using a portable implementation
+ * Returns the checksum
+ */
+uint32_t libewf_checksum_calculate_adler32_generic(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	size_t block_size = 0;
+	uint32_t lower_word = 0;
+	uint32_t upper_word = 0;
+
+	if( buffer == NULL )
+	{
+		return( 1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( size > 0 )
+	{
+		block_size = size;
+
+		if( block_size > LIBEWF_CHECKSUM_ADLER32_NMAX )
+		{
+			block_size = LIBEWF_CHECKSUM_ADLER32_NMAX;
+		}
+		size -= block_size;
+
+		while( block_size >= 8 )
+		{
+			lower_word += buffer[ 0 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 1 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 2 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 3 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 4 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 5 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 6 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 7 ];
+			upper_word += lower_word;
+
+			buffer     += 8;
+			block_size -= 8;
+		}
+		while( block_size > 0 )
+		{
+			lower_word += *buffer;
+			upper_word += lower_word;
+
+			buffer     += 1;
+			block_size -= 1;
+		}
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+
+/* Calculates the Adler-32 of the buffer using SSSE3 instructions
+ * Returns the checksum
+ */
+__attribute__(( target( "ssse3" ) ))
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m128i ones                  = _mm_set1_epi16( 1 );
+	__m128i zero                  = _mm_setzero_si128();
+	__m128i lower_tap             = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	__m128i upper_tap             = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	__m128i lower_bytes           = zero;
+	__m128i upper_bytes           = zero;
+	__m128i vector_lower_word     = zero;
+	__m128i vector_previous_lower = zero;
+	__m128i vector_upper_word     = zero;
+	size_t number_of_blocks       = 0;
+	size_t block_iterator         = 0;
+	uint32_t lower_word           = 0;
+	uint32_t upper_word           = 0;
+
+	if( buffer == NULL )
+	{
+		return( 1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	number_of_blocks = size / LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+
+	while( number_of_blocks > 0 )
+	{
+		block_iterator = LIBEWF_CHECKSUM_ADLER32_NMAX / LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+
+		if( block_iterator > number_of_blocks )
+		{
+			block_iterator = number_of_blocks;
+		}
+		number_of_blocks -= block_iterator;
+		size             -= block_iterator * LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+
+		/* Every block adds the lower word of the previous blocks
+		 * 32 times to the upper word, this is applied after the loop
+		 */
+		vector_previous_lower = _mm_set_epi32( 0, 0, 0, (int) ( lower_word * block_iterator ) );
+		vector_upper_word     = _mm_set_epi32( 0, 0, 0, (int) upper_word );
+		vector_lower_word     = zero;
+
+		do
+		{
+			upper_bytes = _mm_loadu_si128( (const __m128i *) buffer );
+			lower_bytes = _mm_loadu_si128( (const __m128i *) &( buffer[ 16 ] ) );
+
+			vector_previous_lower = _mm_add_epi32( vector_previous_lower, vector_lower_word );
+
+			vector_lower_word = _mm_add_epi32( vector_lower_word, _mm_sad_epu8( upper_bytes, zero ) );
+			vector_upper_word = _mm_add_epi32( vector_upper_word, _mm_madd_epi16( _mm_maddubs_epi16( upper_bytes, upper_tap ), ones ) );
+
+			vector_lower_word = _mm_add_epi32( vector_lower_word, _mm_sad_epu8( lower_bytes, zero ) );
+			vector_upper_word = _mm_add_epi32( vector_upper_word, _mm_madd_epi16( _mm_maddubs_epi16( lower_bytes, lower_tap ), ones ) );
+
+			buffer += LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+		}
+		while( --block_iterator > 0 );
+
+		vector_upper_word = _mm_add_epi32( vector_upper_word, _mm_slli_epi32( vector_previous_lower, 5 ) );
+
+		vector_lower_word = _mm_add_epi32( vector_lower_word, _mm_shuffle_epi32( vector_lower_word, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		vector_lower_word = _mm_add_epi32( vector_lower_word, _mm_shuffle_epi32( vector_lower_word, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		vector_upper_word = _mm_add_epi32( vector_upper_word, _mm_shuffle_epi32( vector_upper_word, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		vector_upper_word = _mm_add_epi32( vector_upper_word, _mm_shuffle_epi32( vector_upper_word, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( vector_lower_word );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( vector_upper_word );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( libewf_checksum_calculate_adler32_generic(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+/* Calculates the Adler-32 of the buffer using AVX2 instructions
+ * Returns the checksum
+ */
+__attribute__(( target( "avx2" ) ))
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m256i ones                  = _mm256_set1_epi16( 1 );
+	__m256i zero                  = _mm256_setzero_si256();
+	__m256i tap                   = _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	__m256i bytes                 = zero;
+	__m256i vector_lower_word     = zero;
+	__m256i vector_previous_lower = zero;
+	__m256i vector_upper_word     = zero;
+	__m128i sum                   = _mm_setzero_si128();
+	size_t number_of_blocks       = 0;
+	size_t block_iterator         = 0;
+	uint32_t lower_word           = 0;
+	uint32_t upper_word           = 0;
+
+	if( buffer == NULL )
+	{
+		return( 1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	number_of_blocks = size / LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+
+	while( number_of_blocks > 0 )
+	{
+		block_iterator = LIBEWF_CHECKSUM_ADLER32_NMAX / LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+
+		if( block_iterator > number_of_blocks )
+		{
+			block_iterator = number_of_blocks;
+		}
+		number_of_blocks -= block_iterator;
+		size             -= block_iterator * LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+
+		vector_previous_lower = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) ( lower_word * block_iterator ) );
+		vector_upper_word     = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) upper_word );
+		vector_lower_word     = zero;
+
+		do
+		{
+			bytes = _mm256_loadu_si256( (const __m256i *) buffer );
+
+			vector_previous_lower = _mm256_add_epi32( vector_previous_lower, vector_lower_word );
+
+			vector_lower_word = _mm256_add_epi32( vector_lower_word, _mm256_sad_epu8( bytes, zero ) );
+			vector_upper_word = _mm256_add_epi32( vector_upper_word, _mm256_madd_epi16( _mm256_maddubs_epi16( bytes, tap ), ones ) );
+
+			buffer += LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+		}
+		while( --block_iterator > 0 );
+
+		vector_upper_word = _mm256_add_epi32( vector_upper_word, _mm256_slli_epi32( vector_previous_lower, 5 ) );
+
+		sum = _mm_add_epi32( _mm256_castsi256_si128( vector_lower_word ), _mm256_extracti128_si256( vector_lower_word, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum );
+
+		sum = _mm_add_epi32( _mm256_castsi256_si128( vector_upper_word ), _mm256_extracti128_si256( vector_upper_word, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( libewf_checksum_calculate_adler32_generic(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
+
+/* Calculates the Adler-32 of the buffer
+ * The implementation is selected on first use based on the CPU features
+ * Returns the checksum
+ */
+uint32_t libewf_checksum_calculate_adler32(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	libewf_checksum_adler32_function_t adler32_function = libewf_checksum_adler32_function;
+
+	if( adler32_function == NULL )
+	{
+		adler32_function = &libewf_checksum_calculate_adler32_generic;
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+		__builtin_cpu_init();
+
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			adler32_function = &libewf_checksum_calculate_adler32_avx2;
+		}
+		else if( __builtin_cpu_supports( "ssse3" ) )
+		{
+			adler32_function = &libewf_checksum_calculate_adler32_ssse3;
+		}
+#endif
+		/* Every thread selects the same function so a concurrent
+		 * first use does not require locking
+		 */
+		libewf_checksum_adler32_function = adler32_function;
+	}
+	return( adler32_function(
+	         buffer,
+	         size,
+	         initial_value ) );
+}
+
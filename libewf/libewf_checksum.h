@@ -0,0 +1,69 @@
+/*
+ * Checksum functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHECKSUM_H )
+#define _LIBEWF_CHECKSUM_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The SSSE3 and AVX2 implementations require compiler support
+ * for target specific functions and runtime CPU feature detection
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+ && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) )
+#define LIBEWF_CHECKSUM_HAVE_X86_SIMD
+#endif
+
+uint32_t libewf_checksum_calculate_adler32(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_generic(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -40,6 +40,7 @@
  */
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *chunk_data_pool,
      size_t data_size,
      libcerror_error_t **error )
 {
@@ -78,19 +79,39 @@ int libewf_chunk_data_initialize(
 
 		return( -1 );
 	}
-	*chunk_data = memory_allocate_structure(
-	               libewf_chunk_data_t );
+	if( chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_get_value(
+		     chunk_data_pool,
+		     (intptr_t **) chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk data from pool.",
+			 function );
 
-	if( *chunk_data == NULL )
+			goto on_error;
+		}
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create chunk data.",
-		 function );
+		*chunk_data = memory_allocate_structure(
+		               libewf_chunk_data_t );
 
-		goto on_error;
+		if( *chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk data.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( memory_set(
 	     *chunk_data,
@@ -106,10 +127,14 @@ int libewf_chunk_data_initialize(
 
 		goto on_error;
 	}
-	( *chunk_data )->data = (uint8_t *) memory_allocate(
-	                                     sizeof( uint8_t ) * data_size );
+	( *chunk_data )->chunk_data_pool = chunk_data_pool;
 
-	if( ( *chunk_data )->data == NULL )
+	if( libewf_chunk_data_get_buffer(
+	     *chunk_data,
+	     data_size,
+	     &( ( *chunk_data )->data ),
+	     &( ( *chunk_data )->allocated_data_size ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -120,29 +145,39 @@ int libewf_chunk_data_initialize(
 
 		goto on_error;
 	}
-	( *chunk_data )->allocated_data_size = data_size;
-
 	return( 1 );
 
 on_error:
 	if( *chunk_data != NULL )
 	{
-		memory_free(
-		 *chunk_data );
-
+		if( chunk_data_pool != NULL )
+		{
+			libewf_chunk_data_pool_release_value(
+			 chunk_data_pool,
+			 (intptr_t **) chunk_data,
+			 NULL );
+		}
+		else
+		{
+			memory_free(
+			 *chunk_data );
+		}
 		*chunk_data = NULL;
 	}
 	return( -1 );
 }
 
 /* Frees the chunk data including elements
+ * The data buffers and the chunk data are returned to the chunk data pool if set
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_data_free";
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	static char *function                     = "libewf_chunk_data_free";
+	int result                                = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -157,71 +192,303 @@ int libewf_chunk_data_free(
 	}
 	if( *chunk_data != NULL )
 	{
-		if( ( *chunk_data )->data != NULL )
+		if( libewf_chunk_data_release_buffer(
+		     *chunk_data,
+		     &( ( *chunk_data )->data ),
+		     ( *chunk_data )->allocated_data_size,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *chunk_data )->data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release data.",
+			 function );
+
+			result = -1;
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		if( libewf_chunk_data_release_buffer(
+		     *chunk_data,
+		     &( ( *chunk_data )->compressed_data ),
+		     ( *chunk_data )->allocated_compressed_data_size,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release compressed data.",
+			 function );
+
+			result = -1;
 		}
-		memory_free(
-		 *chunk_data );
+		chunk_data_pool = ( *chunk_data )->chunk_data_pool;
 
+		if( chunk_data_pool != NULL )
+		{
+			if( libewf_chunk_data_pool_release_value(
+			     chunk_data_pool,
+			     (intptr_t **) chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release chunk data to pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else
+		{
+			memory_free(
+			 *chunk_data );
+		}
 		*chunk_data = NULL;
 	}
+	return( result );
+}
+
+/* Retrieves a buffer of at least the requested size
+ * The buffer is taken from the chunk data pool if set, otherwise it is allocated
+ * The buffer size is set to the allocated size of the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_get_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_get_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_get_buffer(
+		     chunk_data->chunk_data_pool,
+		     size,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve buffer from chunk data pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer = (uint8_t *) memory_allocate(
+	                       sizeof( uint8_t ) * size );
+
+	if( *buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer_size = size;
+
 	return( 1 );
 }
 
-/* Packs the chunk data
- * This function either adds the checksum or compresses the chunk data
+/* Releases a buffer
+ * The buffer is returned to the chunk data pool if set, otherwise it is freed
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_data_pack(
+int libewf_chunk_data_release_buffer(
      libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_release_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_release_buffer(
+		     chunk_data->chunk_data_pool,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffer to chunk data pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer != NULL )
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Determines the compression level of the data of a chunk
+ * Empty blocks are compressed if empty block compression is set and blocks that only
+ * contain 0-byte values are flagged so the compressed zero byte empty block can be used
+ * With adaptive compression data that is estimated to be incompressible is not compressed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_determine_compression_level(
+     const uint8_t *data,
+     size_t data_size,
      int8_t compression_level,
      uint8_t compression_flags,
      uint8_t ewf_format,
-     size32_t chunk_size,
-     const uint8_t *compressed_zero_byte_empty_block,
-     size_t compressed_zero_byte_empty_block_size,
+     int8_t *chunk_compression_level,
+     uint8_t *is_empty_zero_block,
+     uint8_t *is_compression_skipped,
      libcerror_error_t **error )
 {
-	static char *function        = "libewf_chunk_data_pack";
-	void *reallocation           = NULL;
-	uint32_t calculated_checksum = 0;
-	int is_empty_zero_block      = 0;
-	int result                   = 0;
+	static char *function = "libewf_chunk_data_determine_compression_level";
+	int is_empty_block    = 0;
+	int result            = 0;
 
-	if( chunk_data == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data->data == NULL )
+	if( data_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid chunk data - missing data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid data size value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data->is_packed != 0 )
+	if( chunk_compression_level == NULL )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk compression level.",
+		 function );
+
+		return( -1 );
 	}
-	chunk_data->is_compressed = 0;
+	if( is_empty_zero_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is empty zero block.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_compression_skipped == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is compression skipped.",
+		 function );
+
+		return( -1 );
+	}
+	*is_empty_zero_block    = 0;
+	*is_compression_skipped = 0;
 
 	/* Skip the empty block check only if the compression is none and
 	 * the empty block compression flag is not set.
@@ -231,13 +498,13 @@ int libewf_chunk_data_pack(
 	{
 #if defined( TEST_EMPTY_BLOCK_MEMCMP )
 		if( memory_compare(
-		     chunk_data->data,
-		     &( chunk_data->data[ 1 ] )
-		     chunk_data->data_size - 1 ) == 0 )
+		     data,
+		     &( data[ 1 ] ),
+		     data_size - 1 ) == 0 )
 #else
 		result = libewf_empty_block_test(
-			  chunk_data->data,
-			  chunk_data->data_size,
+			  data,
+			  data_size,
 			  error );
 
 		if( result == -1 )
@@ -246,7 +513,7 @@ int libewf_chunk_data_pack(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if chunk data is empty an empty block.",
+			 "%s: unable to determine if data is an empty block.",
 			 function );
 
 			return( -1 );
@@ -254,9 +521,11 @@ int libewf_chunk_data_pack(
 		else if( result == 1 )
 #endif
 		{
-			if( ( chunk_data->data )[ 0 ] == 0 )
+			is_empty_block = 1;
+
+			if( data[ 0 ] == 0 )
 			{
-				is_empty_zero_block = 1;
+				*is_empty_zero_block = 1;
 			}
 			else if( compression_level == EWF_COMPRESSION_NONE )
 			{
@@ -264,26 +533,156 @@ int libewf_chunk_data_pack(
 			}
 		}
 	}
-	if( ( ewf_format == EWF_FORMAT_S01 )
-	 || ( compression_level != EWF_COMPRESSION_NONE )
-	 || ( is_empty_zero_block != 0 ) )
+	/* Empty blocks are always compressible
+	 */
+	if( ( ewf_format != EWF_FORMAT_S01 )
+	 && ( compression_level != EWF_COMPRESSION_NONE )
+	 && ( is_empty_block == 0 )
+	 && ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 ) )
 	{
-		chunk_data->compressed_data_size = 2 * chunk_data->data_size;
-
-		chunk_data->compressed_data = (uint8_t *) memory_allocate(
-		                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
+		result = libewf_compression_test_compressible(
+			  data,
+			  data_size,
+			  error );
 
-		if( chunk_data->compressed_data == NULL )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create compressed data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if data is compressible.",
 			 function );
 
 			return( -1 );
 		}
+		else if( result == 0 )
+		{
+			compression_level       = EWF_COMPRESSION_NONE;
+			*is_compression_skipped = 1;
+		}
+	}
+	*chunk_compression_level = compression_level;
+
+	return( 1 );
+}
+
+/* Packs the chunk data
+ * This function either adds the checksum or compresses the chunk data
+ * The zlib compression level overrides the level determined by the compression level, 0 if not set
+ * The zlib strategy, window bits and memory level are passed to zlib deflate, 0 represents the default
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pack(
+     libewf_chunk_data_t *chunk_data,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     uint8_t ewf_format,
+     size32_t chunk_size,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_chunk_data_pack";
+	uint32_t calculated_checksum = 0;
+	uint8_t is_empty_zero_block  = 0;
+	int result                   = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->is_packed != 0 )
+	{
+		return( 1 );
+	}
+	chunk_data->is_compressed = 0;
+
+	if( libewf_chunk_data_determine_compression_level(
+	     chunk_data->data,
+	     chunk_data->data_size,
+	     compression_level,
+	     compression_flags,
+	     ewf_format,
+	     &compression_level,
+	     &is_empty_zero_block,
+	     &( chunk_data->is_compression_skipped ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ewf_format == EWF_FORMAT_S01 )
+	 || ( compression_level != EWF_COMPRESSION_NONE )
+	 || ( is_empty_zero_block != 0 ) )
+	{
+		if( chunk_data->compressed_data == NULL )
+		{
+			if( libewf_chunk_data_get_buffer(
+			     chunk_data,
+			     2 * chunk_data->data_size,
+			     &( chunk_data->compressed_data ),
+			     &( chunk_data->allocated_compressed_data_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create compressed data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( zlib_compression_level == 0 )
+		 || ( compression_level == EWF_COMPRESSION_NONE ) )
+		{
+			if( libewf_compression_get_zlib_compression_level(
+			     compression_level,
+			     &zlib_compression_level,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine zlib compression level.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		chunk_data->compressed_data_size = chunk_data->allocated_compressed_data_size;
+
 		if( ( is_empty_zero_block != 0 )
 		 && ( chunk_data->data_size == (size_t) chunk_size )
 		 && ( compressed_zero_byte_empty_block != NULL ) )
@@ -306,12 +705,15 @@ int libewf_chunk_data_pack(
 		}
 		else
 		{
-			result = libewf_compress(
+			result = libewf_compress_with_zlib_values(
 				  chunk_data->compressed_data,
 				  &( chunk_data->compressed_data_size ),
 				  chunk_data->data,
 				  chunk_data->data_size,
-				  compression_level,
+				  zlib_compression_level,
+				  zlib_strategy,
+				  zlib_window_bits,
+				  zlib_memory_level,
 				  error );
 
 			/* Check if the compressed buffer was too small
@@ -323,11 +725,29 @@ int libewf_chunk_data_pack(
 				libcerror_error_free(
 				 error );
 
-				reallocation = memory_reallocate(
-						chunk_data->compressed_data,
-						sizeof( uint8_t ) * chunk_data->compressed_data_size );
+				if( libewf_chunk_data_release_buffer(
+				     chunk_data,
+				     &( chunk_data->compressed_data ),
+				     chunk_data->allocated_compressed_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to release compressed data.",
+					 function );
 
-				if( reallocation == NULL )
+					return( -1 );
+				}
+				chunk_data->allocated_compressed_data_size = 0;
+
+				if( libewf_chunk_data_get_buffer(
+				     chunk_data,
+				     chunk_data->compressed_data_size,
+				     &( chunk_data->compressed_data ),
+				     &( chunk_data->allocated_compressed_data_size ),
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -338,14 +758,15 @@ int libewf_chunk_data_pack(
 
 					return( -1 );
 				}
-				chunk_data->compressed_data = (uint8_t *) reallocation;
-
-				result = libewf_compress(
+				result = libewf_compress_with_zlib_values(
 					  chunk_data->compressed_data,
 					  &( chunk_data->compressed_data_size ),
 					  chunk_data->data,
 					  chunk_data->data_size,
-					  compression_level,
+					  zlib_compression_level,
+					  zlib_strategy,
+					  zlib_window_bits,
+					  zlib_memory_level,
 					  error );
 			}
 			if( result != 1 )
@@ -363,14 +784,28 @@ int libewf_chunk_data_pack(
 	 	if( ( ewf_format == EWF_FORMAT_S01 )
 		 || ( chunk_data->compressed_data_size < chunk_data->data_size ) )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( libewf_chunk_data_release_buffer(
+			     chunk_data,
+			     &( chunk_data->data ),
+			     chunk_data->allocated_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release data.",
+				 function );
 
-			chunk_data->data      = chunk_data->compressed_data;
-			chunk_data->data_size = chunk_data->compressed_data_size;
+				return( -1 );
+			}
+			chunk_data->data                = chunk_data->compressed_data;
+			chunk_data->data_size           = chunk_data->compressed_data_size;
+			chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
 
-			chunk_data->compressed_data      = NULL;
-			chunk_data->compressed_data_size = 0;
+			chunk_data->compressed_data                = NULL;
+			chunk_data->compressed_data_size           = 0;
+			chunk_data->allocated_compressed_data_size = 0;
 
 			chunk_data->is_compressed = 1;
 		}
@@ -509,17 +944,21 @@ int libewf_chunk_data_unpack(
 
 			return( -1 );
 		}
-		chunk_data->compressed_data      = chunk_data->data;
-		chunk_data->compressed_data_size = chunk_data->data_size;
+		chunk_data->compressed_data                = chunk_data->data;
+		chunk_data->compressed_data_size           = chunk_data->data_size;
+		chunk_data->allocated_compressed_data_size = chunk_data->allocated_data_size;
+
+		chunk_data->data                = NULL;
+		chunk_data->allocated_data_size = 0;
 
 		/* Reserve 4 bytes for the checksum
 		 */
-		chunk_data->allocated_data_size = chunk_size + sizeof( uint32_t );
-
-		chunk_data->data = (uint8_t *) memory_allocate(
-		                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
-
-		if( chunk_data->data == NULL )
+		if( libewf_chunk_data_get_buffer(
+		     chunk_data,
+		     chunk_size + sizeof( uint32_t ),
+		     &( chunk_data->data ),
+		     &( chunk_data->allocated_data_size ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -568,3 +1007,105 @@ int libewf_chunk_data_unpack(
 	return( 1 );
 }
 
+/* Unpacks chunk data that is known to contain a compressed zero byte empty block
+ * This function sets the chunk data to 0-byte values instead of decompressing the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_unpack_zero_byte_empty_block(
+     libewf_chunk_data_t *chunk_data,
+     size_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_unpack_zero_byte_empty_block";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->is_packed == 0 )
+	 || ( chunk_data->is_compressed == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid chunk data - unsupported chunk data is not packed and compressed.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->compressed_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data - compressed data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->compressed_data                = chunk_data->data;
+	chunk_data->compressed_data_size           = chunk_data->data_size;
+	chunk_data->allocated_compressed_data_size = chunk_data->allocated_data_size;
+
+	chunk_data->data                = NULL;
+	chunk_data->allocated_data_size = 0;
+
+	/* Reserve 4 bytes for the checksum
+	 */
+	if( libewf_chunk_data_get_buffer(
+	     chunk_data,
+	     chunk_size + sizeof( uint32_t ),
+	     &( chunk_data->data ),
+	     &( chunk_data->allocated_data_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     chunk_data->data,
+	     0,
+	     chunk_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->data_size = chunk_size;
+	chunk_data->is_packed = 0;
+
+	return( 1 );
+}
+
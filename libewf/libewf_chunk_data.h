@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -35,6 +36,10 @@ typedef struct libewf_chunk_data libewf_chunk_data_t;
 
 struct libewf_chunk_data
 {
+	/* The chunk data pool
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
 	/* The allocated data size
 	 */
 	size_t allocated_data_size;
@@ -51,6 +56,10 @@ struct libewf_chunk_data
 	 */
 	uint8_t *compressed_data;
 
+	/* The allocated compressed data size
+	 */
+	size_t allocated_compressed_data_size;
+
 	/* The compressed data size
 	 */
 	size_t compressed_data_size;
@@ -59,6 +68,11 @@ struct libewf_chunk_data
 	 */
 	uint8_t is_compressed;
 
+	/* Value to indicate the compression of the chunk was skipped
+	 * since adaptive compression estimated the chunk to be incompressible
+	 */
+	uint8_t is_compression_skipped;
+
 	/* Value to indicate the chunk is packed
 	 */
 	uint8_t is_packed;
@@ -70,6 +84,7 @@ struct libewf_chunk_data
 
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *chunk_data_pool,
      size_t data_size,
      libcerror_error_t **error );
 
@@ -77,10 +92,38 @@ int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_get_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_release_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_determine_compression_level(
+     const uint8_t *data,
+     size_t data_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint8_t ewf_format,
+     int8_t *chunk_compression_level,
+     uint8_t *is_empty_zero_block,
+     uint8_t *is_compression_skipped,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      int8_t compression_level,
      uint8_t compression_flags,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
      uint8_t ewf_format,
      size32_t chunk_size,
      const uint8_t *compressed_zero_byte_empty_block,
@@ -92,6 +135,11 @@ int libewf_chunk_data_unpack(
      size_t chunk_size,
      libcerror_error_t **error );
 
+int libewf_chunk_data_unpack_zero_byte_empty_block(
+     libewf_chunk_data_t *chunk_data,
+     size_t chunk_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
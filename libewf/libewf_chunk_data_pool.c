@@ -0,0 +1,627 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates a chunk data pool
+ * The value size is the size of the values (chunk data structures) kept by the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     size_t value_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_initialize";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_size == 0 )
+	 || ( value_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid value size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_data_pool = memory_allocate_structure(
+	                    libewf_chunk_data_pool_t );
+
+	if( *chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_data_pool,
+	     0,
+	     sizeof( libewf_chunk_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_data_pool )->value_size = value_size;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_data_pool != NULL )
+	{
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk data pool including the free buffers and values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_free";
+	int result            = 1;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_empty(
+		     *chunk_data_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk data pool.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+	}
+	return( result );
+}
+
+/* Empties a chunk data pool
+ * This function frees the free buffers and values but retains the statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_empty(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_empty";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk_data_pool->number_of_data_buffers > 0 )
+	{
+		chunk_data_pool->number_of_data_buffers -= 1;
+
+		memory_free(
+		 chunk_data_pool->data_buffers[ chunk_data_pool->number_of_data_buffers ] );
+
+		chunk_data_pool->data_buffers[ chunk_data_pool->number_of_data_buffers ] = NULL;
+
+		chunk_data_pool->number_of_frees += 1;
+	}
+	while( chunk_data_pool->number_of_compressed_data_buffers > 0 )
+	{
+		chunk_data_pool->number_of_compressed_data_buffers -= 1;
+
+		memory_free(
+		 chunk_data_pool->compressed_data_buffers[ chunk_data_pool->number_of_compressed_data_buffers ] );
+
+		chunk_data_pool->compressed_data_buffers[ chunk_data_pool->number_of_compressed_data_buffers ] = NULL;
+
+		chunk_data_pool->number_of_frees += 1;
+	}
+	while( chunk_data_pool->number_of_values > 0 )
+	{
+		chunk_data_pool->number_of_values -= 1;
+
+		memory_free(
+		 chunk_data_pool->values[ chunk_data_pool->number_of_values ] );
+
+		chunk_data_pool->values[ chunk_data_pool->number_of_values ] = NULL;
+
+		chunk_data_pool->number_of_frees += 1;
+	}
+	return( 1 );
+}
+
+/* Sets the chunk size
+ * The data buffers are sized to hold a chunk and its checksum and
+ * the compressed data buffers to hold the compressed data of a chunk
+ * Free buffers of a previous chunk size are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_set_chunk_size(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_set_chunk_size";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size > (size32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == chunk_data_pool->chunk_size )
+	{
+		return( 1 );
+	}
+	while( chunk_data_pool->number_of_data_buffers > 0 )
+	{
+		chunk_data_pool->number_of_data_buffers -= 1;
+
+		memory_free(
+		 chunk_data_pool->data_buffers[ chunk_data_pool->number_of_data_buffers ] );
+
+		chunk_data_pool->data_buffers[ chunk_data_pool->number_of_data_buffers ] = NULL;
+
+		chunk_data_pool->number_of_frees += 1;
+	}
+	while( chunk_data_pool->number_of_compressed_data_buffers > 0 )
+	{
+		chunk_data_pool->number_of_compressed_data_buffers -= 1;
+
+		memory_free(
+		 chunk_data_pool->compressed_data_buffers[ chunk_data_pool->number_of_compressed_data_buffers ] );
+
+		chunk_data_pool->compressed_data_buffers[ chunk_data_pool->number_of_compressed_data_buffers ] = NULL;
+
+		chunk_data_pool->number_of_frees += 1;
+	}
+	chunk_data_pool->chunk_size = chunk_size;
+
+	if( chunk_size == 0 )
+	{
+		chunk_data_pool->data_buffer_size            = 0;
+		chunk_data_pool->compressed_data_buffer_size = 0;
+	}
+	else
+	{
+		/* Reserve 4 bytes for the chunk checksum
+		 */
+		chunk_data_pool->data_buffer_size = (size_t) chunk_size + sizeof( uint32_t );
+
+		/* The chunk data pack function allocates twice the chunk data size for the compressed data
+		 */
+		chunk_data_pool->compressed_data_buffer_size = 2 * (size_t) chunk_size;
+	}
+	return( 1 );
+}
+
+/* Retrieves a buffer of at least the requested size
+ * The buffer size is set to the allocated size of the buffer, which is needed to release the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_get_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t **free_buffers   = NULL;
+	static char *function    = "libewf_chunk_data_pool_get_buffer";
+	size_t allocation_size   = 0;
+	int *number_of_buffers   = NULL;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_pool->chunk_size == 0 )
+	{
+		allocation_size = size;
+	}
+	else if( size <= chunk_data_pool->data_buffer_size )
+	{
+		free_buffers      = chunk_data_pool->data_buffers;
+		number_of_buffers = &( chunk_data_pool->number_of_data_buffers );
+		allocation_size   = chunk_data_pool->data_buffer_size;
+	}
+	else if( size <= chunk_data_pool->compressed_data_buffer_size )
+	{
+		free_buffers      = chunk_data_pool->compressed_data_buffers;
+		number_of_buffers = &( chunk_data_pool->number_of_compressed_data_buffers );
+		allocation_size   = chunk_data_pool->compressed_data_buffer_size;
+	}
+	else
+	{
+		allocation_size = size;
+	}
+	if( ( number_of_buffers != NULL )
+	 && ( *number_of_buffers > 0 ) )
+	{
+		*number_of_buffers -= 1;
+
+		*buffer = free_buffers[ *number_of_buffers ];
+
+		free_buffers[ *number_of_buffers ] = NULL;
+
+		chunk_data_pool->number_of_reuses += 1;
+	}
+	else
+	{
+		*buffer = (uint8_t *) memory_allocate(
+		                       sizeof( uint8_t ) * allocation_size );
+
+		if( *buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_data_pool->number_of_allocations += 1;
+	}
+	*buffer_size = allocation_size;
+
+	return( 1 );
+}
+
+/* Releases a buffer
+ * The buffer is kept for reuse if its size matches that of the data or compressed data buffers
+ * and the pool is not full, otherwise it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_release_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t **free_buffers = NULL;
+	static char *function  = "libewf_chunk_data_pool_release_buffer";
+	int *number_of_buffers = NULL;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( chunk_data_pool->chunk_size != 0 )
+	{
+		if( buffer_size == chunk_data_pool->data_buffer_size )
+		{
+			free_buffers      = chunk_data_pool->data_buffers;
+			number_of_buffers = &( chunk_data_pool->number_of_data_buffers );
+		}
+		else if( buffer_size == chunk_data_pool->compressed_data_buffer_size )
+		{
+			free_buffers      = chunk_data_pool->compressed_data_buffers;
+			number_of_buffers = &( chunk_data_pool->number_of_compressed_data_buffers );
+		}
+	}
+	if( ( number_of_buffers != NULL )
+	 && ( *number_of_buffers < LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_ENTRIES ) )
+	{
+		free_buffers[ *number_of_buffers ] = *buffer;
+
+		*number_of_buffers += 1;
+	}
+	else
+	{
+		memory_free(
+		 *buffer );
+
+		chunk_data_pool->number_of_frees += 1;
+	}
+	*buffer = NULL;
+
+	return( 1 );
+}
+
+/* Retrieves a value (chunk data structure)
+ * The value is not cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_get_value(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_get_value";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_pool->number_of_values > 0 )
+	{
+		chunk_data_pool->number_of_values -= 1;
+
+		*value = chunk_data_pool->values[ chunk_data_pool->number_of_values ];
+
+		chunk_data_pool->values[ chunk_data_pool->number_of_values ] = NULL;
+
+		chunk_data_pool->number_of_reuses += 1;
+	}
+	else
+	{
+		*value = (intptr_t *) memory_allocate(
+		                       chunk_data_pool->value_size );
+
+		if( *value == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create value.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_data_pool->number_of_allocations += 1;
+	}
+	return( 1 );
+}
+
+/* Releases a value (chunk data structure)
+ * The value is kept for reuse if the pool is not full, otherwise it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_release_value(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_release_value";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value == NULL )
+	{
+		return( 1 );
+	}
+	if( chunk_data_pool->number_of_values < LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_ENTRIES )
+	{
+		chunk_data_pool->values[ chunk_data_pool->number_of_values ] = *value;
+
+		chunk_data_pool->number_of_values += 1;
+	}
+	else
+	{
+		memory_free(
+		 *value );
+
+		chunk_data_pool->number_of_frees += 1;
+	}
+	*value = NULL;
+
+	return( 1 );
+}
+
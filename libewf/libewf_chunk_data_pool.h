@@ -0,0 +1,138 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_DATA_POOL_H )
+#define _LIBEWF_CHUNK_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_data_pool libewf_chunk_data_pool_t;
+
+struct libewf_chunk_data_pool
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The size of the data buffers
+	 */
+	size_t data_buffer_size;
+
+	/* The free data buffers
+	 */
+	uint8_t *data_buffers[ LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_ENTRIES ];
+
+	/* The number of free data buffers
+	 */
+	int number_of_data_buffers;
+
+	/* The size of the compressed data buffers
+	 */
+	size_t compressed_data_buffer_size;
+
+	/* The free compressed data buffers
+	 */
+	uint8_t *compressed_data_buffers[ LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_ENTRIES ];
+
+	/* The number of free compressed data buffers
+	 */
+	int number_of_compressed_data_buffers;
+
+	/* The size of the values
+	 */
+	size_t value_size;
+
+	/* The free values
+	 */
+	intptr_t *values[ LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_ENTRIES ];
+
+	/* The number of free values
+	 */
+	int number_of_values;
+
+	/* The number of buffers and values allocated from the heap
+	 */
+	uint64_t number_of_allocations;
+
+	/* The number of buffers and values reused from the pool
+	 */
+	uint64_t number_of_reuses;
+
+	/* The number of buffers and values freed to the heap
+	 */
+	uint64_t number_of_frees;
+};
+
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     size_t value_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_empty(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_set_chunk_size(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_get_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_release_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_get_value(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_release_value(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -35,6 +35,8 @@
 #include "libewf_libfcache.h"
 #include "libewf_libmfdata.h"
 #include "libewf_section.h"
+#include "libewf_statistics.h"
+#include "libewf_trace.h"
 #include "libewf_unused.h"
 
 #include "ewf_checksum.h"
@@ -42,11 +44,15 @@
 #include "ewf_table.h"
 
 /* Initialize the chunk table
+ * The chunk data pool is optional and is used to allocate the chunk data
+ * The statistics are optional and are updated when chunks are read
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_table_initialize(
      libewf_chunk_table_t **chunk_table,
      libewf_io_handle_t *io_handle,
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libewf_statistics_t *statistics,
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_table_initialize";
@@ -112,7 +118,9 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
-	( *chunk_table )->io_handle = io_handle;
+	( *chunk_table )->io_handle       = io_handle;
+	( *chunk_table )->chunk_data_pool = chunk_data_pool;
+	( *chunk_table )->statistics      = statistics;
 
 	return( 1 );
 
@@ -223,6 +231,11 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
+	/* The chunk data pool and statistics belong to the source handle and are not shared
+	 */
+	( (libewf_chunk_table_t *) *destination_chunk_table )->chunk_data_pool = NULL;
+	( (libewf_chunk_table_t *) *destination_chunk_table )->statistics      = NULL;
+
 	return( 1 );
 
 on_error:
@@ -252,13 +265,16 @@ int libewf_chunk_table_read_chunk(
      uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_chunk_table_read_chunk";
-	ssize_t read_count              = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	int element_index               = 0;
-#endif
+	libewf_chunk_data_t *chunk_data   = NULL;
+	libewf_chunk_table_t *chunk_table = NULL;
+	libewf_trace_t *trace             = NULL;
+	static char *function             = "libewf_chunk_table_read_chunk";
+	ssize_t read_count                = 0;
+	uint64_t end_time                 = 0;
+	uint64_t seek_time                = 0;
+	uint64_t start_time               = 0;
+	uint8_t seek_stage                = 0;
+	int element_index                 = 0;
 
 	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
 
@@ -273,6 +289,8 @@ int libewf_chunk_table_read_chunk(
 
 		return( -1 );
 	}
+	chunk_table = (libewf_chunk_table_t *) io_handle;
+
 	if( element_data_size > (size64_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
@@ -334,6 +352,46 @@ int libewf_chunk_table_read_chunk(
 		}
 	}
 #endif
+	if( chunk_table->statistics != NULL )
+	{
+		trace = chunk_table->statistics->trace;
+	}
+	if( trace != NULL )
+	{
+		if( libmfdata_list_element_get_element_index(
+		     list_element,
+		     &element_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element index from list element.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_trace_get_seek_stage(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &seek_stage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine seek stage.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( chunk_table->statistics != NULL )
+	{
+		start_time = libewf_statistics_get_time();
+	}
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -352,8 +410,32 @@ int libewf_chunk_table_read_chunk(
 
 		goto on_error;
 	}
+	if( trace != NULL )
+	{
+		seek_time = libewf_statistics_get_time();
+
+		if( libewf_trace_append_event(
+		     trace,
+		     seek_stage,
+		     (uint64_t) element_index,
+		     file_io_pool_entry,
+		     start_time,
+		     seek_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append seek event to trace.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_chunk_data_initialize(
 	     &chunk_data,
+	     chunk_table->chunk_data_pool,
 	     (size_t) element_data_size,
 	     error ) != 1 )
 	{
@@ -395,6 +477,35 @@ int libewf_chunk_table_read_chunk(
 
 		goto on_error;
 	}
+	if( chunk_table->statistics != NULL )
+	{
+		end_time = libewf_statistics_get_time();
+
+		chunk_table->statistics->number_of_chunks_read += 1;
+		chunk_table->statistics->number_of_bytes_read  += (uint64_t) read_count;
+		chunk_table->statistics->read_time             += end_time - start_time;
+	}
+	if( trace != NULL )
+	{
+		if( libewf_trace_append_event(
+		     trace,
+		     LIBEWF_TRACE_STAGE_READ,
+		     (uint64_t) element_index,
+		     file_io_pool_entry,
+		     seek_time,
+		     end_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append read event to trace.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	chunk_data->data_size = (size_t) read_count;
 
 	if( ( element_data_flags & LIBMFDATA_RANGE_FLAG_IS_COMPRESSED ) != 0 )
@@ -2179,3 +2290,99 @@ int libewf_chunk_table_fill_offsets(
 	return( 1 );
 }
 
+/* Retrieves the data range of a specific chunk
+ * This function will expand element groups
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_range(
+     libmfdata_list_t *chunk_table_list,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_table_cache,
+     int chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_offset,
+     size64_t *chunk_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
+{
+	libmfdata_list_element_t *list_element = NULL;
+	static char *function                  = "libewf_chunk_table_get_chunk_data_range";
+	int result                             = 0;
+
+	result = libmfdata_list_is_group(
+	          chunk_table_list,
+	          chunk_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk: %d is a group.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libmfdata_list_get_element_by_index(
+		     chunk_table_list,
+		     chunk_index,
+		     &list_element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve list element: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( libmfdata_list_expand_group(
+		     chunk_table_list,
+		     file_io_pool,
+		     chunk_table_cache,
+		     list_element,
+		     chunk_index,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to expand group of chunk: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( libmfdata_list_get_data_range_by_index(
+	     chunk_table_list,
+	     chunk_index,
+	     file_io_pool_entry,
+	     chunk_offset,
+	     chunk_size,
+	     chunk_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range of chunk: %d.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -27,11 +27,13 @@
 
 #include "libewf_libcerror.h"
 
+#include "libewf_chunk_data_pool.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libfcache.h"
 #include "libewf_libmfdata.h"
 #include "libewf_section.h"
+#include "libewf_statistics.h"
 
 #include "ewf_table.h"
 
@@ -47,6 +49,14 @@ struct libewf_chunk_table
 	 */
 	libewf_io_handle_t *io_handle;
 
+	/* The chunk data pool, which is not managed by the chunk table
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
+	/* The statistics, which are not managed by the chunk table
+	 */
+	libewf_statistics_t *statistics;
+
 	/* The chunk size
 	 */
 	uint32_t chunk_size;
@@ -67,6 +77,8 @@ struct libewf_chunk_table
 int libewf_chunk_table_initialize(
      libewf_chunk_table_t **chunk_table,
      libewf_io_handle_t *io_handle,
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libewf_statistics_t *statistics,
      libcerror_error_t **error );
 
 int libewf_chunk_table_free(
@@ -136,6 +148,17 @@ int libewf_chunk_table_fill_offsets(
      uint32_t number_of_offsets,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_data_range(
+     libmfdata_list_t *chunk_table_list,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_table_cache,
+     int chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_offset,
+     size64_t *chunk_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
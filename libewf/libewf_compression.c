@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
 #include "libewf_libcerror.h"
@@ -33,11 +34,390 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
 #include "libewf_compression.h"
+#include "libewf_definitions.h"
 
 #include "ewf_definitions.h"
 
-/* Compresses data, wraps zlib uncompress function
+/* The compression backend used to compress and decompress data
+ */
+static int libewf_compression_backend = LIBEWF_COMPRESSION_BACKEND_DEFAULT;
+
+#if defined( HAVE_LIBDEFLATE )
+
+/* The libdeflate decompressor and the compressors are cached between calls
+ * since allocating them is relatively expensive. The decompressor is stored
+ * at index 0 and a compressor at the index of its compression level (1 - 12).
+ * A thread takes the cached object and puts it back when done, if another
+ * thread is using the cached object a new object is allocated instead.
+ */
+#define LIBEWF_COMPRESSION_LIBDEFLATE_DECOMPRESSOR		0
+#define LIBEWF_COMPRESSION_LIBDEFLATE_MAXIMUM_LEVEL		12
+
+static void *libewf_compression_libdeflate_cache[ LIBEWF_COMPRESSION_LIBDEFLATE_MAXIMUM_LEVEL + 1 ] = { NULL };
+
+/* Takes an object from the libdeflate cache
+ * Returns the object or NULL if not available
+ */
+void *libewf_compression_libdeflate_cache_take(
+       int cache_index )
+{
+#if defined( __GNUC__ )
+	return( __sync_lock_test_and_set(
+	         &( libewf_compression_libdeflate_cache[ cache_index ] ),
+	         NULL ) );
+#else
+	return( NULL );
+#endif
+}
+
+/* Puts an object back into the libdeflate cache
+ * Returns 1 if the object was cached or 0 if the caller needs to free it
+ */
+int libewf_compression_libdeflate_cache_put(
+     int cache_index,
+     void *object )
+{
+#if defined( __GNUC__ )
+	if( __sync_bool_compare_and_swap(
+	     &( libewf_compression_libdeflate_cache[ cache_index ] ),
+	     NULL,
+	     object ) )
+	{
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
+#if defined( __GNUC__ )
+void libewf_compression_libdeflate_cache_free(
+      void ) __attribute__ ((destructor));
+#endif
+
+/* Frees the objects in the libdeflate cache
+ * This function is called when the library is unloaded
+ */
+void libewf_compression_libdeflate_cache_free(
+      void )
+{
+	void *object    = NULL;
+	int cache_index = 0;
+
+	object = libewf_compression_libdeflate_cache_take(
+	          LIBEWF_COMPRESSION_LIBDEFLATE_DECOMPRESSOR );
+
+	if( object != NULL )
+	{
+		libdeflate_free_decompressor(
+		 (struct libdeflate_decompressor *) object );
+	}
+	for( cache_index = 1;
+	     cache_index <= LIBEWF_COMPRESSION_LIBDEFLATE_MAXIMUM_LEVEL;
+	     cache_index++ )
+	{
+		object = libewf_compression_libdeflate_cache_take(
+		          cache_index );
+
+		if( object != NULL )
+		{
+			libdeflate_free_compressor(
+			 (struct libdeflate_compressor *) object );
+		}
+	}
+}
+
+/* Compresses data using libdeflate
+ * The compression level is a zlib compatible compression level
+ * Returns 1 on success, 0 if the compressed data does not fit in the buffer or -1 on error
+ */
+int libewf_compress_libdeflate(
+     uint8_t *compressed_data,
+     size_t *compressed_size,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_size,
+     int compression_level,
+     libcerror_error_t **error )
+{
+	struct libdeflate_compressor *compressor = NULL;
+	static char *function                    = "libewf_compress_libdeflate";
+	size_t safe_compressed_size              = 0;
+
+	if( ( compression_level < 1 )
+	 || ( compression_level > LIBEWF_COMPRESSION_LIBDEFLATE_MAXIMUM_LEVEL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		*compressed_size = 0;
+
+		return( -1 );
+	}
+	compressor = (struct libdeflate_compressor *) libewf_compression_libdeflate_cache_take(
+	                                               compression_level );
+
+	if( compressor == NULL )
+	{
+		compressor = libdeflate_alloc_compressor(
+		              compression_level );
+
+		if( compressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressor.",
+			 function );
+
+			*compressed_size = 0;
+
+			return( -1 );
+		}
+	}
+	safe_compressed_size = libdeflate_zlib_compress(
+	                        compressor,
+	                        uncompressed_data,
+	                        uncompressed_size,
+	                        compressed_data,
+	                        *compressed_size );
+
+	if( libewf_compression_libdeflate_cache_put(
+	     compression_level,
+	     compressor ) == 0 )
+	{
+		libdeflate_free_compressor(
+		 compressor );
+	}
+	if( safe_compressed_size == 0 )
+	{
+		return( 0 );
+	}
+	*compressed_size = safe_compressed_size;
+
+	return( 1 );
+}
+
+/* Decompresses data using libdeflate
+ * Returns 1 on success, 0 on failure or -1 on error
+ */
+int libewf_decompress_libdeflate(
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_size,
+     const uint8_t *compressed_data,
+     size_t compressed_size,
+     libcerror_error_t **error )
+{
+	struct libdeflate_decompressor *decompressor = NULL;
+	static char *function                        = "libewf_decompress_libdeflate";
+	size_t safe_compressed_size                  = 0;
+	size_t safe_uncompressed_size                = 0;
+	enum libdeflate_result result                = LIBDEFLATE_SUCCESS;
+
+	decompressor = (struct libdeflate_decompressor *) libewf_compression_libdeflate_cache_take(
+	                                                   LIBEWF_COMPRESSION_LIBDEFLATE_DECOMPRESSOR );
+
+	if( decompressor == NULL )
+	{
+		decompressor = libdeflate_alloc_decompressor();
+
+		if( decompressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create decompressor.",
+			 function );
+
+			*uncompressed_size = 0;
+
+			return( -1 );
+		}
+	}
+	/* The compressed data can be followed by padding
+	 */
+	result = libdeflate_zlib_decompress_ex(
+	          decompressor,
+	          compressed_data,
+	          compressed_size,
+	          uncompressed_data,
+	          *uncompressed_size,
+	          &safe_compressed_size,
+	          &safe_uncompressed_size );
+
+	if( libewf_compression_libdeflate_cache_put(
+	     LIBEWF_COMPRESSION_LIBDEFLATE_DECOMPRESSOR,
+	     decompressor ) == 0 )
+	{
+		libdeflate_free_decompressor(
+		 decompressor );
+	}
+	if( result == LIBDEFLATE_SUCCESS )
+	{
+		*uncompressed_size = safe_uncompressed_size;
+
+		return( 1 );
+	}
+	else if( result == LIBDEFLATE_BAD_DATA )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_size = 0;
+
+		return( 0 );
+	}
+	else if( result == LIBDEFLATE_INSUFFICIENT_SPACE )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+		 	"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_size *= 2;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: libdeflate returned undefined error: %d.",
+		 function,
+		 (int) result );
+
+		*uncompressed_size = 0;
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+/* Retrieves the compression backend
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_get_backend(
+     int *compression_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_get_backend";
+
+	if( compression_backend == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression backend.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_backend = libewf_compression_backend;
+
+	return( 1 );
+}
+
+/* Sets the compression backend
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_set_backend(
+     int compression_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_set_backend";
+
+	if( ( compression_backend != LIBEWF_COMPRESSION_BACKEND_DEFAULT )
+#if defined( HAVE_LIBDEFLATE )
+	 && ( compression_backend != LIBEWF_COMPRESSION_BACKEND_LIBDEFLATE )
+#endif
+	 && ( compression_backend != LIBEWF_COMPRESSION_BACKEND_ZLIB ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression backend.",
+		 function );
+
+		return( -1 );
+	}
+	libewf_compression_backend = compression_backend;
+
+	return( 1 );
+}
+
+/* Determines the zlib compression level that corresponds with the (EWF) compression level
+ * Returns 1 on success or -1 on error
+ */
+int libewf_compression_get_zlib_compression_level(
+     int8_t compression_level,
+     int *zlib_compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_get_zlib_compression_level";
+
+	if( zlib_compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == EWF_COMPRESSION_DEFAULT )
+	{
+		*zlib_compression_level = Z_BEST_SPEED;
+	}
+	else if( compression_level == EWF_COMPRESSION_FAST )
+	{
+		*zlib_compression_level = Z_BEST_SPEED;
+	}
+	else if( compression_level == EWF_COMPRESSION_BEST )
+	{
+		*zlib_compression_level = Z_BEST_COMPRESSION;
+	}
+	else if( compression_level == EWF_COMPRESSION_NONE )
+	{
+		*zlib_compression_level = Z_NO_COMPRESSION;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Compresses data, wraps zlib compress2 or libdeflate depending on the compression backend
  * Returns 1 on success or -1 on error
  */
 int libewf_compress(
@@ -48,9 +428,56 @@ int libewf_compress(
      int8_t compression_level,
      libcerror_error_t **error )
 {
-	static char *function       = "libewf_compress";
+	static char *function      = "libewf_compress";
+	int zlib_compression_level = 0;
+
+	if( libewf_compression_get_zlib_compression_level(
+	     compression_level,
+	     &zlib_compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine zlib compression level.",
+		 function );
+
+		return( -1 );
+	}
+	return( libewf_compress_with_zlib_values(
+	         compressed_data,
+	         compressed_size,
+	         uncompressed_data,
+	         uncompressed_size,
+	         zlib_compression_level,
+	         LIBEWF_COMPRESSION_STRATEGY_DEFAULT,
+	         0,
+	         0,
+	         error ) );
+}
+
+/* Compresses data using specific zlib compression values
+ * The zlib compression level ranges from 0 to 9, the strategy is one of
+ * the LIBEWF_COMPRESSION_STRATEGY definitions, a window bits or memory level
+ * value of 0 represents the zlib default
+ * Wraps zlib compress2 or libdeflate depending on the compression backend,
+ * non-default strategy, window bits or memory level values are only supported by zlib deflate
+ * Returns 1 on success or -1 on error
+ */
+int libewf_compress_with_zlib_values(
+     uint8_t *compressed_data,
+     size_t *compressed_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_size,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_compress_with_zlib_values";
 	uLongf safe_compressed_size = 0;
-	int zlib_compression_level  = 0;
 	int result                  = 0;
 
 	if( compressed_data == NULL )
@@ -97,33 +524,55 @@ int libewf_compress(
 
 		return( -1 );
 	}
-	if( compression_level == EWF_COMPRESSION_DEFAULT )
-	{
-		zlib_compression_level = Z_BEST_SPEED;
-	}
-	else if( compression_level == EWF_COMPRESSION_FAST )
-	{
-		zlib_compression_level = Z_BEST_SPEED;
-	}
-	else if( compression_level == EWF_COMPRESSION_BEST )
-	{
-		zlib_compression_level = Z_BEST_COMPRESSION;
-	}
-	else if( compression_level == EWF_COMPRESSION_NONE )
-	{
-		zlib_compression_level = Z_NO_COMPRESSION;
-	}
-	else
+	if( ( zlib_compression_level < Z_NO_COMPRESSION )
+	 || ( zlib_compression_level > Z_BEST_COMPRESSION ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression level.",
+		 "%s: unsupported zlib compression level.",
 		 function );
 
 		return( -1 );
 	}
+	if( ( zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_DEFAULT )
+	 || ( zlib_window_bits != 0 )
+	 || ( zlib_memory_level != 0 ) )
+	{
+		return( libewf_compress_with_zlib_deflate(
+		         compressed_data,
+		         compressed_size,
+		         uncompressed_data,
+		         uncompressed_size,
+		         zlib_compression_level,
+		         zlib_strategy,
+		         zlib_window_bits,
+		         zlib_memory_level,
+		         error ) );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	/* libdeflate does not support storing data without compression
+	 * and needs more space in the compressed data buffer than zlib,
+	 * in both cases zlib is used instead
+	 */
+	if( ( libewf_compression_backend == LIBEWF_COMPRESSION_BACKEND_LIBDEFLATE )
+	 && ( zlib_compression_level != Z_NO_COMPRESSION ) )
+	{
+		result = libewf_compress_libdeflate(
+		          compressed_data,
+		          compressed_size,
+		          uncompressed_data,
+		          uncompressed_size,
+		          zlib_compression_level,
+		          error );
+
+		if( result != 0 )
+		{
+			return( result );
+		}
+	}
+#endif
 	safe_compressed_size = (uLongf) *compressed_size;
 
 	result = compress2(
@@ -186,7 +635,333 @@ int libewf_compress(
 	return( -1 );
 }
 
-/* Decompresses data, wraps zlib uncompress function
+/* Compresses data using zlib deflate with a specific strategy, window bits and memory level
+ * A window bits or memory level value of 0 represents the zlib default
+ * Returns 1 on success or -1 on error
+ */
+int libewf_compress_with_zlib_deflate(
+     uint8_t *compressed_data,
+     size_t *compressed_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_size,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error )
+{
+	z_stream zlib_stream;
+
+	static char *function = "libewf_compress_with_zlib_deflate";
+	int deflate_strategy  = Z_DEFAULT_STRATEGY;
+	int result            = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *compressed_size > (size_t) UINT32_MAX )
+	 || ( uncompressed_size > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	switch( zlib_strategy )
+	{
+		case LIBEWF_COMPRESSION_STRATEGY_DEFAULT:
+			deflate_strategy = Z_DEFAULT_STRATEGY;
+			break;
+
+		case LIBEWF_COMPRESSION_STRATEGY_FILTERED:
+			deflate_strategy = Z_FILTERED;
+			break;
+
+		case LIBEWF_COMPRESSION_STRATEGY_HUFFMAN_ONLY:
+			deflate_strategy = Z_HUFFMAN_ONLY;
+			break;
+
+#if defined( Z_RLE )
+		case LIBEWF_COMPRESSION_STRATEGY_RLE:
+			deflate_strategy = Z_RLE;
+			break;
+#endif
+
+#if defined( Z_FIXED )
+		case LIBEWF_COMPRESSION_STRATEGY_FIXED:
+			deflate_strategy = Z_FIXED;
+			break;
+#endif
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported zlib strategy.",
+			 function );
+
+			return( -1 );
+	}
+	if( zlib_window_bits == 0 )
+	{
+		zlib_window_bits = MAX_WBITS;
+	}
+	else if( ( zlib_window_bits < 9 )
+	      || ( zlib_window_bits > MAX_WBITS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported zlib window bits.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_memory_level == 0 )
+	{
+		zlib_memory_level = LIBEWF_COMPRESSION_ZLIB_DEFAULT_MEMORY_LEVEL;
+	}
+	else if( ( zlib_memory_level < 1 )
+	      || ( zlib_memory_level > MAX_MEM_LEVEL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported zlib memory level.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &zlib_stream,
+	     0,
+	     sizeof( z_stream ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear zlib stream.",
+		 function );
+
+		return( -1 );
+	}
+	result = deflateInit2(
+	          &zlib_stream,
+	          zlib_compression_level,
+	          Z_DEFLATED,
+	          zlib_window_bits,
+	          zlib_memory_level,
+	          deflate_strategy );
+
+	if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to initialize zlib stream with error: %d.",
+		 function,
+		 result );
+
+		*compressed_size = 0;
+
+		return( -1 );
+	}
+	zlib_stream.next_in   = (Bytef *) uncompressed_data;
+	zlib_stream.avail_in  = (uInt) uncompressed_size;
+	zlib_stream.next_out  = (Bytef *) compressed_data;
+	zlib_stream.avail_out = (uInt) *compressed_size;
+
+	result = deflate(
+	          &zlib_stream,
+	          Z_FINISH );
+
+	if( result == Z_STREAM_END )
+	{
+		*compressed_size = (size_t) zlib_stream.total_out;
+
+		result = 1;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+		 	"%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Use deflateBound to determine the size of the uncompressed buffer
+		 */
+		*compressed_size = (size_t) deflateBound(
+		                             &zlib_stream,
+		                             (uLong) uncompressed_size );
+
+		result = -1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*compressed_size = 0;
+
+		result = -1;
+	}
+	deflateEnd(
+	 &zlib_stream );
+
+	return( result );
+}
+
+/* Tests if data is compressible
+ * The estimate is made by compressing samples spread evenly over the data with the fast
+ * compression level, which is considerably cheaper than compressing all of the data
+ * Returns 1 if the data is estimated to be compressible, 0 if not or -1 on error
+ */
+int libewf_compression_test_compressible(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t compressed_samples[ 2 * LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES * LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE ];
+	uint8_t samples[ LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES * LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE ];
+
+	static char *function          = "libewf_compression_test_compressible";
+	size_t compressed_samples_size = 0;
+	size_t data_offset             = 0;
+	size_t samples_offset          = 0;
+	int result                     = 0;
+	int sample_index               = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Small data is not sampled, the compression itself is considered cheap enough
+	 */
+	if( data_size < ( 2 * LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES * LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE ) )
+	{
+		return( 1 );
+	}
+	for( sample_index = 0;
+	     sample_index < LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES;
+	     sample_index++ )
+	{
+		data_offset = ( ( data_size - LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE ) / ( LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES - 1 ) )
+		            * (size_t) sample_index;
+
+		if( memory_copy(
+		     &( samples[ samples_offset ] ),
+		     &( data[ data_offset ] ),
+		     LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sample: %d.",
+			 function,
+			 sample_index );
+
+			return( -1 );
+		}
+		samples_offset += LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE;
+	}
+	compressed_samples_size = sizeof( compressed_samples );
+
+	result = libewf_compress(
+	          compressed_samples,
+	          &compressed_samples_size,
+	          samples,
+	          samples_offset,
+	          EWF_COMPRESSION_FAST,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress samples.",
+		 function );
+
+		return( -1 );
+	}
+	/* The compression needs to save at least 1/32 of the samples to be considered worthwhile
+	 */
+	if( compressed_samples_size > ( samples_offset - ( samples_offset / 32 ) ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Decompresses data, wraps zlib uncompress or libdeflate depending on the compression backend
  * Returns 1 on success, 0 on failure or -1 on error
  */
 int libewf_decompress(
@@ -244,6 +1019,17 @@ int libewf_decompress(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBDEFLATE )
+	if( libewf_compression_backend == LIBEWF_COMPRESSION_BACKEND_LIBDEFLATE )
+	{
+		return( libewf_decompress_libdeflate(
+		         uncompressed_data,
+		         uncompressed_size,
+		         compressed_data,
+		         compressed_size,
+		         error ) );
+	}
+#endif
 	safe_uncompressed_size = (uLongf) *uncompressed_size;
 
 	result = uncompress(
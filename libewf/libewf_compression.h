@@ -31,6 +31,48 @@
 extern "C" {
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+
+void *libewf_compression_libdeflate_cache_take(
+       int cache_index );
+
+int libewf_compression_libdeflate_cache_put(
+     int cache_index,
+     void *object );
+
+void libewf_compression_libdeflate_cache_free(
+      void );
+
+int libewf_compress_libdeflate(
+     uint8_t *compressed_data,
+     size_t *compressed_size,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_size,
+     int compression_level,
+     libcerror_error_t **error );
+
+int libewf_decompress_libdeflate(
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_size,
+     const uint8_t *compressed_data,
+     size_t compressed_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+int libewf_compression_get_backend(
+     int *compression_backend,
+     libcerror_error_t **error );
+
+int libewf_compression_set_backend(
+     int compression_backend,
+     libcerror_error_t **error );
+
+int libewf_compression_get_zlib_compression_level(
+     int8_t compression_level,
+     int *zlib_compression_level,
+     libcerror_error_t **error );
+
 int libewf_compress(
      uint8_t *compressed_data,
      size_t *compressed_size,
@@ -39,6 +81,33 @@ int libewf_compress(
      int8_t compression_level,
      libcerror_error_t **error );
 
+int libewf_compress_with_zlib_values(
+     uint8_t *compressed_data,
+     size_t *compressed_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_size,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error );
+
+int libewf_compress_with_zlib_deflate(
+     uint8_t *compressed_data,
+     size_t *compressed_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_size,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error );
+
+int libewf_compression_test_compressible(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 int libewf_decompress(
      uint8_t *uncompressed_data,
      size_t *uncompressed_size,
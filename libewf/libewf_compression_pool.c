@@ -0,0 +1,800 @@
+/*
+ * Compression pool functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
+#include "libewf_compression_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_statistics.h"
+
+#include "ewf_definitions.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a compression pool
+ * Up to twice the number of threads chunks can be outstanding
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_pool_initialize(
+     libewf_compression_pool_t **compression_pool,
+     int number_of_threads,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint8_t ewf_format,
+     size32_t chunk_size,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_pool_initialize";
+	size_t requests_size  = 0;
+
+	if( compression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_pool = memory_allocate_structure(
+	                     libewf_compression_pool_t );
+
+	if( *compression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_pool,
+	     0,
+	     sizeof( libewf_compression_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression pool.",
+		 function );
+
+		memory_free(
+		 *compression_pool );
+
+		*compression_pool = NULL;
+
+		return( -1 );
+	}
+	( *compression_pool )->compression_level                     = compression_level;
+	( *compression_pool )->compression_flags                     = compression_flags;
+	( *compression_pool )->ewf_format                            = ewf_format;
+	( *compression_pool )->chunk_size                            = chunk_size;
+	( *compression_pool )->compressed_zero_byte_empty_block      = compressed_zero_byte_empty_block;
+	( *compression_pool )->compressed_zero_byte_empty_block_size = compressed_zero_byte_empty_block_size;
+	( *compression_pool )->maximum_number_of_requests            = 2 * number_of_threads;
+
+	requests_size = sizeof( libewf_compression_request_t * ) * ( *compression_pool )->maximum_number_of_requests;
+
+	( *compression_pool )->requests = (libewf_compression_request_t **) memory_allocate(
+	                                                                     requests_size );
+
+	if( ( *compression_pool )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *compression_pool )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *compression_pool )->requests_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create requests mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *compression_pool )->packed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create packed condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *compression_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *compression_pool )->maximum_number_of_requests,
+	     (int (*)(intptr_t *, void *)) &libewf_compression_pool_process_request,
+	     (void *) *compression_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_pool != NULL )
+	{
+		libewf_compression_pool_free(
+		 compression_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a compression pool
+ * Waits for the outstanding requests to be processed before the threads are stopped
+ * The chunk data of the chunks that were not retrieved is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_pool_free(
+     libewf_compression_pool_t **compression_pool,
+     libcerror_error_t **error )
+{
+	libewf_compression_request_t *request = NULL;
+	static char *function                 = "libewf_compression_pool_free";
+	int request_index                     = 0;
+	int result                            = 1;
+
+	if( compression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_pool != NULL )
+	{
+		if( ( *compression_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *compression_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *compression_pool )->requests != NULL )
+		{
+			for( request_index = 0;
+			     request_index < ( *compression_pool )->maximum_number_of_requests;
+			     request_index++ )
+			{
+				request = ( *compression_pool )->requests[ request_index ];
+
+				if( request == NULL )
+				{
+					continue;
+				}
+				if( libewf_chunk_data_free(
+				     &( request->chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data of request: %d.",
+					 function,
+					 request_index );
+
+					result = -1;
+				}
+				memory_free(
+				 request );
+			}
+			memory_free(
+			 ( *compression_pool )->requests );
+		}
+		if( ( *compression_pool )->packed_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *compression_pool )->packed_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free packed condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *compression_pool )->requests_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *compression_pool )->requests_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free requests mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *compression_pool );
+
+		*compression_pool = NULL;
+	}
+	return( result );
+}
+
+/* Submits a chunk to be packed by one of the threads
+ * The compression pool takes over the management of the chunk data only if successful
+ * The chunk data pool is not thread safe, hence the buffer for the compressed data
+ * is retrieved here and the threads pack the chunk without the chunk data pool
+ * The zlib compression values are passed per chunk since they can change while writing, 0 if not set
+ * Returns 1 if successful, 0 if the maximum number of outstanding chunks was reached or -1 on error
+ */
+int libewf_compression_pool_submit(
+     libewf_compression_pool_t *compression_pool,
+     libewf_chunk_data_t *chunk_data,
+     uint64_t chunk_index,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error )
+{
+	libewf_compression_request_t *request = NULL;
+	static char *function                 = "libewf_compression_pool_submit";
+	int request_index                     = 0;
+	int result                            = 0;
+
+	if( compression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_pool->ewf_format == EWF_FORMAT_S01 )
+	 || ( compression_pool->compression_level != EWF_COMPRESSION_NONE )
+	 || ( ( compression_pool->compression_flags & LIBEWF_FLAG_COMPRESS_EMPTY_BLOCK ) != 0 ) )
+	{
+		if( chunk_data->compressed_data == NULL )
+		{
+			if( libewf_chunk_data_get_buffer(
+			     chunk_data,
+			     2 * chunk_data->data_size,
+			     &( chunk_data->compressed_data ),
+			     &( chunk_data->allocated_compressed_data_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create compressed data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	request = memory_allocate_structure(
+	           libewf_compression_request_t );
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		return( -1 );
+	}
+	request->chunk_data             = chunk_data;
+	request->chunk_index            = chunk_index;
+	request->chunk_data_size        = chunk_data->data_size;
+	request->zlib_compression_level = zlib_compression_level;
+	request->zlib_strategy          = zlib_strategy;
+	request->zlib_window_bits       = zlib_window_bits;
+	request->zlib_memory_level      = zlib_memory_level;
+	request->start_time             = 0;
+	request->end_time               = 0;
+	request->result                 = 0;
+
+	if( libcthreads_mutex_grab(
+	     compression_pool->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab requests mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_pool->number_of_requests < compression_pool->maximum_number_of_requests )
+	{
+		request_index = ( compression_pool->first_request_index + compression_pool->number_of_requests )
+		              % compression_pool->maximum_number_of_requests;
+
+		compression_pool->requests[ request_index ] = request;
+		compression_pool->number_of_requests       += 1;
+
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     compression_pool->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release requests mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		memory_free(
+		 request );
+
+		return( 0 );
+	}
+	/* The thread pool queue can hold the maximum number of outstanding requests
+	 * so pushing a request does not block
+	 */
+	if( libcthreads_thread_pool_push(
+	     compression_pool->thread_pool,
+	     (intptr_t *) request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push request onto thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		/* Remove the request so that the caller retains the management of the chunk data,
+		 * the request was the last one stored since there is only a single submitter
+		 */
+		if( result == 1 )
+		{
+			if( libcthreads_mutex_grab(
+			     compression_pool->requests_mutex,
+			     NULL ) == 1 )
+			{
+				compression_pool->number_of_requests -= 1;
+
+				request_index = ( compression_pool->first_request_index + compression_pool->number_of_requests )
+				              % compression_pool->maximum_number_of_requests;
+
+				compression_pool->requests[ request_index ] = NULL;
+
+				libcthreads_mutex_release(
+				 compression_pool->requests_mutex,
+				 NULL );
+			}
+		}
+		memory_free(
+		 request );
+	}
+	return( -1 );
+}
+
+/* Retrieves the oldest outstanding chunk once it has been packed
+ * The chunks are retrieved in the order they were submitted
+ * If wait for completion is set the function blocks until the chunk is packed
+ * The caller takes over the management of the chunk data
+ * Returns 1 if successful, 0 if no packed chunk is available or -1 on error
+ */
+int libewf_compression_pool_get_packed_chunk(
+     libewf_compression_pool_t *compression_pool,
+     libewf_chunk_data_t **chunk_data,
+     uint64_t *chunk_index,
+     size_t *chunk_data_size,
+     uint64_t *start_time,
+     uint64_t *end_time,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error )
+{
+	libewf_compression_request_t *request = NULL;
+	static char *function                 = "libewf_compression_pool_get_packed_chunk";
+	int result                            = 0;
+
+	if( compression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid start time.",
+		 function );
+
+		return( -1 );
+	}
+	if( end_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid end time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     compression_pool->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( compression_pool->number_of_requests > 0 )
+	{
+		request = compression_pool->requests[ compression_pool->first_request_index ];
+
+		if( request->result != 0 )
+		{
+			compression_pool->requests[ compression_pool->first_request_index ] = NULL;
+
+			compression_pool->first_request_index = ( compression_pool->first_request_index + 1 )
+			                                      % compression_pool->maximum_number_of_requests;
+			compression_pool->number_of_requests -= 1;
+
+			result = 1;
+
+			break;
+		}
+		request = NULL;
+
+		if( wait_for_completion == 0 )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     compression_pool->packed_condition,
+		     compression_pool->requests_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for packed condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     compression_pool->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release requests mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( request == NULL )
+	{
+		return( result );
+	}
+	if( ( result != 1 )
+	 || ( request->result != 1 ) )
+	{
+		if( request->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk data: %" PRIu64 ".",
+			 function,
+			 request->chunk_index );
+		}
+		libewf_chunk_data_free(
+		 &( request->chunk_data ),
+		 NULL );
+
+		memory_free(
+		 request );
+
+		return( -1 );
+	}
+	*chunk_data      = request->chunk_data;
+	*chunk_index     = request->chunk_index;
+	*chunk_data_size = request->chunk_data_size;
+	*start_time      = request->start_time;
+	*end_time        = request->end_time;
+
+	memory_free(
+	 request );
+
+	return( 1 );
+}
+
+/* Packs the chunk data of a request
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_pool_process_request(
+     libewf_compression_request_t *request,
+     libewf_compression_pool_t *compression_pool )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	int result                                = 0;
+
+	if( request == NULL )
+	{
+		return( -1 );
+	}
+	if( compression_pool == NULL )
+	{
+		return( -1 );
+	}
+	/* Pack the chunk without the chunk data pool, buffers that are
+	 * released or needed while packing are freed or allocated instead
+	 */
+	chunk_data_pool                      = request->chunk_data->chunk_data_pool;
+	request->chunk_data->chunk_data_pool = NULL;
+
+	request->start_time = libewf_statistics_get_time();
+
+	result = libewf_chunk_data_pack(
+	          request->chunk_data,
+	          compression_pool->compression_level,
+	          compression_pool->compression_flags,
+	          request->zlib_compression_level,
+	          request->zlib_strategy,
+	          request->zlib_window_bits,
+	          request->zlib_memory_level,
+	          compression_pool->ewf_format,
+	          compression_pool->chunk_size,
+	          compression_pool->compressed_zero_byte_empty_block,
+	          compression_pool->compressed_zero_byte_empty_block_size,
+	          &error );
+
+	request->end_time = libewf_statistics_get_time();
+
+	request->chunk_data->chunk_data_pool = chunk_data_pool;
+
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     compression_pool->requests_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	request->result = ( result == 1 ) ? 1 : -1;
+
+	if( libcthreads_condition_broadcast(
+	     compression_pool->packed_condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     compression_pool->requests_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,186 @@
+/*
+ * Compression pool functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_POOL_H )
+#define _LIBEWF_COMPRESSION_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_compression_request libewf_compression_request_t;
+
+struct libewf_compression_request
+{
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data size before packing
+	 */
+	size_t chunk_data_size;
+
+	/* The zlib compression level, 0 if not set
+	 */
+	int zlib_compression_level;
+
+	/* The zlib strategy
+	 */
+	int zlib_strategy;
+
+	/* The zlib window bits, 0 if not set
+	 */
+	int zlib_window_bits;
+
+	/* The zlib memory level, 0 if not set
+	 */
+	int zlib_memory_level;
+
+	/* The time the packing started
+	 */
+	uint64_t start_time;
+
+	/* The time the packing ended
+	 */
+	uint64_t end_time;
+
+	/* The result of the packing, 0 if still pending, 1 if packed or -1 on error
+	 */
+	int result;
+};
+
+typedef struct libewf_compression_pool libewf_compression_pool_t;
+
+struct libewf_compression_pool
+{
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The compression flags
+	 */
+	uint8_t compression_flags;
+
+	/* The EWF format
+	 */
+	uint8_t ewf_format;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The compressed zero byte empty block, which is not managed by the pool
+	 */
+	const uint8_t *compressed_zero_byte_empty_block;
+
+	/* The size of the compressed zero byte empty block
+	 */
+	size_t compressed_zero_byte_empty_block_size;
+
+	/* The requests in the order they were submitted
+	 */
+	libewf_compression_request_t **requests;
+
+	/* The maximum number of outstanding requests
+	 */
+	int maximum_number_of_requests;
+
+	/* The index of the first (oldest) request
+	 */
+	int first_request_index;
+
+	/* The number of outstanding requests
+	 */
+	int number_of_requests;
+
+	/* The mutex that protects the requests
+	 */
+	libcthreads_mutex_t *requests_mutex;
+
+	/* The condition that is signalled when a request was packed
+	 */
+	libcthreads_condition_t *packed_condition;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+int libewf_compression_pool_initialize(
+     libewf_compression_pool_t **compression_pool,
+     int number_of_threads,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint8_t ewf_format,
+     size32_t chunk_size,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     libcerror_error_t **error );
+
+int libewf_compression_pool_free(
+     libewf_compression_pool_t **compression_pool,
+     libcerror_error_t **error );
+
+int libewf_compression_pool_submit(
+     libewf_compression_pool_t *compression_pool,
+     libewf_chunk_data_t *chunk_data,
+     uint64_t chunk_index,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error );
+
+int libewf_compression_pool_get_packed_chunk(
+     libewf_compression_pool_t *compression_pool,
+     libewf_chunk_data_t **chunk_data,
+     uint64_t *chunk_index,
+     size_t *chunk_data_size,
+     uint64_t *start_time,
+     uint64_t *end_time,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error );
+
+int libewf_compression_pool_process_request(
+     libewf_compression_request_t *request,
+     libewf_compression_pool_t *compression_pool );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
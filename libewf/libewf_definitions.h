@@ -125,16 +125,42 @@ enum LIBEWF_COMPRESSION_LEVELS
  * bit 1	set to 1 for empty block compression
  *              detects empty blocks and stored them compressed, the compression
  *              is only done once
- * bit 2-8	not used
+ * bit 2	set to 1 for adaptive compression
+ *              estimates if chunk data is compressible before compressing it,
+ *              chunk data that is estimated to be incompressible is stored uncompressed
+ * bit 3-8	not used
  */
 enum LIBEWF_COMPRESSION_FLAGS
 {
 	LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION	= (uint8_t) 0x01,
+	LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION		= (uint8_t) 0x02,
 };
 
 /* TODO deprecated remove after a while */
 #define LIBEWF_FLAG_COMPRESS_EMPTY_BLOCK			LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION
 
+/* The compression backend definitions
+ * The default backend is zlib, libdeflate is only used when selected
+ */
+enum LIBEWF_COMPRESSION_BACKENDS
+{
+	LIBEWF_COMPRESSION_BACKEND_DEFAULT			= 0,
+	LIBEWF_COMPRESSION_BACKEND_ZLIB				= 1,
+	LIBEWF_COMPRESSION_BACKEND_LIBDEFLATE			= 2
+};
+
+/* The compression strategy definitions
+ * These correspond to the deflate (zlib) compression strategies
+ */
+enum LIBEWF_COMPRESSION_STRATEGIES
+{
+	LIBEWF_COMPRESSION_STRATEGY_DEFAULT			= 0,
+	LIBEWF_COMPRESSION_STRATEGY_FILTERED			= 1,
+	LIBEWF_COMPRESSION_STRATEGY_HUFFMAN_ONLY		= 2,
+	LIBEWF_COMPRESSION_STRATEGY_RLE				= 3,
+	LIBEWF_COMPRESSION_STRATEGY_FIXED			= 4,
+};
+
 /* The media type definitions
  */
 enum LIBEWF_MEDIA_TYPES
@@ -195,6 +221,89 @@ enum LIBEWF_SEGMENT_FILE_TYPES
 	LIBEWF_SEGMENT_FILE_TYPE_LWF				= (int) 'L'
 };
 
+/* The segment file write flags
+ * bit 1	set to 1 to preallocate the segment file to the maximum segment file size
+ * bit 2	set to 1 to start writing back a segment file when it is closed
+ * bit 3-8	not used
+ */
+enum LIBEWF_SEGMENT_FILE_WRITE_FLAGS
+{
+	LIBEWF_SEGMENT_FILE_WRITE_FLAG_PREALLOCATE		= (uint8_t) 0x01,
+	LIBEWF_SEGMENT_FILE_WRITE_FLAG_FLUSH_ON_CLOSE		= (uint8_t) 0x02
+};
+
+/* The chunk flags
+ * bit 1	set to 1 if the chunk data is compressed
+ * bit 2	set to 1 if the chunk checksum was stored separately
+ * bit 3	set to 1 if the chunk is marked as corrupted
+ * bit 4-8	not used
+ */
+enum LIBEWF_CHUNK_FLAGS
+{
+	LIBEWF_CHUNK_FLAG_IS_COMPRESSED				= (uint8_t) 0x01,
+	LIBEWF_CHUNK_FLAG_HAS_CHECKSUM				= (uint8_t) 0x02,
+	LIBEWF_CHUNK_FLAG_IS_CORRUPTED				= (uint8_t) 0x04
+};
+
+/* The media extent flags
+ * bit 1	set to 1 if the extent only contains 0-byte values
+ * bit 2-32	not used
+ */
+enum LIBEWF_EXTENT_FLAGS
+{
+	LIBEWF_EXTENT_FLAG_IS_SPARSE				= 0x00000001UL
+};
+
+/* The statistics values
+ * The times are in nanoseconds
+ * The chunks compressed, uncompressed and compression skipped values count each chunk written once,
+ * compression skipped are the chunks that adaptive compression estimated to be incompressible
+ */
+enum LIBEWF_STATISTICS_VALUES
+{
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_READ		= 0,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_READ		= 1,
+	LIBEWF_STATISTICS_VALUE_READ_TIME			= 2,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_DECOMPRESSED	= 3,
+	LIBEWF_STATISTICS_VALUE_DECOMPRESSION_TIME		= 4,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_WRITTEN	= 5,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_WRITTEN		= 6,
+	LIBEWF_STATISTICS_VALUE_WRITE_TIME			= 7,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_COMPRESSED	= 8,
+	LIBEWF_STATISTICS_VALUE_COMPRESSION_TIME		= 9,
+	LIBEWF_STATISTICS_VALUE_CHUNK_TABLE_CACHE_HITS		= 10,
+	LIBEWF_STATISTICS_VALUE_CHUNK_TABLE_CACHE_MISSES	= 11,
+	LIBEWF_STATISTICS_VALUE_SEGMENT_FILES_CACHE_HITS	= 12,
+	LIBEWF_STATISTICS_VALUE_SEGMENT_FILES_CACHE_MISSES	= 13,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_FILE_IO_POOL_OPENS	= 14,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_FILE_IO_POOL_EVICTIONS	= 15,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSED	= 16,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_UNCOMPRESSED	= 17,
+	LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSION_SKIPPED	= 18,
+
+	LIBEWF_STATISTICS_NUMBER_OF_VALUES			= 19
+};
+
+/* The statistics value of a value that is not available
+ * The cache and file IO pool values are not available when libewf
+ * is built against a system installed libmfdata or libbfio
+ */
+#define LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE			( (uint64_t) -1 )
+
+/* The trace stages
+ */
+enum LIBEWF_TRACE_STAGES
+{
+	LIBEWF_TRACE_STAGE_OPEN					= 1,
+	LIBEWF_TRACE_STAGE_SEEK					= 2,
+	LIBEWF_TRACE_STAGE_READ					= 3,
+	LIBEWF_TRACE_STAGE_DECOMPRESS				= 4,
+	LIBEWF_TRACE_STAGE_CHECKSUM				= 5,
+	LIBEWF_TRACE_STAGE_UNPACK				= 6,
+	LIBEWF_TRACE_STAGE_COMPRESS				= 7,
+	LIBEWF_TRACE_STAGE_WRITE				= 8
+};
+
 /* The (single) file entry types
  */
 enum LIBEWF_FILE_ENTRY_TYPES
@@ -276,6 +385,40 @@ enum LIBEWF_SEGMENT_FILE_FLAGS
  */
 #define LIBEWF_RANGE_FLAG_IS_CORRUPTED				LIBMFDATA_RANGE_FLAG_USER_DEFINED_6
 
+/* The size of the blocks in which the ltree data is read
+ */
+#define LIBEWF_LTREE_STREAM_BLOCK_SIZE				( 64 * 1024 )
+
+/* The maximum size of an UTF-8 ltree line string
+ */
+#define LIBEWF_LTREE_STREAM_MAXIMUM_LINE_SIZE			( 1024 * 1024 )
+
+/* The maximum number of free buffers and chunk data values kept by the chunk data pool
+ */
+#define LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_ENTRIES	16
+
+/* The default number of threads used to process asynchronous read requests
+ */
+#define LIBEWF_ASYNC_READ_DEFAULT_NUMBER_OF_THREADS		4
+
+/* The maximum number of outstanding asynchronous read requests
+ */
+#define LIBEWF_ASYNC_READ_MAXIMUM_NUMBER_OF_REQUESTS		256
+
+/* The maximum number of threads used to pack chunks while writing
+ */
+#define LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS		64
+
+/* The number and size of the samples of the chunk data that are compressed
+ * to estimate if the chunk data is compressible with adaptive compression
+ */
+#define LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES		4
+#define LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE			1024
+
+/* The zlib deflate memory level used when no memory level was specified
+ */
+#define LIBEWF_COMPRESSION_ZLIB_DEFAULT_MEMORY_LEVEL		8
+
 #if defined( __BORLANDC__ ) && ( __BORLANDC__ < 0x0560 )
 #define LIBEWF_2_TIB						0x20000000000UL
 #else
@@ -33,6 +33,7 @@
 #include "libewf_libcstring.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_single_file_tree.h"
+#include "libewf_single_files.h"
 #include "libewf_types.h"
 
 /* Initializes the file entry and its values
@@ -1729,6 +1730,21 @@ int libewf_file_entry_get_number_of_sub_file_entries(
 	}
 	internal_file_entry = (libewf_internal_file_entry_t *) file_entry;
 
+	if( libewf_single_files_read_sub_file_entries(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->internal_handle->file_io_pool,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_tree_node_get_number_of_sub_nodes(
 	     internal_file_entry->file_entry_tree_node,
 	     number_of_sub_file_entries,
@@ -1805,6 +1821,21 @@ int libewf_file_entry_get_sub_file_entry(
 
 		return( -1 );
 	}
+	if( libewf_single_files_read_sub_file_entries(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->internal_handle->file_io_pool,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_tree_node_get_sub_node_by_index(
 	     internal_file_entry->file_entry_tree_node,
              sub_file_entry_index,
@@ -1912,6 +1943,21 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_name(
 
 		return( -1 );
 	}
+	if( libewf_single_files_read_sub_file_entries(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->internal_handle->file_io_pool,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		return( -1 );
+	}
 	result = libewf_single_file_tree_get_sub_node_by_utf8_name(
 	          internal_file_entry->file_entry_tree_node,
 	          utf8_string,
@@ -2102,6 +2148,21 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_path(
 
 			return( -1 );
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_file_entry->internal_handle->single_files,
+		     internal_file_entry->internal_handle->file_io_pool,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub file entries.",
+			 function );
+
+			return( -1 );
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
 			  node,
 			  utf8_string_segment,
@@ -2211,6 +2272,21 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_name(
 
 		return( -1 );
 	}
+	if( libewf_single_files_read_sub_file_entries(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->internal_handle->file_io_pool,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		return( -1 );
+	}
 	result = libewf_single_file_tree_get_sub_node_by_utf16_name(
 	          internal_file_entry->file_entry_tree_node,
 	          utf16_string,
@@ -2401,6 +2477,21 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_path(
 
 			return( -1 );
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_file_entry->internal_handle->single_files,
+		     internal_file_entry->internal_handle->file_io_pool,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub file entries.",
+			 function );
+
+			return( -1 );
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
 			  node,
 			  utf16_string_segment,
@@ -32,11 +32,12 @@
 #include <time.h>
 #endif
 
+#include "libewf_async_read_handle.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
+#include "libewf_compression_pool.h"
 #include "libewf_definitions.h"
-#include "libewf_empty_block.h"
 #include "libewf_file_entry.h"
 #include "libewf_handle.h"
 #include "libewf_header_values.h"
@@ -58,6 +59,7 @@
 #include "libewf_types.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_journal.h"
 
 #include "ewf_checksum.h"
 #include "ewf_data.h"
@@ -195,8 +197,22 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_statistics_initialize(
+	     &( internal_handle->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
 	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->number_of_read_threads         = LIBEWF_ASYNC_READ_DEFAULT_NUMBER_OF_THREADS;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -205,6 +221,13 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+		if( internal_handle->acquiry_errors != NULL )
+		{
+			libcdata_range_list_free(
+			 &( internal_handle->acquiry_errors ),
+			 NULL,
+			 NULL );
+		}
 		if( internal_handle->tracks != NULL )
 		{
 			libcdata_array_free(
@@ -349,6 +372,35 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( internal_handle->statistics->trace != NULL )
+		{
+			if( libewf_trace_free(
+			     &( internal_handle->statistics->trace ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free trace.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libewf_statistics_free(
+		     &( internal_handle->statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 internal_handle );
 	}
@@ -523,6 +575,21 @@ int libewf_handle_clone(
 
 		goto on_error;
 	}
+	/* The statistics are not shared with the source handle
+	 */
+	if( libewf_statistics_initialize(
+	     &( internal_destination_handle->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( internal_source_handle->file_io_pool != NULL )
 	{
 		if( libbfio_pool_clone(
@@ -557,6 +624,7 @@ int libewf_handle_clone(
 
 			goto on_error;
 		}
+		internal_destination_handle->read_io_handle->statistics = internal_destination_handle->statistics;
 	}
 	if( internal_source_handle->write_io_handle != NULL )
 	{
@@ -574,6 +642,7 @@ int libewf_handle_clone(
 
 			goto on_error;
 		}
+		internal_destination_handle->write_io_handle->statistics = internal_destination_handle->statistics;
 	}
 	if( internal_source_handle->segment_files_list != NULL )
 	{
@@ -694,6 +763,39 @@ int libewf_handle_clone(
 			goto on_error;
 		}
 	}
+	if( internal_source_handle->chunk_data_pool != NULL )
+	{
+		/* The chunk data pool is not shared with the source handle
+		 */
+		if( libewf_chunk_data_pool_initialize(
+		     &( internal_destination_handle->chunk_data_pool ),
+		     sizeof( libewf_chunk_data_t ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination chunk data pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_pool_set_chunk_size(
+		     internal_destination_handle->chunk_data_pool,
+		     internal_source_handle->chunk_data_pool->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set destination chunk data pool chunk size.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( internal_source_handle->header_sections != NULL )
 	{
 		if( libewf_header_sections_clone(
@@ -765,6 +867,8 @@ int libewf_handle_clone(
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
 	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->number_of_read_threads         = internal_source_handle->number_of_read_threads;
+	internal_destination_handle->number_of_compression_threads  = internal_source_handle->number_of_compression_threads;
 	internal_destination_handle->date_format                    = internal_source_handle->date_format;
 
 	return( 1 );
@@ -808,6 +912,12 @@ on_error:
 			 &( internal_destination_handle->chunk_table_cache ),
 			 NULL );
 		}
+		if( internal_destination_handle->chunk_data_pool != NULL )
+		{
+			libewf_chunk_data_pool_free(
+			 &( internal_destination_handle->chunk_data_pool ),
+			 NULL );
+		}
 		if( internal_destination_handle->delta_segment_table != NULL )
 		{
 			libewf_segment_table_free(
@@ -856,6 +966,12 @@ on_error:
 			 &( internal_destination_handle->file_io_pool ),
 			 NULL );
 		}
+		if( internal_destination_handle->statistics != NULL )
+		{
+			libewf_statistics_free(
+			 &( internal_destination_handle->statistics ),
+			 NULL );
+		}
 		if( internal_destination_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -1836,6 +1952,17 @@ int libewf_handle_open_file_io_pool(
 
 		return( -1 );
 	}
+	if( internal_handle->chunk_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data pool already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->header_sections != NULL )
 	{
 		libcerror_error_set(
@@ -1880,7 +2007,7 @@ int libewf_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	if( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_LAZY_FILE_ENTRIES ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1941,6 +2068,7 @@ int libewf_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		internal_handle->read_io_handle->statistics = internal_handle->statistics;
 	}
 	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
 	{
@@ -1957,6 +2085,8 @@ int libewf_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		internal_handle->write_io_handle->statistics = internal_handle->statistics;
+
 		if( libewf_write_io_handle_set_compressed_zero_byte_empty_block(
 		     internal_handle->write_io_handle,
 		     internal_handle->io_handle,
@@ -2023,9 +2153,25 @@ int libewf_handle_open_file_io_pool(
 
 		goto on_error;
 	}
+	if( libewf_chunk_data_pool_initialize(
+	     &( internal_handle->chunk_data_pool ),
+	     sizeof( libewf_chunk_data_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_chunk_table_initialize(
 	     &chunk_table,
 	     internal_handle->io_handle,
+	     internal_handle->chunk_data_pool,
+	     internal_handle->statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -2496,12 +2642,14 @@ int libewf_handle_open_file_io_pool(
 
 			goto on_error;
 		}
-		if( internal_handle->single_files->ltree_data != NULL )
+		if( internal_handle->single_files->ltree_data_size > 0 )
 		{
 			if( libewf_single_files_parse(
 			     internal_handle->single_files,
+			     file_io_pool,
 			     &( internal_handle->media_values->media_size ),
 			     &( internal_handle->io_handle->format ),
+			     (uint8_t) ( ( access_flags & LIBEWF_ACCESS_FLAG_LAZY_FILE_ENTRIES ) != 0 ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -2595,6 +2743,20 @@ int libewf_handle_open_file_io_pool(
 			goto on_error;
 		}
 	}
+	if( libewf_chunk_data_pool_set_chunk_size(
+	     internal_handle->chunk_data_pool,
+	     internal_handle->media_values->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk data pool chunk size.",
+		 function );
+
+		goto on_error;
+	}
 	internal_handle->io_handle->access_flags = access_flags;
 	internal_handle->file_io_pool            = file_io_pool;
 
@@ -2637,6 +2799,12 @@ on_error:
 		 &( internal_handle->chunk_table_list ),
 		 NULL );
 	}
+	if( internal_handle->chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &( internal_handle->chunk_data_pool ),
+		 NULL );
+	}
 	if( internal_handle->segment_files_cache != NULL )
 	{
 		libfcache_cache_free(
@@ -3114,7 +3282,8 @@ int libewf_handle_open_read_segment_files(
 						      section,
 						      file_io_pool,
 						      file_io_pool_entry,
-						      &( internal_handle->single_files->ltree_data ),
+						      &( internal_handle->single_files->ltree_file_io_pool_entry ),
+						      &( internal_handle->single_files->ltree_data_offset ),
 						      &( internal_handle->single_files->ltree_data_size ),
 						      error );
 
@@ -3553,7 +3722,7 @@ int libewf_handle_open_read_delta_segment_files(
 
 		goto on_error;
 	}
-	if( number_of_segment_files <= 1 )
+	if( number_of_segment_files == 0 )
 	{
 		return( 1 );
 	}
@@ -3562,7 +3731,7 @@ int libewf_handle_open_read_delta_segment_files(
 	     segment_files_list_index++ )
 	{
 		if( libmfdata_file_list_get_file_by_index(
-		     internal_handle->segment_files_list,
+		     internal_handle->delta_segment_files_list,
 		     segment_files_list_index,
 		     &file_io_pool_entry,
 		     error ) != 1 )
@@ -3571,7 +3740,7 @@ int libewf_handle_open_read_delta_segment_files(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data file: %d from segment files list.",
+			 "%s: unable to retrieve data file: %d from delta segment files list.",
 			 function,
 			 segment_files_list_index + 1 );
 
@@ -3680,7 +3849,7 @@ int libewf_handle_open_read_delta_segment_files(
 			goto on_error;
 		}
 		if( libmfdata_file_list_set_file_value_by_index(
-		     internal_handle->segment_files_list,
+		     internal_handle->delta_segment_files_list,
 		     internal_handle->segment_files_cache,
 		     segment_files_list_index,
 		     (intptr_t *) segment_file,
@@ -3692,7 +3861,7 @@ int libewf_handle_open_read_delta_segment_files(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set segment file: %d in segment files list.",
+			 "%s: unable to set delta segment file: %d in delta segment files list.",
 			 function,
 			 segment_files_list_index + 1 );
 
@@ -3918,6 +4087,27 @@ int libewf_handle_close(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Wait for the outstanding asynchronous read requests before closing the file IO pool
+	 */
+	if( internal_handle->async_read_handle != NULL )
+	{
+		if( libewf_async_read_handle_free(
+		     &( internal_handle->async_read_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free async read handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+
 	if( ( internal_handle->write_io_handle != NULL )
 	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
 	{
@@ -4126,6 +4316,22 @@ int libewf_handle_close(
 			result = -1;
 		}
 	}
+	if( internal_handle->chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_free(
+		     &( internal_handle->chunk_data_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data pool.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_handle->header_sections != NULL )
 	{
 		if( libewf_header_sections_free(
@@ -4748,24 +4954,44 @@ ssize_t libewf_handle_read_chunk(
 	return( (ssize_t) read_size );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Reads multiple chunks of (media) data as they are stored in the segment files
+ * The chunk data is not decompressed and the chunk checksum is not validated
+ * Chunks that are stored adjacent in the same segment file are read at once
+ * The chunk data is stored in the chunks buffer, the values chunk_data_offsets
+ * and chunk_data_sizes contain the offset and size of the data of every chunk
+ * in the chunks buffer. The value chunk_checksums contains the checksum
+ * of chunks that have LIBEWF_CHUNK_FLAG_HAS_CHECKSUM set in chunk_flags
+ * This function does not change the current offset
+ * Returns the number of chunks read or -1 on error
  */
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_read_chunks(
+     libewf_handle_t *handle,
+     const uint64_t *chunk_indexes,
+     int number_of_chunks,
+     void *chunks_buffer,
+     size_t chunks_buffer_size,
+     size_t *chunk_data_offsets,
+     size_t *chunk_data_sizes,
+     uint32_t *chunk_checksums,
+     uint8_t *chunk_flags,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data           = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
+	uint8_t *chunk_data                       = NULL;
+	static char *function                     = "libewf_handle_read_chunks";
 	off64_t chunk_offset                      = 0;
+	off64_t range_offset                      = 0;
+	size64_t chunk_size                       = 0;
 	size_t buffer_offset                      = 0;
-	size_t read_size                          = 0;
-	ssize_t total_read_count                  = 0;
-	uint64_t chunk_index                      = 0;
-	uint64_t chunk_data_offset                = 0;
+	size_t range_size                         = 0;
+	ssize_t read_count                        = 0;
+	uint32_t range_flags                      = 0;
+	int chunk_iterator                        = 0;
+	int file_io_pool_entry                    = 0;
+	int number_of_chunk_table_elements        = 0;
+	int range_chunk_index                     = 0;
+	int range_file_io_pool_entry              = 0;
+	uint8_t buffer_is_full                    = 0;
 
 	if( handle == NULL )
 	{
@@ -4780,282 +5006,330 @@ ssize_t libewf_handle_read_buffer(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->chunk_table_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing chunk table list.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( chunk_indexes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk indexes.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle->current_offset < 0 )
+	if( number_of_chunks < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of chunks value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( chunks_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( chunks_buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunks buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( chunk_data_offsets == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid chunk data offsets.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( chunk_data_sizes == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data sizes.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-	if( (size64_t) ( internal_handle->io_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	if( chunk_checksums == NULL )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->io_handle->current_offset );
-	}
-	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk checksums.",
+		 function );
 
-	if( chunk_index >= (uint64_t) INT_MAX )
+		return( -1 );
+	}
+	if( chunk_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk flags.",
 		 function );
 
 		return( -1 );
 	}
-	chunk_offset = chunk_index * internal_handle->media_values->chunk_size;
-
-	chunk_data_offset = internal_handle->io_handle->current_offset - chunk_offset;
-
-	if( chunk_data_offset >= (uint64_t) SSIZE_MAX )
+	if( libmfdata_list_get_number_of_elements(
+	     internal_handle->chunk_table_list,
+	     &number_of_chunk_table_elements,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of chunk table elements.",
 		 function );
 
 		return( -1 );
 	}
-	while( buffer_size > 0 )
+	while( ( buffer_is_full == 0 )
+	    && ( chunk_iterator < number_of_chunks ) )
 	{
-		if( libewf_read_io_handle_read_chunk_data(
-		     internal_handle->read_io_handle,
-		     internal_handle->file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->chunk_table_list,
-		     internal_handle->chunk_table_cache,
-		     (int) chunk_index,
-		     chunk_offset,
-		     &chunk_data,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read chunk data: %" PRIu64 ".",
-			 function,
-			 chunk_index );
+		/* Determine the range of chunks that are stored adjacent
+		 * in the same segment file
+		 */
+		range_chunk_index = chunk_iterator;
+		range_size        = 0;
 
-			return( -1 );
-		}
-		if( chunk_data == NULL )
+		while( chunk_iterator < number_of_chunks )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk data: %" PRIu64 ".",
-			 function,
-			 chunk_index );
+			if( chunk_indexes[ chunk_iterator ] >= (uint64_t) number_of_chunk_table_elements )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk index: %" PRIu64 " value out of bounds.",
+				 function,
+				 chunk_indexes[ chunk_iterator ] );
 
-			return( -1 );
-		}
-		if( chunk_data_offset > chunk_data->data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
-			 function );
+				return( -1 );
+			}
+			if( libewf_chunk_table_get_chunk_data_range(
+			     internal_handle->chunk_table_list,
+			     internal_handle->file_io_pool,
+			     internal_handle->chunk_table_cache,
+			     (int) chunk_indexes[ chunk_iterator ],
+			     &file_io_pool_entry,
+			     &chunk_offset,
+			     &chunk_size,
+			     &range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data range of chunk: %" PRIu64 ".",
+				 function,
+				 chunk_indexes[ chunk_iterator ] );
 
-			return( -1 );
-		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+				return( -1 );
+			}
+			if( ( chunk_size == 0 )
+			 || ( chunk_size > (size64_t) SSIZE_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk: %" PRIu64 " size value out of bounds.",
+				 function,
+				 chunk_indexes[ chunk_iterator ] );
 
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
+				return( -1 );
+			}
+			if( range_size > 0 )
+			{
+				if( ( file_io_pool_entry != range_file_io_pool_entry )
+				 || ( chunk_offset != ( range_offset + (off64_t) range_size ) ) )
+				{
+					break;
+				}
+			}
+			if( chunk_size > (size64_t) ( chunks_buffer_size - ( buffer_offset + range_size ) ) )
+			{
+				if( ( chunk_iterator == 0 )
+				 && ( range_size == 0 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: invalid chunks buffer size value too small.",
+					 function );
+
+					return( -1 );
+				}
+				buffer_is_full = 1;
+
+				break;
+			}
+			if( range_size == 0 )
+			{
+				range_file_io_pool_entry = file_io_pool_entry;
+				range_offset             = chunk_offset;
+			}
+			chunk_data_offsets[ chunk_iterator ] = buffer_offset + range_size;
+			chunk_data_sizes[ chunk_iterator ]   = (size_t) chunk_size;
+			chunk_checksums[ chunk_iterator ]    = 0;
+			chunk_flags[ chunk_iterator ]        = 0;
+
+			if( ( range_flags & LIBMFDATA_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+			{
+				chunk_flags[ chunk_iterator ] |= LIBEWF_CHUNK_FLAG_IS_COMPRESSED;
+			}
+			if( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				chunk_flags[ chunk_iterator ] |= LIBEWF_CHUNK_FLAG_IS_CORRUPTED;
+			}
+			range_size += (size_t) chunk_size;
+
+			chunk_iterator++;
 		}
-		if( read_size == 0 )
+		if( range_size == 0 )
 		{
 			break;
 		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %d chunk(s) from file IO pool entry: %d at offset: %" PRIi64 " of size: %" PRIzd "\n",
+			 function,
+			 chunk_iterator - range_chunk_index,
+			 range_file_io_pool_entry,
+			 range_offset,
+			 range_size );
+		}
+#endif
+		if( libbfio_pool_seek_offset(
+		     internal_handle->file_io_pool,
+		     range_file_io_pool_entry,
+		     range_offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk data to buffer.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek chunk offset: %" PRIi64 " in file IO pool entry: %d.",
+			 function,
+			 range_offset,
+			 range_file_io_pool_entry );
 
 			return( -1 );
 		}
-		buffer_offset    += read_size;
-		buffer_size      -= read_size;
-		total_read_count += (ssize_t) read_size;
-		chunk_index      += 1;
-		chunk_offset     += internal_handle->media_values->chunk_size;
-		chunk_data_offset = 0;
-
-		internal_handle->io_handle->current_offset += (off64_t) read_size;
+		read_count = libbfio_pool_read_buffer(
+		              internal_handle->file_io_pool,
+		              range_file_io_pool_entry,
+		              &( ( (uint8_t *) chunks_buffer )[ buffer_offset ] ),
+		              range_size,
+		              error );
 
-		if( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size )
+		if( read_count != (ssize_t) range_size )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data.",
+			 function );
+
+			return( -1 );
 		}
-		if( internal_handle->io_handle->abort != 0 )
+		/* The checksum of an uncompressed chunk is stored after the chunk data
+		 */
+		while( range_chunk_index < chunk_iterator )
 		{
-			break;
-		}
-	}
-	return( total_read_count );
-}
-
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libewf_handle_read_random(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	static char *function = "libewf_handle_read_random";
-	ssize_t read_count    = 0;
+			if( ( chunk_flags[ range_chunk_index ] & LIBEWF_CHUNK_FLAG_IS_COMPRESSED ) == 0 )
+			{
+				if( chunk_data_sizes[ range_chunk_index ] < sizeof( uint32_t ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid chunk: %" PRIu64 " size value out of bounds.",
+					 function,
+					 chunk_indexes[ range_chunk_index ] );
 
-	if( libewf_handle_seek_offset(
-	     handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+					return( -1 );
+				}
+				chunk_data_sizes[ range_chunk_index ] -= sizeof( uint32_t );
 
-		return( -1 );
-	}
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              buffer,
-	              buffer_size,
-	              error );
+				chunk_data = &( ( (uint8_t *) chunks_buffer )[ chunk_data_offsets[ range_chunk_index ] ] );
 
-	if( read_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+				byte_stream_copy_to_uint32_little_endian(
+				 &( chunk_data[ chunk_data_sizes[ range_chunk_index ] ] ),
+				 chunk_checksums[ range_chunk_index ] );
 
-		return( -1 );
+				chunk_flags[ range_chunk_index ] |= LIBEWF_CHUNK_FLAG_HAS_CHECKSUM;
+			}
+			range_chunk_index++;
+		}
+		buffer_offset += range_size;
 	}
-	return( read_count );
+	return( chunk_iterator );
 }
 
-/* Prepares a chunk of (media) data before writing according to the handle settings
- * This function should be used before libewf_handle_write_chunk
- * The chunk_buffer_size should contain the actual chunk size
- * The function sets the chunk checksum, is compressed and write checksum values
- * Returns the resulting chunk size or -1 on error
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
  */
-ssize_t libewf_handle_prepare_write_chunk(
+ssize_t libewf_handle_read_buffer(
          libewf_handle_t *handle,
-         void *chunk_buffer,
-         size_t chunk_buffer_size,
-         void *compressed_chunk_buffer,
-         size_t *compressed_chunk_buffer_size,
-         int8_t *is_compressed,
-         uint32_t *chunk_checksum,
-         int8_t *write_checksum,
+         void *buffer,
+         size_t buffer_size,
          libcerror_error_t **error )
 {
+	libewf_chunk_data_t *chunk_data           = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_prepare_write_chunk";
-	size_t chunk_write_size                   = 0;
+	static char *function                     = "libewf_handle_read_buffer";
+	off64_t chunk_offset                      = 0;
+	size_t buffer_offset                      = 0;
+	size_t chunk_size                         = 0;
+	size_t read_size                          = 0;
+	ssize_t total_read_count                  = 0;
 	uint64_t chunk_index                      = 0;
-	int8_t compression_level                  = 0;
-	int chunk_exists                          = 0;
-	int is_empty_zero_block                   = 0;
+	uint64_t chunk_data_offset                = 0;
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -5082,6 +5356,17 @@ ssize_t libewf_handle_prepare_write_chunk(
 
 		return( -1 );
 	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->io_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
@@ -5115,338 +5400,257 @@ ssize_t libewf_handle_prepare_write_chunk(
 
 		return( -1 );
 	}
-	if( chunk_buffer == NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer_size > (size_t) SSIZE_MAX )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk buffer size value exceeds maximum.",
+		 "%s: invalid buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer_size > (size_t) internal_handle->media_values->chunk_size )
+	if( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
-		 "%s: invalid chunk buffer size: %" PRIzd " value exceeds media values chunk size: %" PRIu32 ".",
-		 function,
-		 chunk_buffer_size,
-		 internal_handle->media_values->chunk_size );
-
-		return( -1 );
+		return( 0 );
 	}
-	if( chunk_checksum == NULL )
+	if( (size64_t) ( internal_handle->io_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk checksum.",
-		 function );
-
-		return( -1 );
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->io_handle->current_offset );
 	}
-	if( is_compressed == NULL )
+	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid is compressed.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( write_checksum == NULL )
+	chunk_offset = chunk_index * internal_handle->media_values->chunk_size;
+
+	chunk_data_offset = internal_handle->io_handle->current_offset - chunk_offset;
+
+	if( chunk_data_offset >= (uint64_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid write checksum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer_size == 0 )
-	{
-		return( 0 );
-	}
-	if( internal_handle->read_io_handle != NULL )
+	while( buffer_size > 0 )
 	{
-		chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+		chunk_size = internal_handle->media_values->chunk_size;
 
-		if( chunk_index >= (uint64_t) INT_MAX )
+		if( (size64_t) ( chunk_offset + chunk_size ) > internal_handle->media_values->media_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid chunk index value exceeds maximum.",
-			 function );
-
-			return( -1 );
+			chunk_size = (size_t) ( internal_handle->media_values->media_size - chunk_offset );
 		}
-		chunk_exists = libmfdata_list_is_set(
-		                internal_handle->chunk_table_list,
-		                (int) chunk_index,
-		                error );
+		result = 0;
 
-		if( chunk_exists == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists in the chunk table list.",
-			 function,
-			 chunk_index );
+		/* Whole chunks are read directly into the buffer when the handle is opened read-only
+		 * which prevents copying the chunk data from the chunk table cache
+		 */
+		if( ( internal_handle->write_io_handle == NULL )
+		 && ( chunk_data_offset == 0 )
+		 && ( buffer_size >= chunk_size ) )
+		{
+			result = libewf_read_io_handle_read_chunk_data_to_buffer(
+			          internal_handle->read_io_handle,
+			          internal_handle->file_io_pool,
+			          internal_handle->media_values,
+			          internal_handle->chunk_table_list,
+			          internal_handle->chunk_table_cache,
+			          (int) chunk_index,
+			          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			          chunk_size,
+			          error );
 
-			return( -1 );
-		}
-		else if( chunk_exists == 0 )
-		{
-			if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-			 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunk: %" PRIu64 ".",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data: %" PRIu64 " into buffer.",
 				 function,
 				 chunk_index );
 
 				return( -1 );
 			}
+			read_size = chunk_size;
 		}
-	}
-	*is_compressed = 0;
-
-	if( chunk_exists == 0 )
-	{
-		compression_level = internal_handle->io_handle->compression_level;
-
-		/* Skip the empty block check only if the compression is none and
-		 * the empty block compression flag is not set.
-		 */
-		if( ( compression_level != EWF_COMPRESSION_NONE )
-		 || ( ( internal_handle->io_handle->compression_flags & LIBEWF_FLAG_COMPRESS_EMPTY_BLOCK ) != 0 ) )
-		{
-#if defined( TEST_EMPTY_BLOCK_MEMCMP )
-			if( memory_compare(
-			     chunk_buffer,
-			     &( ( (uint8_t *) chunk_buffer )[ 1 ] ),
-			     chunk_buffer_size - 1 ) == 0 )
-#else
-			result = libewf_empty_block_test(
-				  chunk_buffer,
-				  chunk_buffer_size,
-				  error );
-
-			if( result == -1 )
+		if( result == 0 )
+		{
+			if( libewf_read_io_handle_read_chunk_data(
+			     internal_handle->read_io_handle,
+			     internal_handle->file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->chunk_table_list,
+			     internal_handle->chunk_table_cache,
+			     (int) chunk_index,
+			     chunk_offset,
+			     &chunk_data,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if chunk buffer is empty.",
-				 function );
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data: %" PRIu64 ".",
+				 function,
+				 chunk_index );
 
 				return( -1 );
 			}
-			else if( result == 1 )
-#endif
-			{
-				if( ( (uint8_t *) chunk_buffer )[ 0 ] == 0 )
-				{
-					is_empty_zero_block = 1;
-				}
-				else if( compression_level == EWF_COMPRESSION_NONE )
-				{
-					compression_level = EWF_COMPRESSION_DEFAULT;
-				}
-			}
-		}
-		if( ( internal_handle->io_handle->ewf_format == EWF_FORMAT_S01 )
-		 || ( compression_level != EWF_COMPRESSION_NONE )
-		 || ( is_empty_zero_block != 0 ) )
-		{
-			if( compressed_chunk_buffer == NULL )
+			if( chunk_data == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-				 "%s: invalid compressed chunk buffer.",
-				 function );
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk data: %" PRIu64 ".",
+				 function,
+				 chunk_index );
 
 				return( -1 );
 			}
-			if( compressed_chunk_buffer == chunk_buffer )
+			if( chunk_data_offset > chunk_data->data_size )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-				 "%s: invalid compressed chunk buffer is the same as chunk buffer.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk offset exceeds chunk data size.",
 				 function );
 
 				return( -1 );
 			}
-			if( compressed_chunk_buffer_size == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-				 "%s: invalid compressed chunk buffer size.",
-				 function );
+			read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
 
-				return( -1 );
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
 			}
-			/* The compressed data size contains the maximum allowed buffer size on entry
-			 */
-			if( *compressed_chunk_buffer_size > (size_t) SSIZE_MAX )
+			if( read_size == 0 )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-				 "%s: invalid compressed chunk buffer size value exceeds maximum.",
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk data to buffer.",
 				 function );
 
 				return( -1 );
 			}
-			/* Use the cached version of the zero byte empty block data if available
-			 */
-			if( ( is_empty_zero_block != 0 )
-			 && ( (size_t) internal_handle->media_values->chunk_size == chunk_buffer_size )
-			 && ( internal_handle->write_io_handle->compressed_zero_byte_empty_block != NULL ) )
-			{
-				if( memory_copy(
-				     compressed_chunk_buffer,
-				     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-				     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy compressed zero byte empty block to compressed chunk buffer.",
-					 function );
-
-					return( -1 );
-				}
-				*compressed_chunk_buffer_size = internal_handle->write_io_handle->compressed_zero_byte_empty_block_size;
-			}
-			else
-			{
-				result = libewf_compress(
-					  (uint8_t *) compressed_chunk_buffer,
-					  compressed_chunk_buffer_size,
-					  (uint8_t *) chunk_buffer,
-					  chunk_buffer_size,
-					  compression_level,
-					  error );
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		chunk_index      += 1;
+		chunk_offset     += internal_handle->media_values->chunk_size;
+		chunk_data_offset = 0;
 
-				if( result != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
-					 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
-					 "%s: unable to compress chunk.",
-					 function );
+		internal_handle->io_handle->current_offset += (off64_t) read_size;
 
-					return( -1 );
-				}
-			}
-			if( ( internal_handle->io_handle->ewf_format == EWF_FORMAT_S01 )
-			 || ( *compressed_chunk_buffer_size < chunk_buffer_size ) )
-			{
-				*is_compressed = 1;
-			}
+		if( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
 		}
 	}
-	if( *is_compressed == 0 )
-	{
-		*chunk_checksum = ewf_checksum_calculate(
-		                   chunk_buffer,
-		                   chunk_buffer_size,
-		                   1 );
+	return( total_read_count );
+}
 
-		chunk_write_size = chunk_buffer_size;
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_handle_read_random(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_handle_read_random";
+	ssize_t read_count    = 0;
 
-		*write_checksum = 1;
-	}
-	else
+	if( libewf_handle_seek_offset(
+	     handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
 	{
-		/* Zlib creates its own checksum
-		 */
-		if( memory_copy(
-		     chunk_checksum,
-		     &( ( (uint8_t *) compressed_chunk_buffer )[ *compressed_chunk_buffer_size - sizeof( uint32_t ) ] ),
-		     sizeof( uint32_t ) ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to set checksum.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
 
-			return( -1 );
-		}
-		chunk_write_size = *compressed_chunk_buffer_size;
+		return( -1 );
+	}
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              buffer_size,
+	              error );
 
-		*write_checksum = 0;
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
 	}
-	return( (ssize_t) chunk_write_size );
+	return( read_count );
 }
 
-/* Writes a chunk of (media) data in EWF format at the current offset
- * the necessary settings of the write values must have been made
- * chunk_buffer_size contains the size of the data within the buffer while
- * data_size contains the size of the actual input data
- * Will initialize write if necessary
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Sets the number of threads used to process asynchronous read requests
+ * The number of threads cannot be changed after the first asynchronous read request was submitted
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_chunk(
-         libewf_handle_t *handle,
-         const void *chunk_buffer,
-         size_t chunk_buffer_size,
-         size_t data_size,
-         int8_t is_compressed,
-         void *checksum_buffer,
-         uint32_t chunk_checksum,
-         int8_t write_checksum,
-         libcerror_error_t **error )
+int libewf_handle_set_number_of_read_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_chunk";
-	ssize_t write_count                       = 0;
-	uint64_t chunk_index                      = 0;
-	int chunk_exists                          = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	int number_of_chunks                      = 0;
-#endif
+	static char *function                     = "libewf_handle_set_number_of_read_threads";
 
 	if( handle == NULL )
 	{
@@ -5461,289 +5665,303 @@ ssize_t libewf_handle_write_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->chunk_data != NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_handle->async_read_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 "%s: invalid handle - async read handle value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle->current_offset < 0 )
+#endif
+	if( number_of_threads <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+	internal_handle->number_of_read_threads = number_of_threads;
 
-		return( -1 );
-	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	return( 1 );
+}
+
+/* Submits an asynchronous request to read (media) data at a specific offset
+ * The asynchronous read handle and its threads are created on the first request
+ * Returns 1 if successful, 0 if the maximum number of outstanding requests was reached or -1 on error
+ */
+int libewf_handle_submit_read_random(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libewf_handle_t *handle,
+            ssize_t read_count,
+            intptr_t *user_data ),
+     intptr_t *user_data,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_submit_read_random";
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int result                                = 0;
+#endif
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( internal_handle->read_io_handle == NULL )
+	 || ( internal_handle->write_io_handle != NULL ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - not opened for reading only.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_handle->async_read_handle == NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		if( libewf_async_read_handle_initialize(
+		     &( internal_handle->async_read_handle ),
+		     handle,
+		     internal_handle->number_of_read_threads,
+		     LIBEWF_ASYNC_READ_MAXIMUM_NUMBER_OF_REQUESTS,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 "%s: unable to create async read handle.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	if( chunk_buffer == NULL )
+	result = libewf_async_read_handle_submit(
+	          internal_handle->async_read_handle,
+	          (uint8_t *) buffer,
+	          buffer_size,
+	          offset,
+	          callback_function,
+	          user_data,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to submit read request.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > internal_handle->media_values->chunk_size )
+	return( result );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: asynchronous reads require multi-thread support.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Retrieves the user data and read count of an asynchronous read request
+ * that was submitted without a callback function
+ * Returns 1 if successful, 0 if no completion is available or -1 on error
+ */
+int libewf_handle_get_read_completion(
+     libewf_handle_t *handle,
+     intptr_t **user_data,
+     ssize_t *read_count,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_read_completion";
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int result                                = 0;
+#endif
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: data size cannot be larger than maximum chunk size.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	if( chunk_buffer_size == 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_handle->async_read_handle == NULL )
 	{
 		return( 0 );
 	}
-	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+	result = libewf_async_read_handle_get_completion(
+	          internal_handle->async_read_handle,
+	          user_data,
+	          read_count,
+	          wait_for_completion,
+	          error );
 
-	if( chunk_index >= (uint64_t) INT_MAX )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read completion.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->io_handle->current_offset + data_size ) >= internal_handle->media_values->media_size ) )
-	{
-		data_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->io_handle->current_offset );
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( libmfdata_list_get_number_of_elements(
-		     internal_handle->chunk_table_list,
-		     &number_of_chunks,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of chunks in the chunk table list.",
-			 function );
-
-			return( -1 );
-		}
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of total: %d.\n",
-		 function,
-		 chunk_index,
-		 number_of_chunks );
+	return( result );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: asynchronous reads require multi-thread support.",
+	 function );
 
-		libcnotify_printf(
-		 "%s: writing chunk buffer of size: %" PRIzd " with data of size: %" PRIzd ".\n",
-		 function,
-		 chunk_buffer_size,
-		 data_size );
-	}
+	return( -1 );
 #endif
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		chunk_exists = libmfdata_list_is_set(
-		                internal_handle->chunk_table_list,
-		                (int) chunk_index,
-		                error );
+}
 
-		if( chunk_exists == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists in the chunk table list.",
-			 function,
-			 chunk_index );
+/* Sets the number of threads used to pack (compress) chunks while writing
+ * If set the chunks written by libewf_handle_write_buffer are packed concurrently
+ * and written in order, 0 (the default) packs the chunks in the writing thread
+ * The number of threads cannot be changed after the first chunk was packed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_compression_threads";
 
-			return( -1 );
-		}
-		else if( chunk_exists == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 ".",
-			 function,
-			 chunk_index );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			return( -1 );
-		}
-		write_count = libewf_write_io_handle_write_existing_chunk(
-		               internal_handle->write_io_handle,
-		               internal_handle->io_handle,
-		               internal_handle->file_io_pool,
-		               internal_handle->media_values,
-		               internal_handle->delta_segment_files_list,
-		               internal_handle->segment_files_cache,
-		               internal_handle->delta_segment_table,
-		               internal_handle->chunk_table_list,
-		               internal_handle->header_sections,
-		               (int) chunk_index,
-		               (uint8_t *) chunk_buffer,
-		               chunk_buffer_size,
-		               data_size,
-		               is_compressed,
-		               (uint8_t *) checksum_buffer,
-		               chunk_checksum,
-		               write_checksum,
-		               error );
+		return( -1 );
 	}
-	else
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->compression_pool != NULL ) )
 	{
-		write_count = libewf_write_io_handle_write_new_chunk(
-		               internal_handle->write_io_handle,
-		               internal_handle->io_handle,
-		               internal_handle->file_io_pool,
-		               internal_handle->media_values,
-		               internal_handle->segment_files_list,
-		               internal_handle->segment_files_cache,
-		               internal_handle->segment_table,
-		               internal_handle->chunk_table_list,
-		               internal_handle->header_values,
-		               internal_handle->hash_values,
-		               internal_handle->header_sections,
-		               internal_handle->hash_sections,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               (int) chunk_index,
-		               (uint8_t *) chunk_buffer,
-		               chunk_buffer_size,
-		               data_size,
-		               is_compressed,
-		               (uint8_t *) checksum_buffer,
-		               chunk_checksum,
-		               write_checksum,
-		               error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - invalid write IO handle - compression pool value already set.",
+		 function );
+
+		return( -1 );
 	}
-	if( write_count < 0 )
+#endif
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write raw chunk data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->current_offset += (off64_t) data_size;
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: compression threads require multi-thread support.",
+		 function );
 
-	return( (ssize_t) chunk_buffer_size );
+		return( -1 );
+	}
+#endif
+	internal_handle->number_of_compression_threads = number_of_threads;
+
+	return( 1 );
 }
 
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Prepares a chunk of (media) data before writing according to the handle settings
+ * This function should be used before libewf_handle_write_chunk
+ * The chunk_buffer_size should contain the actual chunk size
+ * The function sets the chunk checksum, is compressed and write checksum values
+ * Returns the resulting chunk size or -1 on error
  */
-ssize_t libewf_handle_write_buffer(
+ssize_t libewf_handle_prepare_write_chunk(
          libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         void *compressed_chunk_buffer,
+         size_t *compressed_chunk_buffer_size,
+         int8_t *is_compressed,
+         uint32_t *chunk_checksum,
+         int8_t *write_checksum,
          libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data           = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	off64_t chunk_offset                      = 0;
-	size_t buffer_offset                      = 0;
-	size_t chunk_data_size                    = 0;
-	size_t write_size                         = 0;
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_prepare_write_chunk";
+	size_t chunk_write_size                   = 0;
 	uint64_t chunk_index                      = 0;
-	uint64_t chunk_data_offset                = 0;
+	uint64_t end_time                         = 0;
+	uint64_t start_time                       = 0;
+	uint8_t is_compression_skipped            = 0;
+	uint8_t is_empty_zero_block               = 0;
+	int8_t compression_level                  = 0;
 	int chunk_exists                          = 0;
-	int write_chunk                           = 0;
+	int result                                = 0;
+	int zlib_compression_level                = 0;
 
 	if( handle == NULL )
 	{
@@ -5780,21 +5998,6 @@ ssize_t libewf_handle_write_buffer(
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
-
-			return( -1 );
-		}
-	}
 	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
@@ -5817,113 +6020,97 @@ ssize_t libewf_handle_write_buffer(
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( chunk_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( buffer == NULL )
+	if( chunk_buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( chunk_buffer_size > (size_t) internal_handle->media_values->chunk_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+		 "%s: invalid chunk buffer size: %" PRIzd " value exceeds media values chunk size: %" PRIu32 ".",
+		 function,
+		 chunk_buffer_size,
+		 internal_handle->media_values->chunk_size );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle->current_offset < 0 )
+	if( chunk_checksum == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk checksum.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->io_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
-	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->io_handle->current_offset );
-	}
-	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	if( chunk_index >= (uint64_t) INT_MAX )
+	if( is_compressed == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is compressed.",
 		 function );
 
 		return( -1 );
 	}
-	chunk_offset = chunk_index * internal_handle->media_values->chunk_size;
-
-	chunk_data_offset = internal_handle->io_handle->current_offset - chunk_offset;
-
-	if( chunk_data_offset >= (uint64_t) SSIZE_MAX )
+	if( write_checksum == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write checksum.",
 		 function );
 
 		return( -1 );
 	}
-	while( buffer_size > 0 )
+	if( chunk_buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( internal_handle->read_io_handle != NULL )
 	{
+		chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		if( chunk_index >= (uint64_t) INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid chunk index value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
 		chunk_exists = libmfdata_list_is_set(
-				internal_handle->chunk_table_list,
-				(int) chunk_index,
-				error );
+		                internal_handle->chunk_table_list,
+		                (int) chunk_index,
+		                error );
 
 		if( chunk_exists == -1 )
 		{
@@ -5937,10 +6124,10 @@ ssize_t libewf_handle_write_buffer(
 
 			return( -1 );
 		}
-		if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-		 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+		else if( chunk_exists == 0 )
 		{
-			if( chunk_exists == 0 )
+			if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+			 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
 			{
 				libcerror_error_set(
 				 error,
@@ -5952,491 +6139,269 @@ ssize_t libewf_handle_write_buffer(
 
 				return( -1 );
 			}
-			if( ( chunk_data_offset != 0 )
-			 || ( buffer_size < internal_handle->media_values->chunk_size ) )
-			{
-				if( libewf_read_io_handle_read_chunk_data(
-				     internal_handle->read_io_handle,
-				     internal_handle->file_io_pool,
-				     internal_handle->media_values,
-				     internal_handle->chunk_table_list,
-				     internal_handle->chunk_table_cache,
-				     (int) chunk_index,
-				     chunk_offset,
-				     &chunk_data,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
+		}
+	}
+	*is_compressed = 0;
 
-					return( -1 );
-				}
-				if( chunk_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
+	if( chunk_exists == 0 )
+	{
+		if( libewf_chunk_data_determine_compression_level(
+		     (uint8_t *) chunk_buffer,
+		     chunk_buffer_size,
+		     internal_handle->io_handle->compression_level,
+		     internal_handle->io_handle->compression_flags,
+		     internal_handle->io_handle->ewf_format,
+		     &compression_level,
+		     &is_empty_zero_block,
+		     &is_compression_skipped,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression level.",
+			 function );
 
-					return( -1 );
-				}
-				if( chunk_data_offset > chunk_data->data_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: chunk offset exceeds chunk data size.",
-					 function );
+			return( -1 );
+		}
+		if( ( internal_handle->io_handle->ewf_format == EWF_FORMAT_S01 )
+		 || ( compression_level != EWF_COMPRESSION_NONE )
+		 || ( is_empty_zero_block != 0 ) )
+		{
+			if( compressed_chunk_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+				 "%s: invalid compressed chunk buffer.",
+				 function );
 
-					return( -1 );
-				}
-				write_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
-
-				if( write_size > buffer_size )
-				{
-					write_size = buffer_size;
-				}
-				if( write_size == 0 )
-				{
-					break;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: updating chunk data: %" PRIu64 " at offset: %" PRIu64 " with size: %" PRIzd ".\n",
-					 function,
-					 chunk_index,
-					 chunk_data_offset,
-					 write_size );
-				}
-#endif
-			}
-			else
-			{
-				/* Reserve 4 bytes for the chunk checksum
-				 */
-				if( libewf_chunk_data_initialize(
-				     &chunk_data,
-				     (size_t) internal_handle->media_values->chunk_size + sizeof( uint32_t ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
-
-					return( -1 );
-				}
-				if( chunk_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
-
-					return( -1 );
-				}
-				if( libmfdata_list_set_element_value_by_index(
-				     internal_handle->chunk_table_list,
-				     internal_handle->chunk_table_cache,
-				     (int) chunk_index,
-				     (intptr_t *) chunk_data,
-				     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-				     LIBMFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
-
-					libewf_chunk_data_free(
-					 &chunk_data,
-					 NULL );
-
-					return( -1 );
-				}
-				chunk_data->data_size = internal_handle->media_values->chunk_size;
-
-				write_size = chunk_data->data_size;
-			}
-			if( memory_copy(
-			     &( ( chunk_data->data )[ chunk_data_offset ] ),
-			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-			     write_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy buffer to chunk data.",
-				 function );
-
-				return( -1 );
-			}
-			buffer_offset += write_size;
-			buffer_size   -= write_size;
-
-			chunk_data_size = chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     chunk_data,
-			     EWF_COMPRESSION_NONE,
-			     0,
-			     EWF_FORMAT_D01,
-			     internal_handle->media_values->chunk_size,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk data: %" PRIu64 ".",
-				 function,
-				 chunk_index );
+				return( -1 );
+			}
+			if( compressed_chunk_buffer == chunk_buffer )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+				 "%s: invalid compressed chunk buffer is the same as chunk buffer.",
+				 function );
 
 				return( -1 );
 			}
-			write_count = libewf_write_io_handle_write_existing_chunk(
-				       internal_handle->write_io_handle,
-				       internal_handle->io_handle,
-				       internal_handle->file_io_pool,
-				       internal_handle->media_values,
-				       internal_handle->delta_segment_files_list,
-				       internal_handle->segment_files_cache,
-				       internal_handle->delta_segment_table,
-				       internal_handle->chunk_table_list,
-				       internal_handle->header_sections,
-				       (int) chunk_index,
-				       chunk_data->data,
-				       chunk_data->data_size,
-				       chunk_data_size,
-				       0,
-				       NULL,
-				       0,
-				       0,
-				       error );
-
-			if( write_count <= 0 )
+			if( compressed_chunk_buffer_size == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write existing chunk.",
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+				 "%s: invalid compressed chunk buffer size.",
 				 function );
 
 				return( -1 );
 			}
-		}
-		else
-		{
-			if( internal_handle->write_io_handle->write_finalized != 0 )
-			{
-				break;
-			}
-			if( chunk_exists != 0 )
+			/* The compressed data size contains the maximum allowed buffer size on entry
+			 */
+			if( *compressed_chunk_buffer_size > (size_t) SSIZE_MAX )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-				 "%s: chunk: %" PRIu64 " already set.",
-				 function,
-				 chunk_index );
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid compressed chunk buffer size value exceeds maximum.",
+				 function );
 
 				return( -1 );
 			}
-			if( internal_handle->chunk_data == NULL )
+			/* Use the cached version of the zero byte empty block data if available
+			 */
+			if( ( is_empty_zero_block != 0 )
+			 && ( (size_t) internal_handle->media_values->chunk_size == chunk_buffer_size )
+			 && ( internal_handle->write_io_handle->compressed_zero_byte_empty_block != NULL ) )
 			{
-				/* Reserve 4 bytes for the chunk checksum
-				 */
-				if( libewf_chunk_data_initialize(
-				     &( internal_handle->chunk_data ),
-				     (size_t) internal_handle->media_values->chunk_size + sizeof( uint32_t ),
-				     error ) != 1 )
+				if( memory_copy(
+				     compressed_chunk_buffer,
+				     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+				     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size ) == NULL )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy compressed zero byte empty block to compressed chunk buffer.",
+					 function );
 
 					return( -1 );
 				}
-				if( internal_handle->chunk_data == NULL )
+				*compressed_chunk_buffer_size = internal_handle->write_io_handle->compressed_zero_byte_empty_block_size;
+			}
+			else
+			{
+				if( internal_handle->statistics != NULL )
+				{
+					start_time = libewf_statistics_get_time();
+				}
+				if( ( compression_level != EWF_COMPRESSION_NONE )
+				 && ( ( internal_handle->io_handle->zlib_compression_level != 0 )
+				  || ( internal_handle->io_handle->zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_DEFAULT )
+				  || ( internal_handle->io_handle->zlib_window_bits != 0 )
+				  || ( internal_handle->io_handle->zlib_memory_level != 0 ) ) )
+				{
+					zlib_compression_level = internal_handle->io_handle->zlib_compression_level;
+
+					if( zlib_compression_level == 0 )
+					{
+						result = libewf_compression_get_zlib_compression_level(
+						          compression_level,
+						          &zlib_compression_level,
+						          error );
+					}
+					else
+					{
+						result = 1;
+					}
+					if( result == 1 )
+					{
+						result = libewf_compress_with_zlib_values(
+							  (uint8_t *) compressed_chunk_buffer,
+							  compressed_chunk_buffer_size,
+							  (uint8_t *) chunk_buffer,
+							  chunk_buffer_size,
+							  zlib_compression_level,
+							  internal_handle->io_handle->zlib_strategy,
+							  internal_handle->io_handle->zlib_window_bits,
+							  internal_handle->io_handle->zlib_memory_level,
+							  error );
+					}
+				}
+				else
+				{
+					result = libewf_compress(
+						  (uint8_t *) compressed_chunk_buffer,
+						  compressed_chunk_buffer_size,
+						  (uint8_t *) chunk_buffer,
+						  chunk_buffer_size,
+						  compression_level,
+						  error );
+				}
+
+				if( result != 1 )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
+					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+					 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+					 "%s: unable to compress chunk.",
+					 function );
 
 					return( -1 );
 				}
-			}
-			if( internal_handle->chunk_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: internal handle - missing chunk data: %" PRIu64 ".",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			if( chunk_data_offset > internal_handle->media_values->chunk_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: chunk offset exceeds chunk data size.",
-				 function );
+				if( internal_handle->statistics != NULL )
+				{
+					end_time = libewf_statistics_get_time();
 
-				return( -1 );
-			}
-			write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+					internal_handle->statistics->number_of_bytes_compressed += (uint64_t) chunk_buffer_size;
+					internal_handle->statistics->compression_time           += end_time - start_time;
 
-			if( write_size > buffer_size )
-			{
-				write_size = buffer_size;
+					if( internal_handle->statistics->trace != NULL )
+					{
+						if( libewf_trace_append_event(
+						     internal_handle->statistics->trace,
+						     LIBEWF_TRACE_STAGE_COMPRESS,
+						     internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size,
+						     -1,
+						     start_time,
+						     end_time,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+							 "%s: unable to append compress event to trace.",
+							 function );
+
+							return( -1 );
+						}
+					}
+				}
 			}
-			if( write_size == 0 )
+			if( ( internal_handle->io_handle->ewf_format == EWF_FORMAT_S01 )
+			 || ( *compressed_chunk_buffer_size < chunk_buffer_size ) )
 			{
-				break;
-			}
-			if( memory_copy(
-			     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-			     write_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy buffer to chunk data.",
-				 function );
-
-				return( -1 );
-			}
-			internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
-
-			buffer_offset += write_size;
-			buffer_size   -= write_size;
-
-			if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-			{
-				write_chunk = 1;
-			}
-			else if( ( internal_handle->media_values->media_size != 0 )
-			      && ( ( (size64_t) internal_handle->io_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-			{
-				write_chunk = 1;
-			}
-			else
-			{
-				write_chunk = 0;
-			}
-			if( write_chunk != 0 )
-			{
-				chunk_data_size = internal_handle->chunk_data->data_size;
-
-				if( libewf_chunk_data_pack(
-				     internal_handle->chunk_data,
-				     internal_handle->io_handle->compression_level,
-				     internal_handle->io_handle->compression_flags,
-				     internal_handle->io_handle->ewf_format,
-				     internal_handle->media_values->chunk_size,
-				     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-				     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GENERIC,
-					 "%s: unable to pack chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
-
-					return( -1 );
-				}
-				write_count = libewf_write_io_handle_write_new_chunk(
-					       internal_handle->write_io_handle,
-					       internal_handle->io_handle,
-					       internal_handle->file_io_pool,
-					       internal_handle->media_values,
-					       internal_handle->segment_files_list,
-					       internal_handle->segment_files_cache,
-					       internal_handle->segment_table,
-					       internal_handle->chunk_table_list,
-					       internal_handle->header_values,
-					       internal_handle->hash_values,
-					       internal_handle->header_sections,
-					       internal_handle->hash_sections,
-					       internal_handle->sessions,
-					       internal_handle->tracks,
-					       internal_handle->acquiry_errors,
-					       (int) chunk_index,
-					       internal_handle->chunk_data->data,
-					       internal_handle->chunk_data->data_size,
-					       chunk_data_size,
-					       internal_handle->chunk_data->is_compressed,
-					       NULL,
-					       0,
-					       0,
-					       error );
-
-				if( write_count <= 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to write new chunk.",
-					 function );
-
-					return( -1 );
-				}
-				if( libmfdata_list_set_element_value_by_index(
-				     internal_handle->chunk_table_list,
-				     internal_handle->chunk_table_cache,
-				     (int) chunk_index,
-				     (intptr_t *) internal_handle->chunk_data,
-				     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-				     LIBMFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set chunk data: %" PRIu64 ".",
-					 function,
-					 chunk_index );
-
-					return( -1 );
-				}
-				internal_handle->chunk_data = NULL;
+				*is_compressed = 1;
 			}
 		}
-		chunk_index      += 1;
-		chunk_offset     += internal_handle->media_values->chunk_size;
-		chunk_data_offset = 0;
+		libewf_statistics_count_packed_chunk(
+		 internal_handle->statistics,
+		 (uint8_t) *is_compressed,
+		 is_compression_skipped );
+	}
+	if( *is_compressed == 0 )
+	{
+		*chunk_checksum = ewf_checksum_calculate(
+		                   chunk_buffer,
+		                   chunk_buffer_size,
+		                   1 );
 
-		internal_handle->io_handle->current_offset += (off64_t) write_size;
+		chunk_write_size = chunk_buffer_size;
 
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size ) )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
+		*write_checksum = 1;
+	}
+	else
+	{
+		/* Zlib creates its own checksum
+		 */
+		if( memory_copy(
+		     chunk_checksum,
+		     &( ( (uint8_t *) compressed_chunk_buffer )[ *compressed_chunk_buffer_size - sizeof( uint32_t ) ] ),
+		     sizeof( uint32_t ) ) == NULL )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set checksum.",
+			 function );
+
+			return( -1 );
 		}
+		chunk_write_size = *compressed_chunk_buffer_size;
+
+		*write_checksum = 0;
 	}
-	return( (ssize_t) buffer_offset );
+	return( (ssize_t) chunk_write_size );
 }
 
-/* Writes (media) data at a specific offset,
+/* Writes a chunk of (media) data in EWF format at the current offset
  * the necessary settings of the write values must have been made
+ * chunk_buffer_size contains the size of the data within the buffer while
+ * data_size contains the size of the actual input data
  * Will initialize write if necessary
  * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
  */
-ssize_t libewf_handle_write_random(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	static char *function = "libewf_handle_write_random";
-	ssize_t write_count   = 0;
-
-	if( libewf_handle_seek_offset(
-	     handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		return( -1 );
-	}
-	write_count = libewf_handle_write_buffer(
-	               handle,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer.",
-		 function );
-
-		return( -1 );
-	}
-	return( write_count );
-}
-
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
- */
-ssize_t libewf_handle_write_finalize(
+ssize_t libewf_handle_write_chunk(
          libewf_handle_t *handle,
+         const void *chunk_buffer,
+         size_t chunk_buffer_size,
+         size_t data_size,
+         int8_t is_compressed,
+         void *checksum_buffer,
+         uint32_t chunk_checksum,
+         int8_t write_checksum,
          libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_file_t *segment_file       = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	void *reallocation                        = NULL;
-	off64_t segment_file_offset               = 0;
-	size_t chunk_data_size                    = 0;
+	static char *function                     = "libewf_handle_write_chunk";
 	ssize_t write_count                       = 0;
-	ssize_t write_finalize_count              = 0;
 	uint64_t chunk_index                      = 0;
-	int file_io_pool_entry                    = -1;
-	int number_of_segment_files               = 0;
-	int segment_files_list_index              = 0;
+	int chunk_exists                          = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	int number_of_chunks                      = 0;
+#endif
 
 	if( handle == NULL )
 	{
@@ -6462,39 +6427,24 @@ ssize_t libewf_handle_write_finalize(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle->current_offset < 0 )
+	if( internal_handle->chunk_data != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( internal_handle->write_io_handle == NULL )
+	if( internal_handle->io_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -6521,495 +6471,3349 @@ ssize_t libewf_handle_write_finalize(
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		return( 0 );
-	}
-	chunk_index = internal_handle->io_handle->current_offset
-	            / internal_handle->media_values->chunk_size;
-
-	if( chunk_index >= (uint64_t) INT_MAX )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->write_io_handle->values_initialized == 0 )
 	{
-		chunk_data_size = internal_handle->chunk_data->data_size;
-
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle->compression_level,
-		     internal_handle->io_handle->compression_flags,
-		     internal_handle->io_handle->ewf_format,
-		     internal_handle->media_values->chunk_size,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk data: %" PRIu64 ".",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       internal_handle->file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_files_list,
-			       internal_handle->segment_files_cache,
-			       internal_handle->segment_table,
-			       internal_handle->chunk_table_list,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->header_sections,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       (int) chunk_index,
-			       internal_handle->chunk_data->data,
-			       internal_handle->chunk_data->data_size,
-			       chunk_data_size,
-			       internal_handle->chunk_data->is_compressed,
-			       NULL,
-			       0,
-			       0,
-			       error );
-
-		if( write_count <= 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
 			 function );
 
 			return( -1 );
 		}
-		write_finalize_count += write_count;
-
-		if( libmfdata_list_set_element_value_by_index(
-		     internal_handle->chunk_table_list,
-		     internal_handle->chunk_table_cache,
-		     (int) chunk_index,
-		     (intptr_t *) internal_handle->chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBMFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		if( libewf_chunk_data_pool_set_chunk_size(
+		     internal_handle->chunk_data_pool,
+		     internal_handle->media_values->chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set chunk data: %" PRIu64 ".",
-			 function,
-			 chunk_index );
+			 "%s: unable to set chunk data pool chunk size.",
+			 function );
 
 			return( -1 );
 		}
-		internal_handle->chunk_data = NULL;
 	}
-	/* Check if all media data has been written
-	 */
+	if( chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > internal_handle->media_values->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: data size cannot be larger than maximum chunk size.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	 && ( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size ) )
 	{
-		return( write_finalize_count );
+		return( 0 );
 	}
-	if( libmfdata_file_list_get_number_of_files(
-	     internal_handle->segment_files_list,
-	     &number_of_segment_files,
-	     error ) != 1 )
+	if( chunk_buffer_size == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Write the chunks outstanding in the compression pool first
+	 */
+	if( libewf_internal_handle_write_packed_chunks(
+	     internal_handle,
+	     error ) < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segment files.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write packed chunks.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( number_of_segment_files < 0 )
-	 || ( number_of_segment_files > (int) UINT16_MAX ) )
+#endif
+	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
 		 error,
-	 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of segment files value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segment_files == 0 )
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->io_handle->current_offset + data_size ) >= internal_handle->media_values->media_size ) )
 	{
-		/* No segment file need to be created
-		 */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the headers if required
-		 */
-		if( internal_handle->header_sections == NULL )
+		data_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->io_handle->current_offset );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( libmfdata_list_get_number_of_elements(
+		     internal_handle->chunk_table_list,
+		     &number_of_chunks,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid header sections.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of chunks in the chunk table list.",
 			 function );
 
 			return( -1 );
 		}
-		if( ( internal_handle->header_sections->header == NULL )
-		 && ( internal_handle->header_sections->header2 == NULL )
-		 && ( internal_handle->header_sections->xheader == NULL ) )
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of total: %d.\n",
+		 function,
+		 chunk_index,
+		 number_of_chunks );
+
+		libcnotify_printf(
+		 "%s: writing chunk buffer of size: %" PRIzd " with data of size: %" PRIzd ".\n",
+		 function,
+		 chunk_buffer_size,
+		 data_size );
+	}
+#endif
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		chunk_exists = libmfdata_list_is_set(
+		                internal_handle->chunk_table_list,
+		                (int) chunk_index,
+		                error );
+
+		if( chunk_exists == -1 )
 		{
-			if( libewf_header_sections_generate(
-			     internal_handle->header_sections,
-			     internal_handle->header_values,
-			     time( NULL ),
-			     internal_handle->io_handle->compression_level,
-			     internal_handle->io_handle->format,
-			     internal_handle->io_handle->header_codepage,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create header(s).",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists in the chunk table list.",
+			 function,
+			 chunk_index );
 
-				return( -1 );
-			}
+			return( -1 );
 		}
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     internal_handle->file_io_pool,
-		     internal_handle->segment_files_list,
-		     internal_handle->segment_files_cache,
-		     internal_handle->segment_table,
-		     1,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     LIBEWF_SEGMENT_FILE_TYPE_EWF,
-		     &segment_file,
-		     &segment_files_list_index,
-		     &file_io_pool_entry,
-		     error ) != 1 )
+		else if( chunk_exists == 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 1.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
 
 			return( -1 );
 		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
+		write_count = libewf_write_io_handle_write_existing_chunk(
+		               internal_handle->write_io_handle,
 		               internal_handle->io_handle,
 		               internal_handle->file_io_pool,
-		               file_io_pool_entry,
 		               internal_handle->media_values,
+		               internal_handle->delta_segment_files_list,
+		               internal_handle->segment_files_cache,
+		               internal_handle->delta_segment_table,
+		               internal_handle->chunk_table_list,
 		               internal_handle->header_sections,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file start.",
-			 function );
-
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+		               (int) chunk_index,
+		               (uint8_t *) chunk_buffer,
+		               chunk_buffer_size,
+		               data_size,
+		               is_compressed,
+		               (uint8_t *) checksum_buffer,
+		               chunk_checksum,
+		               write_checksum,
+		               error );
 	}
 	else
 	{
-		segment_files_list_index = number_of_segment_files - 1;
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               internal_handle->file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->segment_files_list,
+		               internal_handle->segment_files_cache,
+		               internal_handle->segment_table,
+		               internal_handle->chunk_table_list,
+		               internal_handle->header_values,
+		               internal_handle->hash_values,
+		               internal_handle->header_sections,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               (int) chunk_index,
+		               (uint8_t *) chunk_buffer,
+		               chunk_buffer_size,
+		               data_size,
+		               is_compressed,
+		               (uint8_t *) checksum_buffer,
+		               chunk_checksum,
+		               write_checksum,
+		               error );
+	}
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write raw chunk data.",
+		 function );
 
-		if( libmfdata_file_list_get_file_by_index(
-		     internal_handle->segment_files_list,
-		     segment_files_list_index,
-		     &file_io_pool_entry,
-		     error ) != 1 )
+		return( -1 );
+	}
+	internal_handle->io_handle->current_offset += (off64_t) data_size;
+
+	return( (ssize_t) chunk_buffer_size );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	off64_t chunk_offset                      = 0;
+	size_t buffer_offset                      = 0;
+	size_t chunk_data_size                    = 0;
+	size_t write_size                         = 0;
+	ssize_t write_count                       = 0;
+	uint64_t chunk_index                      = 0;
+	uint64_t chunk_data_offset                = 0;
+	uint64_t end_time                         = 0;
+	uint64_t start_time                       = 0;
+	int chunk_exists                          = 0;
+	int write_chunk                           = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int result                                = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %d from list.",
-			 function,
-			 segment_files_list_index + 1 );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
 
 			return( -1 );
 		}
-		if( libmfdata_file_list_get_file_value_by_index(
-		     internal_handle->segment_files_list,
-		     internal_handle->file_io_pool,
-		     internal_handle->segment_files_cache,
-		     segment_files_list_index,
-		     (intptr_t **) &segment_file,
-		     0,
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %d value from list.",
-			 function,
-			 segment_files_list_index + 1 );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
 
 			return( -1 );
 		}
-		if( segment_file == NULL )
+		if( libewf_chunk_data_pool_set_chunk_size(
+		     internal_handle->chunk_data_pool,
+		     internal_handle->media_values->chunk_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %d.",
-			 function,
-			 segment_files_list_index + 1 );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk data pool chunk size.",
+			 function );
 
 			return( -1 );
 		}
 	}
-	/* Set segment file to the correct offset if write is resumed
-	 */
-	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	if( buffer == NULL )
 	{
-		if( libbfio_pool_seek_offset(
-		     internal_handle->file_io_pool,
-		     file_io_pool_entry,
-		     internal_handle->write_io_handle->resume_segment_file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %d.",
-			 function,
-			 internal_handle->write_io_handle->resume_segment_file_offset,
-			 segment_files_list_index + 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-			return( -1 );
-		}
-		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+		return( -1 );
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
-		if( libbfio_pool_get_offset(
-		     internal_handle->file_io_pool,
-		     file_io_pool_entry,
-		     &segment_file_offset,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve current offset in segment file.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->io_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->io_handle->current_offset );
+	}
+	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = chunk_index * internal_handle->media_values->chunk_size;
+
+	chunk_data_offset = internal_handle->io_handle->current_offset - chunk_offset;
+
+	if( chunk_data_offset >= (uint64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		chunk_exists = libmfdata_list_is_set(
+				internal_handle->chunk_table_list,
+				(int) chunk_index,
+				error );
+
+		if( chunk_exists == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists in the chunk table list.",
+			 function,
+			 chunk_index );
 
 			return( -1 );
 		}
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+		 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
 		{
-			/* Correct the offset, size in the chunks section
-			 */
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			if( chunk_exists == 0 )
 			{
-				libcnotify_printf(
-				 "%s: correcting chunks section.\n",
-				 function );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
 			}
-#endif
-			if( internal_handle->write_io_handle->number_of_table_offsets < internal_handle->write_io_handle->number_of_chunks_written_to_section )
+			/* The chunk data of the previous chunk is managed by the chunk table cache
+			 */
+			chunk_data = NULL;
+
+			if( ( chunk_data_offset != 0 )
+			 || ( buffer_size < internal_handle->media_values->chunk_size ) )
 			{
-				reallocation = memory_reallocate(
-				                internal_handle->write_io_handle->table_offsets,
-				                sizeof( ewf_table_offset_t ) * internal_handle->write_io_handle->number_of_chunks_written_to_section );
+				if( libewf_read_io_handle_read_chunk_data(
+				     internal_handle->read_io_handle,
+				     internal_handle->file_io_pool,
+				     internal_handle->media_values,
+				     internal_handle->chunk_table_list,
+				     internal_handle->chunk_table_cache,
+				     (int) chunk_index,
+				     chunk_offset,
+				     &chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
 
-				if( reallocation == NULL )
+					return( -1 );
+				}
+				if( chunk_data == NULL )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-					 "%s: unable to create table offsets.",
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( chunk_data_offset > chunk_data->data_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: chunk offset exceeds chunk data size.",
 					 function );
 
 					return( -1 );
 				}
-				internal_handle->write_io_handle->table_offsets           = (ewf_table_offset_t *) reallocation;
-				internal_handle->write_io_handle->number_of_table_offsets = internal_handle->write_io_handle->number_of_chunks_written_to_section;
+				write_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+				if( write_size > buffer_size )
+				{
+					write_size = buffer_size;
+				}
+				if( write_size == 0 )
+				{
+					break;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: updating chunk data: %" PRIu64 " at offset: %" PRIu64 " with size: %" PRIzd ".\n",
+					 function,
+					 chunk_index,
+					 chunk_data_offset,
+					 write_size );
+				}
+#endif
 			}
-			write_count = libewf_segment_file_write_chunks_section_correction(
-				       segment_file,
-				       internal_handle->io_handle,
-				       internal_handle->file_io_pool,
-				       file_io_pool_entry,
-				       segment_file_offset,
-				       internal_handle->chunk_table_list,
-			               internal_handle->write_io_handle->table_offsets,
-			               internal_handle->write_io_handle->number_of_table_offsets,
-				       internal_handle->write_io_handle->chunks_section_offset,
-				       (size64_t) internal_handle->write_io_handle->chunks_section_write_count,
-				       internal_handle->write_io_handle->number_of_chunks_written,
-				       internal_handle->write_io_handle->number_of_chunks_written_to_section,
-			               error );
+			else
+			{
+				/* Reserve 4 bytes for the chunk checksum
+				 */
+				if( libewf_chunk_data_initialize(
+				     &chunk_data,
+				     internal_handle->chunk_data_pool,
+				     (size_t) internal_handle->media_values->chunk_size + sizeof( uint32_t ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
 
-			if( write_count == -1 )
+					return( -1 );
+				}
+				if( chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( libmfdata_list_set_element_value_by_index(
+				     internal_handle->chunk_table_list,
+				     internal_handle->chunk_table_cache,
+				     (int) chunk_index,
+				     (intptr_t *) chunk_data,
+				     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+				     LIBMFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					libewf_chunk_data_free(
+					 &chunk_data,
+					 NULL );
+
+					return( -1 );
+				}
+				chunk_data->data_size = internal_handle->media_values->chunk_size;
+
+				write_size = chunk_data->data_size;
+			}
+			if( memory_copy(
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     write_size ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to correct chunks section.",
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy buffer to chunk data.",
 				 function );
 
 				return( -1 );
 			}
-			segment_file_offset  += write_count;
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file.\n",
-			 function );
-		}
+			buffer_offset += write_size;
+			buffer_size   -= write_size;
+
+			chunk_data_size = chunk_data->data_size;
+
+			if( libewf_chunk_data_pack(
+			     chunk_data,
+			     EWF_COMPRESSION_NONE,
+			     0,
+			     0,
+			     LIBEWF_COMPRESSION_STRATEGY_DEFAULT,
+			     0,
+			     0,
+			     EWF_FORMAT_D01,
+			     internal_handle->media_values->chunk_size,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to pack chunk data: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			write_count = libewf_write_io_handle_write_existing_chunk(
+				       internal_handle->write_io_handle,
+				       internal_handle->io_handle,
+				       internal_handle->file_io_pool,
+				       internal_handle->media_values,
+				       internal_handle->delta_segment_files_list,
+				       internal_handle->segment_files_cache,
+				       internal_handle->delta_segment_table,
+				       internal_handle->chunk_table_list,
+				       internal_handle->header_sections,
+				       (int) chunk_index,
+				       chunk_data->data,
+				       chunk_data->data_size,
+				       chunk_data_size,
+				       0,
+				       NULL,
+				       0,
+				       0,
+				       error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write existing chunk.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( internal_handle->write_io_handle->write_finalized != 0 )
+			{
+				break;
+			}
+			if( chunk_exists != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+				 "%s: chunk: %" PRIu64 " already set.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( internal_handle->chunk_data == NULL )
+			{
+				/* Reserve 4 bytes for the chunk checksum
+				 */
+				if( libewf_chunk_data_initialize(
+				     &( internal_handle->chunk_data ),
+				     internal_handle->chunk_data_pool,
+				     (size_t) internal_handle->media_values->chunk_size + sizeof( uint32_t ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( internal_handle->chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+			}
+			if( internal_handle->chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: internal handle - missing chunk data: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( chunk_data_offset > internal_handle->media_values->chunk_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk offset exceeds chunk data size.",
+				 function );
+
+				return( -1 );
+			}
+			write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+			if( write_size > buffer_size )
+			{
+				write_size = buffer_size;
+			}
+			if( write_size == 0 )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     write_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy buffer to chunk data.",
+				 function );
+
+				return( -1 );
+			}
+			internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+			buffer_offset += write_size;
+			buffer_size   -= write_size;
+
+			if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+			{
+				write_chunk = 1;
+			}
+			else if( ( internal_handle->media_values->media_size != 0 )
+			      && ( ( (size64_t) internal_handle->io_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+			{
+				write_chunk = 1;
+			}
+			else
+			{
+				write_chunk = 0;
+			}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( ( write_chunk != 0 )
+			 && ( internal_handle->number_of_compression_threads > 0 ) )
+			{
+				if( internal_handle->write_io_handle->compression_pool == NULL )
+				{
+					if( libewf_compression_pool_initialize(
+					     &( internal_handle->write_io_handle->compression_pool ),
+					     internal_handle->number_of_compression_threads,
+					     internal_handle->io_handle->compression_level,
+					     internal_handle->io_handle->compression_flags,
+					     internal_handle->io_handle->ewf_format,
+					     internal_handle->media_values->chunk_size,
+					     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+					     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create compression pool.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				/* If the maximum number of outstanding chunks was reached
+				 * the oldest chunk is written first
+				 */
+				do
+				{
+					result = libewf_compression_pool_submit(
+					          internal_handle->write_io_handle->compression_pool,
+					          internal_handle->chunk_data,
+					          chunk_index,
+					          internal_handle->io_handle->zlib_compression_level,
+					          internal_handle->io_handle->zlib_strategy,
+					          internal_handle->io_handle->zlib_window_bits,
+					          internal_handle->io_handle->zlib_memory_level,
+					          error );
+
+					if( result == 0 )
+					{
+						write_count = libewf_internal_handle_write_packed_chunk(
+						               internal_handle,
+						               1,
+						               error );
+
+						if( write_count < 0 )
+						{
+							result = -1;
+						}
+					}
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to submit chunk: %" PRIu64 " to compression pool.",
+						 function,
+						 chunk_index );
+
+						return( -1 );
+					}
+				}
+				while( result == 0 );
+
+				internal_handle->chunk_data = NULL;
+
+				/* Write the chunks that are already packed
+				 */
+				do
+				{
+					write_count = libewf_internal_handle_write_packed_chunk(
+					               internal_handle,
+					               0,
+					               error );
+
+					if( write_count < 0 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write packed chunk.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				while( write_count > 0 );
+
+				write_chunk = 0;
+			}
 #endif
-		write_count = libewf_segment_file_write_close(
-		               segment_file,
-		               internal_handle->io_handle,
-		               internal_handle->file_io_pool,
-		               file_io_pool_entry,
-		               segment_file_offset,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+			if( write_chunk != 0 )
+			{
+				chunk_data_size = internal_handle->chunk_data->data_size;
+
+				if( internal_handle->statistics != NULL )
+				{
+					start_time = libewf_statistics_get_time();
+				}
+				if( libewf_chunk_data_pack(
+				     internal_handle->chunk_data,
+				     internal_handle->io_handle->compression_level,
+				     internal_handle->io_handle->compression_flags,
+				     internal_handle->io_handle->zlib_compression_level,
+				     internal_handle->io_handle->zlib_strategy,
+				     internal_handle->io_handle->zlib_window_bits,
+				     internal_handle->io_handle->zlib_memory_level,
+				     internal_handle->io_handle->ewf_format,
+				     internal_handle->media_values->chunk_size,
+				     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+				     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to pack chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( internal_handle->statistics != NULL )
+				{
+					end_time = libewf_statistics_get_time();
+
+					internal_handle->statistics->number_of_bytes_compressed += (uint64_t) chunk_data_size;
+					internal_handle->statistics->compression_time           += end_time - start_time;
+
+					libewf_statistics_count_packed_chunk(
+					 internal_handle->statistics,
+					 internal_handle->chunk_data->is_compressed,
+					 internal_handle->chunk_data->is_compression_skipped );
+
+					if( internal_handle->statistics->trace != NULL )
+					{
+						if( libewf_trace_append_event(
+						     internal_handle->statistics->trace,
+						     LIBEWF_TRACE_STAGE_COMPRESS,
+						     chunk_index,
+						     -1,
+						     start_time,
+						     end_time,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+							 "%s: unable to append compress event to trace.",
+							 function );
+
+							return( -1 );
+						}
+					}
+				}
+				write_count = libewf_write_io_handle_write_new_chunk(
+					       internal_handle->write_io_handle,
+					       internal_handle->io_handle,
+					       internal_handle->file_io_pool,
+					       internal_handle->media_values,
+					       internal_handle->segment_files_list,
+					       internal_handle->segment_files_cache,
+					       internal_handle->segment_table,
+					       internal_handle->chunk_table_list,
+					       internal_handle->header_values,
+					       internal_handle->hash_values,
+					       internal_handle->header_sections,
+					       internal_handle->hash_sections,
+					       internal_handle->sessions,
+					       internal_handle->tracks,
+					       internal_handle->acquiry_errors,
+					       (int) chunk_index,
+					       internal_handle->chunk_data->data,
+					       internal_handle->chunk_data->data_size,
+					       chunk_data_size,
+					       internal_handle->chunk_data->is_compressed,
+					       NULL,
+					       0,
+					       0,
+					       error );
+
+				if( write_count <= 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write new chunk.",
+					 function );
+
+					return( -1 );
+				}
+				if( libmfdata_list_set_element_value_by_index(
+				     internal_handle->chunk_table_list,
+				     internal_handle->chunk_table_cache,
+				     (int) chunk_index,
+				     (intptr_t *) internal_handle->chunk_data,
+				     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+				     LIBMFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk data: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				internal_handle->chunk_data = NULL;
+			}
+		}
+		chunk_index      += 1;
+		chunk_offset     += internal_handle->media_values->chunk_size;
+		chunk_data_offset = 0;
+
+		internal_handle->io_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->io_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_write_random(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_handle_write_random";
+	ssize_t write_count   = 0;
+
+	if( libewf_handle_seek_offset(
+	     handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_handle_write_buffer(
+	               handle,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_file_t *segment_file       = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	void *reallocation                        = NULL;
+	off64_t segment_file_offset               = 0;
+	size_t chunk_data_size                    = 0;
+	ssize_t write_count                       = 0;
+	ssize_t write_finalize_count              = 0;
+	uint64_t chunk_index                      = 0;
+	uint64_t end_time                         = 0;
+	uint64_t start_time                       = 0;
+	int file_io_pool_entry                    = -1;
+	int number_of_segment_files               = 0;
+	int segment_files_list_index              = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Write the chunks outstanding in the compression pool before the last chunk
+	 */
+	write_count = libewf_internal_handle_write_packed_chunks(
+	               internal_handle,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	write_finalize_count += write_count;
+
+#endif
+	chunk_index = internal_handle->io_handle->current_offset
+	            / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_data_size = internal_handle->chunk_data->data_size;
+
+		if( internal_handle->statistics != NULL )
+		{
+			start_time = libewf_statistics_get_time();
+		}
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle->compression_level,
+		     internal_handle->io_handle->compression_flags,
+		     internal_handle->io_handle->zlib_compression_level,
+		     internal_handle->io_handle->zlib_strategy,
+		     internal_handle->io_handle->zlib_window_bits,
+		     internal_handle->io_handle->zlib_memory_level,
+		     internal_handle->io_handle->ewf_format,
+		     internal_handle->media_values->chunk_size,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk data: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( internal_handle->statistics != NULL )
+		{
+			end_time = libewf_statistics_get_time();
+
+			internal_handle->statistics->number_of_bytes_compressed += (uint64_t) chunk_data_size;
+			internal_handle->statistics->compression_time           += end_time - start_time;
+
+			libewf_statistics_count_packed_chunk(
+			 internal_handle->statistics,
+			 internal_handle->chunk_data->is_compressed,
+			 internal_handle->chunk_data->is_compression_skipped );
+
+			if( internal_handle->statistics->trace != NULL )
+			{
+				if( libewf_trace_append_event(
+				     internal_handle->statistics->trace,
+				     LIBEWF_TRACE_STAGE_COMPRESS,
+				     chunk_index,
+				     -1,
+				     start_time,
+				     end_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append compress event to trace.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       internal_handle->file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_files_list,
+			       internal_handle->segment_files_cache,
+			       internal_handle->segment_table,
+			       internal_handle->chunk_table_list,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->header_sections,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       (int) chunk_index,
+			       internal_handle->chunk_data->data,
+			       internal_handle->chunk_data->data_size,
+			       chunk_data_size,
+			       internal_handle->chunk_data->is_compressed,
+			       NULL,
+			       0,
+			       0,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libmfdata_list_set_element_value_by_index(
+		     internal_handle->chunk_table_list,
+		     internal_handle->chunk_table_cache,
+		     (int) chunk_index,
+		     (intptr_t *) internal_handle->chunk_data,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+		     LIBMFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk data: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data = NULL;
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libmfdata_file_list_get_number_of_files(
+	     internal_handle->segment_files_list,
+	     &number_of_segment_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment files.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segment_files < 0 )
+	 || ( number_of_segment_files > (int) UINT16_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+	 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segment files value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segment_files == 0 )
+	{
+		/* No segment file need to be created
+		 */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the headers if required
+		 */
+		if( internal_handle->header_sections == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid header sections.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( internal_handle->header_sections->header == NULL )
+		 && ( internal_handle->header_sections->header2 == NULL )
+		 && ( internal_handle->header_sections->xheader == NULL ) )
+		{
+			if( libewf_header_sections_generate(
+			     internal_handle->header_sections,
+			     internal_handle->header_values,
+			     time( NULL ),
+			     internal_handle->io_handle->compression_level,
+			     internal_handle->io_handle->format,
+			     internal_handle->io_handle->header_codepage,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create header(s).",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->segment_files_list,
+		     internal_handle->segment_files_cache,
+		     internal_handle->segment_table,
+		     1,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     LIBEWF_SEGMENT_FILE_TYPE_EWF,
+		     &segment_file,
+		     &segment_files_list_index,
+		     &file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 1.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               internal_handle->io_handle,
+		               internal_handle->file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->media_values,
+		               internal_handle->header_sections,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	else
+	{
+		segment_files_list_index = number_of_segment_files - 1;
+
+		if( libmfdata_file_list_get_file_by_index(
+		     internal_handle->segment_files_list,
+		     segment_files_list_index,
+		     &file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %d from list.",
+			 function,
+			 segment_files_list_index + 1 );
+
+			return( -1 );
+		}
+		if( libmfdata_file_list_get_file_value_by_index(
+		     internal_handle->segment_files_list,
+		     internal_handle->file_io_pool,
+		     internal_handle->segment_files_cache,
+		     segment_files_list_index,
+		     (intptr_t **) &segment_file,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %d value from list.",
+			 function,
+			 segment_files_list_index + 1 );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %d.",
+			 function,
+			 segment_files_list_index + 1 );
+
+			return( -1 );
+		}
+	}
+	/* Set segment file to the correct offset if write is resumed
+	 */
+	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     internal_handle->write_io_handle->resume_segment_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %d.",
+			 function,
+			 internal_handle->write_io_handle->resume_segment_file_offset,
+			 segment_files_list_index + 1 );
+
+			return( -1 );
+		}
+		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	{
+		if( libbfio_pool_get_offset(
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     &segment_file_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve current offset in segment file.",
+			 function );
+
+			return( -1 );
+		}
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			/* Correct the offset, size in the chunks section
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: correcting chunks section.\n",
+				 function );
+			}
+#endif
+			if( internal_handle->write_io_handle->number_of_table_offsets < internal_handle->write_io_handle->number_of_chunks_written_to_section )
+			{
+				reallocation = memory_reallocate(
+				                internal_handle->write_io_handle->table_offsets,
+				                sizeof( ewf_table_offset_t ) * internal_handle->write_io_handle->number_of_chunks_written_to_section );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create table offsets.",
+					 function );
+
+					return( -1 );
+				}
+				internal_handle->write_io_handle->table_offsets           = (ewf_table_offset_t *) reallocation;
+				internal_handle->write_io_handle->number_of_table_offsets = internal_handle->write_io_handle->number_of_chunks_written_to_section;
+			}
+			write_count = libewf_segment_file_write_chunks_section_correction(
+				       segment_file,
+				       internal_handle->io_handle,
+				       internal_handle->file_io_pool,
+				       file_io_pool_entry,
+				       segment_file_offset,
+				       internal_handle->chunk_table_list,
+			               internal_handle->write_io_handle->table_offsets,
+			               internal_handle->write_io_handle->number_of_table_offsets,
+				       internal_handle->write_io_handle->chunks_section_offset,
+				       (size64_t) internal_handle->write_io_handle->chunks_section_write_count,
+				       internal_handle->write_io_handle->number_of_chunks_written,
+				       internal_handle->write_io_handle->number_of_chunks_written_to_section,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to correct chunks section.",
+				 function );
+
+				return( -1 );
+			}
+			segment_file_offset  += write_count;
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file.\n",
+			 function );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               segment_file,
+		               internal_handle->io_handle,
+		               internal_handle->file_io_pool,
+		               file_io_pool_entry,
+		               segment_file_offset,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libewf_write_io_handle_finish_segment_file(
+		     internal_handle->write_io_handle,
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     (size64_t) ( segment_file_offset + write_count ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to finish last segment file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the data section write cache
+		 */
+		memory_free(
+		 internal_handle->write_io_handle->data_section );
+
+		internal_handle->write_io_handle->data_section = NULL;
+
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->io_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->write_io_handle->number_of_chunks_written_to_segment,
+		     internal_handle->media_values,
+		     internal_handle->segment_files_list,
+		     internal_handle->segment_files_cache,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     &( internal_handle->write_io_handle->data_section ),
+		     error ) != 1 )
+
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The write journal is no longer needed once the write is finalized
+	 */
+	if( internal_handle->write_io_handle->write_journal != NULL )
+	{
+		if( libewf_write_journal_remove(
+		     internal_handle->write_io_handle->write_journal,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove write journal.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_write_journal_free(
+		     &( internal_handle->write_io_handle->write_journal ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write journal.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	return( write_finalize_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Write the chunks outstanding in the compression pool before
+	 * the chunks at the new offset can be tested for existence
+	 */
+	if( ( offset != internal_handle->io_handle->current_offset )
+	 && ( internal_handle->write_io_handle != NULL ) )
+	{
+		if( libewf_internal_handle_write_packed_chunks(
+		     internal_handle,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	internal_handle->io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	*offset = internal_handle->io_handle->current_offset;
+
+	return( 1 );
+}
+
+/* Retrieves the extent of the (media) data that contains the offset
+ * An extent is a range of chunks that either all contain data or all only contain 0-byte values
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libewf_handle_get_media_extent(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_media_extent";
+	off64_t chunk_offset                      = 0;
+	uint64_t chunk_index                      = 0;
+	uint64_t number_of_chunks                 = 0;
+	int extent_is_sparse                      = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	number_of_chunks = internal_handle->media_values->media_size / internal_handle->media_values->chunk_size;
+
+	if( ( internal_handle->media_values->media_size % internal_handle->media_values->chunk_size ) != 0 )
+	{
+		number_of_chunks++;
+	}
+	if( number_of_chunks > (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of chunks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index  = (uint64_t) offset / internal_handle->media_values->chunk_size;
+	chunk_offset = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+
+	*extent_offset = chunk_offset;
+
+	while( chunk_index < number_of_chunks )
+	{
+		result = libewf_read_io_handle_is_zero_byte_empty_block(
+		          internal_handle->read_io_handle,
+		          internal_handle->file_io_pool,
+		          internal_handle->media_values,
+		          internal_handle->chunk_table_list,
+		          internal_handle->chunk_table_cache,
+		          (int) chunk_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " only contains 0-byte values.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_offset == *extent_offset )
+		{
+			extent_is_sparse = result;
+		}
+		else if( result != extent_is_sparse )
+		{
+			break;
+		}
+		chunk_offset += internal_handle->media_values->chunk_size;
+
+		chunk_index++;
+	}
+	if( (size64_t) chunk_offset > internal_handle->media_values->media_size )
+	{
+		chunk_offset = (off64_t) internal_handle->media_values->media_size;
+	}
+	*extent_size  = (size64_t) ( chunk_offset - *extent_offset );
+	*extent_flags = 0;
+
+	if( extent_is_sparse != 0 )
+	{
+		*extent_flags |= LIBEWF_EXTENT_FLAG_IS_SPARSE;
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk data pool statistics
+ * The number of allocations is the number of chunk data buffers and values allocated from the heap,
+ * the number of reuses the number taken from the pool and the number of frees the number freed to the heap
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_handle_get_chunk_data_pool_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     uint64_t *number_of_frees,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_data_pool_statistics";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_allocations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocations.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reuses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reuses.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_frees == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of frees.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data_pool == NULL )
+	{
+		return( 0 );
+	}
+	*number_of_allocations = internal_handle->chunk_data_pool->number_of_allocations;
+	*number_of_reuses      = internal_handle->chunk_data_pool->number_of_reuses;
+	*number_of_frees       = internal_handle->chunk_data_pool->number_of_frees;
+
+	return( 1 );
+}
+
+/* Retrieves the statistics
+ * Fills the statistics array with up to number of statistics values indexed by LIBEWF_STATISTICS_VALUES
+ * The cache and file IO pool values cover the currently open segment files,
+ * these are LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE if the local libmfdata or libbfio is not used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_statistics(
+     libewf_handle_t *handle,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error )
+{
+	uint64_t values[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_statistics";
+	int value_index                           = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_statistics < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of statistics value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     values,
+	     0,
+	     sizeof( uint64_t ) * LIBEWF_STATISTICS_NUMBER_OF_VALUES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear values.",
+		 function );
+
+		return( -1 );
+	}
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_READ ]                = internal_handle->statistics->number_of_chunks_read;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_READ ]                 = internal_handle->statistics->number_of_bytes_read;
+	values[ LIBEWF_STATISTICS_VALUE_READ_TIME ]                            = internal_handle->statistics->read_time;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_DECOMPRESSED ]         = internal_handle->statistics->number_of_bytes_decompressed;
+	values[ LIBEWF_STATISTICS_VALUE_DECOMPRESSION_TIME ]                   = internal_handle->statistics->decompression_time;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_WRITTEN ]             = internal_handle->statistics->number_of_chunks_written;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_WRITTEN ]              = internal_handle->statistics->number_of_bytes_written;
+	values[ LIBEWF_STATISTICS_VALUE_WRITE_TIME ]                           = internal_handle->statistics->write_time;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_COMPRESSED ]           = internal_handle->statistics->number_of_bytes_compressed;
+	values[ LIBEWF_STATISTICS_VALUE_COMPRESSION_TIME ]                     = internal_handle->statistics->compression_time;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSED ]          = internal_handle->statistics->number_of_chunks_compressed;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_UNCOMPRESSED ]        = internal_handle->statistics->number_of_chunks_uncompressed;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSION_SKIPPED ] = internal_handle->statistics->number_of_chunks_compression_skipped;
+
+#if defined( HAVE_LOCAL_LIBMFDATA )
+	if( internal_handle->chunk_table_list != NULL )
+	{
+		if( libmfdata_list_get_cache_statistics(
+		     internal_handle->chunk_table_list,
+		     &( values[ LIBEWF_STATISTICS_VALUE_CHUNK_TABLE_CACHE_HITS ] ),
+		     &( values[ LIBEWF_STATISTICS_VALUE_CHUNK_TABLE_CACHE_MISSES ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk table cache statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->segment_files_list != NULL )
+	{
+		if( libmfdata_file_list_get_cache_statistics(
+		     internal_handle->segment_files_list,
+		     &( values[ LIBEWF_STATISTICS_VALUE_SEGMENT_FILES_CACHE_HITS ] ),
+		     &( values[ LIBEWF_STATISTICS_VALUE_SEGMENT_FILES_CACHE_MISSES ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment files cache statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#else
+	values[ LIBEWF_STATISTICS_VALUE_CHUNK_TABLE_CACHE_HITS ]     = LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE;
+	values[ LIBEWF_STATISTICS_VALUE_CHUNK_TABLE_CACHE_MISSES ]   = LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE;
+	values[ LIBEWF_STATISTICS_VALUE_SEGMENT_FILES_CACHE_HITS ]   = LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE;
+	values[ LIBEWF_STATISTICS_VALUE_SEGMENT_FILES_CACHE_MISSES ] = LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE;
+#endif
+#if defined( HAVE_LOCAL_LIBBFIO )
+	if( internal_handle->file_io_pool != NULL )
+	{
+		if( libbfio_pool_get_open_statistics(
+		     internal_handle->file_io_pool,
+		     &( values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_FILE_IO_POOL_OPENS ] ),
+		     &( values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_FILE_IO_POOL_EVICTIONS ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO pool open statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#else
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_FILE_IO_POOL_OPENS ]     = LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE;
+	values[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_FILE_IO_POOL_EVICTIONS ] = LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE;
+#endif
+	if( number_of_statistics > LIBEWF_STATISTICS_NUMBER_OF_VALUES )
+	{
+		number_of_statistics = LIBEWF_STATISTICS_NUMBER_OF_VALUES;
+	}
+	for( value_index = 0;
+	     value_index < number_of_statistics;
+	     value_index++ )
+	{
+		statistics[ value_index ] = values[ value_index ];
+	}
+	return( 1 );
+}
+
+/* Sets the maximum number of trace events
+ * The chunk I/O is traced into a ring buffer of the maximum number of events
+ * A value of 0 disables tracing, existing trace events are discarded
+ * Reads submitted with libewf_handle_submit_read_random are not traced
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_trace_events(
+     libewf_handle_t *handle,
+     int maximum_number_of_trace_events,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_trace_events";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_trace_events < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of trace events value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->statistics->trace != NULL )
+	{
+		if( libewf_trace_free(
+		     &( internal_handle->statistics->trace ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free trace.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( maximum_number_of_trace_events > 0 )
+	{
+		if( libewf_trace_initialize(
+		     &( internal_handle->statistics->trace ),
+		     maximum_number_of_trace_events,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create trace.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of trace events
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_number_of_trace_events(
+     libewf_handle_t *handle,
+     int *number_of_trace_events,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_number_of_trace_events";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_trace_events == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of trace events.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->statistics->trace == NULL )
+	{
+		*number_of_trace_events = 0;
+	}
+	else if( libewf_trace_get_number_of_events(
+	          internal_handle->statistics->trace,
+	          number_of_trace_events,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of trace events.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific trace event
+ * The trace events are ordered from oldest to newest
+ * The stage contains a LIBEWF_TRACE_STAGES value, the file IO pool entry is -1 if the stage
+ * does not access a segment file and the start time and duration are in nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_trace_event(
+     libewf_handle_t *handle,
+     int trace_event_index,
+     uint8_t *stage,
+     uint64_t *chunk_index,
+     int *file_io_pool_entry,
+     uint64_t *start_time,
+     uint64_t *duration,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_trace_event";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->statistics->trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_trace_get_event(
+	     internal_handle->statistics->trace,
+	     trace_event_index,
+	     stage,
+	     chunk_index,
+	     file_io_pool_entry,
+	     start_time,
+	     duration,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve trace event: %d.",
+		 function,
+		 trace_event_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Empties the trace events
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_empty_trace_events(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_empty_trace_events";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->statistics->trace != NULL )
+	{
+		if( libewf_trace_empty(
+		     internal_handle->statistics->trace,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to empty trace.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool != NULL )
+	{
+		if( libbfio_pool_set_maximum_number_of_open_handles(
+		     internal_handle->file_io_pool,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	return( 1 );
+}
+
+/* Determine if the segment files are corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
+ */
+int libewf_handle_segment_files_corrupted(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_segment_files_corrupted";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_CORRUPTED ) != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the segment filename size
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_size(
+     libewf_handle_t *handle,
+     size_t *filename_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_size";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_basename_size(
+	          internal_handle->segment_table,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename(
+     libewf_handle_t *handle,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_basename(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_segment_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_segment_filename";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_set_basename(
+	     internal_handle->segment_table,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a segment filename
+ * The additional segment filenames are used round-robin with the segment filename
+ * for the segment files that are created
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_append_segment_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_append_segment_filename";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be appended.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_append_stripe_basename(
+	     internal_handle->segment_table,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment table stripe basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the segment filename size
+ * The filename size includes the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_size_wide(
+     libewf_handle_t *handle,
+     size_t *filename_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_basename_size_wide(
+	          internal_handle->segment_table,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_wide(
+     libewf_handle_t *handle,
+     wchar_t *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_wide";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file.",
-			 function );
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
+	result = libewf_segment_table_get_basename_wide(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
 
-		/* Flush the data section write cache
-		 */
-		memory_free(
-		 internal_handle->write_io_handle->data_section );
+		return( -1 );
+	}
+	return( result );
+}
 
-		internal_handle->write_io_handle->data_section = NULL;
+/* Sets the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_segment_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_segment_filename_wide";
 
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->io_handle,
-		     internal_handle->file_io_pool,
-		     internal_handle->write_io_handle->number_of_chunks_written_to_segment,
-		     internal_handle->media_values,
-		     internal_handle->segment_files_list,
-		     internal_handle->segment_files_cache,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     &( internal_handle->write_io_handle->data_section ),
-		     error ) != 1 )
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
-			 function );
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-			return( -1 );
-		}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
+		 function );
+
+		return( -1 );
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
 
-	return( write_finalize_count );
+		return( -1 );
+	}
+	if( libewf_segment_table_set_basename_wide(
+	     internal_handle->segment_table,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a segment filename
+ * The additional segment filenames are used round-robin with the segment filename
+ * for the segment files that are created
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_append_segment_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_append_segment_filename_wide";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be appended.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_append_stripe_basename_wide(
+	     internal_handle->segment_table,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment table stripe basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif
+
+/* Retrieves the maximum segment file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_maximum_segment_size(
+     libewf_handle_t *handle,
+     size64_t *maximum_segment_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_maximum_segment_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_segment_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum segment size.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
+
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Sets the maximum segment file size
+ * A maximum segment file size of 0 represents the maximum possible size for the format
+ * If the maximum segment file size is smaller than the size needed to store a single chunk
+ * the size off the latter is enforced and not the maximum segment file size
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_maximum_segment_size(
+     libewf_handle_t *handle,
+     size64_t maximum_segment_size,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+	static char *function                     = "libewf_handle_set_maximum_segment_size";
 
 	if( handle == NULL )
 	{
@@ -7024,106 +9828,79 @@ off64_t libewf_handle_seek_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->chunk_data != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: maximum segment size cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( maximum_segment_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum segment size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->io_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
-	}
-#endif
-	if( offset < 0 )
+	if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->current_offset = offset;
+	internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
 
-	return( offset );
+	return( 1 );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Retrieves the write checkpoint interval
+ * The interval is the maximum number of chunks written between checkpoints of the write journal
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_get_write_checkpoint_interval(
      libewf_handle_t *handle,
-     off64_t *offset,
+     uint32_t *number_of_chunks,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_get_write_checkpoint_interval";
 
 	if( handle == NULL )
 	{
@@ -7138,43 +9915,50 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( number_of_chunks == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid number of chunks.",
 		 function );
 
 		return( -1 );
 	}
-	*offset = internal_handle->io_handle->current_offset;
+	*number_of_chunks = internal_handle->write_io_handle->checkpoint_interval;
 
 	return( 1 );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Sets the write checkpoint interval
+ * The interval is the maximum number of chunks written between checkpoints of the write journal
+ * At every checkpoint the current chunks section is closed, the segment file is flushed
+ * to the storage device and the checkpoint is recorded in the write journal,
+ * which is stored next to the segment files with the extension .journal
+ * An interrupted write that is resumed continues from the last checkpoint
+ * The write journal is removed when the write is finalized
+ * An interval of 0 disables the write journal
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_set_write_checkpoint_interval(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     uint32_t number_of_chunks,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	static char *function                     = "libewf_handle_set_write_checkpoint_interval";
 
 	if( handle == NULL )
 	{
@@ -7189,37 +9973,33 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool != NULL )
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->write_finalized != 0 ) )
 	{
-		if( libbfio_pool_set_maximum_number_of_open_handles(
-		     internal_handle->file_io_pool,
-		     maximum_number_of_open_handles,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: write checkpoint interval cannot be changed.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	internal_handle->write_io_handle->checkpoint_interval = number_of_chunks;
 
 	return( 1 );
 }
 
-/* Determine if the segment files are corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+/* Retrieves the segment file write flags
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_segment_files_corrupted(
+int libewf_handle_get_segment_file_write_flags(
      libewf_handle_t *handle,
+     uint8_t *write_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_segment_files_corrupted";
+	static char *function                     = "libewf_handle_get_segment_file_write_flags";
 
 	if( handle == NULL )
 	{
@@ -7234,35 +10014,101 @@ int libewf_handle_segment_files_corrupted(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_CORRUPTED ) != 0 )
+	if( write_flags == NULL )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write flags.",
+		 function );
+
+		return( -1 );
 	}
-	return( 0 );
+	*write_flags = internal_handle->write_io_handle->segment_file_write_flags;
+
+	return( 1 );
 }
 
-/* Retrieves the segment filename size
- * The filename size should include the end of string character
+/* Sets the segment file write flags
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_segment_file_write_flags(
+     libewf_handle_t *handle,
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_segment_file_write_flags";
+	uint8_t supported_flags                   = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->write_finalized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment file write flags cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
+	supported_flags = LIBEWF_SEGMENT_FILE_WRITE_FLAG_PREALLOCATE
+	                | LIBEWF_SEGMENT_FILE_WRITE_FLAG_FLUSH_ON_CLOSE;
+
+	if( ( write_flags & ~( supported_flags ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported write flags: 0x%02" PRIx8 ".",
+		 function,
+		 write_flags );
+
+		return( -1 );
+	}
+	internal_handle->write_io_handle->segment_file_write_flags = write_flags;
+
+	return( 1 );
+}
+
+/* Retrieves the delta segment filename size
+ * The filename size includes the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename_size(
+int libewf_handle_get_delta_segment_filename_size(
      libewf_handle_t *handle,
      size_t *filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size";
+	static char *function                     = "libewf_handle_get_delta_segment_filename_size";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7278,19 +10124,19 @@ int libewf_handle_get_segment_filename_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename_size(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename_size,
 	          error );
 
@@ -7308,18 +10154,18 @@ int libewf_handle_get_segment_filename_size(
 	return( result );
 }
 
-/* Retrieves the segment filename
+/* Retrieves the delta segment filename
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename(
+int libewf_handle_get_delta_segment_filename(
      libewf_handle_t *handle,
      char *filename,
      size_t filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename";
+	static char *function                     = "libewf_handle_get_delta_segment_filename";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7335,19 +10181,19 @@ int libewf_handle_get_segment_filename(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename,
 	          filename_size,
 	          error );
@@ -7366,17 +10212,17 @@ int libewf_handle_get_segment_filename(
 	return( result );
 }
 
-/* Sets the segment file
+/* Sets the delta segment file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_filename(
+int libewf_handle_set_delta_segment_filename(
      libewf_handle_t *handle,
      const char *filename,
      size_t filename_length,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename";
+	static char *function                     = "libewf_handle_set_delta_segment_filename";
 
 	if( handle == NULL )
 	{
@@ -7397,24 +10243,24 @@ int libewf_handle_set_segment_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
+		 "%s: delta segment filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	if( libewf_segment_table_set_basename(
-	     internal_handle->segment_table,
+	     internal_handle->delta_segment_table,
 	     filename,
 	     filename_length,
 	     error ) != 1 )
@@ -7433,17 +10279,17 @@ int libewf_handle_set_segment_filename(
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Retrieves the segment filename size
+/* Retrieves the delta segment filename size
  * The filename size includes the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename_size_wide(
+int libewf_handle_get_delta_segment_filename_size_wide(
      libewf_handle_t *handle,
      size_t *filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
+	static char *function                     = "libewf_handle_get_delta_segment_filename_size_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7459,19 +10305,19 @@ int libewf_handle_get_segment_filename_size_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename_size_wide(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename_size,
 	          error );
 
@@ -7489,18 +10335,18 @@ int libewf_handle_get_segment_filename_size_wide(
 	return( result );
 }
 
-/* Retrieves the segment filename
+/* Retrieves the delta segment filename
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename_wide(
+int libewf_handle_get_delta_segment_filename_wide(
      libewf_handle_t *handle,
      wchar_t *filename,
      size_t filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_wide";
+	static char *function                     = "libewf_handle_get_delta_segment_filename_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7516,19 +10362,19 @@ int libewf_handle_get_segment_filename_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename_wide(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename,
 	          filename_size,
 	          error );
@@ -7547,17 +10393,17 @@ int libewf_handle_get_segment_filename_wide(
 	return( result );
 }
 
-/* Sets the segment file
+/* Sets the delta segment file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_filename_wide(
+int libewf_handle_set_delta_segment_filename_wide(
      libewf_handle_t *handle,
      const wchar_t *filename,
      size_t filename_length,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename_wide";
+	static char *function                     = "libewf_handle_set_delta_segment_filename_wide";
 
 	if( handle == NULL )
 	{
@@ -7578,24 +10424,24 @@ int libewf_handle_set_segment_filename_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
+		 "%s: delta segment filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	if( libewf_segment_table_set_basename_wide(
-	     internal_handle->segment_table,
+	     internal_handle->delta_segment_table,
 	     filename,
 	     filename_length,
 	     error ) != 1 )
@@ -7614,16 +10460,16 @@ int libewf_handle_set_segment_filename_wide(
 
 #endif
 
-/* Retrieves the maximum segment file size
+/* Retrieves the maximum delta segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_maximum_segment_size(
+int libewf_handle_get_maximum_delta_segment_size(
      libewf_handle_t *handle,
-     size64_t *maximum_segment_size,
+     size64_t *maximum_delta_segment_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_maximum_segment_size";
+	static char *function                     = "libewf_handle_get_maximum_delta_segment_size";
 
 	if( handle == NULL )
 	{
@@ -7638,46 +10484,43 @@ int libewf_handle_get_maximum_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_segment_size == NULL )
+	if( maximum_delta_segment_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid maximum segment size.",
+		 "%s: invalid maximum delta segment size.",
 		 function );
 
 		return( -1 );
 	}
-	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
+	*maximum_delta_segment_size = internal_handle->delta_segment_table->maximum_segment_size;
 
 	return( 1 );
 }
 
-/* Sets the maximum segment file size
- * A maximum segment file size of 0 represents the maximum possible size for the format
- * If the maximum segment file size is smaller than the size needed to store a single chunk
- * the size off the latter is enforced and not the maximum segment file size
+/* Sets the maximum delta segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_segment_size(
+int libewf_handle_set_maximum_delta_segment_size(
      libewf_handle_t *handle,
-     size64_t maximum_segment_size,
+     size64_t maximum_delta_segment_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_segment_size";
+	static char *function                     = "libewf_handle_set_maximum_delta_segment_size";
 
 	if( handle == NULL )
 	{
@@ -7692,80 +10535,68 @@ int libewf_handle_set_maximum_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
+	if( ( internal_handle->write_io_handle == NULL )
 	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: maximum segment size cannot be changed.",
+		 "%s: maximum delta segment size cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_segment_size > (size64_t) INT64_MAX )
+	if( maximum_delta_segment_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid maximum segment size value exceeds maximum.",
+		 "%s: invalid maximum delta segment size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
+	if( maximum_delta_segment_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid segment file size value out of bounds.",
+		 "%s: invalid maximum delta segment size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
+	internal_handle->delta_segment_table->maximum_segment_size = maximum_delta_segment_size;
 
 	return( 1 );
 }
 
-/* Retrieves the delta segment filename size
- * The filename size includes the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+/* Retrieves the filename size of the (delta) segment file of the current chunk
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_delta_segment_filename_size(
+int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
      size_t *filename_size,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename_size";
-	int result                                = 0;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename_size";
+	int result                       = 0;
 
 	if( handle == NULL )
 	{
@@ -7778,22 +10609,9 @@ int libewf_handle_get_delta_segment_filename_size(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->delta_segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
-		 function );
-
-		return( -1 );
-	}
-	result = libewf_segment_table_get_basename_size(
-	          internal_handle->delta_segment_table,
-	          filename_size,
+	result = libewf_handle_get_file_io_handle(
+	          handle,
+	          &file_io_handle,
 	          error );
 
 	if( result == -1 )
@@ -7802,27 +10620,44 @@ int libewf_handle_get_delta_segment_filename_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
+	else if( result != 0 )
+	{
+		if( libbfio_file_get_name_size(
+		     file_io_handle,
+		     filename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename size.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( result );
 }
 
-/* Retrieves the delta segment filename
+/* Retrieves the filename of the (delta) segment file of the current chunk
  * The filename size should include the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_delta_segment_filename(
+int libewf_handle_get_filename(
      libewf_handle_t *handle,
      char *filename,
      size_t filename_size,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename";
-	int result                                = 0;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename";
+	int result                       = 0;
 
 	if( handle == NULL )
 	{
@@ -7835,23 +10670,9 @@ int libewf_handle_get_delta_segment_filename(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->delta_segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
-		 function );
-
-		return( -1 );
-	}
-	result = libewf_segment_table_get_basename(
-	          internal_handle->delta_segment_table,
-	          filename,
-	          filename_size,
+	result = libewf_handle_get_file_io_handle(
+	          handle,
+	          &file_io_handle,
 	          error );
 
 	if( result == -1 )
@@ -7860,121 +10681,61 @@ int libewf_handle_get_delta_segment_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
-		 function );
-
-		return( -1 );
-	}
-	return( result );
-}
-
-/* Sets the delta segment file
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_set_delta_segment_filename(
-     libewf_handle_t *handle,
-     const char *filename,
-     size_t filename_length,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_delta_segment_filename";
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->write_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: delta segment filename cannot be changed.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->delta_segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_set_basename(
-	     internal_handle->delta_segment_table,
-	     filename,
-	     filename_length,
-	     error ) != 1 )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
-		 function );
+		if( libbfio_file_get_name(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
-	return( 1 );
+	return( result );
 }
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Retrieves the delta segment filename size
+/* Retrieves the filename size of the (delta) segment file of the current chunk
  * The filename size includes the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_delta_segment_filename_size_wide(
+int libewf_handle_get_filename_size_wide(
      libewf_handle_t *handle,
      size_t *filename_size,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename_size_wide";
-	int result                                = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename_size_wide";
+	int result                       = 0;
 
-	if( internal_handle->delta_segment_table == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_segment_table_get_basename_size_wide(
-	          internal_handle->delta_segment_table,
-	          filename_size,
+	result = libewf_handle_get_file_io_handle(
+	          handle,
+	          &file_io_handle,
 	          error );
 
 	if( result == -1 )
@@ -7983,27 +10744,44 @@ int libewf_handle_get_delta_segment_filename_size_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
+	else if( result != 0 )
+	{
+		if( libbfio_file_get_name_size_wide(
+		     file_io_handle,
+		     filename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename size.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( result );
 }
 
-/* Retrieves the delta segment filename
+/* Retrieves the filename of the (delta) segment file of the current chunk
  * The filename size should include the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_delta_segment_filename_wide(
+int libewf_handle_get_filename_wide(
      libewf_handle_t *handle,
      wchar_t *filename,
      size_t filename_size,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename_wide";
-	int result                                = 0;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename_wide";
+	int result                       = 0;
 
 	if( handle == NULL )
 	{
@@ -8016,23 +10794,9 @@ int libewf_handle_get_delta_segment_filename_wide(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->delta_segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
-		 function );
-
-		return( -1 );
-	}
-	result = libewf_segment_table_get_basename_wide(
-	          internal_handle->delta_segment_table,
-	          filename,
-	          filename_size,
+	result = libewf_handle_get_file_io_handle(
+	          handle,
+	          &file_io_handle,
 	          error );
 
 	if( result == -1 )
@@ -8041,25 +10805,49 @@ int libewf_handle_get_delta_segment_filename_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
+	else if( result != 0 )
+	{
+		if( libbfio_file_get_name_wide(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( result );
 }
 
-/* Sets the delta segment file
- * Returns 1 if successful or -1 on error
+#endif
+
+/* Retrieves the file IO handle of the (delta) segment file of the current chunk
+ * Returns 1 if successful, 0 if no such file IO handle or -1 on error
  */
-int libewf_handle_set_delta_segment_filename_wide(
+int libewf_handle_get_file_io_handle(
      libewf_handle_t *handle,
-     const wchar_t *filename,
-     size_t filename_length,
+     libbfio_handle_t **file_io_handle,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_delta_segment_filename_wide";
+	static char *function                     = "libewf_handle_get_file_io_handle";
+	off64_t chunk_offset                      = 0;
+	size64_t chunk_size                       = 0;
+	uint64_t chunk_index                      = 0;
+	uint32_t chunk_flags                      = 0;
+	int file_io_pool_entry                    = 0;
 
 	if( handle == NULL )
 	{
@@ -8074,109 +10862,118 @@ int libewf_handle_set_delta_segment_filename_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->write_io_handle == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: delta segment filename cannot be changed.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->delta_segment_table == NULL )
+	if( internal_handle->io_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_set_basename_wide(
-	     internal_handle->delta_segment_table,
-	     filename,
-	     filename_length,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-#endif
-
-/* Retrieves the maximum delta segment file size
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_get_maximum_delta_segment_size(
-     libewf_handle_t *handle,
-     size64_t *maximum_delta_segment_size,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_maximum_delta_segment_size";
-
-	if( handle == NULL )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
 
-	if( internal_handle->delta_segment_table == NULL )
+	if( chunk_index >= (uint64_t) INT32_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_delta_segment_size == NULL )
+	if( libmfdata_list_get_data_range_by_index(
+	     internal_handle->chunk_table_list,
+	     (int) chunk_index,
+	     &file_io_pool_entry,
+	     &chunk_offset,
+	     &chunk_size,
+	     &chunk_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid maximum delta segment size.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-	*maximum_delta_segment_size = internal_handle->delta_segment_table->maximum_segment_size;
+	if( file_io_pool_entry == -1 )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_get_handle(
+	     internal_handle->file_io_pool,
+	     file_io_pool_entry,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool (chunk: %" PRIu64 ").",
+		 function,
+		 file_io_pool_entry,
+		 chunk_index );
 
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Sets the maximum delta segment file size
+/* Retrieves the number of (delta) segment files
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_delta_segment_size(
+int libewf_handle_get_number_of_segment_files(
      libewf_handle_t *handle,
-     size64_t maximum_delta_segment_size,
+     uint32_t *number_of_segment_files,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_delta_segment_size";
+	static char *function                     = "libewf_handle_get_number_of_segment_files";
+	int number_of_files                       = 0;
+	int number_of_delta_files                 = 0;
 
 	if( handle == NULL )
 	{
@@ -8191,67 +10988,203 @@ int libewf_handle_set_maximum_delta_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->delta_segment_table == NULL )
+	if( number_of_segment_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of segment files.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	if( internal_handle->segment_files_list != NULL )
+	{
+		if( libmfdata_file_list_get_number_of_files(
+		     internal_handle->segment_files_list,
+		     &number_of_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->delta_segment_files_list != NULL )
+	{
+		if( libmfdata_file_list_get_number_of_files(
+		     internal_handle->delta_segment_files_list,
+		     &number_of_delta_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of delta segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( number_of_files < 0 )
+	 || ( number_of_delta_files < 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: maximum delta segment size cannot be changed.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segment files value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_segment_files = (uint32_t) number_of_files + (uint32_t) number_of_delta_files;
+
+	return( 1 );
+}
+
+/* Retrieves the file IO handle of a specific (delta) segment file
+ * The segment files are followed by the delta segment files
+ * Returns 1 if successful, 0 if no such file IO handle or -1 on error
+ */
+int libewf_internal_handle_get_segment_file_io_handle(
+     libewf_internal_handle_t *internal_handle,
+     uint32_t segment_file_index,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	libmfdata_file_list_t *segment_files_list = NULL;
+	static char *function                     = "libewf_internal_handle_get_segment_file_io_handle";
+	int file_io_pool_entry                    = 0;
+	int number_of_files                       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_delta_segment_size > (size64_t) INT64_MAX )
+	if( segment_file_index > (uint32_t) INT32_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid maximum delta segment size value exceeds maximum.",
+		 "%s: invalid segment file index value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_delta_segment_size == 0 )
+	segment_files_list = internal_handle->segment_files_list;
+
+	if( segment_files_list != NULL )
+	{
+		if( libmfdata_file_list_get_number_of_files(
+		     segment_files_list,
+		     &number_of_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( (int) segment_file_index >= number_of_files )
+	{
+		segment_file_index -= (uint32_t) number_of_files;
+		segment_files_list  = internal_handle->delta_segment_files_list;
+		number_of_files     = 0;
+
+		if( segment_files_list != NULL )
+		{
+			if( libmfdata_file_list_get_number_of_files(
+			     segment_files_list,
+			     &number_of_files,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of delta segment files.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( (int) segment_file_index >= number_of_files )
+		{
+			return( 0 );
+		}
+	}
+	if( libmfdata_file_list_get_file_by_index(
+	     segment_files_list,
+	     (int) segment_file_index,
+	     &file_io_pool_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid maximum delta segment size value out of bounds.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 " from list.",
+		 function,
+		 segment_file_index );
 
 		return( -1 );
 	}
-	internal_handle->delta_segment_table->maximum_segment_size = maximum_delta_segment_size;
+	if( file_io_pool_entry == -1 )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_get_handle(
+	     internal_handle->file_io_pool,
+	     file_io_pool_entry,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
 
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Retrieves the filename size of the (delta) segment file of the current chunk
- * The filename size should include the end of string character
+/* Retrieves the filename size of a specific (delta) segment file
+ * The filename size includes the end of string character
  * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_filename_size(
+int libewf_handle_get_segment_file_name_size(
      libewf_handle_t *handle,
+     uint32_t segment_file_index,
      size_t *filename_size,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename_size";
+	static char *function            = "libewf_handle_get_segment_file_name_size";
 	int result                       = 0;
 
 	if( handle == NULL )
@@ -8265,8 +11198,9 @@ int libewf_handle_get_filename_size(
 
 		return( -1 );
 	}
-	result = libewf_handle_get_file_io_handle(
-	          handle,
+	result = libewf_internal_handle_get_segment_file_io_handle(
+	          (libewf_internal_handle_t *) handle,
+	          segment_file_index,
 	          &file_io_handle,
 	          error );
 
@@ -8276,8 +11210,9 @@ int libewf_handle_get_filename_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
-		 function );
+		 "%s: unable to retrieve file IO handle of segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_index );
 
 		return( -1 );
 	}
@@ -8301,18 +11236,19 @@ int libewf_handle_get_filename_size(
 	return( result );
 }
 
-/* Retrieves the filename of the (delta) segment file of the current chunk
+/* Retrieves the filename of a specific (delta) segment file
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_filename(
+int libewf_handle_get_segment_file_name(
      libewf_handle_t *handle,
+     uint32_t segment_file_index,
      char *filename,
      size_t filename_size,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename";
+	static char *function            = "libewf_handle_get_segment_file_name";
 	int result                       = 0;
 
 	if( handle == NULL )
@@ -8326,8 +11262,9 @@ int libewf_handle_get_filename(
 
 		return( -1 );
 	}
-	result = libewf_handle_get_file_io_handle(
-	          handle,
+	result = libewf_internal_handle_get_segment_file_io_handle(
+	          (libewf_internal_handle_t *) handle,
+	          segment_file_index,
 	          &file_io_handle,
 	          error );
 
@@ -8337,8 +11274,9 @@ int libewf_handle_get_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
-		 function );
+		 "%s: unable to retrieve file IO handle of segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_index );
 
 		return( -1 );
 	}
@@ -8365,17 +11303,18 @@ int libewf_handle_get_filename(
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Retrieves the filename size of the (delta) segment file of the current chunk
+/* Retrieves the filename size of a specific (delta) segment file
  * The filename size includes the end of string character
  * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_filename_size_wide(
+int libewf_handle_get_segment_file_name_size_wide(
      libewf_handle_t *handle,
+     uint32_t segment_file_index,
      size_t *filename_size,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename_size_wide";
+	static char *function            = "libewf_handle_get_segment_file_name_size_wide";
 	int result                       = 0;
 
 	if( handle == NULL )
@@ -8389,8 +11328,9 @@ int libewf_handle_get_filename_size_wide(
 
 		return( -1 );
 	}
-	result = libewf_handle_get_file_io_handle(
-	          handle,
+	result = libewf_internal_handle_get_segment_file_io_handle(
+	          (libewf_internal_handle_t *) handle,
+	          segment_file_index,
 	          &file_io_handle,
 	          error );
 
@@ -8400,8 +11340,9 @@ int libewf_handle_get_filename_size_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
-		 function );
+		 "%s: unable to retrieve file IO handle of segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_index );
 
 		return( -1 );
 	}
@@ -8425,18 +11366,19 @@ int libewf_handle_get_filename_size_wide(
 	return( result );
 }
 
-/* Retrieves the filename of the (delta) segment file of the current chunk
+/* Retrieves the filename of a specific (delta) segment file
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_filename_wide(
+int libewf_handle_get_segment_file_name_wide(
      libewf_handle_t *handle,
+     uint32_t segment_file_index,
      wchar_t *filename,
      size_t filename_size,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename_wide";
+	static char *function            = "libewf_handle_get_segment_file_name_wide";
 	int result                       = 0;
 
 	if( handle == NULL )
@@ -8450,8 +11392,9 @@ int libewf_handle_get_filename_wide(
 
 		return( -1 );
 	}
-	result = libewf_handle_get_file_io_handle(
-	          handle,
+	result = libewf_internal_handle_get_segment_file_io_handle(
+	          (libewf_internal_handle_t *) handle,
+	          segment_file_index,
 	          &file_io_handle,
 	          error );
 
@@ -8461,8 +11404,9 @@ int libewf_handle_get_filename_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
-		 function );
+		 "%s: unable to retrieve file IO handle of segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_index );
 
 		return( -1 );
 	}
@@ -8489,23 +11433,27 @@ int libewf_handle_get_filename_wide(
 
 #endif
 
-/* Retrieves the file IO handle of the (delta) segment file of the current chunk
- * Returns 1 if successful, 0 if no such file IO handle or -1 on error
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Writes the oldest chunk that was packed by the compression pool
+ * If wait for completion is set the function waits until the chunk is packed
+ * Returns the number of bytes written, 0 if no packed chunk is available or -1 on error
  */
-int libewf_handle_get_file_io_handle(
-     libewf_handle_t *handle,
-     libbfio_handle_t **file_io_handle,
-     libcerror_error_t **error )
+ssize_t libewf_internal_handle_write_packed_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint8_t wait_for_completion,
+         libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_file_io_handle";
-	off64_t chunk_offset                      = 0;
-	size64_t chunk_size                       = 0;
-	uint64_t chunk_index                      = 0;
-	uint32_t chunk_flags                      = 0;
-	int file_io_pool_entry                    = 0;
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_write_packed_chunk";
+	size_t chunk_data_size          = 0;
+	ssize_t write_count             = 0;
+	uint64_t chunk_index            = 0;
+	uint64_t end_time               = 0;
+	uint64_t start_time             = 0;
+	int result                      = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -8516,108 +11464,186 @@ int libewf_handle_get_file_io_handle(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle->current_offset < 0 )
+	if( internal_handle->write_io_handle->compression_pool == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
+		return( 0 );
 	}
-	if( internal_handle->media_values == NULL )
+	result = libewf_compression_pool_get_packed_chunk(
+	          internal_handle->write_io_handle->compression_pool,
+	          &chunk_data,
+	          &chunk_index,
+	          &chunk_data_size,
+	          &start_time,
+	          &end_time,
+	          wait_for_completion,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve packed chunk from compression pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	else if( result == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
-
-		return( -1 );
+		return( 0 );
 	}
-	chunk_index = internal_handle->io_handle->current_offset / internal_handle->media_values->chunk_size;
+	if( internal_handle->statistics != NULL )
+	{
+		internal_handle->statistics->number_of_bytes_compressed += (uint64_t) chunk_data_size;
+		internal_handle->statistics->compression_time           += end_time - start_time;
 
-	if( chunk_index >= (uint64_t) INT32_MAX )
+		libewf_statistics_count_packed_chunk(
+		 internal_handle->statistics,
+		 chunk_data->is_compressed,
+		 chunk_data->is_compression_skipped );
+
+		if( internal_handle->statistics->trace != NULL )
+		{
+			if( libewf_trace_append_event(
+			     internal_handle->statistics->trace,
+			     LIBEWF_TRACE_STAGE_COMPRESS,
+			     chunk_index,
+			     -1,
+			     start_time,
+			     end_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append compress event to trace.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+		       internal_handle->write_io_handle,
+		       internal_handle->io_handle,
+		       internal_handle->file_io_pool,
+		       internal_handle->media_values,
+		       internal_handle->segment_files_list,
+		       internal_handle->segment_files_cache,
+		       internal_handle->segment_table,
+		       internal_handle->chunk_table_list,
+		       internal_handle->header_values,
+		       internal_handle->hash_values,
+		       internal_handle->header_sections,
+		       internal_handle->hash_sections,
+		       internal_handle->sessions,
+		       internal_handle->tracks,
+		       internal_handle->acquiry_errors,
+		       (int) chunk_index,
+		       chunk_data->data,
+		       chunk_data->data_size,
+		       chunk_data_size,
+		       chunk_data->is_compressed,
+		       NULL,
+		       0,
+		       0,
+		       error );
+
+	if( write_count <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write new chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libmfdata_list_get_data_range_by_index(
+	if( libmfdata_list_set_element_value_by_index(
 	     internal_handle->chunk_table_list,
+	     internal_handle->chunk_table_cache,
 	     (int) chunk_index,
-	     &file_io_pool_entry,
-	     &chunk_offset,
-	     &chunk_size,
-	     &chunk_flags,
+	     (intptr_t *) chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBMFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range of chunk: %" PRIu64 ".",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk data: %" PRIu64 ".",
 		 function,
 		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( file_io_pool_entry == -1 )
+	return( write_count );
+
+on_error:
+	if( chunk_data != NULL )
 	{
-		return( 0 );
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
 	}
-	if( libbfio_pool_get_handle(
-	     internal_handle->file_io_pool,
-	     file_io_pool_entry,
-	     file_io_handle,
-	     error ) != 1 )
+	return( -1 );
+}
+
+/* Writes all the chunks outstanding in the compression pool
+ * Waits until the chunks are packed
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_packed_chunks(
+         libewf_internal_handle_t *internal_handle,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_packed_chunks";
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+
+	do
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle: %d from pool (chunk: %" PRIu64 ").",
-		 function,
-		 file_io_pool_entry,
-		 chunk_index );
+		write_count = libewf_internal_handle_write_packed_chunk(
+		               internal_handle,
+		               1,
+		               error );
 
-		return( -1 );
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunk.",
+			 function );
+
+			return( -1 );
+		}
+		total_write_count += write_count;
 	}
-	return( 1 );
+	while( write_count > 0 );
+
+	return( total_write_count );
 }
 
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Retrieves the maximum number of supported segment files to write
  * Returns 1 if successful or -1 on error
  */
@@ -9368,6 +12394,21 @@ int libewf_file_get_file_entry_by_utf8_path(
 
 			return( -1 );
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_handle->single_files,
+		     internal_handle->file_io_pool,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub file entries.",
+			 function );
+
+			return( -1 );
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
 			  node,
 			  utf8_string_segment,
@@ -9579,6 +12620,21 @@ int libewf_file_get_file_entry_by_utf16_path(
 
 			return( -1 );
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_handle->single_files,
+		     internal_handle->file_io_pool,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub file entries.",
+			 function );
+
+			return( -1 );
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
 			  node,
 			  utf16_string_segment,
@@ -25,7 +25,9 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_async_read_handle.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
 #include "libewf_chunk_table.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
@@ -41,6 +43,7 @@
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
 
@@ -104,6 +107,20 @@ struct libewf_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The number of threads used to process asynchronous read requests
+	 */
+	int number_of_read_threads;
+
+	/* The number of threads used to pack chunks while writing, 0 if the chunks are packed by the writing thread
+	 */
+	int number_of_compression_threads;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The asynchronous read handle
+	 */
+	libewf_async_read_handle_t *async_read_handle;
+#endif
+
 	/* The segment files list
 	 */
 	libmfdata_file_list_t *segment_files_list;
@@ -132,6 +149,14 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunk_table_cache;
 
+	/* The chunk data pool
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
+	/* The statistics
+	 */
+	libewf_statistics_t *statistics;
+
 	/* The stored header sections
 	 */
 	libewf_header_sections_t *header_sections;
@@ -250,6 +275,19 @@ ssize_t libewf_handle_read_chunk(
          int8_t *read_checksum,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_read_chunks(
+     libewf_handle_t *handle,
+     const uint64_t *chunk_indexes,
+     int number_of_chunks,
+     void *chunks_buffer,
+     size_t chunks_buffer_size,
+     size_t *chunk_data_offsets,
+     size_t *chunk_data_sizes,
+     uint32_t *chunk_checksums,
+     uint8_t *chunk_flags,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_buffer(
          libewf_handle_t *handle,
@@ -265,6 +303,39 @@ ssize_t libewf_handle_read_random(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_read_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_submit_read_random(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libewf_handle_t *handle,
+            ssize_t read_count,
+            intptr_t *user_data ),
+     intptr_t *user_data,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_completion(
+     libewf_handle_t *handle,
+     intptr_t **user_data,
+     ssize_t *read_count,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_prepare_write_chunk(
          libewf_handle_t *handle,
@@ -322,6 +393,58 @@ int libewf_handle_get_offset(
      off64_t *offset,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_media_extent(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_data_pool_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     uint64_t *number_of_frees,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_statistics(
+     libewf_handle_t *handle,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_number_of_trace_events(
+     libewf_handle_t *handle,
+     int maximum_number_of_trace_events,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_trace_events(
+     libewf_handle_t *handle,
+     int *number_of_trace_events,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_trace_event(
+     libewf_handle_t *handle,
+     int trace_event_index,
+     uint8_t *stage,
+     uint64_t *chunk_index,
+     int *file_io_pool_entry,
+     uint64_t *start_time,
+     uint64_t *duration,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_empty_trace_events(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_set_maximum_number_of_open_handles(
      libewf_handle_t *handle,
@@ -353,6 +476,13 @@ int libewf_handle_set_segment_filename(
      size_t filename_length,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_append_segment_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 LIBEWF_EXTERN \
 int libewf_handle_get_segment_filename_size_wide(
@@ -373,6 +503,13 @@ int libewf_handle_set_segment_filename_wide(
      const wchar_t *filename,
      size_t filename_length,
      libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_append_segment_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
 #endif
 
 LIBEWF_EXTERN \
@@ -387,6 +524,30 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_write_checkpoint_interval(
+     libewf_handle_t *handle,
+     uint32_t *number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_write_checkpoint_interval(
+     libewf_handle_t *handle,
+     uint32_t number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_write_flags(
+     libewf_handle_t *handle,
+     uint8_t *write_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_segment_file_write_flags(
+     libewf_handle_t *handle,
+     uint8_t write_flags,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_delta_segment_filename_size(
      libewf_handle_t *handle,
@@ -475,6 +636,63 @@ int libewf_handle_get_file_io_handle(
      libbfio_handle_t **file_io_handle,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_segment_files(
+     libewf_handle_t *handle,
+     uint32_t *number_of_segment_files,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name_size(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     size_t *filename_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name_size_wide(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     size_t *filename_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_name_wide(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     wchar_t *filename,
+     size_t filename_size,
+     libcerror_error_t **error );
+#endif
+
+int libewf_internal_handle_get_segment_file_io_handle(
+     libewf_internal_handle_t *internal_handle,
+     uint32_t segment_file_index,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+ssize_t libewf_internal_handle_write_packed_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint8_t wait_for_completion,
+         libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_packed_chunks(
+         libewf_internal_handle_t *internal_handle,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int libewf_internal_handle_get_write_maximum_number_of_segments(
      uint8_t ewf_format,
      uint16_t *maximum_number_of_segments,
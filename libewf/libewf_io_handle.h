@@ -62,6 +62,23 @@ struct libewf_io_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The zlib compression level used to compress chunks,
+	 * 0 if determined by the compression level
+	 */
+	int zlib_compression_level;
+
+	/* The zlib strategy used to compress chunks
+	 */
+	int zlib_strategy;
+
+	/* The zlib window bits used to compress chunks, 0 if the zlib default
+	 */
+	int zlib_window_bits;
+
+	/* The zlib memory level used to compress chunks, 0 if the zlib default
+	 */
+	int zlib_memory_level;
+
 	/* The header codepage
 	 */
 	int header_codepage;
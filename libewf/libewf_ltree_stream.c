@@ -0,0 +1,633 @@
+/*
+ * Ltree stream functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libuna.h"
+#include "libewf_ltree_stream.h"
+
+/* Initialize the ltree stream
+ * The block size must be large enough to contain an UTF-16 surrogate pair
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_stream_initialize(
+     libewf_ltree_stream_t **ltree_stream,
+     int file_io_pool_entry,
+     off64_t data_offset,
+     size64_t data_size,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_stream_initialize";
+
+	if( ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ltree_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ltree stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size < 4 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid block size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*ltree_stream = memory_allocate_structure(
+	                 libewf_ltree_stream_t );
+
+	if( *ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ltree stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *ltree_stream,
+	     0,
+	     sizeof( libewf_ltree_stream_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ltree stream.",
+		 function );
+
+		memory_free(
+		 *ltree_stream );
+
+		*ltree_stream = NULL;
+
+		return( -1 );
+	}
+	( *ltree_stream )->block_data = (uint8_t *) memory_allocate(
+	                                             sizeof( uint8_t ) * block_size );
+
+	if( ( *ltree_stream )->block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block data.",
+		 function );
+
+		goto on_error;
+	}
+	( *ltree_stream )->line_string_size = 256;
+
+	( *ltree_stream )->line_string = (uint8_t *) memory_allocate(
+	                                              sizeof( uint8_t ) * ( *ltree_stream )->line_string_size );
+
+	if( ( *ltree_stream )->line_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create line string.",
+		 function );
+
+		goto on_error;
+	}
+	( *ltree_stream )->file_io_pool_entry = file_io_pool_entry;
+	( *ltree_stream )->data_offset        = data_offset;
+	( *ltree_stream )->data_size          = data_size;
+	( *ltree_stream )->block_size         = block_size;
+
+	return( 1 );
+
+on_error:
+	if( *ltree_stream != NULL )
+	{
+		if( ( *ltree_stream )->block_data != NULL )
+		{
+			memory_free(
+			 ( *ltree_stream )->block_data );
+		}
+		memory_free(
+		 *ltree_stream );
+
+		*ltree_stream = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees the ltree stream
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_stream_free(
+     libewf_ltree_stream_t **ltree_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_stream_free";
+
+	if( ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ltree_stream != NULL )
+	{
+		if( ( *ltree_stream )->line_string != NULL )
+		{
+			memory_free(
+			 ( *ltree_stream )->line_string );
+		}
+		if( ( *ltree_stream )->block_data != NULL )
+		{
+			memory_free(
+			 ( *ltree_stream )->block_data );
+		}
+		memory_free(
+		 *ltree_stream );
+
+		*ltree_stream = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the next block of ltree data
+ * The unread bytes of the previous block are moved to the start of the block data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_stream_read_block(
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function   = "libewf_ltree_stream_read_block";
+	size64_t remaining_size = 0;
+	size_t byte_index       = 0;
+	size_t read_size        = 0;
+	size_t unread_size      = 0;
+	ssize_t read_count      = 0;
+
+	if( ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ltree_stream->block_data_index > ltree_stream->block_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ltree stream - block data index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	unread_size = ltree_stream->block_data_size - ltree_stream->block_data_index;
+
+	/* The unread bytes can overlap with the start of the block data
+	 */
+	for( byte_index = 0;
+	     byte_index < unread_size;
+	     byte_index++ )
+	{
+		ltree_stream->block_data[ byte_index ] = ltree_stream->block_data[ ltree_stream->block_data_index + byte_index ];
+	}
+	ltree_stream->block_data_size  = unread_size;
+	ltree_stream->block_data_index = 0;
+
+	remaining_size = ltree_stream->data_size - (size64_t) ltree_stream->block_offset;
+	read_size      = ltree_stream->block_size - unread_size;
+
+	if( (size64_t) read_size > remaining_size )
+	{
+		read_size = (size_t) remaining_size;
+	}
+	if( read_size == 0 )
+	{
+		return( 1 );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     ltree_stream->file_io_pool_entry,
+	     ltree_stream->data_offset + ltree_stream->block_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek ltree data offset: %" PRIi64 ".",
+		 function,
+		 ltree_stream->data_offset + ltree_stream->block_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              ltree_stream->file_io_pool_entry,
+	              &( ltree_stream->block_data[ unread_size ] ),
+	              read_size,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Skip the byte order mark at the start of the ltree data
+	 */
+	if( ( ltree_stream->block_offset == 0 )
+	 && ( read_size >= 2 )
+	 && ( ltree_stream->block_data[ 0 ] == 0xff )
+	 && ( ltree_stream->block_data[ 1 ] == 0xfe ) )
+	{
+		ltree_stream->block_data_index = 2;
+	}
+	ltree_stream->block_offset    += (off64_t) read_size;
+	ltree_stream->block_data_size += read_size;
+
+	return( 1 );
+}
+
+/* Reads the next line from the ltree stream
+ * The UTF-16 little-endian ltree data is converted into an UTF-8 line string
+ * without the end-of-line character(s). The line string is owned by the ltree
+ * stream and is valid until the next call.
+ *
+ * Similar to splitting the ltree data on end-of-line characters, the last line
+ * is returned even if it is empty. The end of the ltree data is reached at
+ * the end of the ltree data or at the first 0-character.
+ *
+ * A line that does not fit in LIBEWF_LTREE_STREAM_MAXIMUM_LINE_SIZE bytes
+ * is considered corrupt.
+ *
+ * Returns 1 if successful, 0 if no more lines are available or -1 on error
+ */
+int libewf_ltree_stream_read_line(
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
+     uint8_t **line_string,
+     size_t *line_string_size,
+     libcerror_error_t **error )
+{
+	libuna_unicode_character_t unicode_character = 0;
+	uint8_t *reallocation                        = NULL;
+	static char *function                        = "libewf_ltree_stream_read_line";
+	size_t line_string_index                     = 0;
+	size_t reallocation_size                     = 0;
+
+	if( ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line string.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ltree_stream->end_of_data != 0 )
+	{
+		return( 0 );
+	}
+	while( ltree_stream->end_of_data == 0 )
+	{
+		/* Make sure a complete UTF-16 surrogate pair is available
+		 */
+		if( ( ( ltree_stream->block_data_size - ltree_stream->block_data_index ) < 4 )
+		 && ( (size64_t) ltree_stream->block_offset < ltree_stream->data_size ) )
+		{
+			if( libewf_ltree_stream_read_block(
+			     ltree_stream,
+			     file_io_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read ltree data block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( ltree_stream->block_data_index + 1 ) >= ltree_stream->block_data_size )
+		{
+			ltree_stream->end_of_data = 1;
+
+			break;
+		}
+		if( libuna_unicode_character_copy_from_utf16_stream(
+		     &unicode_character,
+		     ltree_stream->block_data,
+		     ltree_stream->block_data_size,
+		     &( ltree_stream->block_data_index ),
+		     LIBUNA_ENDIAN_LITTLE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-16 stream.",
+			 function );
+
+			return( -1 );
+		}
+		if( unicode_character == 0 )
+		{
+			ltree_stream->end_of_data = 1;
+
+			break;
+		}
+		if( unicode_character == (libuna_unicode_character_t) '\n' )
+		{
+			break;
+		}
+		/* Make sure the line string can hold the largest UTF-8 character
+		 * and the end-of-string character
+		 */
+		if( ( line_string_index + 5 ) > ltree_stream->line_string_size )
+		{
+			if( ltree_stream->line_string_size >= LIBEWF_LTREE_STREAM_MAXIMUM_LINE_SIZE )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid line string size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			reallocation_size = ltree_stream->line_string_size * 2;
+
+			if( reallocation_size > LIBEWF_LTREE_STREAM_MAXIMUM_LINE_SIZE )
+			{
+				reallocation_size = LIBEWF_LTREE_STREAM_MAXIMUM_LINE_SIZE;
+			}
+			reallocation = (uint8_t *) memory_reallocate(
+			                            ltree_stream->line_string,
+			                            sizeof( uint8_t ) * reallocation_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize line string.",
+				 function );
+
+				return( -1 );
+			}
+			ltree_stream->line_string      = reallocation;
+			ltree_stream->line_string_size = reallocation_size;
+		}
+		if( libuna_unicode_character_copy_to_utf8(
+		     unicode_character,
+		     ltree_stream->line_string,
+		     ltree_stream->line_string_size,
+		     &line_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_OUTPUT_FAILED,
+			 "%s: unable to copy Unicode character to UTF-8.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Remove trailing carriage return
+	 */
+	if( ( line_string_index > 0 )
+	 && ( ltree_stream->line_string[ line_string_index - 1 ] == (uint8_t) '\r' ) )
+	{
+		line_string_index -= 1;
+	}
+	ltree_stream->line_string[ line_string_index ] = 0;
+
+	*line_string      = ltree_stream->line_string;
+	*line_string_size = line_string_index + 1;
+
+	return( 1 );
+}
+
+/* Retrieves the offset of the next unread byte relative to the start of the ltree data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_stream_get_offset(
+     libewf_ltree_stream_t *ltree_stream,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_stream_get_offset";
+
+	if( ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	*offset = ltree_stream->block_offset
+	        - (off64_t) ( ltree_stream->block_data_size - ltree_stream->block_data_index );
+
+	return( 1 );
+}
+
+/* Sets the offset of the next byte to read relative to the start of the ltree data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_stream_set_offset(
+     libewf_ltree_stream_t *ltree_stream,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_stream_set_offset";
+	off64_t block_start   = 0;
+
+	if( ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset > ltree_stream->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	block_start = ltree_stream->block_offset - (off64_t) ltree_stream->block_data_size;
+
+	/* Reuse the block data if it contains the offset
+	 */
+	if( ( offset > 0 )
+	 && ( offset >= block_start )
+	 && ( offset <= ltree_stream->block_offset ) )
+	{
+		ltree_stream->block_data_index = (size_t) ( offset - block_start );
+	}
+	else
+	{
+		ltree_stream->block_offset     = offset;
+		ltree_stream->block_data_size  = 0;
+		ltree_stream->block_data_index = 0;
+	}
+	ltree_stream->end_of_data = 0;
+
+	return( 1 );
+}
+
@@ -0,0 +1,123 @@
+/*
+ * Ltree stream functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_LTREE_STREAM_H )
+#define _LIBEWF_LTREE_STREAM_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_ltree_stream libewf_ltree_stream_t;
+
+struct libewf_ltree_stream
+{
+	/* The file IO pool entry of the segment file containing the ltree data
+	 */
+	int file_io_pool_entry;
+
+	/* The offset of the ltree data in the segment file
+	 */
+	off64_t data_offset;
+
+	/* The ltree data size
+	 */
+	size64_t data_size;
+
+	/* The size of the blocks in which the ltree data is read
+	 */
+	size_t block_size;
+
+	/* The offset of the next block relative to the start of the ltree data
+	 */
+	off64_t block_offset;
+
+	/* The block data
+	 */
+	uint8_t *block_data;
+
+	/* The number of bytes in the block data
+	 */
+	size_t block_data_size;
+
+	/* The index of the next unread byte in the block data
+	 */
+	size_t block_data_index;
+
+	/* The line string
+	 */
+	uint8_t *line_string;
+
+	/* The allocated line string size
+	 */
+	size_t line_string_size;
+
+	/* Value to indicate the end of the ltree data was reached
+	 */
+	uint8_t end_of_data;
+};
+
+int libewf_ltree_stream_initialize(
+     libewf_ltree_stream_t **ltree_stream,
+     int file_io_pool_entry,
+     off64_t data_offset,
+     size64_t data_size,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libewf_ltree_stream_free(
+     libewf_ltree_stream_t **ltree_stream,
+     libcerror_error_t **error );
+
+int libewf_ltree_stream_read_block(
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_ltree_stream_read_line(
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
+     uint8_t **line_string,
+     size_t *line_string_size,
+     libcerror_error_t **error );
+
+int libewf_ltree_stream_get_offset(
+     libewf_ltree_stream_t *ltree_stream,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+int libewf_ltree_stream_set_offset(
+     libewf_ltree_stream_t *ltree_stream,
+     off64_t offset,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -668,6 +668,329 @@ int libewf_handle_set_compression_values(
 	return( 1 );
 }
 
+/* Retrieves the zlib compression level
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_zlib_compression_level(
+     libewf_handle_t *handle,
+     int *zlib_compression_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_zlib_compression_level";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib compression level.",
+		 function );
+
+		return( -1 );
+	}
+	*zlib_compression_level = internal_handle->io_handle->zlib_compression_level;
+
+	return( 1 );
+}
+
+/* Sets the zlib compression level
+ * The level (1 to 9) overrides the zlib level that corresponds with the compression level
+ * for chunks that are compressed, 0 removes the override
+ * Unlike the compression values the level can be changed while writing,
+ * it applies to the chunks that are written afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_zlib_compression_level(
+     libewf_handle_t *handle,
+     int zlib_compression_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_zlib_compression_level";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: zlib compression level cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( zlib_compression_level < 0 )
+	 || ( zlib_compression_level > 9 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported zlib compression level.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->zlib_compression_level = zlib_compression_level;
+
+	return( 1 );
+}
+
+/* Retrieves the zlib compression values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_zlib_compression_values(
+     libewf_handle_t *handle,
+     int *zlib_compression_level,
+     int *zlib_strategy,
+     int *zlib_window_bits,
+     int *zlib_memory_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_zlib_compression_values";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_strategy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib strategy.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_window_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib window bits.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_memory_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib memory level.",
+		 function );
+
+		return( -1 );
+	}
+	*zlib_compression_level = internal_handle->io_handle->zlib_compression_level;
+	*zlib_strategy          = internal_handle->io_handle->zlib_strategy;
+	*zlib_window_bits       = internal_handle->io_handle->zlib_window_bits;
+	*zlib_memory_level      = internal_handle->io_handle->zlib_memory_level;
+
+	return( 1 );
+}
+
+/* Sets the zlib compression values
+ * The level (1 to 9) overrides the zlib level that corresponds with the compression level, 0 removes the override
+ * The strategy is one of the LIBEWF_COMPRESSION_STRATEGY definitions
+ * The window bits (9 to 15) and memory level (1 to 9) are passed to zlib deflate, 0 represents the zlib default
+ * Non-default strategy, window bits or memory level values cause chunks to be compressed with zlib
+ * regardless of the compression backend
+ * Like the zlib compression level the values can be changed while writing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_zlib_compression_values(
+     libewf_handle_t *handle,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_zlib_compression_values";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: zlib compression values cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( zlib_compression_level < 0 )
+	 || ( zlib_compression_level > 9 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported zlib compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_DEFAULT )
+	 && ( zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_FILTERED )
+	 && ( zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_HUFFMAN_ONLY )
+	 && ( zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_RLE )
+	 && ( zlib_strategy != LIBEWF_COMPRESSION_STRATEGY_FIXED ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported zlib strategy.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( zlib_window_bits != 0 )
+	 && ( ( zlib_window_bits < 9 )
+	  || ( zlib_window_bits > 15 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported zlib window bits.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( zlib_memory_level < 0 )
+	 || ( zlib_memory_level > 9 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported zlib memory level.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->zlib_compression_level = zlib_compression_level;
+	internal_handle->io_handle->zlib_strategy          = zlib_strategy;
+	internal_handle->io_handle->zlib_window_bits       = zlib_window_bits;
+	internal_handle->io_handle->zlib_memory_level      = zlib_memory_level;
+
+	return( 1 );
+}
+
 /* Retrieves the size of the contained media data
  * Returns 1 if successful or -1 on error
  */
@@ -96,6 +96,36 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_zlib_compression_level(
+     libewf_handle_t *handle,
+     int *zlib_compression_level,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_zlib_compression_level(
+     libewf_handle_t *handle,
+     int zlib_compression_level,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_zlib_compression_values(
+     libewf_handle_t *handle,
+     int *zlib_compression_level,
+     int *zlib_strategy,
+     int *zlib_window_bits,
+     int *zlib_memory_level,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_zlib_compression_values(
+     libewf_handle_t *handle,
+     int zlib_compression_level,
+     int zlib_strategy,
+     int zlib_window_bits,
+     int zlib_memory_level,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_media_size(
      libewf_handle_t *handle,
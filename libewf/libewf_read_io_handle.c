@@ -20,10 +20,15 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_empty_block.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -32,6 +37,10 @@
 #include "libewf_libmfdata.h"
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_statistics.h"
+#include "libewf_trace.h"
+
+#include "ewf_checksum.h"
 
 /* Initialize the read IO handle
  * Returns 1 if successful or -1 on error
@@ -157,6 +166,16 @@ int libewf_read_io_handle_free(
 
 			result = -1;
 		}
+		if( ( *read_io_handle )->compressed_zero_byte_empty_block != NULL )
+		{
+			memory_free(
+			 ( *read_io_handle )->compressed_zero_byte_empty_block );
+		}
+		if( ( *read_io_handle )->stored_chunk_data != NULL )
+		{
+			memory_free(
+			 ( *read_io_handle )->stored_chunk_data );
+		}
 		memory_free(
 		 *read_io_handle );
 
@@ -277,10 +296,14 @@ int libewf_read_io_handle_read_chunk_data(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
+	libewf_trace_t *trace      = NULL;
 	static char *function      = "libewf_read_io_handle_read_chunk_data";
 	size_t chunk_size          = 0;
+	uint64_t end_time          = 0;
 	uint64_t start_sector      = 0;
+	uint64_t start_time        = 0;
 	uint32_t number_of_sectors = 0;
+	uint8_t is_compressed      = 0;
 	int result                 = 0;
 
 	if( read_io_handle == NULL )
@@ -361,6 +384,7 @@ int libewf_read_io_handle_read_chunk_data(
 
 		if( libewf_chunk_data_initialize(
 		     chunk_data,
+		     NULL,
 		     chunk_size,
 		     error ) != 1 )
 		{
@@ -467,20 +491,139 @@ int libewf_read_io_handle_read_chunk_data(
 
 			return( -1 );
 		}
-		if( libewf_chunk_data_unpack(
-		     *chunk_data,
-		     media_values->chunk_size,
-		     error ) != 1 )
+		/* A chunk that is stored identical to a known compressed zero byte empty block
+		 * does not need to be decompressed
+		 */
+		if( ( ( *chunk_data )->is_packed != 0 )
+		 && ( ( *chunk_data )->is_compressed != 0 )
+		 && ( read_io_handle->compressed_zero_byte_empty_block != NULL )
+		 && ( ( *chunk_data )->data_size == read_io_handle->compressed_zero_byte_empty_block_size )
+		 && ( memory_compare(
+		       ( *chunk_data )->data,
+		       read_io_handle->compressed_zero_byte_empty_block,
+		       read_io_handle->compressed_zero_byte_empty_block_size ) == 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk data: %d.",
-			 function,
-			 chunk_index );
+			if( libewf_chunk_data_unpack_zero_byte_empty_block(
+			     *chunk_data,
+			     media_values->chunk_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack zero byte empty block chunk data: %d.",
+				 function,
+				 chunk_index );
 
-			return( -1 );
+				return( -1 );
+			}
+		}
+		else if( ( *chunk_data )->is_packed != 0 )
+		{
+			is_compressed = ( *chunk_data )->is_compressed;
+
+			if( read_io_handle->statistics != NULL )
+			{
+				trace = read_io_handle->statistics->trace;
+			}
+			if( ( is_compressed != 0 )
+			 || ( trace != NULL ) )
+			{
+				start_time = libewf_statistics_get_time();
+			}
+			if( libewf_chunk_data_unpack(
+			     *chunk_data,
+			     media_values->chunk_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk data: %d.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( ( is_compressed != 0 )
+			 || ( trace != NULL ) )
+			{
+				end_time = libewf_statistics_get_time();
+			}
+			if( ( read_io_handle->statistics != NULL )
+			 && ( is_compressed != 0 ) )
+			{
+				read_io_handle->statistics->number_of_bytes_decompressed += (uint64_t) ( *chunk_data )->data_size;
+				read_io_handle->statistics->decompression_time           += end_time - start_time;
+			}
+			if( trace != NULL )
+			{
+				if( libewf_trace_append_event(
+				     trace,
+				     LIBEWF_TRACE_STAGE_UNPACK,
+				     (uint64_t) chunk_index,
+				     -1,
+				     start_time,
+				     end_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append unpack event to trace.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			/* Remember the stored data of the first compressed chunk
+			 * that only contains 0-byte values
+			 */
+			if( ( read_io_handle->compressed_zero_byte_empty_block == NULL )
+			 && ( ( *chunk_data )->compressed_data != NULL )
+			 && ( ( *chunk_data )->is_corrupt == 0 )
+			 && ( ( *chunk_data )->data_size == (size_t) media_values->chunk_size )
+			 && ( ( *chunk_data )->data[ 0 ] == 0 ) )
+			{
+				result = libewf_empty_block_test(
+				          ( *chunk_data )->data,
+				          ( *chunk_data )->data_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to determine if chunk data: %d is an empty block.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					if( libewf_read_io_handle_set_compressed_zero_byte_empty_block(
+					     read_io_handle,
+					     ( *chunk_data )->compressed_data,
+					     ( *chunk_data )->compressed_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to set compressed zero byte empty block.",
+						 function );
+
+						return( -1 );
+					}
+				}
+			}
 		}
 		if( ( *chunk_data )->is_corrupt != 0 )
 		{
@@ -536,3 +679,873 @@ int libewf_read_io_handle_read_chunk_data(
 	return( 1 );
 }
 
+/* Reads chunk data directly into a buffer
+ * The chunk data is not stored in the chunk table cache
+ * The buffer size must match the size of the chunk data
+ * Chunks that are not stored, corrupted or cannot be read directly
+ * into the buffer should be read using libewf_read_io_handle_read_chunk_data
+ * Returns 1 if successful, 0 if the chunk data could not be read into the buffer or -1 on error
+ */
+int libewf_read_io_handle_read_chunk_data_to_buffer(
+     libewf_read_io_handle_t *read_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libmfdata_list_t *chunk_table_list,
+     libfcache_cache_t *chunk_table_cache,
+     int chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_read_io_handle_read_chunk_data_to_buffer";
+	off64_t chunk_data_offset = 0;
+	size64_t chunk_data_size  = 0;
+	uint32_t chunk_data_flags = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_range(
+	     chunk_table_list,
+	     file_io_pool,
+	     chunk_table_cache,
+	     chunk_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     &chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range of chunk: %d.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	result = libewf_read_io_handle_read_chunk_data_range_to_buffer(
+	          file_io_pool,
+	          media_values,
+	          chunk_index,
+	          file_io_pool_entry,
+	          chunk_data_offset,
+	          chunk_data_size,
+	          chunk_data_flags,
+	          read_io_handle->compressed_zero_byte_empty_block,
+	          read_io_handle->compressed_zero_byte_empty_block_size,
+	          &( read_io_handle->stored_chunk_data ),
+	          &( read_io_handle->stored_chunk_data_size ),
+	          buffer,
+	          buffer_size,
+	          read_io_handle->statistics,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data: %d into buffer.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* Remember the stored data of the first compressed chunk
+	 * that only contains 0-byte values
+	 */
+	if( ( ( chunk_data_flags & LIBMFDATA_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	 && ( read_io_handle->compressed_zero_byte_empty_block == NULL )
+	 && ( buffer_size == (size_t) media_values->chunk_size )
+	 && ( buffer[ 0 ] == 0 ) )
+	{
+		result = libewf_empty_block_test(
+		          buffer,
+		          buffer_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if chunk data: %d is an empty block.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libewf_read_io_handle_set_compressed_zero_byte_empty_block(
+			     read_io_handle,
+			     read_io_handle->stored_chunk_data,
+			     (size_t) chunk_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set compressed zero byte empty block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the chunk data of a previously retrieved chunk data range directly into a buffer
+ * The stored chunk data is used as scratch buffer for compressed chunk data and is resized when needed
+ * This function does not use the read IO handle so that it can be called with a private file IO pool
+ * The statistics are optional, the chunk I/O is traced if the statistics have a trace
+ * Returns 1 if successful, 0 if the chunk data could not be read into the buffer or -1 on error
+ */
+int libewf_read_io_handle_read_chunk_data_range_to_buffer(
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     int chunk_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     uint8_t **stored_chunk_data,
+     size_t *stored_chunk_data_size,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	uint8_t stored_checksum_data[ 4 ];
+
+	libewf_trace_t *trace        = NULL;
+	uint8_t *reallocation        = NULL;
+	static char *function        = "libewf_read_io_handle_read_chunk_data_range_to_buffer";
+	size_t data_size             = 0;
+	size_t read_size             = 0;
+	ssize_t read_count           = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t stored_checksum     = 0;
+	uint64_t end_time            = 0;
+	uint64_t seek_time           = 0;
+	uint64_t start_time          = 0;
+	uint8_t seek_stage           = 0;
+	int result                   = 0;
+
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stored chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stored chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) media_values->chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( ( chunk_data_flags & ( LIBMFDATA_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_IS_CORRUPTED | LIBEWF_RANGE_FLAG_IS_TAINTED ) ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_flags & LIBMFDATA_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( ( chunk_data_size == 0 )
+		 || ( chunk_data_size > (size64_t) SSIZE_MAX ) )
+		{
+			return( 0 );
+		}
+		read_size = (size_t) chunk_data_size;
+
+		if( read_size > *stored_chunk_data_size )
+		{
+			reallocation = (uint8_t *) memory_reallocate(
+			                            *stored_chunk_data,
+			                            sizeof( uint8_t ) * read_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize stored chunk data.",
+				 function );
+
+				return( -1 );
+			}
+			*stored_chunk_data      = reallocation;
+			*stored_chunk_data_size = read_size;
+		}
+	}
+	else
+	{
+		/* The stored chunk data contains the data followed by a 32-bit checksum
+		 */
+		if( chunk_data_size != (size64_t) ( buffer_size + sizeof( uint32_t ) ) )
+		{
+			return( 0 );
+		}
+		read_size = buffer_size;
+	}
+	if( statistics != NULL )
+	{
+		trace = statistics->trace;
+	}
+	if( trace != NULL )
+	{
+		if( libewf_trace_get_seek_stage(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &seek_stage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine seek stage.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( statistics != NULL )
+	{
+		start_time = libewf_statistics_get_time();
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 chunk_data_offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( trace != NULL )
+	{
+		seek_time = libewf_statistics_get_time();
+
+		if( libewf_trace_append_event(
+		     trace,
+		     seek_stage,
+		     (uint64_t) chunk_index,
+		     file_io_pool_entry,
+		     start_time,
+		     seek_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append seek event to trace.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( chunk_data_flags & LIBMFDATA_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		read_count = libbfio_pool_read_buffer(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      *stored_chunk_data,
+			      read_size,
+			      error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( statistics != NULL )
+		{
+			end_time = libewf_statistics_get_time();
+
+			statistics->number_of_chunks_read += 1;
+			statistics->number_of_bytes_read  += (uint64_t) read_size;
+			statistics->read_time             += end_time - start_time;
+		}
+		if( trace != NULL )
+		{
+			if( libewf_trace_append_event(
+			     trace,
+			     LIBEWF_TRACE_STAGE_READ,
+			     (uint64_t) chunk_index,
+			     file_io_pool_entry,
+			     seek_time,
+			     end_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append read event to trace.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( compressed_zero_byte_empty_block != NULL )
+		 && ( read_size == compressed_zero_byte_empty_block_size )
+		 && ( buffer_size == (size_t) media_values->chunk_size )
+		 && ( memory_compare(
+		       *stored_chunk_data,
+		       compressed_zero_byte_empty_block,
+		       read_size ) == 0 ) )
+		{
+			if( memory_set(
+			     buffer,
+			     0,
+			     buffer_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to set buffer.",
+				 function );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+		data_size = buffer_size;
+
+		if( statistics != NULL )
+		{
+			start_time = libewf_statistics_get_time();
+		}
+		result = libewf_decompress(
+			  buffer,
+			  &data_size,
+			  *stored_chunk_data,
+			  read_size,
+			  NULL );
+
+		if( statistics != NULL )
+		{
+			end_time = libewf_statistics_get_time();
+
+			statistics->decompression_time += end_time - start_time;
+
+			if( result == 1 )
+			{
+				statistics->number_of_bytes_decompressed += (uint64_t) data_size;
+			}
+		}
+		if( trace != NULL )
+		{
+			if( libewf_trace_append_event(
+			     trace,
+			     LIBEWF_TRACE_STAGE_DECOMPRESS,
+			     (uint64_t) chunk_index,
+			     file_io_pool_entry,
+			     start_time,
+			     end_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append decompress event to trace.",
+				 function );
+
+				return( -1 );
+			}
+		}
+
+		/* Leave the handling of corrupted chunk data to libewf_read_io_handle_read_chunk_data
+		 */
+		if( ( result != 1 )
+		 || ( data_size != buffer_size ) )
+		{
+			return( 0 );
+		}
+	}
+	else
+	{
+		read_count = libbfio_pool_read_buffer(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      buffer,
+			      read_size,
+			      error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		read_count = libbfio_pool_read_buffer(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      stored_checksum_data,
+			      4,
+			      error );
+
+		if( read_count != (ssize_t) 4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data: %d checksum.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( statistics != NULL )
+		{
+			end_time = libewf_statistics_get_time();
+
+			statistics->number_of_chunks_read += 1;
+			statistics->number_of_bytes_read  += (uint64_t) read_size + 4;
+			statistics->read_time             += end_time - start_time;
+		}
+		if( trace != NULL )
+		{
+			if( libewf_trace_append_event(
+			     trace,
+			     LIBEWF_TRACE_STAGE_READ,
+			     (uint64_t) chunk_index,
+			     file_io_pool_entry,
+			     seek_time,
+			     end_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append read event to trace.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 stored_checksum_data,
+		 stored_checksum );
+
+		calculated_checksum = ewf_checksum_calculate(
+				       buffer,
+				       buffer_size,
+				       1 );
+
+		if( trace != NULL )
+		{
+			if( libewf_trace_append_event(
+			     trace,
+			     LIBEWF_TRACE_STAGE_CHECKSUM,
+			     (uint64_t) chunk_index,
+			     file_io_pool_entry,
+			     end_time,
+			     libewf_statistics_get_time(),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum event to trace.",
+				 function );
+
+				return( -1 );
+			}
+		}
+
+		/* Leave the handling of corrupted chunk data to libewf_read_io_handle_read_chunk_data
+		 */
+		if( stored_checksum != calculated_checksum )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the compressed zero byte empty block
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_io_handle_set_compressed_zero_byte_empty_block(
+     libewf_read_io_handle_t *read_io_handle,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_io_handle_set_compressed_zero_byte_empty_block";
+
+	if( read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size == 0 )
+	 || ( compressed_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_io_handle->compressed_zero_byte_empty_block != NULL )
+	{
+		memory_free(
+		 read_io_handle->compressed_zero_byte_empty_block );
+
+		read_io_handle->compressed_zero_byte_empty_block      = NULL;
+		read_io_handle->compressed_zero_byte_empty_block_size = 0;
+	}
+	read_io_handle->compressed_zero_byte_empty_block = (uint8_t *) memory_allocate(
+	                                                                sizeof( uint8_t ) * compressed_data_size );
+
+	if( read_io_handle->compressed_zero_byte_empty_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed zero byte empty block.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     read_io_handle->compressed_zero_byte_empty_block,
+	     compressed_data,
+	     compressed_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy compressed zero byte empty block.",
+		 function );
+
+		memory_free(
+		 read_io_handle->compressed_zero_byte_empty_block );
+
+		read_io_handle->compressed_zero_byte_empty_block = NULL;
+
+		return( -1 );
+	}
+	read_io_handle->compressed_zero_byte_empty_block_size = compressed_data_size;
+
+	return( 1 );
+}
+
+/* Determines if a chunk only contains 0-byte values
+ * This function compares the stored data of the chunk with the known
+ * compressed zero byte empty block and does not decompress the chunk data.
+ * If the compressed zero byte empty block is not yet known and the chunk
+ * is small enough to be a candidate the chunk data is read to detect it.
+ * Returns 1 if the chunk only contains 0-byte values, 0 if not or unknown or -1 on error
+ */
+int libewf_read_io_handle_is_zero_byte_empty_block(
+     libewf_read_io_handle_t *read_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libmfdata_list_t *chunk_table_list,
+     libfcache_cache_t *chunk_table_cache,
+     int chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	uint8_t *stored_data            = NULL;
+	static char *function           = "libewf_read_io_handle_is_zero_byte_empty_block";
+	off64_t chunk_data_offset       = 0;
+	size64_t chunk_data_size        = 0;
+	ssize_t read_count              = 0;
+	uint32_t chunk_data_flags       = 0;
+	int file_io_pool_entry          = 0;
+	int result                      = 0;
+
+	if( read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_range(
+	     chunk_table_list,
+	     file_io_pool,
+	     chunk_table_cache,
+	     chunk_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     &chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range of chunk: %d.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( ( chunk_data_flags & LIBMFDATA_RANGE_FLAG_IS_COMPRESSED ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( read_io_handle->compressed_zero_byte_empty_block == NULL )
+	{
+		/* Deflate compresses a block of 0-byte values more than a factor 64
+		 * only chunks that are stored that small are read to detect
+		 * the compressed zero byte empty block
+		 */
+		if( chunk_data_size > (size64_t) ( media_values->chunk_size / 64 ) )
+		{
+			return( 0 );
+		}
+		if( libewf_read_io_handle_read_chunk_data(
+		     read_io_handle,
+		     file_io_pool,
+		     media_values,
+		     chunk_table_list,
+		     chunk_table_cache,
+		     chunk_index,
+		     (off64_t) chunk_index * media_values->chunk_size,
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( read_io_handle->compressed_zero_byte_empty_block == NULL )
+		{
+			return( 0 );
+		}
+	}
+	if( chunk_data_size != (size64_t) read_io_handle->compressed_zero_byte_empty_block_size )
+	{
+		return( 0 );
+	}
+	stored_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * read_io_handle->compressed_zero_byte_empty_block_size );
+
+	if( stored_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stored data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 chunk_data_offset,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+		      file_io_pool,
+		      file_io_pool_entry,
+		      stored_data,
+		      read_io_handle->compressed_zero_byte_empty_block_size,
+		      error );
+
+	if( read_count != (ssize_t) read_io_handle->compressed_zero_byte_empty_block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data: %d.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     stored_data,
+	     read_io_handle->compressed_zero_byte_empty_block,
+	     read_io_handle->compressed_zero_byte_empty_block_size ) == 0 )
+	{
+		result = 1;
+	}
+	memory_free(
+	 stored_data );
+
+	return( result );
+
+on_error:
+	if( stored_data != NULL )
+	{
+		memory_free(
+		 stored_data );
+	}
+	return( -1 );
+}
+
@@ -32,6 +32,7 @@
 #include "libewf_libfcache.h"
 #include "libewf_libmfdata.h"
 #include "libewf_media_values.h"
+#include "libewf_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -48,6 +49,29 @@ struct libewf_read_io_handle
 	/* A value to indicate if the chunk data should be zeroed on error
 	 */
 	uint8_t zero_on_error;
+
+	/* The compressed zero byte empty block
+	 * contains the stored data of a compressed chunk that was found
+	 * to only contain 0-byte values
+	 */
+	uint8_t *compressed_zero_byte_empty_block;
+
+	/* The compressed zero byte empty block size
+	 */
+	size_t compressed_zero_byte_empty_block_size;
+
+	/* The stored chunk data
+	 * used to read chunk data directly into a buffer without caching it
+	 */
+	uint8_t *stored_chunk_data;
+
+	/* The stored chunk data size
+	 */
+	size_t stored_chunk_data_size;
+
+	/* The statistics, which are not managed by the read IO handle
+	 */
+	libewf_statistics_t *statistics;
 };
 
 int libewf_read_io_handle_initialize(
@@ -74,6 +98,49 @@ int libewf_read_io_handle_read_chunk_data(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_read_io_handle_read_chunk_data_to_buffer(
+     libewf_read_io_handle_t *read_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libmfdata_list_t *chunk_table_list,
+     libfcache_cache_t *chunk_table_cache,
+     int chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_read_io_handle_read_chunk_data_range_to_buffer(
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     int chunk_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     uint8_t **stored_chunk_data,
+     size_t *stored_chunk_data_size,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libewf_read_io_handle_set_compressed_zero_byte_empty_block(
+     libewf_read_io_handle_t *read_io_handle,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_read_io_handle_is_zero_byte_empty_block(
+     libewf_read_io_handle_t *read_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libmfdata_list_t *chunk_table_list,
+     libfcache_cache_t *chunk_table_cache,
+     int chunk_index,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
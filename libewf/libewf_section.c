@@ -3844,23 +3844,23 @@ ssize_t libewf_section_header2_write(
 }
 
 /* Reads a ltree section
+ * Only the ltree header is read, the location of the ltree data is stored
+ * so that the ltree data can be parsed as a stream at a later time
  * Returns the number of bytes read or -1 on error
  */
 ssize_t libewf_section_ltree_read(
          libewf_section_t *section,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
-         uint8_t **cached_ltree_data,
-         size_t *cached_ltree_data_size,
+         int *ltree_file_io_pool_entry,
+         off64_t *ltree_data_offset,
+         size64_t *ltree_data_size,
          libcerror_error_t **error )
 {
 	ewf_ltree_header_t *ltree_header = NULL;
-	uint8_t *ltree_data              = NULL;
 	static char *function            = "libewf_section_ltree_read";
 	size64_t section_data_size       = 0;
-	size_t ltree_data_size           = 0;
 	ssize_t read_count               = 0;
-	ssize_t total_read_count         = 0;
 	uint32_t ltree_size              = 0;
 
 	if( section == NULL )
@@ -3874,24 +3874,35 @@ ssize_t libewf_section_ltree_read(
 
 		return( -1 );
 	}
-	if( cached_ltree_data == NULL )
+	if( ltree_file_io_pool_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid cached ltree.",
+		 "%s: invalid ltree file IO pool entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( cached_ltree_data_size == NULL )
+	if( ltree_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid cached ltree data size.",
+		 "%s: invalid ltree data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( ltree_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree data size.",
 		 function );
 
 		return( -1 );
@@ -3943,8 +3954,6 @@ ssize_t libewf_section_ltree_read(
 
 		goto on_error;
 	}
-	total_read_count += read_count;
-
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -4018,80 +4027,19 @@ ssize_t libewf_section_ltree_read(
 
 		goto on_error;
 	}
-	ltree_data_size = (size_t) ltree_size;
-
-	ltree_data = (uint8_t *) memory_allocate(
-                                  ltree_data_size );
-
-	if( ltree_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create ltree data.",
-		 function );
-
-		goto on_error;
-	}
-	read_count = libbfio_pool_read_buffer(
-	              file_io_pool,
-	              file_io_pool_entry,
-	              ltree_data,
-	              ltree_data_size,
-	              error );
-
-	if( read_count != (ssize_t) ltree_data_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read ltree data.",
-		 function );
-
-		goto on_error;
-	}
-	total_read_count += read_count;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( libewf_debug_utf16_stream_print(
-		     "ltree data",
-		     ltree_data,
-		     ltree_data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print ltree data.",
-			 function );
-
-			goto on_error;
-		}
-	}
-#endif
-	if( *cached_ltree_data == NULL )
-	{
-		*cached_ltree_data      = ltree_data;
-		*cached_ltree_data_size = ltree_data_size;
-	}
-	else
+	/* Only the first ltree section is used
+	 */
+	if( *ltree_data_size == 0 )
 	{
-		memory_free(
-		 ltree_data );
+		*ltree_file_io_pool_entry = file_io_pool_entry;
+		*ltree_data_offset        = section->start_offset
+		                          + sizeof( ewf_section_start_t )
+		                          + sizeof( ewf_ltree_header_t );
+		*ltree_data_size          = (size64_t) ltree_size;
 	}
-	return( total_read_count );
+	return( read_count );
 
 on_error:
-	if( ltree_data != NULL )
-	{
-		memory_free(
-		 ltree_data );
-	}
 	if( ltree_header != NULL )
 	{
 		memory_free(
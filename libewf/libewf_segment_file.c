@@ -1135,7 +1135,7 @@ ssize_t libewf_segment_file_read_delta_chunk_section(
 	     file_io_pool_entry,
 	     chunk_offset,
 	     (size64_t) chunk_size,
-	     0,
+	     LIBEWF_RANGE_FLAG_IS_DELTA,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -132,6 +132,7 @@ int libewf_segment_table_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_segment_table_free";
+	int stripe_index      = 0;
 	int result            = 1;
 
 	if( segment_table == NULL )
@@ -152,6 +153,23 @@ int libewf_segment_table_free(
 			memory_free(
 			 ( *segment_table )->basename );
 		}
+		if( ( *segment_table )->stripe_basenames != NULL )
+		{
+			for( stripe_index = 0;
+			     stripe_index < ( *segment_table )->number_of_stripe_basenames;
+			     stripe_index++ )
+			{
+				memory_free(
+				 ( *segment_table )->stripe_basenames[ stripe_index ] );
+			}
+			memory_free(
+			 ( *segment_table )->stripe_basenames );
+		}
+		if( ( *segment_table )->stripe_basename_sizes != NULL )
+		{
+			memory_free(
+			 ( *segment_table )->stripe_basename_sizes );
+		}
 		if( libcdata_array_free(
 		     &( ( *segment_table )->segment_files_array ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_file_handle_free,
@@ -182,7 +200,9 @@ int libewf_segment_table_clone(
      libewf_segment_table_t *source_segment_table,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_table_clone";
+	libcstring_system_character_t *stripe_basename = NULL;
+	static char *function                          = "libewf_segment_table_clone";
+	int stripe_index                               = 0;
 
 	if( destination_segment_table == NULL )
 	{
@@ -272,6 +292,58 @@ int libewf_segment_table_clone(
 		}
 		( *destination_segment_table )->basename_size = source_segment_table->basename_size;
 	}
+	for( stripe_index = 0;
+	     stripe_index < source_segment_table->number_of_stripe_basenames;
+	     stripe_index++ )
+	{
+		stripe_basename = libcstring_system_string_allocate(
+		                   source_segment_table->stripe_basename_sizes[ stripe_index ] );
+
+		if( stripe_basename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination stripe basename: %d.",
+			 function,
+			 stripe_index );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     stripe_basename,
+		     source_segment_table->stripe_basenames[ stripe_index ],
+		     sizeof( libcstring_system_character_t ) * source_segment_table->stripe_basename_sizes[ stripe_index ] ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination stripe basename: %d.",
+			 function,
+			 stripe_index );
+
+			goto on_error;
+		}
+		if( libewf_segment_table_append_stripe(
+		     *destination_segment_table,
+		     stripe_basename,
+		     source_segment_table->stripe_basename_sizes[ stripe_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append destination stripe basename: %d.",
+			 function,
+			 stripe_index );
+
+			goto on_error;
+		}
+		stripe_basename = NULL;
+	}
 	if( libcdata_array_clone(
 	     &( ( *destination_segment_table )->segment_files_array ),
 	     source_segment_table->segment_files_array,
@@ -293,6 +365,11 @@ int libewf_segment_table_clone(
 	return( 1 );
 
 on_error:
+	if( stripe_basename != NULL )
+	{
+		memory_free(
+		 stripe_basename );
+	}
 	if( *destination_segment_table != NULL )
 	{
 		if( ( *destination_segment_table )->basename != NULL )
@@ -300,6 +377,23 @@ on_error:
 			memory_free(
 			 ( *destination_segment_table )->basename );
 		}
+		if( ( *destination_segment_table )->stripe_basenames != NULL )
+		{
+			for( stripe_index = 0;
+			     stripe_index < ( *destination_segment_table )->number_of_stripe_basenames;
+			     stripe_index++ )
+			{
+				memory_free(
+				 ( *destination_segment_table )->stripe_basenames[ stripe_index ] );
+			}
+			memory_free(
+			 ( *destination_segment_table )->stripe_basenames );
+		}
+		if( ( *destination_segment_table )->stripe_basename_sizes != NULL )
+		{
+			memory_free(
+			 ( *destination_segment_table )->stripe_basename_sizes );
+		}
 		memory_free(
 		 *destination_segment_table );
 
@@ -788,6 +882,219 @@ int libewf_segment_table_set_basename(
 	return( 1 );
 }
 
+/* Appends a stripe basename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_append_stripe_basename(
+     libewf_segment_table_t *segment_table,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t *stripe_basename = NULL;
+	static char *function                          = "libewf_segment_table_append_stripe_basename";
+	size_t stripe_basename_size                    = 0;
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	int result                                     = 0;
+#endif
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_utf8(
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
+		          &( stripe_basename_size ),
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_utf8(
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
+		          &( stripe_basename_size ),
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_byte_stream(
+		          (uint8_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          &( stripe_basename_size ),
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_byte_stream(
+		          (uint8_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          &( stripe_basename_size ),
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine stripe basename size.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	stripe_basename_size = basename_length + 1;
+#endif
+	stripe_basename = libcstring_system_string_allocate(
+	                           stripe_basename_size );
+
+	if( stripe_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stripe basename.",
+		 function );
+
+		stripe_basename_size = 0;
+
+		return( -1 );
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_utf8(
+		          (libuna_utf32_character_t *) stripe_basename,
+		          stripe_basename_size,
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_utf8(
+		          (libuna_utf16_character_t *) stripe_basename,
+		          stripe_basename_size,
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_byte_stream(
+		          (libuna_utf32_character_t *) stripe_basename,
+		          stripe_basename_size,
+		          (uint8_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_byte_stream(
+		          (libuna_utf16_character_t *) stripe_basename,
+		          stripe_basename_size,
+		          (uint8_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set stripe basename.",
+		 function );
+
+		memory_free(
+		 stripe_basename );
+
+		stripe_basename      = NULL;
+		stripe_basename_size = 0;
+
+		return( -1 );
+	}
+#else
+	if( libcstring_system_string_copy(
+	     stripe_basename,
+	     basename,
+	     basename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set stripe basename.",
+		 function );
+
+		memory_free(
+		 stripe_basename );
+
+		stripe_basename      = NULL;
+		stripe_basename_size = 0;
+
+		return( -1 );
+	}
+	stripe_basename[ basename_length ] = 0;
+#endif /* defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( libewf_segment_table_append_stripe(
+	     segment_table,
+	     stripe_basename,
+	     stripe_basename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append stripe basename.",
+		 function );
+
+		memory_free(
+		 stripe_basename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 /* Retrieves the size of the basename
  * Returns 1 if successful, 0 if value not present or -1 on error
@@ -1262,8 +1569,383 @@ int libewf_segment_table_set_basename_wide(
 #endif /* defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER ) */
 	return( 1 );
 }
+
+/* Appends a stripe basename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_append_stripe_basename_wide(
+     libewf_segment_table_t *segment_table,
+     const wchar_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t *stripe_basename = NULL;
+	static char *function                          = "libewf_segment_table_append_stripe_basename_wide";
+	size_t stripe_basename_size                    = 0;
+
+#if !defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	int result                                     = 0;
+#endif
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	stripe_basename_size = basename_length + 1;
+#else
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_size_from_utf32(
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          &( stripe_basename_size ),
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_size_from_utf16(
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          &( stripe_basename_size ),
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_size_from_utf32(
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          &( stripe_basename_size ),
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_size_from_utf16(
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          &( stripe_basename_size ),
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine stripe basename size.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER ) */
+	stripe_basename = libcstring_system_string_allocate(
+	                           stripe_basename_size );
+
+	if( stripe_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stripe basename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcstring_system_string_copy(
+	     stripe_basename,
+	     basename,
+	     basename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set stripe basename.",
+		 function );
+
+		memory_free(
+		 stripe_basename );
+
+		stripe_basename      = NULL;
+		stripe_basename_size = 0;
+
+		return( -1 );
+	}
+	stripe_basename[ basename_length ] = 0;
+#else
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_copy_from_utf32(
+		          (libuna_utf8_character_t *) stripe_basename,
+		          stripe_basename_size,
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_copy_from_utf16(
+		          (libuna_utf8_character_t *) stripe_basename,
+		          stripe_basename_size,
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_copy_from_utf32(
+		          (uint8_t *) stripe_basename,
+		          stripe_basename_size,
+		          libclocale_codepage,
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_copy_from_utf16(
+		          (uint8_t *) stripe_basename,
+		          stripe_basename_size,
+		          libclocale_codepage,
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set stripe basename.",
+		 function );
+
+		memory_free(
+		 stripe_basename );
+
+		stripe_basename      = NULL;
+		stripe_basename_size = 0;
+
+		return( -1 );
+	}
+#endif /* defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER ) */
+	if( libewf_segment_table_append_stripe(
+	     segment_table,
+	     stripe_basename,
+	     stripe_basename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append stripe basename.",
+		 function );
+
+		memory_free(
+		 stripe_basename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+/* Appends a stripe basename
+ * The segment table takes over management of the stripe basename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_append_stripe(
+     libewf_segment_table_t *segment_table,
+     libcstring_system_character_t *stripe_basename,
+     size_t stripe_basename_size,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t **stripe_basenames = NULL;
+	size_t *stripe_basename_sizes                    = NULL;
+	static char *function                            = "libewf_segment_table_append_stripe";
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( stripe_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stripe basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->number_of_stripe_basenames >= (int) ( UINT16_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment table - number of stripe basenames value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	stripe_basenames = (libcstring_system_character_t **) memory_reallocate(
+	                                                       segment_table->stripe_basenames,
+	                                                       sizeof( libcstring_system_character_t * ) * ( segment_table->number_of_stripe_basenames + 1 ) );
+
+	if( stripe_basenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize stripe basenames.",
+		 function );
+
+		return( -1 );
+	}
+	segment_table->stripe_basenames = stripe_basenames;
+
+	stripe_basename_sizes = (size_t *) memory_reallocate(
+	                                    segment_table->stripe_basename_sizes,
+	                                    sizeof( size_t ) * ( segment_table->number_of_stripe_basenames + 1 ) );
+
+	if( stripe_basename_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize stripe basename sizes.",
+		 function );
+
+		return( -1 );
+	}
+	segment_table->stripe_basename_sizes = stripe_basename_sizes;
+
+	segment_table->stripe_basenames[ segment_table->number_of_stripe_basenames ]      = stripe_basename;
+	segment_table->stripe_basename_sizes[ segment_table->number_of_stripe_basenames ] = stripe_basename_size;
+
+	segment_table->number_of_stripe_basenames += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the basename of a specific segment file
+ * The segment files are distributed round-robin over the basename and the stripe basenames
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_get_segment_file_basename(
+     libewf_segment_table_t *segment_table,
+     uint16_t segment_number,
+     libcstring_system_character_t **basename,
+     size_t *basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_get_segment_file_basename";
+	int stripe_index      = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment table - missing basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_number > 0 )
+	 && ( segment_table->number_of_stripe_basenames > 0 ) )
+	{
+		stripe_index = (int) ( ( segment_number - 1 ) % ( segment_table->number_of_stripe_basenames + 1 ) );
+	}
+	if( stripe_index == 0 )
+	{
+		*basename      = segment_table->basename;
+		*basename_size = segment_table->basename_size;
+	}
+	else
+	{
+		*basename      = segment_table->stripe_basenames[ stripe_index - 1 ];
+		*basename_size = segment_table->stripe_basename_sizes[ stripe_index - 1 ];
+	}
+	return( 1 );
+}
+
 /* Sets the maximum segment size
  * Returns 1 if successful or -1 on error
  */
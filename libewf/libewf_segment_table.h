@@ -49,6 +49,18 @@ struct libewf_segment_table
 	 */
 	size_t basename_size;
 
+	/* The stripe basenames
+	 */
+	libcstring_system_character_t **stripe_basenames;
+
+	/* The stripe basename sizes
+	 */
+	size_t *stripe_basename_sizes;
+
+	/* The number of stripe basenames
+	 */
+	int number_of_stripe_basenames;
+
 	/* The maximum segment size
 	 */
 	size64_t maximum_segment_size;
@@ -93,6 +105,12 @@ int libewf_segment_table_set_basename(
      size_t basename_length,
      libcerror_error_t **error );
 
+int libewf_segment_table_append_stripe_basename(
+     libewf_segment_table_t *segment_table,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 int libewf_segment_table_get_basename_size_wide(
      libewf_segment_table_t *segment_table,
@@ -110,8 +128,27 @@ int libewf_segment_table_set_basename_wide(
      const wchar_t *basename,
      size_t basename_length,
      libcerror_error_t **error );
+
+int libewf_segment_table_append_stripe_basename_wide(
+     libewf_segment_table_t *segment_table,
+     const wchar_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
 #endif
 
+int libewf_segment_table_append_stripe(
+     libewf_segment_table_t *segment_table,
+     libcstring_system_character_t *stripe_basename,
+     size_t stripe_basename_size,
+     libcerror_error_t **error );
+
+int libewf_segment_table_get_segment_file_basename(
+     libewf_segment_table_t *segment_table,
+     uint16_t segment_number,
+     libcstring_system_character_t **basename,
+     size_t *basename_size,
+     libcerror_error_t **error );
+
 int libewf_segment_table_set_maximum_segment_size(
      libewf_segment_table_t *segment_table,
      size64_t maximum_segment_size,
@@ -103,6 +103,14 @@ struct libewf_single_file_entry
 	/* The SHA1 digest hash size
 	 */
 	size_t sha1_hash_size;
+
+	/* The offset of the sub entries in the ltree data
+	 */
+	off64_t sub_entries_offset;
+
+	/* The number of sub entries that have not been read
+	 */
+	uint64_t number_of_unread_sub_entries;
 };
 
 int libewf_single_file_entry_initialize(
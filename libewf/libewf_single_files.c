@@ -24,12 +24,13 @@
 #include <types.h>
 
 #include "libewf_definitions.h"
+#include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libcstring.h"
 #include "libewf_libfvalue.h"
-#include "libewf_libuna.h"
+#include "libewf_ltree_stream.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_single_files.h"
 
@@ -150,6 +151,38 @@ int libewf_single_files_free(
 				result = -1;
 			}
 		}
+		if( ( *single_files )->ltree_stream != NULL )
+		{
+			if( libewf_ltree_stream_free(
+			     &( ( *single_files )->ltree_stream ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free ltree stream.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *single_files )->types != NULL )
+		{
+			if( libfvalue_split_utf8_string_free(
+			     &( ( *single_files )->types ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free split types.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *single_files );
 
@@ -159,17 +192,21 @@ int libewf_single_files_free(
 }
 
 /* Parse an EWF ltree for the values
+ * The ltree data is read from the segment file and parsed in a single pass
+ * If read on demand is set only the root file entry is parsed, the ltree stream
+ * is retained and the sub file entries are read when they are first accessed
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse(
      libewf_single_files_t *single_files,
+     libbfio_pool_t *file_io_pool,
      size64_t *media_size,
      uint8_t *format,
+     uint8_t read_on_demand,
      libcerror_error_t **error )
 {
-	uint8_t *file_entries_string    = NULL;
-	static char *function           = "libewf_single_files_parse";
-	size_t file_entries_string_size = 0;
+	libewf_ltree_stream_t *ltree_stream = NULL;
+	static char *function               = "libewf_single_files_parse";
 
 	if( single_files == NULL )
 	{
@@ -182,7 +219,7 @@ int libewf_single_files_parse(
 
 		return( -1 );
 	}
-	if( single_files->ltree_data == NULL )
+	if( single_files->ltree_data_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
@@ -193,102 +230,103 @@ int libewf_single_files_parse(
 
 		return( -1 );
 	}
-	if( libuna_utf8_string_size_from_utf16_stream(
-	     single_files->ltree_data,
-	     single_files->ltree_data_size,
-	     LIBUNA_ENDIAN_LITTLE,
-	     &file_entries_string_size,
-	     error ) != 1 )
+	if( single_files->ltree_stream != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to determine file entries string size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - ltree stream value already set.",
 		 function );
 
 		return( -1 );
 	}
-	file_entries_string = (uint8_t *) memory_allocate(
-	                                   sizeof( uint8_t ) * (size_t) file_entries_string_size );
-
-	if( file_entries_string == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create file entries string.",
-		 function );
-
-		goto on_error;
-	}
-	if( libuna_utf8_string_copy_from_utf16_stream(
-	     file_entries_string,
-	     file_entries_string_size,
-	     single_files->ltree_data,
+	if( libewf_ltree_stream_initialize(
+	     &ltree_stream,
+	     single_files->ltree_file_io_pool_entry,
+	     single_files->ltree_data_offset,
 	     single_files->ltree_data_size,
-	     LIBUNA_ENDIAN_LITTLE,
+	     LIBEWF_LTREE_STREAM_BLOCK_SIZE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to set file entries string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create ltree stream.",
 		 function );
 
 		goto on_error;
 	}
 	if( libewf_single_files_parse_file_entries(
 	     single_files,
+	     ltree_stream,
+	     file_io_pool,
 	     media_size,
-	     file_entries_string,
-	     file_entries_string_size,
 	     format,
+	     read_on_demand,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to parse file entries string.",
+		 "%s: unable to parse file entries.",
 		 function );
 
 		goto on_error;
 	}
-	memory_free(
-	 file_entries_string );
+	if( read_on_demand != 0 )
+	{
+		single_files->ltree_stream = ltree_stream;
+	}
+	else if( libewf_ltree_stream_free(
+	          &ltree_stream,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free ltree stream.",
+		 function );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
-	if( file_entries_string != NULL )
+	if( ltree_stream != NULL )
 	{
-		memory_free(
-		 file_entries_string );
+		libewf_ltree_stream_free(
+		 &ltree_stream,
+		 NULL );
 	}
 	return( -1 );
 }
 
-/* Parse a single file entries string for the values
+/* Parse the single file entries from the ltree stream
+ * If read on demand is set the sub file entries of the root file entry are not parsed
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entries(
      libewf_single_files_t *single_files,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      size64_t *media_size,
-     const uint8_t *entries_string,
-     size_t entries_string_size,
      uint8_t *format,
+     uint8_t read_on_demand,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *lines = NULL;
-	libfvalue_split_utf8_string_t *types = NULL;
-	uint8_t *line_string                 = NULL;
-	static char *function                = "libewf_single_files_parse_file_entries";
-	size_t line_string_size              = 0;
-	int line_index                       = 0;
-	int number_of_lines                  = 0;
+	libewf_single_file_entry_t *root_single_file_entry = NULL;
+	libfvalue_split_utf8_string_t *types                = NULL;
+	uint8_t *line_string                                = NULL;
+	static char *function                               = "libewf_single_files_parse_file_entries";
+	size_t line_string_size                             = 0;
+	int line_index                                      = 0;
+	int result                                          = 0;
+	uint8_t has_entries                                 = 0;
+	uint8_t has_record_values                           = 0;
 
 	if( single_files == NULL )
 	{
@@ -301,241 +339,148 @@ int libewf_single_files_parse_file_entries(
 
 		return( -1 );
 	}
-	if( entries_string == NULL )
+	if( single_files->root_file_entry_node != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid entries string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - root file entry node value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_utf8_string_split(
-	     entries_string,
-	     entries_string_size - 1,
-	     (uint8_t) '\n',
-	     &lines,
-	     error ) != 1 )
+	result = libewf_ltree_stream_read_line(
+	          ltree_stream,
+	          file_io_pool,
+	          &line_string,
+	          &line_string_size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into lines.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line: %d.",
+		 function,
+		 line_index );
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
-	     error ) != 1 )
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	if( ( line_string_size != 2 )
+	 || ( line_string[ 0 ] < (uint8_t) '0' )
+	 || ( line_string[ 0 ] > (uint8_t) '9' ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported single file entries string.",
 		 function );
 
 		goto on_error;
 	}
-	if( number_of_lines > 0 )
+	/* Find the lines containing: "rec" and "entry"
+	 * Both categories are parsed as soon as they are encountered
+	 */
+	while( ( has_record_values == 0 )
+	    || ( has_entries == 0 ) )
 	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     0,
-		     &line_string,
-		     &line_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve line string: 0.",
-			 function );
-
-			goto on_error;
-		}
-		if( ( line_string == NULL )
-		 || ( line_string_size < 2 )
-		 || ( line_string[ 0 ] == 0 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing line string: 0.",
-			 function );
+		line_index += 1;
 
-			goto on_error;
-		}
-		/* Remove trailing carriage return
-		 */
-		else if( line_string[ line_string_size - 2 ] == (uint8_t) '\r' )
-		{
-			line_string[ line_string_size - 2 ] = 0;
+		result = libewf_ltree_stream_read_line(
+		          ltree_stream,
+		          file_io_pool,
+		          &line_string,
+		          &line_string_size,
+		          error );
 
-			line_string_size -= 1;
-		}
-		if( line_string_size != 2 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported single file entries string.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read line: %d.",
+			 function,
+			 line_index );
 
 			goto on_error;
 		}
-		if( ( line_string[ 0 ] < (uint8_t) '0' )
-		 || ( line_string[ 0 ] > (uint8_t) '9' ) )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported single file entries string.",
-			 function );
-
-			goto on_error;
+			break;
 		}
-		/* Find the line containing: "rec"
-		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
+		if( ( has_record_values == 0 )
+		 && ( line_string_size == 4 )
+		 && ( line_string[ 0 ] == (uint8_t) 'r' )
+		 && ( line_string[ 1 ] == (uint8_t) 'e' )
+		 && ( line_string[ 2 ] == (uint8_t) 'c' ) )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
+			if( libewf_single_files_parse_record_values(
+			     media_size,
+			     ltree_stream,
+			     file_io_pool,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
+				 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+				 LIBCERROR_CONVERSION_ERROR_GENERIC,
+				 "%s: unable to parse record values.",
+				 function );
 
 				goto on_error;
 			}
-			if( line_string_size == 4 )
-			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
-
-					goto on_error;
-				}
-				if( ( line_string[ 0 ] == (uint8_t) 'r' )
-				 && ( line_string[ 1 ] == (uint8_t) 'e' )
-				 && ( line_string[ 2 ] == (uint8_t) 'c' ) )
-				{
-					line_index += 1;
-
-					break;
-				}
-			}
-		}
-		if( libewf_single_files_parse_record_values(
-		     media_size,
-		     lines,
-		     &line_index,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-			 LIBCERROR_CONVERSION_ERROR_GENERIC,
-			 "%s: unable to parse record values.",
-			 function );
-
-			goto on_error;
+			has_record_values = 1;
 		}
-		/* Find the line containing: "entry"
-		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
+		else if( ( has_entries == 0 )
+		      && ( line_string_size == 6 )
+		      && ( line_string[ 0 ] == (uint8_t) 'e' )
+		      && ( line_string[ 1 ] == (uint8_t) 'n' )
+		      && ( line_string[ 2 ] == (uint8_t) 't' )
+		      && ( line_string[ 3 ] == (uint8_t) 'r' )
+		      && ( line_string[ 4 ] == (uint8_t) 'y' ) )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-			if( line_string_size == 6 )
+			/* Skip the line following the "entry" line
+			 */
+			result = libewf_ltree_stream_read_line(
+			          ltree_stream,
+			          file_io_pool,
+			          &line_string,
+			          &line_string_size,
+			          error );
+
+			if( result == 1 )
 			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
-
-					goto on_error;
-				}
-				if( ( line_string[ 0 ] == (uint8_t) 'e' )
-				 && ( line_string[ 1 ] == (uint8_t) 'n' )
-				 && ( line_string[ 2 ] == (uint8_t) 't' )
-				 && ( line_string[ 3 ] == (uint8_t) 'r' )
-				 && ( line_string[ 4 ] == (uint8_t) 'y' ) )
-				{
-					line_index += 2;
-
-					break;
-				}
+				result = libewf_ltree_stream_read_line(
+				          ltree_stream,
+				          file_io_pool,
+				          &line_string,
+				          &line_string_size,
+				          error );
 			}
-		}
-		if( line_index < number_of_lines )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read entry types line.",
+				 function );
 
 				goto on_error;
 			}
-			line_index += 1;
-
+			else if( result == 0 )
+			{
+				break;
+			}
 			if( libfvalue_utf8_string_split(
 			     line_string,
 			     line_string_size,
@@ -567,10 +512,11 @@ int libewf_single_files_parse_file_entries(
 			}
 			if( libewf_single_files_parse_file_entry(
 			     single_files->root_file_entry_node,
-			     lines,
-			     &line_index,
+			     ltree_stream,
+			     file_io_pool,
 			     types,
 			     format,
+			     (uint8_t) ( read_on_demand == 0 ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -582,62 +528,120 @@ int libewf_single_files_parse_file_entries(
 
 				goto on_error;
 			}
+			if( read_on_demand == 0 )
+			{
+				if( libfvalue_split_utf8_string_free(
+				     &types,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free split types.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				if( libewf_single_files_parse_format(
+				     types,
+				     format,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+					 LIBCERROR_CONVERSION_ERROR_GENERIC,
+					 "%s: unable to parse format.",
+					 function );
+
+					goto on_error;
+				}
+				single_files->types = types;
+				types               = NULL;
+
+				/* The remaining ltree data is only needed to find the record values
+				 */
+				if( has_record_values != 0 )
+				{
+					has_entries = 1;
+
+					break;
+				}
+				if( libcdata_tree_node_get_value(
+				     single_files->root_file_entry_node,
+				     (intptr_t **) &root_single_file_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve root single file entry.",
+					 function );
+
+					goto on_error;
+				}
+				if( libewf_single_files_skip_file_entries(
+				     ltree_stream,
+				     file_io_pool,
+				     root_single_file_entry->number_of_unread_sub_entries,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to skip sub file entries.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			/* The single files entries should be followed by an empty line
 			 */
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
+			result = libewf_ltree_stream_read_line(
+			          ltree_stream,
+			          file_io_pool,
+			          &line_string,
+			          &line_string_size,
+			          error );
+
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read line following the file entries.",
+				 function );
 
 				goto on_error;
 			}
-			if( ( line_string_size != 1 )
-			 || ( line_string[ 0 ] != 0 ) )
+			if( line_string_size != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: unsupported empty line string: %d - not empty.",
-				 function,
-				 line_index );
+				 "%s: unsupported line following the file entries - not empty.",
+				 function );
 
 				goto on_error;
 			}
-		}
-		if( libfvalue_split_utf8_string_free(
-		     &types,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free split types.",
-			 function );
-
-			goto on_error;
+			has_entries = 1;
 		}
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &lines,
-	     error ) != 1 )
+	if( has_record_values == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split lines.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing record values.",
 		 function );
 
 		goto on_error;
@@ -651,10 +655,17 @@ on_error:
 		 &types,
 		 NULL );
 	}
-	if( lines != NULL )
+	if( single_files->types != NULL )
 	{
 		libfvalue_split_utf8_string_free(
-		 &lines,
+		 &( single_files->types ),
+		 NULL );
+	}
+	if( single_files->root_file_entry_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &( single_files->root_file_entry_node ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
 		 NULL );
 	}
 	return( -1 );
@@ -665,8 +676,8 @@ on_error:
  */
 int libewf_single_files_parse_record_values(
      size64_t *media_size,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      libcerror_error_t **error )
 {
 	libfvalue_split_utf8_string_t *types  = NULL;
@@ -694,35 +705,22 @@ int libewf_single_files_parse_record_values(
 
 		return( -1 );
 	}
-	if( line_index == NULL )
+	if( libewf_ltree_stream_read_line(
+	     ltree_stream,
+	     file_io_pool,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
-	     &line_string,
-	     &line_string_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
-
-		goto on_error;
-	}
-	*line_index += 1;
 
 	if( libfvalue_utf8_string_split(
 	     line_string,
@@ -754,24 +752,22 @@ int libewf_single_files_parse_record_values(
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_ltree_stream_read_line(
+	     ltree_stream,
+	     file_io_pool,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line.",
+		 function );
 
 		goto on_error;
 	}
-	*line_index += 1;
 
 	if( libfvalue_utf8_string_split(
 	     line_string,
@@ -988,14 +984,17 @@ on_error:
 }
 
 /* Parse a single file entry string for the values
+ * If read sub entries is not set the offset and number of the sub entries are
+ * stored in the single file entry and the sub entries are not parsed
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry(
      libcdata_tree_node_t *parent_file_entry_node,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      libfvalue_split_utf8_string_t *types,
      uint8_t *format,
+     uint8_t read_sub_entries,
      libcerror_error_t **error )
 {
 	libewf_single_file_entry_t *single_file_entry = NULL;
@@ -1010,8 +1009,8 @@ int libewf_single_files_parse_file_entry(
 	size_t value_string_size                      = 0;
 	size_t value_string_index                     = 0;
 	uint64_t number_of_sub_entries                = 0;
+	off64_t ltree_offset                          = 0;
 	uint64_t value_64bit                          = 0;
-	int number_of_lines                           = 0;
 	int number_of_types                           = 0;
 	int number_of_values                          = 0;
 	int value_index                               = 0;
@@ -1028,17 +1027,6 @@ int libewf_single_files_parse_file_entry(
 
 		return( -1 );
 	}
-	if( line_index == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
-		 function );
-
-		return( -1 );
-	}
 	if( format == NULL )
 	{
 		libcerror_error_set(
@@ -1065,8 +1053,8 @@ int libewf_single_files_parse_file_entry(
 		goto on_error;
 	}
 	if( libewf_single_files_parse_file_entry_number_of_sub_entries(
-	     lines,
-	     line_index,
+	     ltree_stream,
+	     file_io_pool,
 	     &number_of_sub_entries,
 	     error ) != 1 )
 	{
@@ -1079,24 +1067,22 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_ltree_stream_read_line(
+	     ltree_stream,
+	     file_io_pool,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line.",
+		 function );
 
 		goto on_error;
 	}
-	*line_index += 1;
 
 	if( libfvalue_utf8_string_split(
 	     line_string,
@@ -1711,47 +1697,56 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
-	if( libcdata_tree_node_set_value(
-	     parent_file_entry_node,
-	     (intptr_t *) single_file_entry,
+	if( libewf_ltree_stream_get_offset(
+	     ltree_stream,
+	     &ltree_offset,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set single file entry in node.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve ltree stream offset.",
 		 function );
 
 		goto on_error;
 	}
-	single_file_entry = NULL;
-
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
-	     error ) != 1 )
+	/* Every sub entry consists of at least 2 lines of at least 2 bytes
+	 */
+	if( number_of_sub_entries > ( ( ltree_stream->data_size - (size64_t) ltree_offset ) / 4 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of sub entries exceed the remaining ltree data.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( *line_index + number_of_sub_entries ) > (uint64_t) number_of_lines )
+	if( read_sub_entries == 0 )
+	{
+		single_file_entry->sub_entries_offset           = ltree_offset;
+		single_file_entry->number_of_unread_sub_entries = number_of_sub_entries;
+
+		number_of_sub_entries = 0;
+	}
+	if( libcdata_tree_node_set_value(
+	     parent_file_entry_node,
+	     (intptr_t *) single_file_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: number of sub entries exceed the number of available lines.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set single file entry in node.",
 		 function );
 
 		goto on_error;
 	}
+	single_file_entry = NULL;
+
 	while( number_of_sub_entries > 0 )
 	{
 		if( libcdata_tree_node_initialize(
@@ -1769,10 +1764,11 @@ int libewf_single_files_parse_file_entry(
 		}
 		if( libewf_single_files_parse_file_entry(
 		     file_entry_node,
-		     lines,
-		     line_index,
+		     ltree_stream,
+		     file_io_pool,
 		     types,
 		     format,
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1827,12 +1823,392 @@ on_error:
 	return( -1 );
 }
 
+/* Parse the file entry types for the format
+ * The format is determined by the index of the data offset type
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_format(
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	uint8_t *type_string    = NULL;
+	static char *function   = "libewf_single_files_parse_format";
+	size_t type_string_size = 0;
+	int number_of_types     = 0;
+	int value_index         = 0;
+
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     types,
+	     &number_of_types,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of types",
+		 function );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     value_index < number_of_types;
+	     value_index++ )
+	{
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     types,
+		     value_index,
+		     &type_string,
+		     &type_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve type string: %d.",
+			 function,
+			 value_index );
+
+			return( -1 );
+		}
+		if( ( type_string != NULL )
+		 && ( type_string_size == 3 )
+		 && ( type_string[ 0 ] == (uint8_t) 'b' )
+		 && ( type_string[ 1 ] == (uint8_t) 'e' ) )
+		{
+			if( value_index == 19 )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE5;
+			}
+			else if( ( value_index == 20 )
+			      || ( value_index == 21 ) )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE6;
+			}
+			else if( value_index == 2 )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE7;
+			}
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Skips a number of single file entries including their sub entries in the ltree stream
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_skip_file_entries(
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
+     uint64_t number_of_file_entries,
+     libcerror_error_t **error )
+{
+	uint8_t *line_string           = NULL;
+	static char *function          = "libewf_single_files_skip_file_entries";
+	size_t line_string_size        = 0;
+	uint64_t number_of_sub_entries = 0;
+	off64_t ltree_offset           = 0;
+
+	if( ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sub entries of a skipped file entry are added to the number
+	 * of file entries to skip, this avoids recursion
+	 */
+	while( number_of_file_entries > 0 )
+	{
+		if( libewf_single_files_parse_file_entry_number_of_sub_entries(
+		     ltree_stream,
+		     file_io_pool,
+		     &number_of_sub_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to parse file entry number of sub entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_ltree_stream_read_line(
+		     ltree_stream,
+		     file_io_pool,
+		     &line_string,
+		     &line_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read line.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_ltree_stream_get_offset(
+		     ltree_stream,
+		     &ltree_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve ltree stream offset.",
+			 function );
+
+			return( -1 );
+		}
+		/* Every sub entry consists of at least 2 lines of at least 2 bytes
+		 */
+		if( number_of_sub_entries > ( ( ltree_stream->data_size - (size64_t) ltree_offset ) / 4 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: number of sub entries exceed the remaining ltree data.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_file_entries -= 1;
+		number_of_file_entries += number_of_sub_entries;
+	}
+	return( 1 );
+}
+
+/* Reads the sub file entries of a file entry that were not read when the ltree was parsed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_read_sub_file_entries(
+     libewf_single_files_t *single_files,
+     libbfio_pool_t *file_io_pool,
+     libcdata_tree_node_t *file_entry_node,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry     = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libcdata_tree_node_t *sub_file_entry_node         = NULL;
+	static char *function                             = "libewf_single_files_read_sub_file_entries";
+	off64_t ltree_offset                              = 0;
+	uint8_t format                                    = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     file_entry_node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from file entry tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry->number_of_unread_sub_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( single_files->ltree_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_ltree_stream_set_offset(
+	     single_files->ltree_stream,
+	     single_file_entry->sub_entries_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set ltree stream offset.",
+		 function );
+
+		goto on_error;
+	}
+	while( single_file_entry->number_of_unread_sub_entries > 0 )
+	{
+		if( libcdata_tree_node_initialize(
+		     &sub_file_entry_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create single file entry node.",
+			 function );
+
+			goto on_error;
+		}
+		/* The format was determined when the ltree was parsed
+		 */
+		if( libewf_single_files_parse_file_entry(
+		     sub_file_entry_node,
+		     single_files->ltree_stream,
+		     file_io_pool,
+		     single_files->types,
+		     &format,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to parse file entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_tree_node_get_value(
+		     sub_file_entry_node,
+		     (intptr_t **) &sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub file entry tree node.",
+			 function );
+
+			goto on_error;
+		}
+		/* The sub entries of the sub file entry are read when it is first accessed,
+		 * they only need to be skipped to reach the next sibling
+		 */
+		if( single_file_entry->number_of_unread_sub_entries > 1 )
+		{
+			if( libewf_single_files_skip_file_entries(
+			     single_files->ltree_stream,
+			     file_io_pool,
+			     sub_single_file_entry->number_of_unread_sub_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to skip sub file entries.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_ltree_stream_get_offset(
+		     single_files->ltree_stream,
+		     &ltree_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve ltree stream offset.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_tree_node_append_node(
+		     file_entry_node,
+		     sub_file_entry_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append single file entry node to parent.",
+			 function );
+
+			goto on_error;
+		}
+		sub_file_entry_node = NULL;
+
+		/* Keep track of the sub entries that were read so that a failed read
+		 * can be resumed without duplicating the sub file entries read so far
+		 */
+		single_file_entry->sub_entries_offset           = ltree_offset;
+		single_file_entry->number_of_unread_sub_entries -= 1;
+	}
+	return( 1 );
+
+on_error:
+	if( sub_file_entry_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &sub_file_entry_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Parse a single file entry string for the number of sub entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry_number_of_sub_entries(
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      uint64_t *number_of_sub_entries,
      libcerror_error_t **error )
 {
@@ -1844,35 +2220,22 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 	size_t value_string_size              = 0;
 	int number_of_values                  = 0;
 
-	if( line_index == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
-		 function );
-
-		return( -1 );
-	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_ltree_stream_read_line(
+	     ltree_stream,
+	     file_io_pool,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line.",
+		 function );
 
 		goto on_error;
 	}
-	*line_index += 1;
 
 	if( libfvalue_utf8_string_split(
 	     line_string,
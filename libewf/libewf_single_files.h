@@ -26,9 +26,11 @@
 #include <types.h>
 
 #include "libewf_extern.h"
+#include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfvalue.h"
+#include "libewf_ltree_stream.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_types.h"
 
@@ -48,17 +50,29 @@ struct libewf_single_files
 	 */
 	size_t section_data_size;
 
-	/* The ltree data
+	/* The file IO pool entry of the segment file containing the ltree data
 	 */
-	uint8_t *ltree_data;
+	int ltree_file_io_pool_entry;
+
+	/* The offset of the ltree data in the segment file
+	 */
+	off64_t ltree_data_offset;
 
 	/* The ltree data size
 	 */
-	size_t ltree_data_size;
+	size64_t ltree_data_size;
 
 	/* The single file entry tree
 	 */
 	libcdata_tree_node_t *root_file_entry_node;
+
+	/* The ltree stream used to read sub file entries on demand
+	 */
+	libewf_ltree_stream_t *ltree_stream;
+
+	/* The file entry types used to read sub file entries on demand
+	 */
+	libfvalue_split_utf8_string_t *types;
 };
 
 int libewf_single_files_initialize(
@@ -71,35 +85,56 @@ int libewf_single_files_free(
 
 int libewf_single_files_parse(
      libewf_single_files_t *single_files,
+     libbfio_pool_t *file_io_pool,
      size64_t *media_size,
      uint8_t *format,
+     uint8_t read_on_demand,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entries(
      libewf_single_files_t *single_files,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      size64_t *media_size,
-     const uint8_t *file_entries_string,
-     size_t file_entries_string_size,
      uint8_t *format,
+     uint8_t read_on_demand,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_record_values(
      size64_t *media_size,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_iterator,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entry(
      libcdata_tree_node_t *parent_file_entry_node,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_iterator,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      libfvalue_split_utf8_string_t *types,
      uint8_t *format,
+     uint8_t read_sub_entries,
+     libcerror_error_t **error );
+
+int libewf_single_files_parse_format(
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error );
+
+int libewf_single_files_skip_file_entries(
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
+     uint64_t number_of_file_entries,
+     libcerror_error_t **error );
+
+int libewf_single_files_read_sub_file_entries(
+     libewf_single_files_t *single_files,
+     libbfio_pool_t *file_io_pool,
+     libcdata_tree_node_t *file_entry_node,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entry_number_of_sub_entries(
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_ltree_stream_t *ltree_stream,
+     libbfio_pool_t *file_io_pool,
      uint64_t *number_of_sub_entries,
      libcerror_error_t **error );
 
@@ -0,0 +1,287 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_statistics.h"
+
+/* Creates statistics
+ * Make sure the value statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_initialize(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_initialize";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*statistics = memory_allocate_structure(
+	               libewf_statistics_t );
+
+	if( *statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *statistics,
+	     0,
+	     sizeof( libewf_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_free(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_free";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( 1 );
+}
+
+/* Adds the source statistics to the destination statistics and clears the source statistics
+ * The trace of the source statistics is retained
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_merge(
+     libewf_statistics_t *destination_statistics,
+     libewf_statistics_t *source_statistics,
+     libcerror_error_t **error )
+{
+	libewf_trace_t *trace = NULL;
+	static char *function = "libewf_statistics_merge";
+
+	if( destination_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source statistics.",
+		 function );
+
+		return( -1 );
+	}
+	destination_statistics->number_of_chunks_read        += source_statistics->number_of_chunks_read;
+	destination_statistics->number_of_bytes_read         += source_statistics->number_of_bytes_read;
+	destination_statistics->read_time                    += source_statistics->read_time;
+	destination_statistics->number_of_bytes_decompressed += source_statistics->number_of_bytes_decompressed;
+	destination_statistics->decompression_time           += source_statistics->decompression_time;
+	destination_statistics->number_of_chunks_written     += source_statistics->number_of_chunks_written;
+	destination_statistics->number_of_bytes_written      += source_statistics->number_of_bytes_written;
+	destination_statistics->write_time                   += source_statistics->write_time;
+	destination_statistics->number_of_bytes_compressed   += source_statistics->number_of_bytes_compressed;
+	destination_statistics->compression_time             += source_statistics->compression_time;
+
+	destination_statistics->number_of_chunks_compressed          += source_statistics->number_of_chunks_compressed;
+	destination_statistics->number_of_chunks_uncompressed        += source_statistics->number_of_chunks_uncompressed;
+	destination_statistics->number_of_chunks_compression_skipped += source_statistics->number_of_chunks_compression_skipped;
+
+	trace = source_statistics->trace;
+
+	if( memory_set(
+	     source_statistics,
+	     0,
+	     sizeof( libewf_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear source statistics.",
+		 function );
+
+		return( -1 );
+	}
+	source_statistics->trace = trace;
+
+	return( 1 );
+}
+
+/* Counts a packed chunk by how it is stored
+ */
+void libewf_statistics_count_packed_chunk(
+      libewf_statistics_t *statistics,
+      uint8_t is_compressed,
+      uint8_t is_compression_skipped )
+{
+	if( statistics == NULL )
+	{
+		return;
+	}
+	if( is_compressed != 0 )
+	{
+		statistics->number_of_chunks_compressed += 1;
+	}
+	else if( is_compression_skipped != 0 )
+	{
+		statistics->number_of_chunks_compression_skipped += 1;
+	}
+	else
+	{
+		statistics->number_of_chunks_uncompressed += 1;
+	}
+}
+
+/* Retrieves the current value of a monotonic clock in nanoseconds
+ * The value is only meaningful relative to another value of the same clock
+ * Returns the time or 0 if no clock is available
+ */
+uint64_t libewf_statistics_get_time(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) counter.QuadPart / (uint64_t) frequency.QuadPart ) * 1000000000UL
+	      + ( ( (uint64_t) counter.QuadPart % (uint64_t) frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+
+#elif defined( HAVE_SYS_TIME_H )
+	struct timeval time_value;
+
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + ( (uint64_t) time_value.tv_usec * 1000UL ) );
+
+#else
+	return( 0 );
+#endif
+}
+
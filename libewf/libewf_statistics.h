@@ -0,0 +1,124 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_STATISTICS_H )
+#define _LIBEWF_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_trace.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_statistics libewf_statistics_t;
+
+/* The times are in nanoseconds
+ */
+struct libewf_statistics
+{
+	/* The number of chunks read from the segment files
+	 */
+	uint64_t number_of_chunks_read;
+
+	/* The number of (stored) bytes read from the segment files
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The time spent reading chunks from the segment files
+	 */
+	uint64_t read_time;
+
+	/* The number of bytes produced by decompression
+	 */
+	uint64_t number_of_bytes_decompressed;
+
+	/* The time spent decompressing chunks
+	 */
+	uint64_t decompression_time;
+
+	/* The number of chunks written to the segment files
+	 */
+	uint64_t number_of_chunks_written;
+
+	/* The number of (stored) bytes written to the segment files
+	 */
+	uint64_t number_of_bytes_written;
+
+	/* The time spent writing chunks to the segment files
+	 */
+	uint64_t write_time;
+
+	/* The number of bytes passed to compression
+	 */
+	uint64_t number_of_bytes_compressed;
+
+	/* The time spent compressing chunks
+	 */
+	uint64_t compression_time;
+
+	/* The number of chunks stored compressed
+	 */
+	uint64_t number_of_chunks_compressed;
+
+	/* The number of chunks stored uncompressed
+	 */
+	uint64_t number_of_chunks_uncompressed;
+
+	/* The number of chunks stored uncompressed since they were estimated to be incompressible
+	 */
+	uint64_t number_of_chunks_compression_skipped;
+
+	/* The (optional) trace of the chunk I/O, which is not managed by the statistics
+	 */
+	libewf_trace_t *trace;
+};
+
+int libewf_statistics_initialize(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_free(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_merge(
+     libewf_statistics_t *destination_statistics,
+     libewf_statistics_t *source_statistics,
+     libcerror_error_t **error );
+
+void libewf_statistics_count_packed_chunk(
+      libewf_statistics_t *statistics,
+      uint8_t is_compressed,
+      uint8_t is_compression_skipped );
+
+uint64_t libewf_statistics_get_time(
+          void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
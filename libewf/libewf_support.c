@@ -29,7 +29,16 @@
 
 #include <stdio.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_DIRENT_H ) && !defined( WINAPI )
+#include <dirent.h>
+#endif
+
 #include "libewf_codepage.h"
+#include "libewf_compression.h"
 #include "libewf_definitions.h"
 #include "libewf_filename.h"
 #include "libewf_error.h"
@@ -164,6 +173,56 @@ int libewf_set_codepage(
 
 #endif /* !defined( HAVE_LOCAL_LIBEWF ) */
 
+/* Retrieves the compression backend
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_get_compression_backend(
+     int *compression_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_get_compression_backend";
+
+	if( libewf_compression_get_backend(
+	     compression_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression backend.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the compression backend
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_set_compression_backend(
+     int compression_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_set_compression_backend";
+
+	if( libewf_compression_set_backend(
+	     compression_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression backend.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Determines if a file is an EWF file (check for the EWF file signature)
  * Returns 1 if true, 0 if not or -1 on error
  */
@@ -516,6 +575,370 @@ int libewf_check_file_signature_file_io_handle(
 	return( 0 );
 }
 
+/* Compares two segment file extensions
+ * Returns -1 if the first is less than the second, 0 if equal or 1 if greater
+ */
+int libewf_glob_compare_extensions(
+     const void *first_extension,
+     const void *second_extension )
+{
+	uint32_t first_value  = *( (const uint32_t *) first_extension );
+	uint32_t second_value = *( (const uint32_t *) second_extension );
+
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the extensions of the files in the directory of the prefix
+ * that start with the basename of the prefix followed by 3 characters
+ * The directory is read once, which is considerably faster than testing
+ * every segment filename separately on network file systems
+ * The extensions are stored as 24-bit values and sorted so they can be searched
+ * Returns 1 if successful, 0 if the directory could not be listed or -1 on error
+ */
+int libewf_glob_get_directory_extensions(
+     const char *prefix,
+     size_t prefix_length,
+     uint32_t **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	WIN32_FIND_DATAA find_data;
+
+	HANDLE find_handle               = INVALID_HANDLE_VALUE;
+#elif defined( HAVE_DIRENT_H ) && defined( HAVE_OPENDIR ) && defined( HAVE_READDIR ) && defined( HAVE_CLOSEDIR )
+	struct dirent *directory_entry   = NULL;
+	DIR *directory                   = NULL;
+#endif
+#if defined( WINAPI ) || ( defined( HAVE_DIRENT_H ) && defined( HAVE_OPENDIR ) && defined( HAVE_READDIR ) && defined( HAVE_CLOSEDIR ) )
+	char *directory_name             = NULL;
+	const char *entry_name           = NULL;
+	void *reallocation               = NULL;
+	size_t basename_index            = 0;
+	size_t basename_length           = 0;
+	size_t directory_name_length     = 0;
+	int maximum_number_of_extensions = 0;
+#endif
+	static char *function            = "libewf_glob_get_directory_extensions";
+
+	if( prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( prefix_length == 0 )
+	 || ( prefix_length > (size_t) ( SSIZE_MAX - 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid prefix length.",
+		 function );
+
+		return( -1 );
+	}
+	if( extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extensions.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extensions != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extensions value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extensions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extensions = 0;
+
+#if defined( WINAPI ) || ( defined( HAVE_DIRENT_H ) && defined( HAVE_OPENDIR ) && defined( HAVE_READDIR ) && defined( HAVE_CLOSEDIR ) )
+	for( basename_index = prefix_length;
+	     basename_index > 0;
+	     basename_index-- )
+	{
+		if( prefix[ basename_index - 1 ] == (char) '/' )
+		{
+			break;
+		}
+#if defined( WINAPI )
+		if( ( prefix[ basename_index - 1 ] == (char) '\\' )
+		 || ( prefix[ basename_index - 1 ] == (char) ':' ) )
+		{
+			break;
+		}
+#endif
+	}
+	basename_length = prefix_length - basename_index;
+
+	if( basename_length == 0 )
+	{
+		return( 0 );
+	}
+#if defined( WINAPI )
+	/* Let the file system filter the entries on the prefix
+	 */
+	directory_name_length = prefix_length + 1;
+#else
+	directory_name_length = basename_index;
+
+	if( directory_name_length == 0 )
+	{
+		directory_name_length = 1;
+	}
+#endif
+	directory_name = (char *) memory_allocate(
+	                           sizeof( char ) * ( directory_name_length + 1 ) );
+
+	if( directory_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory name.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( WINAPI )
+	if( libcstring_narrow_string_copy(
+	     directory_name,
+	     prefix,
+	     prefix_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy directory name.",
+		 function );
+
+		goto on_error;
+	}
+	directory_name[ prefix_length ] = (char) '*';
+#else
+	if( basename_index == 0 )
+	{
+		directory_name[ 0 ] = (char) '.';
+	}
+	else if( libcstring_narrow_string_copy(
+	          directory_name,
+	          prefix,
+	          basename_index ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy directory name.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	directory_name[ directory_name_length ] = 0;
+
+	/* If the directory cannot be listed, e.g. due to missing read permissions,
+	 * the caller falls back to testing the individual segment filenames
+	 */
+#if defined( WINAPI )
+	find_handle = FindFirstFileA(
+	               (LPCSTR) directory_name,
+	               &find_data );
+
+	if( find_handle == INVALID_HANDLE_VALUE )
+	{
+		memory_free(
+		 directory_name );
+
+		return( 0 );
+	}
+	entry_name = (const char *) find_data.cFileName;
+#else
+	directory = opendir(
+	             directory_name );
+
+	if( directory == NULL )
+	{
+		memory_free(
+		 directory_name );
+
+		return( 0 );
+	}
+	directory_entry = readdir(
+	                   directory );
+
+	if( directory_entry != NULL )
+	{
+		entry_name = (const char *) directory_entry->d_name;
+	}
+#endif
+	memory_free(
+	 directory_name );
+
+	directory_name = NULL;
+
+	while( entry_name != NULL )
+	{
+		if( ( libcstring_narrow_string_length(
+		       entry_name ) == ( basename_length + 3 ) )
+		 && ( libcstring_narrow_string_compare(
+		       entry_name,
+		       &( prefix[ basename_index ] ),
+		       basename_length ) == 0 ) )
+		{
+			if( *number_of_extensions >= maximum_number_of_extensions )
+			{
+				if( maximum_number_of_extensions > (int) ( INT32_MAX / 2 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid number of extensions value exceeds maximum.",
+					 function );
+
+					goto on_error;
+				}
+				if( maximum_number_of_extensions == 0 )
+				{
+					maximum_number_of_extensions = 64;
+				}
+				else
+				{
+					maximum_number_of_extensions *= 2;
+				}
+				reallocation = memory_reallocate(
+				                *extensions,
+				                sizeof( uint32_t ) * maximum_number_of_extensions );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize extensions.",
+					 function );
+
+					goto on_error;
+				}
+				*extensions = (uint32_t *) reallocation;
+			}
+			( *extensions )[ *number_of_extensions ] = ( (uint32_t) ( (uint8_t) entry_name[ basename_length ] ) << 16 )
+			                                         | ( (uint32_t) ( (uint8_t) entry_name[ basename_length + 1 ] ) << 8 )
+			                                         | (uint32_t) ( (uint8_t) entry_name[ basename_length + 2 ] );
+
+			*number_of_extensions += 1;
+		}
+#if defined( WINAPI )
+		if( FindNextFileA(
+		     find_handle,
+		     &find_data ) == 0 )
+		{
+			entry_name = NULL;
+		}
+#else
+		directory_entry = readdir(
+		                   directory );
+
+		if( directory_entry == NULL )
+		{
+			entry_name = NULL;
+		}
+		else
+		{
+			entry_name = (const char *) directory_entry->d_name;
+		}
+#endif
+	}
+#if defined( WINAPI )
+	FindClose(
+	 find_handle );
+#else
+	closedir(
+	 directory );
+#endif
+	if( *number_of_extensions > 1 )
+	{
+		qsort(
+		 *extensions,
+		 (size_t) *number_of_extensions,
+		 sizeof( uint32_t ),
+		 &libewf_glob_compare_extensions );
+	}
+	return( 1 );
+
+on_error:
+#if defined( WINAPI )
+	if( find_handle != INVALID_HANDLE_VALUE )
+	{
+		FindClose(
+		 find_handle );
+	}
+#else
+	if( directory != NULL )
+	{
+		closedir(
+		 directory );
+	}
+#endif
+	if( *extensions != NULL )
+	{
+		memory_free(
+		 *extensions );
+
+		*extensions = NULL;
+	}
+	*number_of_extensions = 0;
+
+	if( directory_name != NULL )
+	{
+		memory_free(
+		 directory_name );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
+
 /* Globs the segment files according to the EWF naming schema
  * if format is known the filename should contain the base of the filename
  * otherwise the function will try to determine the format based on the extension
@@ -531,10 +954,13 @@ int libewf_glob(
 {
 	libbfio_handle_t *file_io_handle = NULL;
 	char *segment_filename           = NULL;
+	uint32_t *extensions             = NULL;
 	void *reallocation               = NULL;
 	static char *function            = "libewf_glob";
 	size_t additional_length         = 4;
 	size_t segment_filename_length   = 0;
+	uint32_t extension               = 0;
+	int number_of_extensions         = 0;
 	int result                       = 0;
 	uint8_t segment_file_type        = 0;
 	uint8_t ewf_format               = 0;
@@ -569,8 +995,10 @@ int libewf_glob(
 	 && ( format != LIBEWF_FORMAT_ENCASE4 )
 	 && ( format != LIBEWF_FORMAT_ENCASE5 )
 	 && ( format != LIBEWF_FORMAT_ENCASE6 )
+	 && ( format != LIBEWF_FORMAT_ENCASE7 )
 	 && ( format != LIBEWF_FORMAT_LINEN5 )
 	 && ( format != LIBEWF_FORMAT_LINEN6 )
+	 && ( format != LIBEWF_FORMAT_LINEN7 )
 	 && ( format != LIBEWF_FORMAT_SMART )
 	 && ( format != LIBEWF_FORMAT_FTK )
 	 && ( format != LIBEWF_FORMAT_LVF )
@@ -738,37 +1166,80 @@ int libewf_glob(
 		}
 		segment_filename[ segment_filename_length ] = 0;
 
-		if( libbfio_file_set_name(
-		     file_io_handle,
-		     segment_filename,
-		     segment_filename_length,
-		     error ) != 1 )
+		/* Read the directory once and only test the segment filenames
+		 * that are not in the directory listing
+		 */
+		if( *number_of_filenames == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set name in file IO handle.",
-			 function );
-
-			goto on_error;
+			if( libewf_glob_get_directory_extensions(
+			     segment_filename,
+			     segment_filename_length - 3,
+			     &extensions,
+			     &number_of_extensions,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory extensions.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		result = libbfio_handle_exists(
-		          file_io_handle,
-		          error );
+		result = 0;
 
-		if( result == -1 )
+		if( number_of_extensions > 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_GENERIC,
-			 "%s: unable to test if file exists.",
-			 function );
-
-			goto on_error;
+			extension = ( (uint32_t) ( (uint8_t) segment_filename[ segment_filename_length - 3 ] ) << 16 )
+			          | ( (uint32_t) ( (uint8_t) segment_filename[ segment_filename_length - 2 ] ) << 8 )
+			          | (uint32_t) ( (uint8_t) segment_filename[ segment_filename_length - 1 ] );
+
+			if( bsearch(
+			     &extension,
+			     extensions,
+			     (size_t) number_of_extensions,
+			     sizeof( uint32_t ),
+			     &libewf_glob_compare_extensions ) != NULL )
+			{
+				result = 1;
+			}
+		}
+		if( result == 0 )
+		{
+			if( libbfio_file_set_name(
+			     file_io_handle,
+			     segment_filename,
+			     segment_filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set name in file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			result = libbfio_handle_exists(
+			          file_io_handle,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to test if file exists.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		else if( result == 0 )
+		if( result == 0 )
 		{
 			memory_free(
 			 segment_filename );
@@ -809,9 +1280,19 @@ int libewf_glob(
 
 		goto on_error;
 	}
+	if( extensions != NULL )
+	{
+		memory_free(
+		 extensions );
+	}
 	return( 1 );
 
 on_error:
+	if( extensions != NULL )
+	{
+		memory_free(
+		 extensions );
+	}
 	if( segment_filename != NULL )
 	{
 		memory_free(
@@ -874,6 +1355,269 @@ int libewf_glob_free(
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
+/* Retrieves the extensions of the files in the directory of the wide prefix
+ * Only extensions consisting of ASCII characters are stored
+ * Returns 1 if successful, 0 if the directory could not be listed or -1 on error
+ */
+int libewf_glob_get_directory_extensions_wide(
+     const wchar_t *prefix,
+     size_t prefix_length,
+     uint32_t **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	WIN32_FIND_DATAW find_data;
+
+	HANDLE find_handle               = INVALID_HANDLE_VALUE;
+	wchar_t *directory_name             = NULL;
+	const wchar_t *entry_name           = NULL;
+	void *reallocation               = NULL;
+	size_t basename_index            = 0;
+	size_t basename_length           = 0;
+	size_t directory_name_length     = 0;
+	int maximum_number_of_extensions = 0;
+#endif
+	static char *function            = "libewf_glob_get_directory_extensions_wide";
+
+	if( prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( prefix_length == 0 )
+	 || ( prefix_length > (size_t) ( SSIZE_MAX - 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid prefix length.",
+		 function );
+
+		return( -1 );
+	}
+	if( extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extensions.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extensions != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extensions value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extensions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extensions = 0;
+
+#if defined( WINAPI )
+	for( basename_index = prefix_length;
+	     basename_index > 0;
+	     basename_index-- )
+	{
+		if( prefix[ basename_index - 1 ] == (wchar_t) '/' )
+		{
+			break;
+		}
+		if( ( prefix[ basename_index - 1 ] == (wchar_t) '\\' )
+		 || ( prefix[ basename_index - 1 ] == (wchar_t) ':' ) )
+		{
+			break;
+		}
+	}
+	basename_length = prefix_length - basename_index;
+
+	if( basename_length == 0 )
+	{
+		return( 0 );
+	}
+	/* Let the file system filter the entries on the prefix
+	 */
+	directory_name_length = prefix_length + 1;
+
+	directory_name = (wchar_t *) memory_allocate(
+	                           sizeof( wchar_t ) * ( directory_name_length + 1 ) );
+
+	if( directory_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_wide_string_copy(
+	     directory_name,
+	     prefix,
+	     prefix_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy directory name.",
+		 function );
+
+		goto on_error;
+	}
+	directory_name[ prefix_length ] = (wchar_t) '*';
+	directory_name[ directory_name_length ] = 0;
+
+	/* If the directory cannot be listed, e.g. due to missing read permissions,
+	 * the caller falls back to testing the individual segment filenames
+	 */
+	find_handle = FindFirstFileW(
+	               (LPCWSTR) directory_name,
+	               &find_data );
+
+	if( find_handle == INVALID_HANDLE_VALUE )
+	{
+		memory_free(
+		 directory_name );
+
+		return( 0 );
+	}
+	entry_name = (const wchar_t *) find_data.cFileName;
+
+	memory_free(
+	 directory_name );
+
+	directory_name = NULL;
+
+	while( entry_name != NULL )
+	{
+		if( ( libcstring_wide_string_length(
+		       entry_name ) == ( basename_length + 3 ) )
+		 && ( libcstring_wide_string_compare(
+		       entry_name,
+		       &( prefix[ basename_index ] ),
+		       basename_length ) == 0 )
+		 && ( entry_name[ basename_length ] < 0x80 )
+		 && ( entry_name[ basename_length + 1 ] < 0x80 )
+		 && ( entry_name[ basename_length + 2 ] < 0x80 ) )
+		{
+			if( *number_of_extensions >= maximum_number_of_extensions )
+			{
+				if( maximum_number_of_extensions > (int) ( INT32_MAX / 2 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid number of extensions value exceeds maximum.",
+					 function );
+
+					goto on_error;
+				}
+				if( maximum_number_of_extensions == 0 )
+				{
+					maximum_number_of_extensions = 64;
+				}
+				else
+				{
+					maximum_number_of_extensions *= 2;
+				}
+				reallocation = memory_reallocate(
+				                *extensions,
+				                sizeof( uint32_t ) * maximum_number_of_extensions );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize extensions.",
+					 function );
+
+					goto on_error;
+				}
+				*extensions = (uint32_t *) reallocation;
+			}
+			( *extensions )[ *number_of_extensions ] = ( (uint32_t) ( (uint8_t) entry_name[ basename_length ] ) << 16 )
+			                                         | ( (uint32_t) ( (uint8_t) entry_name[ basename_length + 1 ] ) << 8 )
+			                                         | (uint32_t) ( (uint8_t) entry_name[ basename_length + 2 ] );
+
+			*number_of_extensions += 1;
+		}
+		if( FindNextFileW(
+		     find_handle,
+		     &find_data ) == 0 )
+		{
+			entry_name = NULL;
+		}
+	}
+	FindClose(
+	 find_handle );
+
+	if( *number_of_extensions > 1 )
+	{
+		qsort(
+		 *extensions,
+		 (size_t) *number_of_extensions,
+		 sizeof( uint32_t ),
+		 &libewf_glob_compare_extensions );
+	}
+	return( 1 );
+
+on_error:
+	if( find_handle != INVALID_HANDLE_VALUE )
+	{
+		FindClose(
+		 find_handle );
+	}
+	if( *extensions != NULL )
+	{
+		memory_free(
+		 *extensions );
+
+		*extensions = NULL;
+	}
+	*number_of_extensions = 0;
+
+	if( directory_name != NULL )
+	{
+		memory_free(
+		 directory_name );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
+
+
 /* Globs the segment files according to the EWF naming schema
  * if format is known the filename should contain the base of the filename
  * otherwise the function will try to determine the format based on the extension
@@ -889,10 +1633,13 @@ int libewf_glob_wide(
 {
 	libbfio_handle_t *file_io_handle = NULL;
 	wchar_t *segment_filename        = NULL;
+	uint32_t *extensions             = NULL;
 	void *reallocation               = NULL;
 	static char *function            = "libewf_glob_wide";
 	size_t additional_length         = 4;
 	size_t segment_filename_length   = 0;
+	uint32_t extension               = 0;
+	int number_of_extensions         = 0;
 	int result                       = 0;
 	uint8_t segment_file_type        = 0;
 	uint8_t ewf_format               = 0;
@@ -927,8 +1674,10 @@ int libewf_glob_wide(
 	 && ( format != LIBEWF_FORMAT_ENCASE4 )
 	 && ( format != LIBEWF_FORMAT_ENCASE5 )
 	 && ( format != LIBEWF_FORMAT_ENCASE6 )
+	 && ( format != LIBEWF_FORMAT_ENCASE7 )
 	 && ( format != LIBEWF_FORMAT_LINEN5 )
 	 && ( format != LIBEWF_FORMAT_LINEN6 )
+	 && ( format != LIBEWF_FORMAT_LINEN7 )
 	 && ( format != LIBEWF_FORMAT_SMART )
 	 && ( format != LIBEWF_FORMAT_FTK )
 	 && ( format != LIBEWF_FORMAT_LVF )
@@ -1096,37 +1845,80 @@ int libewf_glob_wide(
 		}
 		segment_filename[ segment_filename_length ] = 0;
 
-		if( libbfio_file_set_name_wide(
-		     file_io_handle,
-		     segment_filename,
-		     segment_filename_length,
-		     error ) != 1 )
+		/* Read the directory once and only test the segment filenames
+		 * that are not in the directory listing
+		 */
+		if( *number_of_filenames == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set name in file IO handle.",
-			 function );
-
-			goto on_error;
+			if( libewf_glob_get_directory_extensions_wide(
+			     segment_filename,
+			     segment_filename_length - 3,
+			     &extensions,
+			     &number_of_extensions,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory extensions.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		result = libbfio_handle_exists(
-		          file_io_handle,
-		          error );
+		result = 0;
 
-		if( result == -1 )
+		if( number_of_extensions > 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_GENERIC,
-			 "%s: unable to test if file exists.",
-			 function );
-
-			goto on_error;
+			extension = ( (uint32_t) ( (uint8_t) segment_filename[ segment_filename_length - 3 ] ) << 16 )
+			          | ( (uint32_t) ( (uint8_t) segment_filename[ segment_filename_length - 2 ] ) << 8 )
+			          | (uint32_t) ( (uint8_t) segment_filename[ segment_filename_length - 1 ] );
+
+			if( bsearch(
+			     &extension,
+			     extensions,
+			     (size_t) number_of_extensions,
+			     sizeof( uint32_t ),
+			     &libewf_glob_compare_extensions ) != NULL )
+			{
+				result = 1;
+			}
 		}
-		else if( result == 0 )
+		if( result == 0 )
+		{
+			if( libbfio_file_set_name_wide(
+			     file_io_handle,
+			     segment_filename,
+			     segment_filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set name in file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			result = libbfio_handle_exists(
+			          file_io_handle,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to test if file exists.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( result == 0 )
 		{
 			memory_free(
 			 segment_filename );
@@ -1167,9 +1959,19 @@ int libewf_glob_wide(
 
 		goto on_error;
 	}
+	if( extensions != NULL )
+	{
+		memory_free(
+		 extensions );
+	}
 	return( 1 );
 
 on_error:
+	if( extensions != NULL )
+	{
+		memory_free(
+		 extensions );
+	}
 	if( segment_filename != NULL )
 	{
 		memory_free(
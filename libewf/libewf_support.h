@@ -68,6 +68,16 @@ int libewf_set_codepage(
 
 #endif /* !defined( HAVE_LOCAL_LIBEWF ) */
 
+LIBEWF_EXTERN \
+int libewf_get_compression_backend(
+     int *compression_backend,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_set_compression_backend(
+     int compression_backend,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_check_file_signature(
      const char *filename,
@@ -85,6 +95,17 @@ int libewf_check_file_signature_file_io_handle(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libewf_glob_compare_extensions(
+     const void *first_extension,
+     const void *second_extension );
+
+int libewf_glob_get_directory_extensions(
+     const char *prefix,
+     size_t prefix_length,
+     uint32_t **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_glob(
      const char *filename,
@@ -101,6 +122,13 @@ int libewf_glob_free(
      libcerror_error_t **error );
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
+int libewf_glob_get_directory_extensions_wide(
+     const wchar_t *prefix,
+     size_t prefix_length,
+     uint32_t **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_glob_wide(
      const wchar_t *filename,
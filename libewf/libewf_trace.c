@@ -0,0 +1,493 @@
+/*
+ * Trace functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_trace.h"
+
+/* Creates a trace
+ * Make sure the value trace is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_trace_initialize(
+     libewf_trace_t **trace,
+     int maximum_number_of_events,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_trace_initialize";
+	size_t events_size    = 0;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid trace value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_events <= 0 )
+	 || ( (size_t) maximum_number_of_events > (size_t) ( SSIZE_MAX / sizeof( libewf_trace_event_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of events value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*trace = memory_allocate_structure(
+	          libewf_trace_t );
+
+	if( *trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create trace.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *trace,
+	     0,
+	     sizeof( libewf_trace_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear trace.",
+		 function );
+
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+
+		return( -1 );
+	}
+	events_size = sizeof( libewf_trace_event_t ) * (size_t) maximum_number_of_events;
+
+	( *trace )->events = (libewf_trace_event_t *) memory_allocate(
+	                                               events_size );
+
+	if( ( *trace )->events == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create events.",
+		 function );
+
+		goto on_error;
+	}
+	( *trace )->maximum_number_of_events = maximum_number_of_events;
+
+	return( 1 );
+
+on_error:
+	if( *trace != NULL )
+	{
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a trace
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_trace_free(
+     libewf_trace_t **trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_trace_free";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace != NULL )
+	{
+		memory_free(
+		 ( *trace )->events );
+
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+	}
+	return( 1 );
+}
+
+/* Empties a trace
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_trace_empty(
+     libewf_trace_t *trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_trace_empty";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	trace->first_event_index = 0;
+	trace->number_of_events  = 0;
+
+	return( 1 );
+}
+
+/* Appends an event to the trace
+ * The oldest event is overwritten if the trace is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_trace_append_event(
+     libewf_trace_t *trace,
+     uint8_t stage,
+     uint64_t chunk_index,
+     int file_io_pool_entry,
+     uint64_t start_time,
+     uint64_t end_time,
+     libcerror_error_t **error )
+{
+	libewf_trace_event_t *event = NULL;
+	static char *function       = "libewf_trace_append_event";
+	int event_index             = 0;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace->events == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid trace - missing events.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace->number_of_events < trace->maximum_number_of_events )
+	{
+		event_index = trace->first_event_index + trace->number_of_events;
+
+		trace->number_of_events += 1;
+	}
+	else
+	{
+		event_index = trace->first_event_index;
+
+		trace->first_event_index += 1;
+	}
+	if( event_index >= trace->maximum_number_of_events )
+	{
+		event_index -= trace->maximum_number_of_events;
+	}
+	if( trace->first_event_index >= trace->maximum_number_of_events )
+	{
+		trace->first_event_index = 0;
+	}
+	event = &( trace->events[ event_index ] );
+
+	event->start_time         = start_time;
+	event->chunk_index        = chunk_index;
+	event->file_io_pool_entry = file_io_pool_entry;
+	event->stage              = stage;
+
+	if( end_time > start_time )
+	{
+		event->duration = end_time - start_time;
+	}
+	else
+	{
+		event->duration = 0;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of events
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_trace_get_number_of_events(
+     libewf_trace_t *trace,
+     int *number_of_events,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_trace_get_number_of_events";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_events == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of events.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_events = trace->number_of_events;
+
+	return( 1 );
+}
+
+/* Retrieves a specific event
+ * The events are ordered from oldest to newest
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_trace_get_event(
+     libewf_trace_t *trace,
+     int event_index,
+     uint8_t *stage,
+     uint64_t *chunk_index,
+     int *file_io_pool_entry,
+     uint64_t *start_time,
+     uint64_t *duration,
+     libcerror_error_t **error )
+{
+	libewf_trace_event_t *event = NULL;
+	static char *function       = "libewf_trace_get_event";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( event_index < 0 )
+	 || ( event_index >= trace->number_of_events ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid event index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid start time.",
+		 function );
+
+		return( -1 );
+	}
+	if( duration == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid duration.",
+		 function );
+
+		return( -1 );
+	}
+	event_index += trace->first_event_index;
+
+	if( event_index >= trace->maximum_number_of_events )
+	{
+		event_index -= trace->maximum_number_of_events;
+	}
+	event = &( trace->events[ event_index ] );
+
+	*stage              = event->stage;
+	*chunk_index        = event->chunk_index;
+	*file_io_pool_entry = event->file_io_pool_entry;
+	*start_time         = event->start_time;
+	*duration           = event->duration;
+
+	return( 1 );
+}
+
+/* Determines the stage of a seek in the file IO pool
+ * The stage is open if the file IO handle of the entry is closed and will be (re)opened by the seek
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_trace_get_seek_stage(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint8_t *stage,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_trace_get_seek_stage";
+	int result                       = 0;
+
+	if( stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle: %d is open.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*stage = LIBEWF_TRACE_STAGE_OPEN;
+	}
+	else
+	{
+		*stage = LIBEWF_TRACE_STAGE_SEEK;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,131 @@
+/*
+ * Trace functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_TRACE_H )
+#define _LIBEWF_TRACE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_trace_event libewf_trace_event_t;
+
+struct libewf_trace_event
+{
+	/* The start time in nanoseconds
+	 */
+	uint64_t start_time;
+
+	/* The duration in nanoseconds
+	 */
+	uint64_t duration;
+
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The file IO pool entry of the segment file
+	 */
+	int file_io_pool_entry;
+
+	/* The stage
+	 */
+	uint8_t stage;
+};
+
+typedef struct libewf_trace libewf_trace_t;
+
+/* The trace is a ring buffer that overwrites the oldest events when full
+ */
+struct libewf_trace
+{
+	/* The events
+	 */
+	libewf_trace_event_t *events;
+
+	/* The maximum number of events
+	 */
+	int maximum_number_of_events;
+
+	/* The index of the oldest event
+	 */
+	int first_event_index;
+
+	/* The number of events
+	 */
+	int number_of_events;
+};
+
+int libewf_trace_initialize(
+     libewf_trace_t **trace,
+     int maximum_number_of_events,
+     libcerror_error_t **error );
+
+int libewf_trace_free(
+     libewf_trace_t **trace,
+     libcerror_error_t **error );
+
+int libewf_trace_empty(
+     libewf_trace_t *trace,
+     libcerror_error_t **error );
+
+int libewf_trace_append_event(
+     libewf_trace_t *trace,
+     uint8_t stage,
+     uint64_t chunk_index,
+     int file_io_pool_entry,
+     uint64_t start_time,
+     uint64_t end_time,
+     libcerror_error_t **error );
+
+int libewf_trace_get_number_of_events(
+     libewf_trace_t *trace,
+     int *number_of_events,
+     libcerror_error_t **error );
+
+int libewf_trace_get_event(
+     libewf_trace_t *trace,
+     int event_index,
+     uint8_t *stage,
+     uint64_t *chunk_index,
+     int *file_io_pool_entry,
+     uint64_t *start_time,
+     uint64_t *duration,
+     libcerror_error_t **error );
+
+int libewf_trace_get_seek_stage(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint8_t *stage,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
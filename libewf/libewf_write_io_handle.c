@@ -52,8 +52,11 @@
 #include "libewf_section.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
+#include "libewf_trace.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_journal.h"
 
 #include "ewf_checksum.h"
 #include "ewf_data.h"
@@ -151,6 +154,7 @@ int libewf_write_io_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_write_io_handle_free";
+	int result            = 1;
 
 	if( write_io_handle == NULL )
 	{
@@ -165,6 +169,42 @@ int libewf_write_io_handle_free(
 	}
 	if( *write_io_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The compression pool references the compressed zero byte empty block
+		 */
+		if( ( *write_io_handle )->compression_pool != NULL )
+		{
+			if( libewf_compression_pool_free(
+			     &( ( *write_io_handle )->compression_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *write_io_handle )->write_journal != NULL )
+		{
+			if( libewf_write_journal_free(
+			     &( ( *write_io_handle )->write_journal ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free write journal.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( *write_io_handle )->data_section != NULL )
 		{
 			memory_free(
@@ -185,7 +225,7 @@ int libewf_write_io_handle_free(
 
 		*write_io_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones the write IO handle
@@ -259,6 +299,15 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_offsets           = NULL;
 	( *destination_write_io_handle )->number_of_table_offsets = 0;
 
+	/* The statistics and write journal belong to the source handle and are not shared
+	 */
+	( *destination_write_io_handle )->statistics    = NULL;
+	( *destination_write_io_handle )->write_journal = NULL;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *destination_write_io_handle )->compression_pool = NULL;
+#endif
+
 	if( source_write_io_handle->data_section != NULL )
 	{
 		( *destination_write_io_handle )->data_section = memory_allocate_structure(
@@ -518,11 +567,13 @@ int libewf_write_io_handle_initialize_resume(
 	libewf_segment_file_t *segment_file                    = NULL;
 	static char *function                                  = "libewf_write_io_handle_initialize_resume";
 	uint8_t backtrace_to_last_chunks_sections              = 0;
+	uint8_t is_checkpoint                                  = 0;
 	uint8_t reopen_segment_file                            = 0;
 	int file_io_pool_entry                                 = 0;
 	int number_of_chunks                                   = 0;
 	int number_of_segment_files                            = 0;
 	int number_of_unusable_chunks                          = 0;
+	int result                                             = 0;
 	int segment_files_list_index                           = 0;
 	int supported_section                                  = 0;
 
@@ -559,6 +610,28 @@ int libewf_write_io_handle_initialize_resume(
 
 		return( -1 );
 	}
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
 	if( libmfdata_file_list_get_number_of_files(
 	     segment_files_list,
 	     &number_of_segment_files,
@@ -801,7 +874,67 @@ int libewf_write_io_handle_initialize_resume(
 			return( -1 );
 		}
 	}
-	if( section->type_length == 4 )
+	/* A chunks section that was checkpointed in the write journal
+	 * was flushed to the storage device and does not need to be rewritten
+	 */
+	if( segment_table->basename != NULL )
+	{
+		if( write_io_handle->write_journal == NULL )
+		{
+			if( libewf_write_journal_initialize(
+			     &( write_io_handle->write_journal ),
+			     segment_table->basename,
+			     segment_table->basename_size - 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create write journal.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		result = libewf_write_journal_read(
+		          write_io_handle->write_journal,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read write journal.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( ( write_io_handle->write_journal->segment_number == (uint32_t) ( segment_files_list_index + 1 ) )
+			 && ( write_io_handle->write_journal->segment_file_offset == section->end_offset )
+			 && ( write_io_handle->write_journal->number_of_chunks == (uint64_t) chunk_table->last_chunk_filled )
+			 && ( write_io_handle->write_journal->number_of_chunks_in_segment == segment_file->number_of_chunks ) )
+			{
+				is_checkpoint = 1;
+			}
+		}
+	}
+	if( is_checkpoint != 0 )
+	{
+		/* The sections containing the chunks and offsets were written entirely
+		 */
+		chunk_table->last_chunk_compared = chunk_table->last_chunk_filled;
+
+		supported_section                           = 1;
+		reopen_segment_file                         = 1;
+		write_io_handle->resume_segment_file_offset = section->end_offset;
+		write_io_handle->create_chunks_section      = 1;
+	}
+	else if( section->type_length == 4 )
 	{
 		if( memory_compare(
 		     (void *) section->type,
@@ -1204,6 +1337,11 @@ int libewf_write_io_handle_initialize_resume(
 		write_io_handle->number_of_chunks_written_to_segment = segment_file->number_of_chunks
 		                                                     - number_of_unusable_chunks;
 
+		/* The number of chunks per segment file is recalculated
+		 * since more chunks sections can be added to the segment file
+		 */
+		segment_file->number_of_chunks = 0;
+
 		if( libmfdata_file_list_get_file_by_index(
 		     segment_files_list,
 		     segment_files_list_index,
@@ -1988,8 +2126,10 @@ int libewf_write_io_handle_create_segment_file(
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle        = NULL;
+	libcstring_system_character_t *basename = NULL;
 	libcstring_system_character_t *filename = NULL;
 	static char *function                   = "libewf_write_io_handle_create_segment_file";
+	size_t basename_size                    = 0;
 	size_t filename_size                    = 0;
 	int bfio_access_flags                   = 0;
 
@@ -2059,11 +2199,28 @@ int libewf_write_io_handle_create_segment_file(
 
 		return( -1 );
 	}
+	if( libewf_segment_table_get_segment_file_basename(
+	     segment_table,
+	     segment_number,
+	     &basename,
+	     &basename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu16 " basename.",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
 	if( libewf_filename_create(
 	     &filename,
 	     &filename_size,
-	     segment_table->basename,
-	     segment_table->basename_size - 1,
+	     basename,
+	     basename_size - 1,
 	     segment_number,
 	     maximum_number_of_segments,
 	     segment_file_type,
@@ -2263,6 +2420,245 @@ on_error:
 
 }
 
+/* Preallocates the storage space of a newly created segment file
+ * Preallocation is an optimization, a segment file that cannot be preallocated
+ * is written without it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_preallocate_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_preallocate_segment_file";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( write_io_handle->segment_file_write_flags & LIBEWF_SEGMENT_FILE_WRITE_FLAG_PREALLOCATE ) == 0 )
+	{
+		return( 1 );
+	}
+	if( libbfio_pool_allocate(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to preallocate file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+	}
+	return( 1 );
+}
+
+/* Finishes a segment file that was closed
+ * Releases the preallocated storage space beyond the end of the segment file
+ * and starts writing back the segment file, while the next segment file is being written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_finish_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_finish_segment_file";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( write_io_handle->segment_file_write_flags & LIBEWF_SEGMENT_FILE_WRITE_FLAG_PREALLOCATE ) != 0 )
+	{
+		if( libbfio_pool_truncate(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     segment_file_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to truncate file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	if( ( write_io_handle->segment_file_write_flags & LIBEWF_SEGMENT_FILE_WRITE_FLAG_FLUSH_ON_CLOSE ) != 0 )
+	{
+		if( libbfio_pool_flush(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to flush file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a checkpoint of the last complete chunks section to the write journal
+ * The segment file is flushed to the storage device before the checkpoint is written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_write_checkpoint(
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     off64_t segment_file_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_write_checkpoint";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->write_journal == NULL )
+	{
+		if( segment_table->basename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid segment table - missing basename.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_write_journal_initialize(
+		     &( write_io_handle->write_journal ),
+		     segment_table->basename,
+		     segment_table->basename_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write journal.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The chunks section must be on the storage device before the checkpoint refers to it
+	 */
+	if( libbfio_pool_sync(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to sync segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( libewf_write_journal_write_checkpoint(
+	     write_io_handle->write_journal,
+	     segment_number,
+	     write_io_handle->number_of_chunks_written_to_segment,
+	     segment_file_offset,
+	     (uint64_t) write_io_handle->number_of_chunks_written,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write checkpoint to write journal.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: checkpoint of segment: %" PRIu32 " at offset: %" PRIi64 " after chunk: %" PRIu32 ".\n",
+		 function,
+		 segment_number,
+		 segment_file_offset,
+		 write_io_handle->number_of_chunks_written );
+	}
+#endif
+	return( 1 );
+}
+
 /* Writes a new chunk of data in EWF format at the current offset
  * The necessary settings of the write values must have been made
  * Returns the number of bytes written, 0 when no longer bytes can be written or -1 on error
@@ -2299,6 +2695,8 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	off64_t segment_file_offset         = 0;
 	ssize_t total_write_count           = 0;
 	ssize_t write_count                 = 0;
+	uint64_t end_time                   = 0;
+	uint64_t start_time                 = 0;
 	int chunk_exists                    = 0;
 	int file_io_pool_entry              = -1;
 	int insufficient_output_space       = 0;
@@ -2602,6 +3000,23 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 
 			return( -1 );
 		}
+		if( libewf_write_io_handle_preallocate_segment_file(
+		     write_io_handle,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     segment_table->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to preallocate segment file: %d.",
+			 function,
+			 segment_files_list_index + 1 );
+
+			return( -1 );
+		}
 		/* Reserve space for the done or next section
 		 */
 		write_io_handle->remaining_segment_file_size = segment_table->maximum_segment_size
@@ -2909,6 +3324,10 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		 segment_files_list_index + 1 );
 	}
 #endif
+	if( write_io_handle->statistics != NULL )
+	{
+		start_time = libewf_statistics_get_time();
+	}
 	write_count = libewf_segment_file_write_chunk(
 		       segment_file,
 		       io_handle,
@@ -2958,6 +3377,37 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		write_io_handle->number_of_chunks_written_to_section += 1;
 		write_io_handle->number_of_chunks_written            += 1;
 
+		if( write_io_handle->statistics != NULL )
+		{
+			end_time = libewf_statistics_get_time();
+
+			write_io_handle->statistics->number_of_chunks_written += 1;
+			write_io_handle->statistics->number_of_bytes_written  += (uint64_t) write_count;
+			write_io_handle->statistics->write_time               += end_time - start_time;
+
+			if( write_io_handle->statistics->trace != NULL )
+			{
+				if( libewf_trace_append_event(
+				     write_io_handle->statistics->trace,
+				     LIBEWF_TRACE_STAGE_WRITE,
+				     (uint64_t) chunk_index,
+				     file_io_pool_entry,
+				     start_time,
+				     end_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append write event to trace.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+
 		if( ( io_handle->ewf_format == EWF_FORMAT_S01 )
 		 || ( io_handle->format == LIBEWF_FORMAT_ENCASE1 ) )
 		{
@@ -3014,6 +3464,14 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 
 			return( -1 );
 		}
+		/* Close the current section early if a checkpoint is due
+		 */
+		if( ( result == 0 )
+		 && ( write_io_handle->checkpoint_interval != 0 )
+		 && ( write_io_handle->number_of_chunks_written_to_section >= write_io_handle->checkpoint_interval ) )
+		{
+			result = 1;
+		}
 	}
 	else
 	{
@@ -3102,6 +3560,27 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		write_io_handle->create_chunks_section = 1;
 		write_io_handle->chunks_section_offset = 0;
 
+		if( write_io_handle->checkpoint_interval != 0 )
+		{
+			if( libewf_write_io_handle_write_checkpoint(
+			     write_io_handle,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     segment_table,
+			     (uint32_t) ( segment_files_list_index + 1 ),
+			     segment_file_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write checkpoint.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( insufficient_output_space == 0 )
 		{
 			/* Check if the current segment file is full, if so close the current segment file
@@ -3182,6 +3661,24 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 				}
 				segment_file_offset += write_count;
 				total_write_count   += write_count;
+
+				if( libewf_write_io_handle_finish_segment_file(
+				     write_io_handle,
+				     file_io_pool,
+				     file_io_pool_entry,
+				     (size64_t) segment_file_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_GENERIC,
+					 "%s: unable to finish segment file: %d.",
+					 function,
+					 segment_files_list_index + 1 );
+
+					return( -1 );
+				}
 			}
 		}
 	}
@@ -3226,6 +3723,7 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
 	size64_t required_segment_file_size        = 0;
 	ssize_t total_write_count                  = 0;
 	ssize_t write_count                        = 0;
+	uint64_t start_time                        = 0;
 	uint32_t existing_chunk_flags              = 0;
 	uint8_t no_section_append                  = 0;
 	int file_io_pool_entry                     = -1;
@@ -3699,6 +4197,10 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
 		 segment_file_offset );
 	}
 #endif
+	if( write_io_handle->statistics != NULL )
+	{
+		start_time = libewf_statistics_get_time();
+	}
 	write_count = libewf_segment_file_write_delta_chunk(
 		       segment_file,
 		       file_io_pool,
@@ -3725,6 +4227,12 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
 
 		return( -1 );
 	}
+	if( write_io_handle->statistics != NULL )
+	{
+		write_io_handle->statistics->number_of_chunks_written += 1;
+		write_io_handle->statistics->number_of_bytes_written  += (uint64_t) write_count;
+		write_io_handle->statistics->write_time               += libewf_statistics_get_time() - start_time;
+	}
 	segment_file_offset += write_count;
 	total_write_count   += write_count;
 
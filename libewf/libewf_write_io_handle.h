@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libewf_chunk_table.h"
+#include "libewf_compression_pool.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -37,6 +38,8 @@
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
+#include "libewf_write_journal.h"
 
 #include "ewf_data.h"
 #include "ewf_table.h"
@@ -137,6 +140,29 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The statistics, which are not managed by the write IO handle
+	 */
+	libewf_statistics_t *statistics;
+
+	/* The maximum number of chunks written between checkpoints
+	 * a value of 0 disables the write journal
+	 */
+	uint32_t checkpoint_interval;
+
+	/* The write journal
+	 */
+	libewf_write_journal_t *write_journal;
+
+	/* The segment file write flags
+	 */
+	uint8_t segment_file_write_flags;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The compression pool used to pack chunks concurrently
+	 */
+	libewf_compression_pool_t *compression_pool;
+#endif
 };
 
 int libewf_write_io_handle_initialize(
@@ -237,6 +263,29 @@ int libewf_write_io_handle_create_segment_file(
      int *file_io_pool_entry,
      libcerror_error_t **error );
 
+int libewf_write_io_handle_preallocate_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_finish_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_write_checkpoint(
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     off64_t segment_file_offset,
+     libcerror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_new_chunk(
          libewf_write_io_handle_t *write_io_handle,
          libewf_io_handle_t *io_handle,
@@ -0,0 +1,767 @@
+/*
+ * Write journal functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcfile.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcstring.h"
+#include "libewf_write_journal.h"
+
+#include "ewf_checksum.h"
+#include "ewfx_write_journal.h"
+
+const uint8_t ewfx_write_journal_signature[ 8 ] = { 0x45, 0x57, 0x46, 0x4a, 0x52, 0x4e, 0x4c, 0x00 };
+
+/* Creates a write journal
+ * The journal filename is the basename with the extension .journal
+ * Make sure the value write_journal is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_journal_initialize(
+     libewf_write_journal_t **write_journal,
+     const libcstring_system_character_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_journal_initialize";
+
+	if( write_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_journal != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write journal value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( basename_length == 0 )
+	 || ( basename_length > (size_t) ( SSIZE_MAX - 9 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid basename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*write_journal = memory_allocate_structure(
+	                  libewf_write_journal_t );
+
+	if( *write_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write journal.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_journal,
+	     0,
+	     sizeof( libewf_write_journal_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write journal.",
+		 function );
+
+		memory_free(
+		 *write_journal );
+
+		*write_journal = NULL;
+
+		return( -1 );
+	}
+	/* The filename also contains the extension .journal and an end of string character
+	 */
+	( *write_journal )->filename_size = basename_length + 9;
+
+	( *write_journal )->filename = libcstring_system_string_allocate(
+	                                ( *write_journal )->filename_size );
+
+	if( ( *write_journal )->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     ( *write_journal )->filename,
+	     basename,
+	     basename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     &( ( ( *write_journal )->filename )[ basename_length ] ),
+	     _LIBCSTRING_SYSTEM_STRING( ".journal" ),
+	     9 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set extension.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *write_journal != NULL )
+	{
+		if( ( *write_journal )->filename != NULL )
+		{
+			memory_free(
+			 ( *write_journal )->filename );
+		}
+		memory_free(
+		 *write_journal );
+
+		*write_journal = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write journal
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_journal_free(
+     libewf_write_journal_t **write_journal,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_journal_free";
+	int result            = 1;
+
+	if( write_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_journal != NULL )
+	{
+		if( ( *write_journal )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_close(
+			     ( *write_journal )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *write_journal )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *write_journal )->filename );
+
+		memory_free(
+		 *write_journal );
+
+		*write_journal = NULL;
+	}
+	return( result );
+}
+
+/* Creates a file IO handle of the write journal file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_journal_create_file_io_handle(
+     libewf_write_journal_t *write_journal,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_journal_create_file_io_handle";
+
+	if( write_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     *file_io_handle,
+	     write_journal->filename,
+	     write_journal->filename_size - 1,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     *file_io_handle,
+	     write_journal->filename,
+	     write_journal->filename_size - 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the checkpoint from the write journal file
+ * Returns 1 if successful, 0 if no valid checkpoint is available or -1 on error
+ */
+int libewf_write_journal_read(
+     libewf_write_journal_t *write_journal,
+     libcerror_error_t **error )
+{
+	ewfx_write_journal_record_t record;
+
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_write_journal_read";
+	ssize_t read_count               = 0;
+	uint64_t value_64bit             = 0;
+	uint32_t calculated_checksum     = 0;
+	uint32_t stored_checksum         = 0;
+	int result                       = 0;
+
+	if( write_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_journal->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write journal - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_write_journal_create_file_io_handle(
+	     write_journal,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if write journal file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open write journal file.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              (uint8_t *) &record,
+		              sizeof( ewfx_write_journal_record_t ),
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read write journal record.",
+			 function );
+
+			libbfio_handle_close(
+			 file_io_handle,
+			 NULL );
+
+			goto on_error;
+		}
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close write journal file.",
+			 function );
+
+			goto on_error;
+		}
+		/* A record that was only partially written is ignored
+		 */
+		result = 0;
+
+		if( ( read_count == (ssize_t) sizeof( ewfx_write_journal_record_t ) )
+		 && ( memory_compare(
+		       record.signature,
+		       ewfx_write_journal_signature,
+		       8 ) == 0 ) )
+		{
+			calculated_checksum = ewf_checksum_calculate(
+			                       &record,
+			                       sizeof( ewfx_write_journal_record_t ) - sizeof( uint32_t ),
+			                       1 );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 record.checksum,
+			 stored_checksum );
+
+			if( stored_checksum == calculated_checksum )
+			{
+				result = 1;
+			}
+		}
+		if( result != 0 )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 record.segment_number,
+			 write_journal->segment_number );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 record.number_of_chunks_in_segment,
+			 write_journal->number_of_chunks_in_segment );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 record.segment_file_offset,
+			 value_64bit );
+
+			write_journal->segment_file_offset = (off64_t) value_64bit;
+
+			byte_stream_copy_to_uint64_little_endian(
+			 record.number_of_chunks,
+			 write_journal->number_of_chunks );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( result != 0 )
+			{
+				libcnotify_printf(
+				 "%s: checkpoint of segment: %" PRIu32 " at offset: %" PRIi64 " after chunk: %" PRIu64 ".\n",
+				 function,
+				 write_journal->segment_number,
+				 write_journal->segment_file_offset,
+				 write_journal->number_of_chunks );
+			}
+			else
+			{
+				libcnotify_printf(
+				 "%s: invalid write journal record.\n",
+				 function );
+			}
+		}
+#endif
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a checkpoint to the write journal file
+ * The segment file must have been flushed to the storage device before the checkpoint is written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_journal_write_checkpoint(
+     libewf_write_journal_t *write_journal,
+     uint32_t segment_number,
+     uint32_t number_of_chunks_in_segment,
+     off64_t segment_file_offset,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error )
+{
+	ewfx_write_journal_record_t record;
+
+	static char *function        = "libewf_write_journal_write_checkpoint";
+	ssize_t write_count          = 0;
+	uint32_t calculated_checksum = 0;
+
+	if( write_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid segment file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_journal->file_io_handle == NULL )
+	{
+		if( libewf_write_journal_create_file_io_handle(
+		     write_journal,
+		     &( write_journal->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_handle_open(
+		     write_journal->file_io_handle,
+		     LIBBFIO_OPEN_WRITE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open write journal file.",
+			 function );
+
+			libbfio_handle_free(
+			 &( write_journal->file_io_handle ),
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( memory_copy(
+	     record.signature,
+	     ewfx_write_journal_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 record.segment_number,
+	 segment_number );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 record.number_of_chunks_in_segment,
+	 number_of_chunks_in_segment );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 record.segment_file_offset,
+	 (uint64_t) segment_file_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 record.number_of_chunks,
+	 number_of_chunks );
+
+	calculated_checksum = ewf_checksum_calculate(
+	                       &record,
+	                       sizeof( ewfx_write_journal_record_t ) - sizeof( uint32_t ),
+	                       1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 record.checksum,
+	 calculated_checksum );
+
+	if( libbfio_handle_seek_offset(
+	     write_journal->file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek start of write journal file.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               write_journal->file_io_handle,
+	               (uint8_t *) &record,
+	               sizeof( ewfx_write_journal_record_t ),
+	               error );
+
+	if( write_count != (ssize_t) sizeof( ewfx_write_journal_record_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write write journal record.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_sync(
+	     write_journal->file_io_handle,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to sync write journal file.",
+		 function );
+
+		return( -1 );
+	}
+	write_journal->segment_number              = segment_number;
+	write_journal->number_of_chunks_in_segment = number_of_chunks_in_segment;
+	write_journal->segment_file_offset         = segment_file_offset;
+	write_journal->number_of_chunks            = number_of_chunks;
+
+	return( 1 );
+}
+
+/* Closes and removes the write journal file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_journal_remove(
+     libewf_write_journal_t *write_journal,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_journal_remove";
+
+	if( write_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_journal->file_io_handle != NULL )
+	{
+		if( libbfio_handle_close(
+		     write_journal->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close write journal file.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_handle_free(
+		     &( write_journal->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_remove_wide(
+	     write_journal->filename,
+	     error ) == -1 )
+#else
+	if( libcfile_file_remove(
+	     write_journal->filename,
+	     error ) == -1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 "%s: unable to remove write journal file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
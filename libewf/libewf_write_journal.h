@@ -0,0 +1,108 @@
+/*
+ * Write journal functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_WRITE_JOURNAL_H )
+#define _LIBEWF_WRITE_JOURNAL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcstring.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_write_journal libewf_write_journal_t;
+
+/* The write journal records the last chunks section that was flushed
+ * to the storage device, so an interrupted write can be resumed from it
+ */
+struct libewf_write_journal
+{
+	/* The filename
+	 */
+	libcstring_system_character_t *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The file IO handle, which is opened on the first checkpoint
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The segment number of the checkpoint
+	 */
+	uint32_t segment_number;
+
+	/* The number of chunks written to the segment file of the checkpoint
+	 */
+	uint32_t number_of_chunks_in_segment;
+
+	/* The segment file offset directly after the last complete chunks section of the checkpoint
+	 */
+	off64_t segment_file_offset;
+
+	/* The number of chunks written of the checkpoint
+	 */
+	uint64_t number_of_chunks;
+};
+
+int libewf_write_journal_initialize(
+     libewf_write_journal_t **write_journal,
+     const libcstring_system_character_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
+int libewf_write_journal_free(
+     libewf_write_journal_t **write_journal,
+     libcerror_error_t **error );
+
+int libewf_write_journal_create_file_io_handle(
+     libewf_write_journal_t *write_journal,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_write_journal_read(
+     libewf_write_journal_t *write_journal,
+     libcerror_error_t **error );
+
+int libewf_write_journal_write_checkpoint(
+     libewf_write_journal_t *write_journal,
+     uint32_t segment_number,
+     uint32_t number_of_chunks_in_segment,
+     off64_t segment_file_offset,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_write_journal_remove(
+     libewf_write_journal_t *write_journal,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -1092,6 +1092,14 @@ int libmfdata_file_list_get_file_value(
 		{
 			result = 1;
 		}
+		if( result == 0 )
+		{
+			internal_file_list->number_of_cache_misses += 1;
+		}
+		else
+		{
+			internal_file_list->number_of_cache_hits += 1;
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -1502,3 +1510,56 @@ int libmfdata_file_list_set_file_value_by_index(
 	return( 1 );
 }
 
+/* Retrieves the number of cache hits and misses of the file list
+ * Returns 1 if successful or -1 on error
+ */
+int libmfdata_file_list_get_cache_statistics(
+     libmfdata_file_list_t *file_list,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error )
+{
+	libmfdata_internal_file_list_t *internal_file_list = NULL;
+	static char *function                              = "libmfdata_file_list_get_cache_statistics";
+
+	if( file_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_list = (libmfdata_internal_file_list_t *) file_list;
+
+	if( number_of_cache_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache misses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_cache_hits   = internal_file_list->number_of_cache_hits;
+	*number_of_cache_misses = internal_file_list->number_of_cache_misses;
+
+	return( 1 );
+}
+
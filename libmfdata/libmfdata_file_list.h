@@ -47,6 +47,14 @@ struct libmfdata_internal_file_list
 	 */
 	uint8_t flags;
 
+	/* The number of file value cache hits
+	 */
+	uint64_t number_of_cache_hits;
+
+	/* The number of file value cache misses
+	 */
+	uint64_t number_of_cache_misses;
+
 	/* The io handle
 	 */
 	intptr_t *io_handle;
@@ -200,6 +208,13 @@ int libmfdata_file_list_set_file_value_by_index(
      uint8_t flags,
      libcerror_error_t **error );
 
+LIBMFDATA_EXTERN \
+int libmfdata_file_list_get_cache_statistics(
+     libmfdata_file_list_t *file_list,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
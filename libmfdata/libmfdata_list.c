@@ -3222,6 +3222,14 @@ int libmfdata_list_get_element_value(
 		{
 			result = 1;
 		}
+		if( result == 0 )
+		{
+			internal_list->number_of_cache_misses += 1;
+		}
+		else
+		{
+			internal_list->number_of_cache_hits += 1;
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -3826,3 +3834,56 @@ int libmfdata_list_get_value_size(
 	return( 1 );
 }
 
+/* Retrieves the number of cache hits and misses of the list
+ * Returns 1 if successful or -1 on error
+ */
+int libmfdata_list_get_cache_statistics(
+     libmfdata_list_t *list,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error )
+{
+	libmfdata_internal_list_t *internal_list = NULL;
+	static char *function                    = "libmfdata_list_get_cache_statistics";
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libmfdata_internal_list_t *) list;
+
+	if( number_of_cache_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache misses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_cache_hits   = internal_list->number_of_cache_hits;
+	*number_of_cache_misses = internal_list->number_of_cache_misses;
+
+	return( 1 );
+}
+
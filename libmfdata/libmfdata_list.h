@@ -52,6 +52,14 @@ struct libmfdata_internal_list
 	 */
 	uint8_t flags;
 
+	/* The number of element value cache hits
+	 */
+	uint64_t number_of_cache_hits;
+
+	/* The number of element value cache misses
+	 */
+	uint64_t number_of_cache_misses;
+
 	/* The io handle
 	 */
 	intptr_t *io_handle;
@@ -391,6 +399,13 @@ int libmfdata_list_get_value_size(
      size64_t *value_size,
      libcerror_error_t **error );
 
+LIBMFDATA_EXTERN \
+int libmfdata_list_get_cache_statistics(
+     libmfdata_list_t *list,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -45,13 +45,15 @@
  * bit 1        set to 1 for read access
  * bit 2        set to 1 for write access
  * bit 3        set to 1 to truncate an existing file on write
- * bit 4-8      not used
+ * bit 4        set to 1 to read directly from the device bypassing the system cache
+ * bit 5-8      not used
  */
 enum LIBSMDEV_ACCESS_FLAGS
 {
 	LIBSMDEV_ACCESS_FLAG_READ			= 0x01,
 	LIBSMDEV_ACCESS_FLAG_WRITE			= 0x02,
-	LIBSMDEV_ACCESS_FLAG_TRUNCATE			= 0x04
+	LIBSMDEV_ACCESS_FLAG_TRUNCATE			= 0x04,
+	LIBSMDEV_ACCESS_FLAG_DIRECT			= 0x08
 };
 
 /* The file access macros
@@ -61,6 +63,7 @@ enum LIBSMDEV_ACCESS_FLAGS
 #define LIBSMDEV_OPEN_READ_WRITE			( LIBSMDEV_ACCESS_FLAG_READ | LIBSMDEV_ACCESS_FLAG_WRITE )
 #define LIBSMDEV_OPEN_WRITE_TRUNCATE			( LIBSMDEV_ACCESS_FLAG_WRITE | LIBSMDEV_ACCESS_FLAG_TRUNCATE )
 #define LIBSMDEV_OPEN_READ_WRITE_TRUNCATE		( LIBSMDEV_ACCESS_FLAG_READ | LIBSMDEV_ACCESS_FLAG_WRITE | LIBSMDEV_ACCESS_FLAG_TRUNCATE )
+#define LIBSMDEV_OPEN_READ_DIRECT			( LIBSMDEV_ACCESS_FLAG_READ | LIBSMDEV_ACCESS_FLAG_DIRECT )
 
 /* The error flags definitions
  */
@@ -109,6 +112,14 @@ enum LIBSMDEV_TRACK_TYPES
 
 #endif
 
+/* The maximum number of reads the read queue keeps in flight
+ */
+#define LIBSMDEV_MAXIMUM_READ_QUEUE_DEPTH		64
+
+/* The alignment of the read queue data, which allows direct access reads
+ */
+#define LIBSMDEV_READ_QUEUE_DATA_ALIGNMENT		4096
+
 /* Platform specific macros
  */
 #if defined( _MSC_VER )
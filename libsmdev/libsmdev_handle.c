@@ -51,6 +51,7 @@
 #include "libsmdev_libuna.h"
 #include "libsmdev_metadata.h"
 #include "libsmdev_optical_disc.h"
+#include "libsmdev_read_queue.h"
 #include "libsmdev_scsi.h"
 #include "libsmdev_sector_range.h"
 #include "libsmdev_string.h"
@@ -454,10 +455,8 @@ int libsmdev_handle_open(
 	static char *function                       = "libsmdev_handle_open";
 	size64_t media_size                         = 0;
 	size_t filename_length                      = 0;
-
-#if defined( WINAPI )
 	uint32_t bytes_per_sector                   = 0;
-#endif
+	uint8_t use_block_size                      = 0;
 
 	if( handle == NULL )
 	{
@@ -613,35 +612,46 @@ int libsmdev_handle_open(
 #if defined( WINAPI )
 	/* Some Windows device require sector aligned read and seek operations
 	 */
-	if( libsmdev_handle_get_bytes_per_sector(
-	     handle,
-	     &bytes_per_sector,
-	     error ) != 1 )
+	use_block_size = 1;
+#else
+	/* Direct access requires sector aligned read and seek operations
+	 */
+	if( ( access_flags & LIBSMDEV_ACCESS_FLAG_DIRECT ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve bytes per sector.",
-		 function );
-
-		goto on_error;
+		use_block_size = 1;
 	}
-	if( libcfile_file_set_block_size(
-	     internal_handle->device_file,
-	     (size_t) bytes_per_sector,
-	     error ) != 1 )
+#endif
+	if( use_block_size != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to set block size in device file.",
-		 function );
+		if( libsmdev_handle_get_bytes_per_sector(
+		     handle,
+		     &bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve bytes per sector.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( libcfile_file_set_block_size(
+		     internal_handle->device_file,
+		     (size_t) bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to set block size in device file.",
+			 function );
+
+			goto on_error;
+		}
 	}
-#endif
 	/* Use this function to double the read-ahead system buffer on POSIX system
 	 * This provides for some additional performance
 	 */
@@ -694,10 +704,8 @@ int libsmdev_handle_open_wide(
 	static char *function                       = "libsmdev_handle_open_wide";
 	size64_t media_size                         = 0;
 	size_t filename_length                      = 0;
-
-#if defined( WINAPI )
 	uint32_t bytes_per_sector                   = 0;
-#endif
+	uint8_t use_block_size                      = 0;
 
 	if( handle == NULL )
 	{
@@ -853,35 +861,46 @@ int libsmdev_handle_open_wide(
 #if defined( WINAPI )
 	/* Some Windows device require sector aligned read and seek operations
 	 */
-	if( libsmdev_handle_get_bytes_per_sector(
-	     handle,
-	     &bytes_per_sector,
-	     error ) != 1 )
+	use_block_size = 1;
+#else
+	/* Direct access requires sector aligned read and seek operations
+	 */
+	if( ( access_flags & LIBSMDEV_ACCESS_FLAG_DIRECT ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve bytes per sector.",
-		 function );
-
-		goto on_error;
+		use_block_size = 1;
 	}
-	if( libcfile_file_set_block_size(
-	     internal_handle->device_file,
-	     (size_t) bytes_per_sector,
-	     error ) != 1 )
+#endif
+	if( use_block_size != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to set block size in device file.",
-		 function );
+		if( libsmdev_handle_get_bytes_per_sector(
+		     handle,
+		     &bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve bytes per sector.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( libcfile_file_set_block_size(
+		     internal_handle->device_file,
+		     (size_t) bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to set block size in device file.",
+			 function );
+
+			goto on_error;
+		}
 	}
-#endif
 	/* Use this function to double the read-ahead system buffer on POSIX system
 	 * This provides for some additional performance
 	 */
@@ -945,6 +964,26 @@ int libsmdev_handle_close(
 	}
 	internal_handle = (libsmdev_internal_handle_t *) handle;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+	/* The read queue is freed first since its threads read from the device file
+	 */
+	if( internal_handle->read_queue != NULL )
+	{
+		if( libsmdev_read_queue_free(
+		     &( internal_handle->read_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
 	if( internal_handle->device_file != NULL )
 	{
 		if( libcfile_file_close(
@@ -1056,6 +1095,10 @@ ssize_t libsmdev_handle_read_buffer(
 	uint32_t error_code                         = 0;
 	int16_t number_of_read_errors               = 0;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+	size_t request_size                         = 0;
+#endif
+
 	if( handle == NULL )
 	{
 		libcerror_error_set(
@@ -1122,6 +1165,92 @@ ssize_t libsmdev_handle_read_buffer(
 			read_size = (size_t) ( internal_handle->media_size - internal_handle->offset );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+	/* Read as much as possible from the read queue, the remainder of the buffer,
+	 * if any, is read below which also handles the read error retries
+	 */
+	if( ( internal_handle->read_queue_depth > 0 )
+	 && ( internal_handle->media_size != 0 )
+	 && ( internal_handle->abort == 0 )
+	 && ( read_size > 0 ) )
+	{
+		if( internal_handle->read_queue == NULL )
+		{
+			/* The requests are a multiple of the sector size so that
+			 * the reads remain aligned for direct access
+			 */
+			request_size = internal_handle->read_queue_request_size;
+
+			if( request_size == 0 )
+			{
+				request_size = buffer_size;
+			}
+			if( internal_handle->bytes_per_sector != 0 )
+			{
+				if( ( request_size % internal_handle->bytes_per_sector ) != 0 )
+				{
+					request_size = ( ( request_size / internal_handle->bytes_per_sector ) + 1 )
+					             * internal_handle->bytes_per_sector;
+				}
+			}
+			if( libsmdev_read_queue_initialize(
+			     &( internal_handle->read_queue ),
+			     internal_handle->device_file,
+			     internal_handle->media_size,
+			     internal_handle->read_queue_depth,
+			     request_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create read queue.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		read_count = libsmdev_read_queue_read_buffer(
+		              internal_handle->read_queue,
+		              internal_handle->offset,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from read queue.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+		read_size     -= (size_t) read_count;
+
+		/* The read queue does not change the offset of the device file
+		 */
+		if( libcfile_file_seek_offset(
+		     internal_handle->device_file,
+		     internal_handle->offset + (off64_t) buffer_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in device file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	while( number_of_read_errors <= (int16_t) internal_handle->number_of_error_retries )
 	{
 		if( internal_handle->abort != 0 )
@@ -1592,6 +1721,82 @@ ssize_t libsmdev_handle_write_buffer_at_offset(
 	return( write_count );
 }
 
+/* Sets the read queue values
+ * The queue depth is the number of reads that are kept in flight, 0 disables the read queue
+ * The request size is the size of a single read, 0 to use the size of the buffer that is read
+ * Returns 1 if successful or -1 on error
+ */
+int libsmdev_handle_set_read_queue_values(
+     libsmdev_handle_t *handle,
+     int queue_depth,
+     size_t request_size,
+     libcerror_error_t **error )
+{
+	libsmdev_internal_handle_t *internal_handle = NULL;
+	static char *function                       = "libsmdev_handle_set_read_queue_values";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libsmdev_internal_handle_t *) handle;
+
+	if( ( queue_depth < 0 )
+	 || ( queue_depth > LIBSMDEV_MAXIMUM_READ_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( request_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid request size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+	/* The read queue is created on the next read
+	 */
+	if( internal_handle->read_queue != NULL )
+	{
+		if( libsmdev_read_queue_free(
+		     &( internal_handle->read_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	internal_handle->read_queue_depth        = queue_depth;
+	internal_handle->read_queue_request_size = request_size;
+
+	return( 1 );
+}
+
 /* Seeks a certain offset
  * Returns the offset if seek is successful or -1 on error
  */
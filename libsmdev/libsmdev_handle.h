@@ -30,6 +30,7 @@
 #include "libsmdev_libcerror.h"
 #include "libsmdev_libcfile.h"
 #include "libsmdev_libcstring.h"
+#include "libsmdev_read_queue.h"
 #include "libsmdev_types.h"
 
 #if defined( _MSC_VER ) || defined( __BORLANDC__ ) || defined( __MINGW32_VERSION ) || defined( __MINGW64_VERSION_MAJOR )
@@ -136,6 +137,20 @@ struct libsmdev_internal_handle
 	 */
 	libcdata_range_list_t *errors_range_list;
 
+	/* The number of reads the read queue keeps in flight, 0 if reads are not queued
+	 */
+	int read_queue_depth;
+
+	/* The size of a single queued read
+	 */
+	size_t read_queue_request_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+	/* The read queue
+	 */
+	libsmdev_read_queue_t *read_queue;
+#endif
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -207,6 +222,13 @@ ssize_t libsmdev_handle_write_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBSMDEV_EXTERN \
+int libsmdev_handle_set_read_queue_values(
+     libsmdev_handle_t *handle,
+     int queue_depth,
+     size_t request_size,
+     libcerror_error_t **error );
+
 LIBSMDEV_EXTERN \
 off64_t libsmdev_handle_seek_offset(
          libsmdev_handle_t *handle,
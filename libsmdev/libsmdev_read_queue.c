@@ -0,0 +1,874 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (c) 2010-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libsmdev_definitions.h"
+#include "libsmdev_libcerror.h"
+#include "libsmdev_libcfile.h"
+#include "libsmdev_libcnotify.h"
+#include "libsmdev_libcthreads.h"
+#include "libsmdev_read_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+
+/* Creates a read queue
+ * The queue depth is the number of reads that are kept in flight
+ * and the number of threads that perform the reads
+ * Returns 1 if successful or -1 on error
+ */
+int libsmdev_read_queue_initialize(
+     libsmdev_read_queue_t **read_queue,
+     libcfile_file_t *device_file,
+     size64_t media_size,
+     int queue_depth,
+     size_t request_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libsmdev_read_queue_initialize";
+	size_t requests_size  = 0;
+	int request_index     = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth <= 0 )
+	 || ( queue_depth > LIBSMDEV_MAXIMUM_READ_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( request_size == 0 )
+	 || ( request_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid request size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_queue = memory_allocate_structure(
+	               libsmdev_read_queue_t );
+
+	if( *read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_queue,
+	     0,
+	     sizeof( libsmdev_read_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read queue.",
+		 function );
+
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+
+		return( -1 );
+	}
+	( *read_queue )->device_file                = device_file;
+	( *read_queue )->media_size                 = media_size;
+	( *read_queue )->request_size               = request_size;
+	( *read_queue )->maximum_number_of_requests = queue_depth;
+
+	requests_size = sizeof( libsmdev_read_request_t ) * queue_depth;
+
+	( *read_queue )->requests = (libsmdev_read_request_t *) memory_allocate(
+	                                                         requests_size );
+
+	if( ( *read_queue )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_queue )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		memory_free(
+		 ( *read_queue )->requests );
+
+		( *read_queue )->requests = NULL;
+
+		goto on_error;
+	}
+	for( request_index = 0;
+	     request_index < queue_depth;
+	     request_index++ )
+	{
+		/* The data is aligned since the device can be opened for direct access
+		 */
+#if defined( memory_allocate_aligned )
+		if( memory_allocate_aligned(
+		     (void **) &( ( *read_queue )->requests[ request_index ].data ),
+		     sizeof( uint8_t ) * request_size,
+		     LIBSMDEV_READ_QUEUE_DATA_ALIGNMENT ) != 0 )
+		{
+			( *read_queue )->requests[ request_index ].data = NULL;
+		}
+#else
+		( *read_queue )->requests[ request_index ].data = (uint8_t *) memory_allocate(
+		                                                               sizeof( uint8_t ) * request_size );
+#endif
+		if( ( *read_queue )->requests[ request_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data of request: %d.",
+			 function,
+			 request_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_queue )->requests_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create requests mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_queue )->read_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_queue )->thread_pool ),
+	     NULL,
+	     queue_depth,
+	     queue_depth,
+	     (int (*)(intptr_t *, void *)) &libsmdev_read_queue_process_request,
+	     (void *) *read_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_queue != NULL )
+	{
+		libsmdev_read_queue_free(
+		 read_queue,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a read queue
+ * Waits for the outstanding reads to complete before the threads are stopped
+ * Returns 1 if successful or -1 on error
+ */
+int libsmdev_read_queue_free(
+     libsmdev_read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libsmdev_read_queue_free";
+	int request_index     = 0;
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		if( ( *read_queue )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *read_queue )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_queue )->requests != NULL )
+		{
+			for( request_index = 0;
+			     request_index < ( *read_queue )->maximum_number_of_requests;
+			     request_index++ )
+			{
+				if( ( *read_queue )->requests[ request_index ].data != NULL )
+				{
+					memory_free(
+					 ( *read_queue )->requests[ request_index ].data );
+				}
+			}
+			memory_free(
+			 ( *read_queue )->requests );
+		}
+		if( ( *read_queue )->read_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *read_queue )->read_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_queue )->requests_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *read_queue )->requests_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free requests mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( result );
+}
+
+/* Resets the read queue to read ahead from a specific offset
+ * Waits for the outstanding reads to complete, since their data is discarded
+ * The offset is aligned to the request size
+ * Returns 1 if successful or -1 on error
+ */
+int libsmdev_read_queue_reset(
+     libsmdev_read_queue_t *read_queue,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libsmdev_read_queue_reset";
+	int request_index     = 0;
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_queue->number_of_requests > 0 )
+	{
+		request_index = read_queue->first_request_index;
+
+		if( read_queue->requests[ request_index ].result == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     read_queue->read_condition,
+			     read_queue->requests_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for read condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			continue;
+		}
+		read_queue->first_request_index = ( request_index + 1 )
+		                                % read_queue->maximum_number_of_requests;
+		read_queue->number_of_requests -= 1;
+	}
+	if( result == 1 )
+	{
+		read_queue->first_request_index = 0;
+		read_queue->next_offset         = offset - ( offset % (off64_t) read_queue->request_size );
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Submits reads until the queue is full or the end of the media is reached
+ * Returns 1 if successful or -1 on error
+ */
+int libsmdev_read_queue_submit_requests(
+     libsmdev_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	libsmdev_read_request_t *request = NULL;
+	static char *function            = "libsmdev_read_queue_submit_requests";
+	int request_index                = 0;
+	int result                       = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( read_queue->number_of_requests < read_queue->maximum_number_of_requests )
+	    && ( (size64_t) read_queue->next_offset < read_queue->media_size ) )
+	{
+		request_index = ( read_queue->first_request_index + read_queue->number_of_requests )
+		              % read_queue->maximum_number_of_requests;
+
+		request = &( read_queue->requests[ request_index ] );
+
+		request->offset     = read_queue->next_offset;
+		request->data_size  = read_queue->request_size;
+		request->read_count = 0;
+		request->result     = 0;
+
+		if( (size64_t) request->data_size > ( read_queue->media_size - (size64_t) request->offset ) )
+		{
+			request->data_size = (size_t) ( read_queue->media_size - (size64_t) request->offset );
+		}
+		read_queue->next_offset        += (off64_t) request->data_size;
+		read_queue->number_of_requests += 1;
+
+		/* The thread pool queue can hold the maximum number of outstanding requests
+		 * so pushing a request does not block
+		 */
+		if( libcthreads_thread_pool_push(
+		     read_queue->thread_pool,
+		     (intptr_t *) request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push request onto thread pool queue.",
+			 function );
+
+			/* Mark the request as failed so that it is not waited for
+			 */
+			request->result = -1;
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->requests_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release requests mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads a buffer at a specific offset from the read queue
+ * The reads are retrieved in the order they were submitted and the queue
+ * is reset when the offset is not within the oldest outstanding read
+ * Reading stops at the first read that failed or was cut short,
+ * the caller is expected to read the remainder of the buffer itself
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libsmdev_read_queue_read_buffer(
+         libsmdev_read_queue_t *read_queue,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	libsmdev_read_request_t *request = NULL;
+	static char *function            = "libsmdev_read_queue_read_buffer";
+	off64_t current_offset           = 0;
+	size_t buffer_offset             = 0;
+	size_t read_size                 = 0;
+	size_t request_data_offset       = 0;
+	int result                       = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		current_offset = offset + (off64_t) buffer_offset;
+
+		if( (size64_t) current_offset >= read_queue->media_size )
+		{
+			break;
+		}
+		if( libcthreads_mutex_grab(
+		     read_queue->requests_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab requests mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* Discard the completed reads that precede the offset
+		 */
+		result = 0;
+
+		while( read_queue->number_of_requests > 0 )
+		{
+			request = &( read_queue->requests[ read_queue->first_request_index ] );
+
+			if( current_offset < request->offset )
+			{
+				break;
+			}
+			if( current_offset < ( request->offset + (off64_t) request->data_size ) )
+			{
+				result = 1;
+
+				break;
+			}
+			if( request->result == 0 )
+			{
+				break;
+			}
+			read_queue->first_request_index = ( read_queue->first_request_index + 1 )
+			                                % read_queue->maximum_number_of_requests;
+			read_queue->number_of_requests -= 1;
+		}
+		if( libcthreads_mutex_release(
+		     read_queue->requests_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release requests mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( result == 0 )
+		{
+			if( libsmdev_read_queue_reset(
+			     read_queue,
+			     current_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to reset read queue.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libsmdev_read_queue_submit_requests(
+		     read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to submit requests.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_grab(
+		     read_queue->requests_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab requests mutex.",
+			 function );
+
+			return( -1 );
+		}
+		request = &( read_queue->requests[ read_queue->first_request_index ] );
+
+		while( request->result == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     read_queue->read_condition,
+			     read_queue->requests_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for read condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 read_queue->requests_mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_release(
+		     read_queue->requests_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release requests mutex.",
+			 function );
+
+			return( -1 );
+		}
+		request_data_offset = (size_t) ( current_offset - request->offset );
+
+		/* The read failed or was cut short before the offset
+		 */
+		if( (ssize_t) request_data_offset >= request->read_count )
+		{
+			break;
+		}
+		read_size = (size_t) request->read_count - request_data_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( request->data[ request_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy request data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += read_size;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads the data of a request
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libsmdev_read_queue_process_request(
+     libsmdev_read_request_t *request,
+     libsmdev_read_queue_t *read_queue )
+{
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	ssize_t read_count       = 0;
+	int result               = 1;
+
+	if( request == NULL )
+	{
+		return( -1 );
+	}
+	if( read_queue == NULL )
+	{
+		return( -1 );
+	}
+	/* Continue after a partial read until the end of the media is reached
+	 */
+	while( data_offset < request->data_size )
+	{
+		read_count = libcfile_file_read_buffer_at_offset(
+		              read_queue->device_file,
+		              &( request->data[ data_offset ] ),
+		              request->data_size - data_offset,
+		              request->offset + (off64_t) data_offset,
+		              &error );
+
+		if( read_count <= 0 )
+		{
+			break;
+		}
+		data_offset += (size_t) read_count;
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->requests_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	/* A read error is retried by the caller, which also handles the read error retries
+	 */
+	request->read_count = (ssize_t) data_offset;
+	request->result     = ( read_count < 0 ) ? -1 : 1;
+
+	if( libcthreads_condition_broadcast(
+	     read_queue->read_condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->requests_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI ) */
+
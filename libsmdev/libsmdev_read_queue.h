@@ -0,0 +1,151 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (c) 2010-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBSMDEV_READ_QUEUE_H )
+#define _LIBSMDEV_READ_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libsmdev_libcerror.h"
+#include "libsmdev_libcfile.h"
+#include "libsmdev_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+
+typedef struct libsmdev_read_request libsmdev_read_request_t;
+
+struct libsmdev_read_request
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The number of bytes read
+	 */
+	ssize_t read_count;
+
+	/* The result of the read, 0 if still pending, 1 if read or -1 on error
+	 */
+	int result;
+};
+
+typedef struct libsmdev_read_queue libsmdev_read_queue_t;
+
+struct libsmdev_read_queue
+{
+	/* The device file, which is not managed by the read queue
+	 */
+	libcfile_file_t *device_file;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The size of a single read
+	 */
+	size_t request_size;
+
+	/* The requests, stored as a ring in the order they were submitted
+	 */
+	libsmdev_read_request_t *requests;
+
+	/* The maximum number of outstanding requests
+	 */
+	int maximum_number_of_requests;
+
+	/* The index of the first (oldest) request
+	 */
+	int first_request_index;
+
+	/* The number of outstanding requests
+	 */
+	int number_of_requests;
+
+	/* The offset of the next request to submit
+	 */
+	off64_t next_offset;
+
+	/* The mutex that protects the requests
+	 */
+	libcthreads_mutex_t *requests_mutex;
+
+	/* The condition that is signalled when a request was read
+	 */
+	libcthreads_condition_t *read_condition;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+int libsmdev_read_queue_initialize(
+     libsmdev_read_queue_t **read_queue,
+     libcfile_file_t *device_file,
+     size64_t media_size,
+     int queue_depth,
+     size_t request_size,
+     libcerror_error_t **error );
+
+int libsmdev_read_queue_free(
+     libsmdev_read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+int libsmdev_read_queue_reset(
+     libsmdev_read_queue_t *read_queue,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libsmdev_read_queue_submit_requests(
+     libsmdev_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+ssize_t libsmdev_read_queue_read_buffer(
+         libsmdev_read_queue_t *read_queue,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+int libsmdev_read_queue_process_request(
+     libsmdev_read_request_t *request,
+     libsmdev_read_queue_t *read_queue );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PREAD ) && !defined( WINAPI ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -2852,6 +2852,101 @@ int libsmraw_handle_set_maximum_segment_size(
 	return( 1 );
 }
 
+/* Sets the value to indicate if blocks of 0-byte values should be skipped
+ * instead of written, leaving holes in the segment files
+ * This should only be used when writing new segment files
+ * Returns 1 if successful or -1 on error
+ */
+int libsmraw_handle_set_write_sparse(
+     libsmraw_handle_t *handle,
+     uint8_t write_sparse,
+     libcerror_error_t **error )
+{
+	libsmraw_internal_handle_t *internal_handle = NULL;
+	static char *function                       = "libsmraw_handle_set_write_sparse";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libsmraw_internal_handle_t *) handle;
+
+	if( internal_handle->write_values_initialized != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: write sparse cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmraw_io_handle_set_write_sparse(
+	     internal_handle->io_handle,
+	     write_sparse,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set write sparse in IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of bytes that were skipped instead of written
+ * Returns 1 if successful or -1 on error
+ */
+int libsmraw_handle_get_number_of_sparse_bytes(
+     libsmraw_handle_t *handle,
+     size64_t *number_of_sparse_bytes,
+     libcerror_error_t **error )
+{
+	libsmraw_internal_handle_t *internal_handle = NULL;
+	static char *function                       = "libsmraw_handle_get_number_of_sparse_bytes";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libsmraw_internal_handle_t *) handle;
+
+	if( libsmraw_io_handle_get_number_of_sparse_bytes(
+	     internal_handle->io_handle,
+	     number_of_sparse_bytes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sparse bytes from IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the filename size of the segment file of the current offset
  * The filename size should include the end of string character
  * Returns 1 if successful or -1 on error
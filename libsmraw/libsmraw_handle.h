@@ -257,6 +257,18 @@ int libsmraw_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBSMRAW_EXTERN \
+int libsmraw_handle_set_write_sparse(
+     libsmraw_handle_t *handle,
+     uint8_t write_sparse,
+     libcerror_error_t **error );
+
+LIBSMRAW_EXTERN \
+int libsmraw_handle_get_number_of_sparse_bytes(
+     libsmraw_handle_t *handle,
+     size64_t *number_of_sparse_bytes,
+     libcerror_error_t **error );
+
 LIBSMRAW_EXTERN \
 int libsmraw_handle_get_filename_size(
      libsmraw_handle_t *handle,
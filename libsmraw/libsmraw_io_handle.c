@@ -33,6 +33,11 @@
 #include "libsmraw_libuna.h"
 #include "libsmraw_unused.h"
 
+/* The largest primary (or scalar) available
+ * supported by a single load and store instruction
+ */
+typedef unsigned long int libsmraw_aligned_t;
+
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -402,7 +407,7 @@ ssize_t libsmraw_io_handle_read_segment_data(
 ssize_t libsmraw_io_handle_write_segment_data(
          libsmraw_io_handle_t *io_handle,
          libbfio_pool_t *file_io_pool,
-         int segment_index LIBSMRAW_ATTRIBUTE_UNUSED,
+         int segment_index,
          int segment_file_index,
          const uint8_t *segment_data,
          size_t segment_data_size,
@@ -410,10 +415,12 @@ ssize_t libsmraw_io_handle_write_segment_data(
          uint8_t write_flags LIBSMRAW_ATTRIBUTE_UNUSED,
          libcerror_error_t **error )
 {
-	static char *function = "libsmraw_io_handle_write_segment_data";
+	static char *function  = "libsmraw_io_handle_write_segment_data";
+	size64_t end_offset    = 0;
+	size_t skip_size       = 0;
 	ssize_t write_count    = 0;
+	off64_t segment_offset = 0;
 
-	LIBSMRAW_UNREFERENCED_PARAMETER( segment_index )
 	LIBSMRAW_UNREFERENCED_PARAMETER( segment_flags )
 	LIBSMRAW_UNREFERENCED_PARAMETER( write_flags )
 
@@ -428,6 +435,75 @@ ssize_t libsmraw_io_handle_write_segment_data(
 
 		return( -1 );
 	}
+	if( ( io_handle->write_sparse != 0 )
+	 && ( segment_data_size > 0 )
+	 && ( libsmraw_io_handle_segment_data_is_sparse(
+	       segment_data,
+	       segment_data_size ) != 0 ) )
+	{
+		if( libbfio_pool_get_offset(
+		     file_io_pool,
+		     segment_file_index,
+		     &segment_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment offset.",
+			 function );
+
+			return( -1 );
+		}
+		skip_size  = segment_data_size;
+		end_offset = (size64_t) segment_offset + segment_data_size;
+
+		/* A hole at the end of a segment file does not extend the file
+		 * so the last byte of the segment file is written
+		 */
+		if( io_handle->maximum_segment_size != 0 )
+		{
+			if( end_offset >= io_handle->maximum_segment_size )
+			{
+				skip_size -= 1;
+			}
+			end_offset += (size64_t) segment_index * io_handle->maximum_segment_size;
+		}
+		if( ( skip_size == segment_data_size )
+		 && ( ( io_handle->media_size == 0 )
+		  ||  ( end_offset >= io_handle->media_size ) ) )
+		{
+			skip_size -= 1;
+		}
+		if( skip_size > 0 )
+		{
+			if( libbfio_pool_seek_offset(
+			     file_io_pool,
+			     segment_file_index,
+			     (off64_t) skip_size,
+			     SEEK_CUR,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to skip sparse segment data.",
+				 function );
+
+				return( -1 );
+			}
+			io_handle->number_of_sparse_bytes += skip_size;
+		}
+		segment_data      += skip_size;
+		segment_data_size -= skip_size;
+
+		if( segment_data_size == 0 )
+		{
+			return( (ssize_t) skip_size );
+		}
+	}
 	write_count = libbfio_pool_write_buffer(
 	               file_io_pool,
 	               segment_file_index,
@@ -446,7 +522,55 @@ ssize_t libsmraw_io_handle_write_segment_data(
 
 		return( -1 );
 	}
-	return( write_count );
+	return( (ssize_t) skip_size + write_count );
+}
+
+/* Determines if segment data only contains 0-byte values
+ * Returns 1 if the segment data is sparse or 0 if not
+ */
+int libsmraw_io_handle_segment_data_is_sparse(
+     const uint8_t *segment_data,
+     size_t segment_data_size )
+{
+	const libsmraw_aligned_t *aligned_segment_data = NULL;
+
+	if( segment_data == NULL )
+	{
+		return( 0 );
+	}
+	while( ( segment_data_size > 0 )
+	    && ( ( (intptr_t) segment_data % sizeof( libsmraw_aligned_t ) ) != 0 ) )
+	{
+		if( *segment_data != 0 )
+		{
+			return( 0 );
+		}
+		segment_data      += 1;
+		segment_data_size -= 1;
+	}
+	aligned_segment_data = (const libsmraw_aligned_t *) segment_data;
+
+	while( segment_data_size >= sizeof( libsmraw_aligned_t ) )
+	{
+		if( *aligned_segment_data != 0 )
+		{
+			return( 0 );
+		}
+		aligned_segment_data += 1;
+		segment_data_size    -= sizeof( libsmraw_aligned_t );
+	}
+	segment_data = (const uint8_t *) aligned_segment_data;
+
+	while( segment_data_size > 0 )
+	{
+		if( *segment_data != 0 )
+		{
+			return( 0 );
+		}
+		segment_data      += 1;
+		segment_data_size -= 1;
+	}
+	return( 1 );
 }
 
 /* Seeks a certain segment offset
@@ -1592,3 +1716,67 @@ int libsmraw_io_handle_set_maximum_segment_size(
 	return( 1 );
 }
 
+/* Sets the value to indicate if blocks of 0-byte values should be skipped
+ * instead of written
+ * Returns 1 if successful or -1 on error
+ */
+int libsmraw_io_handle_set_write_sparse(
+     libsmraw_io_handle_t *io_handle,
+     uint8_t write_sparse,
+     libcerror_error_t **error )
+{
+	static char *function = "libsmraw_io_handle_set_write_sparse";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->write_sparse = write_sparse;
+
+	return( 1 );
+}
+
+/* Retrieves the number of bytes that were skipped instead of written
+ * Returns 1 if successful or -1 on error
+ */
+int libsmraw_io_handle_get_number_of_sparse_bytes(
+     libsmraw_io_handle_t *io_handle,
+     size64_t *number_of_sparse_bytes,
+     libcerror_error_t **error )
+{
+	static char *function = "libsmraw_io_handle_get_number_of_sparse_bytes";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sparse_bytes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sparse bytes.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_sparse_bytes = io_handle->number_of_sparse_bytes;
+
+	return( 1 );
+}
+
@@ -58,6 +58,15 @@ struct libsmraw_io_handle
 	 */
 	int number_of_segments;
 
+	/* Value to indicate if blocks of 0-byte values should be skipped
+	 * instead of written, leaving holes in the segment files
+	 */
+	uint8_t write_sparse;
+
+	/* The number of bytes that were skipped instead of written
+	 */
+	size64_t number_of_sparse_bytes;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -103,6 +112,10 @@ ssize_t libsmraw_io_handle_write_segment_data(
          uint8_t write_flags,
          libcerror_error_t **error );
 
+int libsmraw_io_handle_segment_data_is_sparse(
+     const uint8_t *segment_data,
+     size_t segment_data_size );
+
 off64_t libsmraw_io_handle_seek_segment_offset(
          libsmraw_io_handle_t *io_handle,
          libbfio_pool_t *file_io_pool,
@@ -157,6 +170,16 @@ int libsmraw_io_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+int libsmraw_io_handle_set_write_sparse(
+     libsmraw_io_handle_t *io_handle,
+     uint8_t write_sparse,
+     libcerror_error_t **error );
+
+int libsmraw_io_handle_get_number_of_sparse_bytes(
+     libsmraw_io_handle_t *io_handle,
+     size64_t *number_of_sparse_bytes,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -3651,7 +3651,7 @@ int libuna_unicode_character_copy_from_utf7_stream(
 			{
 				*unicode_character  -= LIBUNA_UNICODE_SURROGATE_HIGH_RANGE_START;
 				*unicode_character <<= 10;
-				*unicode_character  += utf16_surrogate - LIBUNA_UNICODE_SURROGATE_LOW_RANGE_END;
+				*unicode_character  += utf16_surrogate - LIBUNA_UNICODE_SURROGATE_LOW_RANGE_START;
 				*unicode_character  += 0x010000;
 			}
 			else
@@ -4778,7 +4778,7 @@ int libuna_unicode_character_copy_from_utf16(
 		{
 			*unicode_character  -= LIBUNA_UNICODE_SURROGATE_HIGH_RANGE_START;
 			*unicode_character <<= 10;
-			*unicode_character  += utf16_surrogate - LIBUNA_UNICODE_SURROGATE_LOW_RANGE_END;
+			*unicode_character  += utf16_surrogate - LIBUNA_UNICODE_SURROGATE_LOW_RANGE_START;
 			*unicode_character  += 0x010000;
 		}
 		else
@@ -5022,7 +5022,7 @@ int libuna_unicode_character_copy_from_utf16_stream(
 		{
 			*unicode_character  -= LIBUNA_UNICODE_SURROGATE_HIGH_RANGE_START;
 			*unicode_character <<= 10;
-			*unicode_character  += utf16_surrogate - LIBUNA_UNICODE_SURROGATE_LOW_RANGE_END;
+			*unicode_character  += utf16_surrogate - LIBUNA_UNICODE_SURROGATE_LOW_RANGE_START;
 			*unicode_character  += 0x010000;
 		}
 		else
@@ -293,7 +293,7 @@ AC_DEFUN([AX_LIBCFILE_CHECK_LOCAL],
  AC_CHECK_HEADERS([cygwin/fs.h fcntl.h linux/fs.h sys/disk.h sys/disklabel.h sys/ioctl.h unistd.h])
 
  dnl File input/output functions used in libcfile/libcfile_file.c
- AC_CHECK_FUNCS([close fstat ftruncate ioctl lseek open read write])
+ AC_CHECK_FUNCS([close fallocate fstat fsync ftruncate ioctl lseek open pread read sync_file_range write])
 
  AS_IF(
   [test "x$ac_cv_func_close" != xyes],
@@ -409,7 +409,7 @@ AC_DEFUN([AX_LIBCFILE_CHECK_LOCAL],
   ])
 
  dnl File input/output functions used in libcfile/libcfile_support.c
- AC_CHECK_FUNCS([stat])
+ AC_CHECK_FUNCS([stat unlink])
 
  AS_IF(
   [test "x$ac_cv_func_stat" != xyes],
@@ -129,6 +129,16 @@ AC_DEFUN([AX_LIBSMRAW_CHECK_LIB],
      libsmraw_handle_set_media_size,
      [ac_cv_libsmraw_dummy=yes],
      [ac_cv_libsmraw=no])
+    AC_CHECK_LIB(
+     smraw,
+     libsmraw_handle_set_write_sparse,
+     [ac_cv_libsmraw_dummy=yes],
+     [ac_cv_libsmraw=no])
+    AC_CHECK_LIB(
+     smraw,
+     libsmraw_handle_get_number_of_sparse_bytes,
+     [ac_cv_libsmraw_dummy=yes],
+     [ac_cv_libsmraw=no])
     AC_CHECK_LIB(
      smraw,
      libsmraw_handle_set_utf8_integrity_hash_value
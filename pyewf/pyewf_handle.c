@@ -207,6 +207,17 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Retrieves all hash values." },
 
+	/* Functions to access the statistics */
+
+	{ "get_statistics",
+	  (PyCFunction) pyewf_handle_get_statistics,
+	  METH_NOARGS,
+	  "get_statistics() -> Dictionary\n"
+	  "\n"
+	  "Retrieves the statistics, such as the number of chunks read and the decompression time in nanoseconds.\n"
+	  "Values that are not available, such as the cache statistics when libewf was built against a system\n"
+	  "installed libmfdata, are None." },
+
 	/* Functions to access the (single) file entries */
 
 	{ "get_root_file_entry",
@@ -234,6 +245,12 @@ PyGetSetDef pyewf_handle_object_get_set_definitions[] = {
 	  "The media size.",
 	  NULL },
 
+	{ "statistics",
+	  (getter) pyewf_handle_get_statistics,
+	  (setter) 0,
+	  "The statistics.",
+	  NULL },
+
 	/* Sentinel */
 	{ NULL, NULL, NULL, NULL, NULL }
 };
@@ -1612,3 +1629,144 @@ on_error:
 	return( NULL );
 }
 
+/* Retrieves the statistics
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	uint64_t statistics[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	const char *statistics_identifiers[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ] = {
+		"number_of_chunks_read",
+		"number_of_bytes_read",
+		"read_time",
+		"number_of_bytes_decompressed",
+		"decompression_time",
+		"number_of_chunks_written",
+		"number_of_bytes_written",
+		"write_time",
+		"number_of_bytes_compressed",
+		"compression_time",
+		"chunk_table_cache_hits",
+		"chunk_table_cache_misses",
+		"segment_files_cache_hits",
+		"segment_files_cache_misses",
+		"number_of_file_io_pool_opens",
+		"number_of_file_io_pool_evictions",
+		"number_of_chunks_compressed",
+		"number_of_chunks_uncompressed",
+		"number_of_chunks_compression_skipped" };
+
+	libcerror_error_t *error    = NULL;
+	PyObject *dictionary_object = NULL;
+	PyObject *integer_object    = NULL;
+	static char *function       = "pyewf_handle_get_statistics";
+	int result                  = 0;
+	int statistics_index        = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_get_statistics(
+	          pyewf_handle->handle,
+	          statistics,
+	          LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	dictionary_object = PyDict_New();
+
+	if( dictionary_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create dictionary.",
+		 function );
+
+		goto on_error;
+	}
+	for( statistics_index = 0;
+	     statistics_index < LIBEWF_STATISTICS_NUMBER_OF_VALUES;
+	     statistics_index++ )
+	{
+		/* A value that is not available is represented by None
+		 */
+		if( statistics[ statistics_index ] == LIBEWF_STATISTICS_VALUE_NOT_AVAILABLE )
+		{
+			Py_IncRef(
+			 Py_None );
+
+			integer_object = Py_None;
+		}
+		else
+		{
+			integer_object = pyewf_integer_unsigned_new_from_64bit(
+			                  statistics[ statistics_index ] );
+
+			if( integer_object == NULL )
+			{
+				goto on_error;
+			}
+		}
+		if( PyDict_SetItemString(
+		     dictionary_object,
+		     statistics_identifiers[ statistics_index ],
+		     integer_object ) != 0 )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to set statistics value: %s in dictionary.",
+			 function,
+			 statistics_identifiers[ statistics_index ] );
+
+			goto on_error;
+		}
+		/* PyDict_SetItemString does not steal the reference
+		 */
+		Py_DecRef(
+		 integer_object );
+
+		integer_object = NULL;
+	}
+	return( dictionary_object );
+
+on_error:
+	if( integer_object != NULL )
+	{
+		Py_DecRef(
+		 integer_object );
+	}
+	if( dictionary_object != NULL )
+	{
+		Py_DecRef(
+		 dictionary_object );
+	}
+	return( NULL );
+}
+
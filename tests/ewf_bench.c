@@ -0,0 +1,1584 @@
+/*
+ * Expert Witness Compression Format (EWF) library benchmark program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+
+/* The size of the buffer used for the sequential read and write benchmarks
+ */
+#define EWF_BENCH_BUFFER_SIZE		( 1024 * 1024 )
+
+/* The size of the random reads
+ */
+#define EWF_BENCH_RANDOM_READ_SIZE	4096
+
+/* Prints the usage information
+ */
+void ewf_bench_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewf_bench to measure the throughput of libewf.\n\n" );
+
+	fprintf( stream, "Usage: ewf_bench [ -b sectors_per_chunk ] [ -B media_size ]\n"
+	                 "                 [ -c compression_level ] [ -n number_of_random_reads ]\n"
+	                 "                 [ -r random_percentage ] [ -s seed ] [ -S segment_size ]\n"
+	                 "                 [ -t number_of_threads ] [ -z zero_percentage ] [ -H ]\n"
+	                 "                 basename\n"
+	                 "       ewf_bench -T\n\n" );
+
+	fprintf( stream, "\tbasename: the basename of the EWF image that is written, the .E01\n"
+	                 "\t          extension is added and an existing image is overwritten\n\n" );
+
+	fprintf( stream, "\t-b:       the number of sectors per chunk, default is 64\n" );
+	fprintf( stream, "\t-B:       the media size in bytes, default is 67108864 (64 MiB)\n" );
+	fprintf( stream, "\t-c:       the compression level: n (none), e (empty-block), f (fast),\n"
+	                 "\t          b (best) or a (adaptive), default is n\n" );
+	fprintf( stream, "\t-H:       print a header line before the results\n" );
+	fprintf( stream, "\t-n:       the number of random 4 KiB reads, default is 4096\n" );
+	fprintf( stream, "\t-r:       the percentage of chunks that contain random (incompressible)\n"
+	                 "\t          data, default is 30\n" );
+	fprintf( stream, "\t-s:       the seed of the pseudo random number generator, default is 1\n" );
+	fprintf( stream, "\t-S:       the maximum segment size in bytes, default is the library default\n" );
+	fprintf( stream, "\t-t:       the number of compression threads, default is 0\n" );
+	fprintf( stream, "\t-T:       print the current time of the benchmark clock in nanoseconds\n"
+	                 "\t          and exit, 0 if no clock is available\n" );
+	fprintf( stream, "\t-z:       the percentage of chunks that only contain 0-byte values,\n"
+	                 "\t          default is 10\n\n" );
+
+	fprintf( stream, "\tThe remaining chunks contain compressible text-like data. Every\n"
+	                 "\tbenchmark prints a tab separated line that contains: benchmark,\n"
+	                 "\tcompression, media size, chunk size, number of bytes, number of\n"
+	                 "\toperations, elapsed time in nanoseconds and MiB per second.\n" );
+}
+
+/* Retrieves the current value of a monotonic clock in nanoseconds
+ * Returns the time or 0 if no clock is available
+ */
+uint64_t ewf_bench_get_time(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) counter.QuadPart / (uint64_t) frequency.QuadPart ) * 1000000000UL
+	      + ( ( (uint64_t) counter.QuadPart % (uint64_t) frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+
+#elif defined( HAVE_SYS_TIME_H )
+	struct timeval time_value;
+
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + ( (uint64_t) time_value.tv_usec * 1000UL ) );
+
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the next value of a xorshift pseudo random number generator
+ * The same seed always results in the same sequence of values
+ * Returns the value
+ */
+uint32_t ewf_bench_get_random(
+          uint32_t *state )
+{
+	uint32_t value = *state;
+
+	value ^= value << 13;
+	value ^= value >> 17;
+	value ^= value << 5;
+
+	*state = value;
+
+	return( value );
+}
+
+/* Prints the result of a benchmark
+ */
+void ewf_bench_result_fprint(
+      FILE *stream,
+      const char *benchmark,
+      const char *compression,
+      size64_t media_size,
+      size32_t chunk_size,
+      uint64_t number_of_bytes,
+      uint64_t number_of_operations,
+      uint64_t elapsed_time )
+{
+	double mebibytes_per_second = 0.0;
+
+	if( stream == NULL )
+	{
+		return;
+	}
+	if( elapsed_time > 0 )
+	{
+		mebibytes_per_second = ( (double) number_of_bytes / ( 1024.0 * 1024.0 ) )
+		                     / ( (double) elapsed_time / 1000000000.0 );
+	}
+	fprintf(
+	 stream,
+	 "%s\t%s\t%" PRIu64 "\t%" PRIu32 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\n",
+	 benchmark,
+	 compression,
+	 media_size,
+	 chunk_size,
+	 number_of_bytes,
+	 number_of_operations,
+	 elapsed_time,
+	 mebibytes_per_second );
+}
+
+/* Fills a buffer with the synthetic data of a chunk
+ * The type of data, 0-byte values, random or text-like, is determined per chunk
+ */
+void ewf_bench_fill_chunk(
+      uint8_t *buffer,
+      size_t buffer_size,
+      uint8_t zero_percentage,
+      uint8_t random_percentage,
+      uint32_t *state )
+{
+	static char *words[ 8 ] = {
+		"evidence ", "sector ", "segment ", "acquire ",
+		"chunk ", "volume ", "the ", "header " };
+
+	size_t buffer_offset = 0;
+	size_t word_length   = 0;
+	uint32_t value       = 0;
+
+	value = ewf_bench_get_random(
+	         state ) % 100;
+
+	if( value < (uint32_t) zero_percentage )
+	{
+		memory_set(
+		 buffer,
+		 0,
+		 buffer_size );
+
+		return;
+	}
+	if( value < (uint32_t) ( zero_percentage + random_percentage ) )
+	{
+		while( buffer_offset < buffer_size )
+		{
+			value = ewf_bench_get_random(
+			         state );
+
+			buffer[ buffer_offset++ ] = (uint8_t) value;
+
+			if( buffer_offset < buffer_size )
+			{
+				buffer[ buffer_offset++ ] = (uint8_t) ( value >> 8 );
+			}
+			if( buffer_offset < buffer_size )
+			{
+				buffer[ buffer_offset++ ] = (uint8_t) ( value >> 16 );
+			}
+			if( buffer_offset < buffer_size )
+			{
+				buffer[ buffer_offset++ ] = (uint8_t) ( value >> 24 );
+			}
+		}
+		return;
+	}
+	while( buffer_offset < buffer_size )
+	{
+		value = ewf_bench_get_random(
+		         state ) % 8;
+
+		word_length = libcstring_narrow_string_length(
+		               words[ value ] );
+
+		if( word_length > ( buffer_size - buffer_offset ) )
+		{
+			word_length = buffer_size - buffer_offset;
+		}
+		memory_copy(
+		 &( buffer[ buffer_offset ] ),
+		 words[ value ],
+		 word_length );
+
+		buffer_offset += word_length;
+	}
+}
+
+/* Writes a synthetic image and measures the throughput
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_write(
+     const libcstring_system_character_t *filename,
+     const char *compression,
+     size64_t media_size,
+     uint32_t sectors_per_chunk,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     int number_of_threads,
+     uint8_t zero_percentage,
+     uint8_t random_percentage,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle   = NULL;
+	uint8_t *buffer           = NULL;
+	static char *function     = "ewf_bench_write";
+	size64_t remaining_size   = 0;
+	size32_t chunk_size       = 0;
+	size_t buffer_offset      = 0;
+	size_t buffer_size        = 0;
+	size_t fill_size          = 0;
+	ssize_t write_count       = 0;
+	uint64_t start_time       = 0;
+	uint64_t end_time         = 0;
+	uint64_t number_of_writes = 0;
+	uint32_t state            = seed;
+
+	chunk_size = sectors_per_chunk * 512;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_BENCH_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	start_time = ewf_bench_get_time();
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     handle,
+	     sectors_per_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sectors per chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( maximum_segment_size > 0 )
+	{
+		if( libewf_handle_set_maximum_segment_size(
+		     handle,
+		     maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads > 0 )
+	{
+		if( libewf_handle_set_number_of_compression_threads(
+		     handle,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of compression threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The buffer size is a multiple of the chunk size so that the type
+	 * of data is determined per chunk
+	 */
+	buffer_size = EWF_BENCH_BUFFER_SIZE;
+
+	if( (size_t) chunk_size < buffer_size )
+	{
+		buffer_size -= buffer_size % chunk_size;
+	}
+	remaining_size = media_size;
+
+	while( remaining_size > 0 )
+	{
+		if( (size64_t) buffer_size > remaining_size )
+		{
+			buffer_size = (size_t) remaining_size;
+		}
+		for( buffer_offset = 0;
+		     buffer_offset < buffer_size;
+		     buffer_offset += fill_size )
+		{
+			fill_size = buffer_size - buffer_offset;
+
+			if( fill_size > (size_t) chunk_size )
+			{
+				fill_size = (size_t) chunk_size;
+			}
+			ewf_bench_fill_chunk(
+			 &( buffer[ buffer_offset ] ),
+			 fill_size,
+			 zero_percentage,
+			 random_percentage,
+			 &state );
+		}
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count != (ssize_t) buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer of size: %" PRIzd ".",
+			 function,
+			 buffer_size );
+
+			goto on_error;
+		}
+		remaining_size   -= (size64_t) write_count;
+		number_of_writes += 1;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	end_time = ewf_bench_get_time();
+
+	ewf_bench_result_fprint(
+	 stdout,
+	 "write",
+	 compression,
+	 media_size,
+	 chunk_size,
+	 media_size,
+	 number_of_writes,
+	 end_time - start_time );
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Measures reading the media data sequentially
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_sequential(
+     libewf_handle_t *handle,
+     const char *compression,
+     size64_t media_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer          = NULL;
+	static char *function    = "ewf_bench_read_sequential";
+	size64_t remaining_size  = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	uint64_t start_time      = 0;
+	uint64_t end_time        = 0;
+	uint64_t number_of_reads = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_BENCH_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	start_time = ewf_bench_get_time();
+
+	remaining_size = media_size;
+
+	while( remaining_size > 0 )
+	{
+		read_size = EWF_BENCH_BUFFER_SIZE;
+
+		if( (size64_t) read_size > remaining_size )
+		{
+			read_size = (size_t) remaining_size;
+		}
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer of size: %" PRIzd ".",
+			 function,
+			 read_size );
+
+			goto on_error;
+		}
+		remaining_size  -= (size64_t) read_count;
+		number_of_reads += 1;
+	}
+	end_time = ewf_bench_get_time();
+
+	ewf_bench_result_fprint(
+	 stdout,
+	 "read_sequential",
+	 compression,
+	 media_size,
+	 chunk_size,
+	 media_size,
+	 number_of_reads,
+	 end_time - start_time );
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Measures reading 4 KiB blocks at pseudo random 4 KiB aligned offsets
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_random(
+     libewf_handle_t *handle,
+     const char *compression,
+     size64_t media_size,
+     size32_t chunk_size,
+     uint64_t number_of_reads,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_BENCH_RANDOM_READ_SIZE ];
+
+	static char *function     = "ewf_bench_read_random";
+	off64_t read_offset       = 0;
+	ssize_t read_count        = 0;
+	uint64_t number_of_blocks = 0;
+	uint64_t read_iterator    = 0;
+	uint64_t start_time       = 0;
+	uint64_t end_time         = 0;
+	uint32_t state            = seed;
+
+	number_of_blocks = media_size / EWF_BENCH_RANDOM_READ_SIZE;
+
+	if( number_of_blocks == 0 )
+	{
+		return( 1 );
+	}
+	start_time = ewf_bench_get_time();
+
+	for( read_iterator = 0;
+	     read_iterator < number_of_reads;
+	     read_iterator++ )
+	{
+		read_offset  = (off64_t) ewf_bench_get_random( &state ) << 32;
+		read_offset |= (off64_t) ewf_bench_get_random( &state );
+		read_offset  = (off64_t) ( (uint64_t) read_offset % number_of_blocks ) * EWF_BENCH_RANDOM_READ_SIZE;
+
+		read_count = libewf_handle_read_random(
+		              handle,
+		              buffer,
+		              EWF_BENCH_RANDOM_READ_SIZE,
+		              read_offset,
+		              error );
+
+		if( read_count != (ssize_t) EWF_BENCH_RANDOM_READ_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 ".",
+			 function,
+			 read_offset );
+
+			return( -1 );
+		}
+	}
+	end_time = ewf_bench_get_time();
+
+	ewf_bench_result_fprint(
+	 stdout,
+	 "read_random_4k",
+	 compression,
+	 media_size,
+	 chunk_size,
+	 number_of_reads * EWF_BENCH_RANDOM_READ_SIZE,
+	 number_of_reads,
+	 end_time - start_time );
+
+	return( 1 );
+}
+
+/* Measures reading the media data chunk by chunk
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_chunks(
+     libewf_handle_t *handle,
+     const char *compression,
+     size64_t media_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	uint8_t checksum_buffer[ 4 ];
+
+	uint8_t *chunk_buffer     = NULL;
+	uint8_t *data_buffer      = NULL;
+	static char *function     = "ewf_bench_read_chunks";
+	size64_t remaining_size   = 0;
+	size_t chunk_buffer_size  = 0;
+	size_t data_size          = 0;
+	ssize_t process_count     = 0;
+	ssize_t read_count        = 0;
+	uint64_t number_of_chunks = 0;
+	uint64_t start_time       = 0;
+	uint64_t end_time         = 0;
+	uint32_t chunk_checksum   = 0;
+	int8_t is_compressed      = 0;
+	int8_t process_checksum   = 0;
+
+	/* The chunk buffer should at least have a size of: chunk_size + 16
+	 */
+	chunk_buffer_size = (size_t) chunk_size * 2;
+
+	chunk_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * chunk_buffer_size );
+
+	if( chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk buffer.",
+		 function );
+
+		goto on_error;
+	}
+	data_buffer = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * chunk_size );
+
+	if( data_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	start_time = ewf_bench_get_time();
+
+	remaining_size = media_size;
+
+	while( remaining_size > 0 )
+	{
+		read_count = libewf_handle_read_chunk(
+		              handle,
+		              chunk_buffer,
+		              chunk_buffer_size,
+		              &is_compressed,
+		              (void *) checksum_buffer,
+		              &chunk_checksum,
+		              &process_checksum,
+		              error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 ".",
+			 function,
+			 number_of_chunks );
+
+			goto on_error;
+		}
+		data_size = (size_t) chunk_size;
+
+		process_count = libewf_handle_prepare_read_chunk(
+		                 handle,
+		                 chunk_buffer,
+		                 (size_t) read_count,
+		                 data_buffer,
+		                 &data_size,
+		                 is_compressed,
+		                 chunk_checksum,
+		                 process_checksum,
+		                 error );
+
+		if( process_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to prepare chunk: %" PRIu64 ".",
+			 function,
+			 number_of_chunks );
+
+			goto on_error;
+		}
+		if( (size64_t) process_count > remaining_size )
+		{
+			process_count = (ssize_t) remaining_size;
+		}
+		remaining_size   -= (size64_t) process_count;
+		number_of_chunks += 1;
+	}
+	end_time = ewf_bench_get_time();
+
+	ewf_bench_result_fprint(
+	 stdout,
+	 "read_chunk",
+	 compression,
+	 media_size,
+	 chunk_size,
+	 media_size,
+	 number_of_chunks,
+	 end_time - start_time );
+
+	memory_free(
+	 data_buffer );
+	memory_free(
+	 chunk_buffer );
+
+	return( 1 );
+
+on_error:
+	if( data_buffer != NULL )
+	{
+		memory_free(
+		 data_buffer );
+	}
+	if( chunk_buffer != NULL )
+	{
+		memory_free(
+		 chunk_buffer );
+	}
+	return( -1 );
+}
+
+/* Opens the image written by ewf_bench_write and runs the read benchmarks
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read(
+     const libcstring_system_character_t *filename,
+     const char *compression,
+     uint64_t number_of_random_reads,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t **filenames = NULL;
+	libewf_handle_t *handle                   = NULL;
+	static char *function                     = "ewf_bench_read";
+	size64_t media_size                       = 0;
+	size32_t chunk_size                       = 0;
+	int number_of_filenames                   = 0;
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     filename,
+	     libcstring_wide_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_ENCASE5,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     filename,
+	     libcstring_narrow_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_ENCASE5,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob filenames.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_filenames == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) INT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_read_sequential(
+	     handle,
+	     compression,
+	     media_size,
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to benchmark sequential read.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_read_random(
+	     handle,
+	     compression,
+	     media_size,
+	     chunk_size,
+	     number_of_random_reads,
+	     seed,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to benchmark random read.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_read_chunks(
+	     handle,
+	     compression,
+	     media_size,
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to benchmark chunk read.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Copies a decimal option value into a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_copy_option(
+     const libcstring_system_character_t *option,
+     uint64_t maximum_value,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_copy_option";
+	size_t string_length  = 0;
+
+	string_length = libcstring_system_string_length(
+	                 option );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     option,
+	     string_length + 1,
+	     value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy option value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value > maximum_value )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: option value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t *option_compression_level    = NULL;
+	libcstring_system_character_t *option_maximum_segment_size = NULL;
+	libcstring_system_character_t *option_media_size           = NULL;
+	libcstring_system_character_t *option_number_of_reads      = NULL;
+	libcstring_system_character_t *option_number_of_threads    = NULL;
+	libcstring_system_character_t *option_random_percentage    = NULL;
+	libcstring_system_character_t *option_sectors_per_chunk    = NULL;
+	libcstring_system_character_t *option_seed                 = NULL;
+	libcstring_system_character_t *option_zero_percentage      = NULL;
+	libcerror_error_t *error                                   = NULL;
+	const char *compression                                    = "none";
+	libcstring_system_integer_t option                         = 0;
+	uint64_t maximum_segment_size                              = 0;
+	uint64_t media_size                                        = 64 * 1024 * 1024;
+	uint64_t number_of_random_reads                            = 4096;
+	uint64_t number_of_threads                                 = 0;
+	uint64_t random_percentage                                 = 30;
+	uint64_t sectors_per_chunk                                 = 64;
+	uint64_t seed                                              = 1;
+	uint64_t zero_percentage                                   = 10;
+	uint8_t compression_flags                                  = 0;
+	uint8_t print_header                                       = 0;
+	int8_t compression_level                                   = LIBEWF_COMPRESSION_NONE;
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _LIBCSTRING_SYSTEM_STRING( "b:B:c:hHn:r:s:S:t:Tz:" ) ) ) != (libcstring_system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (libcstring_system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (libcstring_system_integer_t) 'b':
+				option_sectors_per_chunk = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'B':
+				option_media_size = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'c':
+				option_compression_level = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'h':
+				ewf_bench_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (libcstring_system_integer_t) 'H':
+				print_header = 1;
+
+				break;
+
+			case (libcstring_system_integer_t) 'n':
+				option_number_of_reads = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'r':
+				option_random_percentage = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'S':
+				option_maximum_segment_size = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'T':
+				fprintf(
+				 stdout,
+				 "%" PRIu64 "\n",
+				 ewf_bench_get_time() );
+
+				return( EXIT_SUCCESS );
+
+			case (libcstring_system_integer_t) 'z':
+				option_zero_percentage = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing EWF image basename.\n" );
+
+		ewf_bench_usage_fprint(
+		 stderr );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_compression_level != NULL )
+	{
+		if( libcstring_system_string_length(
+		     option_compression_level ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression level.\n" );
+
+			goto on_error;
+		}
+		if( option_compression_level[ 0 ] == (libcstring_system_character_t) 'n' )
+		{
+			compression       = "none";
+			compression_level = LIBEWF_COMPRESSION_NONE;
+			compression_flags = 0;
+		}
+		else if( option_compression_level[ 0 ] == (libcstring_system_character_t) 'e' )
+		{
+			compression       = "empty-block";
+			compression_level = LIBEWF_COMPRESSION_NONE;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+		}
+		else if( option_compression_level[ 0 ] == (libcstring_system_character_t) 'f' )
+		{
+			compression       = "fast";
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = 0;
+		}
+		else if( option_compression_level[ 0 ] == (libcstring_system_character_t) 'b' )
+		{
+			compression       = "best";
+			compression_level = LIBEWF_COMPRESSION_BEST;
+			compression_flags = 0;
+		}
+		else if( option_compression_level[ 0 ] == (libcstring_system_character_t) 'a' )
+		{
+			compression       = "adaptive";
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression level.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_maximum_segment_size != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_maximum_segment_size,
+		     (uint64_t) INT64_MAX,
+		     &maximum_segment_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum segment size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_media_size != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_media_size,
+		     (uint64_t) INT64_MAX,
+		     &media_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported media size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ( media_size == 0 )
+	 || ( ( media_size % 512 ) != 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported media size, it should be a non-zero multitude of 512.\n" );
+
+		goto on_error;
+	}
+	if( option_number_of_reads != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_number_of_reads,
+		     (uint64_t) UINT32_MAX,
+		     &number_of_random_reads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of random reads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_number_of_threads,
+		     (uint64_t) INT_MAX,
+		     &number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_random_percentage != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_random_percentage,
+		     100,
+		     &random_percentage,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported random percentage.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_sectors_per_chunk != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_sectors_per_chunk,
+		     (uint64_t) ( INT32_MAX / 512 ),
+		     &sectors_per_chunk,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sectors per chunk.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_seed,
+		     (uint64_t) UINT32_MAX,
+		     &seed,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed.\n" );
+
+			goto on_error;
+		}
+	}
+	/* A xorshift generator does not leave the state 0
+	 */
+	if( seed == 0 )
+	{
+		seed = 1;
+	}
+	if( option_zero_percentage != NULL )
+	{
+		if( ewf_bench_copy_option(
+		     option_zero_percentage,
+		     100,
+		     &zero_percentage,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported zero percentage.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ( zero_percentage + random_percentage ) > 100 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported zero and random percentage, their sum exceeds 100.\n" );
+
+		goto on_error;
+	}
+	if( print_header != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "benchmark\tcompression\tmedia_size\tchunk_size\tbytes\toperations\tnanoseconds\tmib_per_second\n" );
+	}
+	if( ewf_bench_write(
+	     argv[ optind ],
+	     compression,
+	     (size64_t) media_size,
+	     (uint32_t) sectors_per_chunk,
+	     (size64_t) maximum_segment_size,
+	     compression_level,
+	     compression_flags,
+	     (int) number_of_threads,
+	     (uint8_t) zero_percentage,
+	     (uint8_t) random_percentage,
+	     (uint32_t) seed,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to benchmark write.\n" );
+
+		goto on_error;
+	}
+	if( ewf_bench_read(
+	     argv[ optind ],
+	     compression,
+	     number_of_random_reads,
+	     (uint32_t) seed,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to benchmark read.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,188 @@
+#!/bin/bash
+#
+# Expert Witness Compression Format (EWF) library benchmark script
+#
+# Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this software.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Writes a synthetic image for every compression level, measures the read
+# and write paths of the library with ewf_bench and ewfverify and ewfexport
+# end-to-end. The results are printed as tab separated lines, see
+# ewf_bench -h for a description of the columns.
+#
+# The options are passed as environment variables:
+#   BENCH_MEDIA_SIZE          the media size in bytes, default is 67108864
+#   BENCH_SECTORS_PER_CHUNK   the number of sectors per chunk, default is 64
+#   BENCH_SEGMENT_SIZE        the maximum segment size in bytes, default is the library default
+#   BENCH_ZERO_PERCENTAGE     the percentage of chunks with 0-byte values, default is 10
+#   BENCH_RANDOM_PERCENTAGE   the percentage of chunks with random data, default is 30
+#   BENCH_COMPRESSION_LEVELS  the compression levels, default is "n e f b a"
+#   BENCH_SEED                the seed of the pseudo random data, default is 1
+#   BENCH_THREADS             the number of compression threads, default is 0
+#   BENCH_TMP                 the directory the images are written to, default is bench_tmp
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+
+BENCH_MEDIA_SIZE=${BENCH_MEDIA_SIZE:-67108864};
+BENCH_SECTORS_PER_CHUNK=${BENCH_SECTORS_PER_CHUNK:-64};
+BENCH_SEGMENT_SIZE=${BENCH_SEGMENT_SIZE:-0};
+BENCH_ZERO_PERCENTAGE=${BENCH_ZERO_PERCENTAGE:-10};
+BENCH_RANDOM_PERCENTAGE=${BENCH_RANDOM_PERCENTAGE:-30};
+BENCH_COMPRESSION_LEVELS=${BENCH_COMPRESSION_LEVELS:-"n e f b a"};
+BENCH_SEED=${BENCH_SEED:-1};
+BENCH_THREADS=${BENCH_THREADS:-0};
+BENCH_TMP=${BENCH_TMP:-bench_tmp};
+
+# Retrieves the current time in nanoseconds using the clock of ewf_bench,
+# date +%s%N is not portable, the fallback date +%s has a resolution of seconds
+get_time()
+{
+	TIME=`${EWF_BENCH} -T`;
+
+	if test -z "${TIME}" || test "${TIME}" = "0";
+	then
+		TIME=`date +%s`;
+		TIME=`expr ${TIME} \* 1000000000`;
+	fi
+	echo ${TIME};
+}
+
+bench_tool()
+{
+	BENCHMARK=$1;
+	COMPRESSION=$2;
+	CHUNK_SIZE=$3;
+	shift 3;
+
+	START_TIME=`get_time`;
+
+	"$@" > /dev/null 2>&1;
+
+	RESULT=$?;
+
+	END_TIME=`get_time`;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to run: $*" >&2;
+
+		return ${RESULT};
+	fi
+	ELAPSED_TIME=`expr ${END_TIME} - ${START_TIME}`;
+
+	MIB_PER_SECOND=`awk "BEGIN { if( ${ELAPSED_TIME} > 0 ) { printf \"%.2f\", ( ${BENCH_MEDIA_SIZE} / 1048576 ) / ( ${ELAPSED_TIME} / 1000000000 ); } else { printf \"0.00\"; } }"`;
+
+	printf "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n" ${BENCHMARK} ${COMPRESSION} ${BENCH_MEDIA_SIZE} ${CHUNK_SIZE} ${BENCH_MEDIA_SIZE} 1 ${ELAPSED_TIME} ${MIB_PER_SECOND};
+
+	return ${EXIT_SUCCESS};
+}
+
+EWF_BENCH="./ewf_bench";
+
+if ! test -x ${EWF_BENCH};
+then
+	EWF_BENCH="./ewf_bench.exe";
+fi
+
+if ! test -x ${EWF_BENCH};
+then
+	echo "Missing executable: ${EWF_BENCH}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+EWFVERIFY="../ewftools/ewfverify";
+
+if ! test -x ${EWFVERIFY};
+then
+	EWFVERIFY="../ewftools/ewfverify.exe";
+fi
+
+EWFEXPORT="../ewftools/ewfexport";
+
+if ! test -x ${EWFEXPORT};
+then
+	EWFEXPORT="../ewftools/ewfexport.exe";
+fi
+
+CHUNK_SIZE=`expr ${BENCH_SECTORS_PER_CHUNK} \* 512`;
+HEADER="-H";
+
+rm -rf ${BENCH_TMP};
+mkdir ${BENCH_TMP};
+
+for LEVEL in ${BENCH_COMPRESSION_LEVELS};
+do
+	case ${LEVEL} in
+	n)	COMPRESSION="none";;
+	e)	COMPRESSION="empty-block";;
+	f)	COMPRESSION="fast";;
+	b)	COMPRESSION="best";;
+	a)	COMPRESSION="adaptive";;
+	*)
+		echo "Unsupported compression level: ${LEVEL}";
+
+		rm -rf ${BENCH_TMP};
+
+		exit ${EXIT_FAILURE};;
+	esac
+
+	if ! ${EWF_BENCH} ${HEADER} \
+	 -B ${BENCH_MEDIA_SIZE} \
+	 -b ${BENCH_SECTORS_PER_CHUNK} \
+	 -c ${LEVEL} \
+	 -r ${BENCH_RANDOM_PERCENTAGE} \
+	 -s ${BENCH_SEED} \
+	 -S ${BENCH_SEGMENT_SIZE} \
+	 -t ${BENCH_THREADS} \
+	 -z ${BENCH_ZERO_PERCENTAGE} \
+	 ${BENCH_TMP}/bench_${LEVEL};
+	then
+		rm -rf ${BENCH_TMP};
+
+		exit ${EXIT_FAILURE};
+	fi
+	HEADER="";
+
+	if test -x ${EWFVERIFY};
+	then
+		if ! bench_tool "ewfverify" ${COMPRESSION} ${CHUNK_SIZE} \
+		 ${EWFVERIFY} -q -d sha1 ${BENCH_TMP}/bench_${LEVEL}.E01;
+		then
+			rm -rf ${BENCH_TMP};
+
+			exit ${EXIT_FAILURE};
+		fi
+	fi
+	if test -x ${EWFEXPORT};
+	then
+		if ! bench_tool "ewfexport" ${COMPRESSION} ${CHUNK_SIZE} \
+		 ${EWFEXPORT} -q -u -f raw -t ${BENCH_TMP}/export_${LEVEL} ${BENCH_TMP}/bench_${LEVEL}.E01;
+		then
+			rm -rf ${BENCH_TMP};
+
+			exit ${EXIT_FAILURE};
+		fi
+	fi
+	rm -f ${BENCH_TMP}/bench_${LEVEL}.* ${BENCH_TMP}/export_${LEVEL}*;
+done
+
+rm -rf ${BENCH_TMP};
+
+exit ${EXIT_SUCCESS};
+
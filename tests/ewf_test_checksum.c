@@ -0,0 +1,355 @@
+/*
+ * Expert Witness Compression Format (EWF) library checksum testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+#include <time.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_test_libcstring.h"
+
+#include "../libewf/libewf_checksum.h"
+
+#define EWF_TEST_CHECKSUM_BUFFER_SIZE	( 256 * 1024 )
+
+/* The chunk size used by the benchmark, the default EWF chunk size
+ */
+#define EWF_TEST_CHECKSUM_CHUNK_SIZE	( 32 * 1024 )
+
+typedef uint32_t (*ewf_test_checksum_function_t)(
+                   const uint8_t *buffer,
+                   size_t size,
+                   uint32_t initial_value );
+
+typedef struct ewf_test_checksum_implementation ewf_test_checksum_implementation_t;
+
+struct ewf_test_checksum_implementation
+{
+	/* The name
+	 */
+	const char *name;
+
+	/* The function
+	 */
+	ewf_test_checksum_function_t function;
+};
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+
+/* Calculates the Adler-32 of the buffer using zlib
+ * Returns the checksum
+ */
+uint32_t ewf_test_checksum_calculate_adler32_zlib(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	return( (uint32_t) adler32(
+	                    (uLong) initial_value,
+	                    (const Bytef *) buffer,
+	                    (uInt) size ) );
+}
+
+#endif /* defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+/* Retrieves the implementations supported by the CPU
+ * Returns the number of implementations
+ */
+int ewf_test_checksum_get_implementations(
+     ewf_test_checksum_implementation_t *implementations )
+{
+	int number_of_implementations = 0;
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	implementations[ number_of_implementations ].name     = "zlib";
+	implementations[ number_of_implementations ].function = &ewf_test_checksum_calculate_adler32_zlib;
+
+	number_of_implementations++;
+#endif
+	implementations[ number_of_implementations ].name     = "generic";
+	implementations[ number_of_implementations ].function = &libewf_checksum_calculate_adler32_generic;
+
+	number_of_implementations++;
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		implementations[ number_of_implementations ].name     = "ssse3";
+		implementations[ number_of_implementations ].function = &libewf_checksum_calculate_adler32_ssse3;
+
+		number_of_implementations++;
+	}
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		implementations[ number_of_implementations ].name     = "avx2";
+		implementations[ number_of_implementations ].function = &libewf_checksum_calculate_adler32_avx2;
+
+		number_of_implementations++;
+	}
+#endif
+	implementations[ number_of_implementations ].name     = "selected";
+	implementations[ number_of_implementations ].function = &libewf_checksum_calculate_adler32;
+
+	number_of_implementations++;
+
+	return( number_of_implementations );
+}
+
+/* Tests if the implementations calculate the same checksum
+ * for various sizes, buffer alignments and initial values
+ * Return 1 if successful, 0 if not
+ */
+int ewf_test_checksum_compare(
+     const uint8_t *buffer,
+     ewf_test_checksum_implementation_t *implementations,
+     int number_of_implementations )
+{
+	size_t sizes[]              = { 5551, 5552, 5553, 11104, 11105, 32768, 65536, EWF_TEST_CHECKSUM_BUFFER_SIZE - 3 };
+	uint32_t initial_values[]   = { 1, 0, 0xfff0fff0UL, 0x12345678UL };
+	size_t size                 = 0;
+	uint32_t expected_checksum  = 0;
+	uint32_t checksum           = 0;
+	int alignment               = 0;
+	int implementation_index    = 0;
+	int initial_value_index     = 0;
+	int size_index              = 0;
+
+	/* Test all sizes up to 2 blocks of 32 bytes and a set of larger sizes
+	 */
+	for( size_index = 0;
+	     size_index < 65 + (int) ( sizeof( sizes ) / sizeof( size_t ) );
+	     size_index++ )
+	{
+		if( size_index < 65 )
+		{
+			size = (size_t) size_index;
+		}
+		else
+		{
+			size = sizes[ size_index - 65 ];
+		}
+		for( alignment = 0;
+		     alignment < 4;
+		     alignment++ )
+		{
+			for( initial_value_index = 0;
+			     initial_value_index < (int) ( sizeof( initial_values ) / sizeof( uint32_t ) );
+			     initial_value_index++ )
+			{
+				expected_checksum = implementations[ 0 ].function(
+				                     &( buffer[ alignment ] ),
+				                     size,
+				                     initial_values[ initial_value_index ] );
+
+				for( implementation_index = 1;
+				     implementation_index < number_of_implementations;
+				     implementation_index++ )
+				{
+					checksum = implementations[ implementation_index ].function(
+					            &( buffer[ alignment ] ),
+					            size,
+					            initial_values[ initial_value_index ] );
+
+					if( checksum != expected_checksum )
+					{
+						fprintf(
+						 stderr,
+						 "%s: checksum: 0x%08" PRIx32 " does not match %s: 0x%08" PRIx32 " for size: %" PRIzd ", alignment: %d and initial value: 0x%08" PRIx32 ".\n",
+						 implementations[ implementation_index ].name,
+						 checksum,
+						 implementations[ 0 ].name,
+						 expected_checksum,
+						 size,
+						 alignment,
+						 initial_values[ initial_value_index ] );
+
+						return( 0 );
+					}
+				}
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Measures the throughput of the implementations using chunk sized buffers
+ */
+void ewf_test_checksum_benchmark(
+      const uint8_t *buffer,
+      ewf_test_checksum_implementation_t *implementations,
+      int number_of_implementations,
+      size64_t benchmark_size )
+{
+	clock_t start_time       = 0;
+	double elapsed_time      = 0.0;
+	size64_t processed_size  = 0;
+	size_t buffer_offset     = 0;
+	uint32_t checksum        = 0;
+	int implementation_index = 0;
+
+	for( implementation_index = 0;
+	     implementation_index < number_of_implementations;
+	     implementation_index++ )
+	{
+		processed_size = 0;
+		buffer_offset  = 0;
+		start_time     = clock();
+
+		while( processed_size < benchmark_size )
+		{
+			checksum += implementations[ implementation_index ].function(
+			             &( buffer[ buffer_offset ] ),
+			             EWF_TEST_CHECKSUM_CHUNK_SIZE,
+			             1 );
+
+			buffer_offset += EWF_TEST_CHECKSUM_CHUNK_SIZE;
+
+			if( buffer_offset >= EWF_TEST_CHECKSUM_BUFFER_SIZE )
+			{
+				buffer_offset = 0;
+			}
+			processed_size += EWF_TEST_CHECKSUM_CHUNK_SIZE;
+		}
+		elapsed_time = (double) ( clock() - start_time ) / CLOCKS_PER_SEC;
+
+		if( elapsed_time <= 0.0 )
+		{
+			elapsed_time = 1.0 / CLOCKS_PER_SEC;
+		}
+		fprintf(
+		 stdout,
+		 "%-10s %10.1f MiB/s\n",
+		 implementations[ implementation_index ].name,
+		 ( (double) processed_size / ( 1024.0 * 1024.0 ) ) / elapsed_time );
+	}
+	/* Print the combined checksum so the calculations cannot be optimized away
+	 */
+	fprintf(
+	 stdout,
+	 "combined checksum: 0x%08" PRIx32 "\n",
+	 checksum );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	ewf_test_checksum_implementation_t implementations[ 5 ];
+
+	uint8_t *buffer               = NULL;
+	size_t buffer_index           = 0;
+	uint32_t random_value         = 0x5eed1e55UL;
+	int number_of_implementations = 0;
+	int result                    = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EWF_TEST_CHECKSUM_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* The first part of the buffer contains the largest byte values
+	 * to test the limits of the intermediate sums
+	 */
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_CHECKSUM_BUFFER_SIZE;
+	     buffer_index++ )
+	{
+		if( buffer_index < ( 3 * 5552 ) )
+		{
+			buffer[ buffer_index ] = 0xff;
+		}
+		else
+		{
+			random_value = ( random_value * 1103515245UL ) + 12345;
+
+			buffer[ buffer_index ] = (uint8_t) ( random_value >> 16 );
+		}
+	}
+	number_of_implementations = ewf_test_checksum_get_implementations(
+	                             implementations );
+
+	result = ewf_test_checksum_compare(
+	          buffer,
+	          implementations,
+	          number_of_implementations );
+
+	fprintf(
+	 stdout,
+	 "Testing Adler-32 implementations against %s ",
+	 implementations[ 0 ].name );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	if( ( result == 1 )
+	 && ( argc > 1 ) )
+	{
+		if( ( argv[ 1 ][ 0 ] == (libcstring_system_character_t) '-' )
+		 && ( argv[ 1 ][ 1 ] == (libcstring_system_character_t) 'b' ) )
+		{
+			ewf_test_checksum_benchmark(
+			 buffer,
+			 implementations,
+			 number_of_implementations,
+			 (size64_t) 1024 * 1024 * 1024 );
+		}
+	}
+	memory_free(
+	 buffer );
+
+	if( result != 1 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+}
+
@@ -0,0 +1,1476 @@
+/*
+ * Expert Witness Compression Format (EWF) library compression backend testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+#include <time.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+
+/* The size of the generated media data
+ */
+#define EWF_TEST_COMPRESSION_MEDIA_SIZE		( 8 * 1024 * 1024 )
+
+/* The size of the blocks of the generated media data
+ */
+#define EWF_TEST_COMPRESSION_BLOCK_SIZE		( 32 * 1024 )
+
+/* The size of the read and write buffer
+ */
+#define EWF_TEST_COMPRESSION_BUFFER_SIZE	( 64 * 1024 )
+
+typedef struct ewf_test_compression_backend ewf_test_compression_backend_t;
+
+struct ewf_test_compression_backend
+{
+	/* The name
+	 */
+	const char *name;
+
+	/* The compression backend
+	 */
+	int backend;
+};
+
+ewf_test_compression_backend_t ewf_test_compression_backends[ 2 ] = {
+	{ "zlib", LIBEWF_COMPRESSION_BACKEND_ZLIB },
+	{ "libdeflate", LIBEWF_COMPRESSION_BACKEND_LIBDEFLATE } };
+
+/* Returns the number of seconds elapsed since the start time
+ */
+double ewf_test_compression_get_elapsed_time(
+        clock_t start_time )
+{
+	double elapsed_time = (double) ( clock() - start_time ) / CLOCKS_PER_SEC;
+
+	if( elapsed_time <= 0.0 )
+	{
+		elapsed_time = 1.0 / CLOCKS_PER_SEC;
+	}
+	return( elapsed_time );
+}
+
+/* Generates media data that consists of blocks of text, random, empty
+ * and repeating data to get a mix of compression ratios
+ */
+void ewf_test_compression_generate_media_data(
+      uint8_t *media_data,
+      size_t media_size )
+{
+	const char *words[ 8 ] = {
+		"evidence ", "sector ", "the ", "acquired ", "image ", "of ", "a ", "device\n" };
+
+	const char *word       = NULL;
+	size_t block_offset    = 0;
+	size_t media_offset    = 0;
+	uint32_t random_value  = 0x5eed1e55UL;
+	int block_index        = 0;
+
+	while( media_offset < media_size )
+	{
+		for( block_offset = 0;
+		     ( block_offset < EWF_TEST_COMPRESSION_BLOCK_SIZE )
+		  && ( media_offset < media_size );
+		     block_offset++ )
+		{
+			random_value = ( random_value * 1103515245UL ) + 12345;
+
+			switch( block_index % 4 )
+			{
+				case 0:
+					if( ( word == NULL )
+					 || ( *word == 0 ) )
+					{
+						word = words[ ( random_value >> 16 ) % 8 ];
+					}
+					media_data[ media_offset ] = (uint8_t) *word;
+
+					word++;
+
+					break;
+
+				case 1:
+					media_data[ media_offset ] = (uint8_t) ( random_value >> 16 );
+
+					break;
+
+				case 2:
+					media_data[ media_offset ] = 0;
+
+					break;
+
+				case 3:
+					media_data[ media_offset ] = (uint8_t) ( block_offset % 251 );
+
+					break;
+			}
+			media_offset++;
+		}
+		block_index++;
+	}
+}
+
+/* Reads the media data of an EWF image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_compression_read_source(
+     const libcstring_system_character_t *filename,
+     uint8_t **media_data,
+     size_t *media_size,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	char **filenames        = NULL;
+	static char *function   = "ewf_test_compression_read_source";
+	size64_t safe_size      = 0;
+	ssize_t read_count      = 0;
+	int number_of_filenames = 0;
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     filename,
+	     libcstring_wide_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     (wchar_t ***) &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     filename,
+	     libcstring_narrow_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob filenames.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &safe_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( safe_size == 0 )
+	 || ( safe_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	*media_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * (size_t) safe_size );
+
+	if( *media_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create media data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              *media_data,
+	              (size_t) safe_size,
+	              error );
+
+	if( read_count != (ssize_t) safe_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read media data.",
+		 function );
+
+		goto on_error;
+	}
+	*media_size = (size_t) safe_size;
+
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     (wchar_t **) filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( *media_data != NULL )
+	{
+		memory_free(
+		 *media_data );
+
+		*media_data = NULL;
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 (wchar_t **) filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Writes the media data to an EWF image
+ * The image is written as a single segment file
+ * The zlib compression level is 0 if not set or -1 to change the zlib compression values,
+ * the level (1 to 9), strategy, window bits and memory level, after every buffer written
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_compression_write(
+     const libcstring_system_character_t *filename,
+     const uint8_t *media_data,
+     size_t media_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     int zlib_compression_level,
+     uint64_t *number_of_chunks_compression_skipped,
+     libcerror_error_t **error )
+{
+	uint64_t statistics[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_compression_write";
+	size_t media_offset     = 0;
+	size_t write_size       = 0;
+	ssize_t write_count     = 0;
+	int buffer_index        = 0;
+
+	if( number_of_chunks_compression_skipped == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks compression skipped.",
+		 function );
+
+		return( -1 );
+	}
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_maximum_segment_size(
+	     handle,
+	     (size64_t) media_size * 2,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set maximum segment size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	while( media_offset < media_size )
+	{
+		write_size = media_size - media_offset;
+
+		if( write_size > EWF_TEST_COMPRESSION_BUFFER_SIZE )
+		{
+			write_size = EWF_TEST_COMPRESSION_BUFFER_SIZE;
+		}
+		if( zlib_compression_level == -1 )
+		{
+			if( libewf_handle_set_zlib_compression_values(
+			     handle,
+			     1 + ( buffer_index % 9 ),
+			     buffer_index % 5,
+			     9 + ( buffer_index % 7 ),
+			     1 + ( buffer_index % 9 ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set zlib compression values.",
+				 function );
+
+				goto on_error;
+			}
+			buffer_index++;
+		}
+		else if( zlib_compression_level != 0 )
+		{
+			if( libewf_handle_set_zlib_compression_level(
+			     handle,
+			     zlib_compression_level,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set zlib compression level.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		write_count = libewf_handle_write_buffer(
+			       handle,
+			       &( media_data[ media_offset ] ),
+			       write_size,
+			       error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable write buffer of size: %" PRIzd ".",
+			 function,
+			 write_size );
+
+			goto on_error;
+		}
+		media_offset += write_size;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_statistics(
+	     handle,
+	     statistics,
+	     LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every chunk written is counted once by how it was stored
+	 */
+	if( ( statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSED ]
+	    + statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_UNCOMPRESSED ]
+	    + statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSION_SKIPPED ] ) != statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_WRITTEN ] )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid statistics - number of chunks stored mismatch.",
+		 function );
+
+		goto on_error;
+	}
+	*number_of_chunks_compression_skipped = statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_COMPRESSION_SKIPPED ];
+
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the media data of an EWF image and compares it with the expected media data
+ * Returns 1 if the media data matches, 0 if not or -1 on error
+ */
+int ewf_test_compression_read(
+     const libcstring_system_character_t *filename,
+     const uint8_t *media_data,
+     size_t media_size,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_COMPRESSION_BUFFER_SIZE ];
+
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_compression_read";
+	size_t media_offset     = 0;
+	size_t read_size        = 0;
+	ssize_t read_count      = 0;
+	int result              = 1;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	while( media_offset < media_size )
+	{
+		read_size = media_size - media_offset;
+
+		if( read_size > EWF_TEST_COMPRESSION_BUFFER_SIZE )
+		{
+			read_size = EWF_TEST_COMPRESSION_BUFFER_SIZE;
+		}
+		read_count = libewf_handle_read_buffer(
+			      handle,
+			      buffer,
+			      read_size,
+			      error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable read buffer of size: %" PRIzd ".",
+			 function,
+			 read_size );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     buffer,
+		     &( media_data[ media_offset ] ),
+		     read_size ) != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		media_offset += read_size;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size of the segment file of a written EWF image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_compression_get_file_size(
+     const libcstring_system_character_t *filename,
+     size64_t *file_size,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file = NULL;
+	static char *function = "ewf_test_compression_get_file_size";
+
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_close(
+		 file,
+		 NULL );
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests if every available compression backend can read the images written by
+ * every available compression backend and optionally measures the throughput
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_compression(
+     const libcstring_system_character_t *target,
+     const uint8_t *media_data,
+     size_t media_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     int zlib_compression_level,
+     int benchmark,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t *filename = NULL;
+	static char *function                   = "ewf_test_compression";
+	clock_t start_time                      = 0;
+	size64_t file_size                      = 0;
+	uint64_t number_of_chunks_skipped       = 0;
+	size_t filename_size                    = 0;
+	size_t target_length                    = 0;
+	double media_size_in_mib                = 0.0;
+	int number_of_backends                  = 0;
+	int read_backend_index                  = 0;
+	int result                              = 0;
+	int write_backend_index                 = 0;
+
+	/* Determine the backends the library was built with
+	 */
+	for( write_backend_index = 0;
+	     write_backend_index < 2;
+	     write_backend_index++ )
+	{
+		if( libewf_set_compression_backend(
+		     ewf_test_compression_backends[ write_backend_index ].backend,
+		     NULL ) != 1 )
+		{
+			break;
+		}
+		number_of_backends++;
+	}
+	target_length = libcstring_system_string_length(
+	                 target );
+
+	/* The filename is the target followed by .E01 and the end of string character
+	 */
+	filename_size = target_length + 5;
+
+	filename = libcstring_system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     filename,
+	     target,
+	     target_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target to filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     &( filename[ target_length ] ),
+	     _LIBCSTRING_SYSTEM_STRING( ".E01" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension to filename.",
+		 function );
+
+		goto on_error;
+	}
+	filename[ filename_size - 1 ] = 0;
+
+	media_size_in_mib = (double) media_size / ( 1024.0 * 1024.0 );
+
+	for( write_backend_index = 0;
+	     write_backend_index < number_of_backends;
+	     write_backend_index++ )
+	{
+		if( libewf_set_compression_backend(
+		     ewf_test_compression_backends[ write_backend_index ].backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression backend.",
+			 function );
+
+			goto on_error;
+		}
+		start_time = clock();
+
+		if( ewf_test_compression_write(
+		     target,
+		     media_data,
+		     media_size,
+		     compression_level,
+		     compression_flags,
+		     zlib_compression_level,
+		     &number_of_chunks_skipped,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write image using backend: %s.",
+			 function,
+			 ewf_test_compression_backends[ write_backend_index ].name );
+
+			goto on_error;
+		}
+		if( benchmark != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "write %-10s %10.1f MiB/s",
+			 ewf_test_compression_backends[ write_backend_index ].name,
+			 media_size_in_mib / ewf_test_compression_get_elapsed_time(
+			                      start_time ) );
+
+			if( ewf_test_compression_get_file_size(
+			     filename,
+			     &file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve image size.",
+				 function );
+
+				goto on_error;
+			}
+			fprintf(
+			 stdout,
+			 " ratio: %.3f",
+			 (double) file_size / (double) media_size );
+
+			if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+			{
+				fprintf(
+				 stdout,
+				 " skipped: %" PRIu64 "",
+				 number_of_chunks_skipped );
+			}
+			fprintf(
+			 stdout,
+			 "\n" );
+		}
+		for( read_backend_index = 0;
+		     read_backend_index < number_of_backends;
+		     read_backend_index++ )
+		{
+			if( libewf_set_compression_backend(
+			     ewf_test_compression_backends[ read_backend_index ].backend,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set compression backend.",
+				 function );
+
+				goto on_error;
+			}
+			start_time = clock();
+
+			result = ewf_test_compression_read(
+			          filename,
+			          media_data,
+			          media_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read image using backend: %s.",
+				 function,
+				 ewf_test_compression_backends[ read_backend_index ].name );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stderr,
+				 "%s: media data written by: %s does not match when read by: %s.\n",
+				 function,
+				 ewf_test_compression_backends[ write_backend_index ].name,
+				 ewf_test_compression_backends[ read_backend_index ].name );
+
+				break;
+			}
+			if( benchmark != 0 )
+			{
+				fprintf(
+				 stdout,
+				 "  read %-10s %10.1f MiB/s\n",
+				 ewf_test_compression_backends[ read_backend_index ].name,
+				 media_size_in_mib / ewf_test_compression_get_elapsed_time(
+				                      start_time ) );
+			}
+		}
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 filename );
+
+	return( result );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+/* Tests if every available compression backend compresses at the requested zlib compression level
+ * by writing an image at zlib compression level 3 and 9 back-to-back and comparing the image sizes
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_compression_levels(
+     const libcstring_system_character_t *target,
+     const uint8_t *media_data,
+     size_t media_size,
+     libcerror_error_t **error )
+{
+	size64_t file_sizes[ 2 ];
+	int zlib_compression_levels[ 2 ] = { 3, 9 };
+
+	libcstring_system_character_t *filename = NULL;
+	static char *function                   = "ewf_test_compression_levels";
+	uint64_t number_of_chunks_skipped       = 0;
+	size_t filename_size                    = 0;
+	size_t target_length                    = 0;
+	int backend_index                       = 0;
+	int level_index                         = 0;
+	int result                              = 1;
+
+	target_length = libcstring_system_string_length(
+	                 target );
+
+	/* The filename is the target followed by .E01 and the end of string character
+	 */
+	filename_size = target_length + 5;
+
+	filename = libcstring_system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     filename,
+	     target,
+	     target_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target to filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     &( filename[ target_length ] ),
+	     _LIBCSTRING_SYSTEM_STRING( ".E01" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension to filename.",
+		 function );
+
+		goto on_error;
+	}
+	filename[ filename_size - 1 ] = 0;
+
+	for( backend_index = 0;
+	     backend_index < 2;
+	     backend_index++ )
+	{
+		if( libewf_set_compression_backend(
+		     ewf_test_compression_backends[ backend_index ].backend,
+		     NULL ) != 1 )
+		{
+			break;
+		}
+		for( level_index = 0;
+		     level_index < 2;
+		     level_index++ )
+		{
+			if( ewf_test_compression_write(
+			     target,
+			     media_data,
+			     media_size,
+			     LIBEWF_COMPRESSION_BEST,
+			     0,
+			     zlib_compression_levels[ level_index ],
+			     &number_of_chunks_skipped,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write image at zlib compression level: %d using backend: %s.",
+				 function,
+				 zlib_compression_levels[ level_index ],
+				 ewf_test_compression_backends[ backend_index ].name );
+
+				goto on_error;
+			}
+			if( ewf_test_compression_get_file_size(
+			     filename,
+			     &( file_sizes[ level_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve image size.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( file_sizes[ 0 ] == file_sizes[ 1 ] )
+		{
+			fprintf(
+			 stderr,
+			 "%s: image size at zlib compression level: %d and %d is the same: %" PRIu64 " using backend: %s.\n",
+			 function,
+			 zlib_compression_levels[ 0 ],
+			 zlib_compression_levels[ 1 ],
+			 file_sizes[ 0 ],
+			 ewf_test_compression_backends[ backend_index ].name );
+
+			result = 0;
+
+			break;
+		}
+	}
+	memory_free(
+	 filename );
+
+	return( result );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t *option_source = NULL;
+	libcerror_error_t *error                      = NULL;
+	uint8_t *media_data                           = NULL;
+	libcstring_system_integer_t option           = 0;
+	size_t media_size                             = 0;
+	int benchmark                                 = 0;
+	int result                                    = 0;
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _LIBCSTRING_SYSTEM_STRING( "bs:" ) ) ) != (libcstring_system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (libcstring_system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (libcstring_system_integer_t) 'b':
+				benchmark = 1;
+
+				break;
+
+			case (libcstring_system_integer_t) 's':
+				option_source = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing EWF image filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_source != NULL )
+	{
+		if( ewf_test_compression_read_source(
+		     option_source,
+		     &media_data,
+		     &media_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read source image.\n" );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		media_size = EWF_TEST_COMPRESSION_MEDIA_SIZE;
+
+		media_data = (uint8_t *) memory_allocate(
+		                          sizeof( uint8_t ) * media_size );
+
+		if( media_data == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create media data.\n" );
+
+			goto on_error;
+		}
+		ewf_test_compression_generate_media_data(
+		 media_data,
+		 media_size );
+	}
+	if( benchmark != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Fast compression:\n" );
+	}
+	result = ewf_test_compression(
+	          argv[ optind ],
+	          media_data,
+	          media_size,
+	          LIBEWF_COMPRESSION_FAST,
+	          0,
+	          0,
+	          benchmark,
+	          &error );
+
+	if( result == 1 )
+	{
+		if( benchmark != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Best compression:\n" );
+		}
+		result = ewf_test_compression(
+		          argv[ optind ],
+		          media_data,
+		          media_size,
+		          LIBEWF_COMPRESSION_BEST,
+		          0,
+		          0,
+		          benchmark,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		if( benchmark != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Adaptive compression:\n" );
+		}
+		result = ewf_test_compression(
+		          argv[ optind ],
+		          media_data,
+		          media_size,
+		          LIBEWF_COMPRESSION_FAST,
+		          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+		          0,
+		          benchmark,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		if( benchmark != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Zlib compression level 6:\n" );
+		}
+		result = ewf_test_compression(
+		          argv[ optind ],
+		          media_data,
+		          media_size,
+		          LIBEWF_COMPRESSION_BEST,
+		          0,
+		          6,
+		          benchmark,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		if( benchmark != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Changing zlib compression values:\n" );
+		}
+		result = ewf_test_compression(
+		          argv[ optind ],
+		          media_data,
+		          media_size,
+		          LIBEWF_COMPRESSION_FAST,
+		          0,
+		          -1,
+		          benchmark,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_compression_levels(
+		          argv[ optind ],
+		          media_data,
+		          media_size,
+		          &error );
+	}
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test compression backends.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 media_data );
+
+	if( result != 1 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,597 @@
+/*
+ * Expert Witness Compression Format (EWF) library media extents testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+
+/* The chunk size used by the test, the default EWF chunk size
+ */
+#define EWF_TEST_EXTENTS_CHUNK_SIZE		( 32 * 1024 )
+
+/* The contents of the chunks of the test media, a 0 represents a chunk
+ * that only contains 0-byte values, the last chunk is partial
+ */
+static const char ewf_test_extents_chunks[] = "A000BC0D";
+
+#define EWF_TEST_EXTENTS_NUMBER_OF_CHUNKS	8
+#define EWF_TEST_EXTENTS_LAST_CHUNK_SIZE	1536
+
+#define EWF_TEST_EXTENTS_MEDIA_SIZE		( ( ( EWF_TEST_EXTENTS_NUMBER_OF_CHUNKS - 1 ) * EWF_TEST_EXTENTS_CHUNK_SIZE ) + EWF_TEST_EXTENTS_LAST_CHUNK_SIZE )
+
+/* Fills the buffer with the data of a specific chunk of the test media
+ * Returns the size of the chunk
+ */
+size_t ewf_test_extents_get_chunk_data(
+        uint8_t *buffer,
+        int chunk_index )
+{
+	size_t chunk_size = EWF_TEST_EXTENTS_CHUNK_SIZE;
+	int fill_value    = 0;
+
+	if( chunk_index == ( EWF_TEST_EXTENTS_NUMBER_OF_CHUNKS - 1 ) )
+	{
+		chunk_size = EWF_TEST_EXTENTS_LAST_CHUNK_SIZE;
+	}
+	if( ewf_test_extents_chunks[ chunk_index ] != '0' )
+	{
+		fill_value = (int) ewf_test_extents_chunks[ chunk_index ];
+	}
+	memory_set(
+	 buffer,
+	 fill_value,
+	 chunk_size );
+
+	return( chunk_size );
+}
+
+/* Writes the test media to an EWF image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_extents_write(
+     const libcstring_system_character_t *filename,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_EXTENTS_CHUNK_SIZE ];
+
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_extents_write";
+	size_t write_size       = 0;
+	ssize_t write_count     = 0;
+	int chunk_index         = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) EWF_TEST_EXTENTS_MEDIA_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_EXTENTS_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		write_size = ewf_test_extents_get_chunk_data(
+		              buffer,
+		              chunk_index );
+
+		write_count = libewf_handle_write_buffer(
+			       handle,
+			       buffer,
+			       write_size,
+			       error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable write chunk: %d.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the media extents and the media data of the EWF image
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_extents_read(
+     const libcstring_system_character_t *filename,
+     int expect_sparse,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_EXTENTS_CHUNK_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_EXTENTS_CHUNK_SIZE ];
+
+	libewf_handle_t *handle  = NULL;
+	static char *function    = "ewf_test_extents_read";
+	off64_t expected_end     = 0;
+	off64_t expected_offset  = 0;
+	off64_t extent_offset    = 0;
+	size64_t extent_size     = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	uint32_t expected_flags  = 0;
+	uint32_t extent_flags    = 0;
+	int chunk_index          = 0;
+	int last_chunk_index     = 0;
+	int result               = 1;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( result == 1 )
+	    && ( expected_offset < (off64_t) EWF_TEST_EXTENTS_MEDIA_SIZE ) )
+	{
+		if( libewf_handle_get_media_extent(
+		     handle,
+		     expected_offset,
+		     &extent_offset,
+		     &extent_size,
+		     &extent_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve media extent at offset: %" PRIi64 ".",
+			 function,
+			 expected_offset );
+
+			goto on_error;
+		}
+		chunk_index      = (int) ( expected_offset / EWF_TEST_EXTENTS_CHUNK_SIZE );
+		last_chunk_index = EWF_TEST_EXTENTS_NUMBER_OF_CHUNKS - 1;
+		expected_flags   = 0;
+
+		if( expect_sparse != 0 )
+		{
+			if( ewf_test_extents_chunks[ chunk_index ] == '0' )
+			{
+				expected_flags = LIBEWF_EXTENT_FLAG_IS_SPARSE;
+			}
+			last_chunk_index = chunk_index;
+
+			while( ( last_chunk_index < ( EWF_TEST_EXTENTS_NUMBER_OF_CHUNKS - 1 ) )
+			    && ( ( ewf_test_extents_chunks[ last_chunk_index + 1 ] == '0' ) == ( expected_flags != 0 ) ) )
+			{
+				last_chunk_index++;
+			}
+		}
+		expected_end = (off64_t) ( last_chunk_index + 1 ) * EWF_TEST_EXTENTS_CHUNK_SIZE;
+
+		if( expected_end > (off64_t) EWF_TEST_EXTENTS_MEDIA_SIZE )
+		{
+			expected_end = (off64_t) EWF_TEST_EXTENTS_MEDIA_SIZE;
+		}
+		if( ( ( extent_flags & LIBEWF_EXTENT_FLAG_IS_SPARSE ) != expected_flags )
+		 || ( extent_offset != expected_offset )
+		 || ( extent_offset + (off64_t) extent_size != expected_end ) )
+		{
+			result = 0;
+		}
+		if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "%s: unexpected extent at offset: %" PRIi64 " of size: %" PRIu64 " and flags: 0x%08" PRIx32 ".\n",
+			 function,
+			 extent_offset,
+			 extent_size,
+			 extent_flags );
+		}
+		expected_offset = extent_offset + (off64_t) extent_size;
+	}
+	if( ( result == 1 )
+	 && ( expected_offset != (off64_t) EWF_TEST_EXTENTS_MEDIA_SIZE ) )
+	{
+		fprintf(
+		 stderr,
+		 "%s: extents do not end at media size.\n",
+		 function );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_media_extent(
+		     handle,
+		     (off64_t) EWF_TEST_EXTENTS_MEDIA_SIZE,
+		     &extent_offset,
+		     &extent_size,
+		     &extent_flags,
+		     error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "%s: extent beyond media size.\n",
+			 function );
+
+			result = 0;
+		}
+	}
+	for( chunk_index = 0;
+	     ( result == 1 ) && ( chunk_index < EWF_TEST_EXTENTS_NUMBER_OF_CHUNKS );
+	     chunk_index++ )
+	{
+		read_size = ewf_test_extents_get_chunk_data(
+		             expected_buffer,
+		             chunk_index );
+
+		read_count = libewf_handle_read_buffer(
+			      handle,
+			      buffer,
+			      read_size,
+			      error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable read chunk: %d.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     read_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "%s: mismatch in data of chunk: %d.\n",
+			 function,
+			 chunk_index );
+
+			result = 0;
+		}
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t *filename = NULL;
+	libcerror_error_t *error                 = NULL;
+	size_t filename_size                     = 0;
+	size_t string_length                     = 0;
+	uint8_t compression_flags                = LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+	int8_t compression_level                 = LIBEWF_COMPRESSION_NONE;
+	int expect_sparse                        = 1;
+	int result                               = 0;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing EWF image filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( argc > 2 )
+	{
+		if( argv[ 2 ][ 0 ] == (libcstring_system_character_t) 'f' )
+		{
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = 0;
+		}
+		else if( argv[ 2 ][ 0 ] == (libcstring_system_character_t) 'n' )
+		{
+			compression_level = LIBEWF_COMPRESSION_NONE;
+			compression_flags = 0;
+
+			/* Chunks that are stored uncompressed are not detected as sparse
+			 */
+			expect_sparse = 0;
+		}
+	}
+	if( ewf_test_extents_write(
+	     argv[ 1 ],
+	     compression_level,
+	     compression_flags,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write test image.\n" );
+
+		goto on_error;
+	}
+	/* The filename of the first segment file is the basename followed by .E01
+	 */
+	string_length = libcstring_system_string_length(
+	                 argv[ 1 ] );
+
+	filename_size = string_length + 5;
+
+	filename = libcstring_system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create filename.\n" );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     filename,
+	     argv[ 1 ],
+	     string_length ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to copy filename.\n" );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     &( filename[ string_length ] ),
+	     _LIBCSTRING_SYSTEM_STRING( ".E01" ),
+	     4 ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to copy filename.\n" );
+
+		goto on_error;
+	}
+	filename[ filename_size - 1 ] = 0;
+
+	result = ewf_test_extents_read(
+	          filename,
+	          expect_sparse,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test media extents.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	if( result != 1 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,718 @@
+/*
+ * Expert Witness Compression Format (EWF) library ltree stream testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_libbfio.h"
+#include "../libewf/libewf_ltree_stream.h"
+
+/* The lines of the synthetic ltree, the record section precedes the entry section
+ * The lines contain characters that are stored as an UTF-16 surrogate pair
+ */
+static const char *ewf_test_ltree_stream_lines[] = {
+	"5",
+	"rec",
+	"tb\tcl\tn",
+	"16384\t1\tcaf\xc3\xa9",
+	"",
+	"perm",
+	"0\t0",
+	"p\tn\ts",
+	"1\tEveryone\tS-1-1-0",
+	"",
+	"srce",
+	"0\t1",
+	"p\tn\tid\tev",
+	"0\t0\t1\t\xf0\x9f\x98\x80",
+	"",
+	"entry",
+	"0\t2",
+	"p\tn\tid\tls\tbe",
+	"1\t\t1\t0\t",
+	"0\tdocument\xf0\x9f\x98\x80.txt\t2\t1536\t1 200 600",
+	"0\tempty\t3\t0\t",
+	"",
+	NULL };
+
+/* Encodes an UTF-8 string as UTF-16 little-endian
+ * Only supports the UTF-8 encodings that are used by the test
+ * Returns the number of bytes written
+ */
+size_t ewf_test_ltree_stream_encode_utf16(
+        const char *utf8_string,
+        uint8_t *data )
+{
+	const uint8_t *utf8_data      = (const uint8_t *) utf8_string;
+	uint32_t unicode_character    = 0;
+	uint16_t utf16_value          = 0;
+	size_t data_index             = 0;
+
+	while( *utf8_data != 0 )
+	{
+		if( *utf8_data < 0x80 )
+		{
+			unicode_character = *utf8_data;
+			utf8_data        += 1;
+		}
+		else if( ( *utf8_data & 0xe0 ) == 0xc0 )
+		{
+			unicode_character = ( (uint32_t) ( utf8_data[ 0 ] & 0x1f ) << 6 )
+			                  | ( utf8_data[ 1 ] & 0x3f );
+			utf8_data        += 2;
+		}
+		else
+		{
+			unicode_character = ( (uint32_t) ( utf8_data[ 0 ] & 0x07 ) << 18 )
+			                  | ( (uint32_t) ( utf8_data[ 1 ] & 0x3f ) << 12 )
+			                  | ( (uint32_t) ( utf8_data[ 2 ] & 0x3f ) << 6 )
+			                  | ( utf8_data[ 3 ] & 0x3f );
+			utf8_data        += 4;
+		}
+		if( unicode_character > 0xffff )
+		{
+			unicode_character -= 0x10000;
+
+			utf16_value = (uint16_t) ( 0xd800 + ( unicode_character >> 10 ) );
+
+			data[ data_index++ ] = (uint8_t) ( utf16_value & 0xff );
+			data[ data_index++ ] = (uint8_t) ( utf16_value >> 8 );
+
+			unicode_character = 0xdc00 + ( unicode_character & 0x03ff );
+		}
+		data[ data_index++ ] = (uint8_t) ( unicode_character & 0xff );
+		data[ data_index++ ] = (uint8_t) ( unicode_character >> 8 );
+	}
+	return( data_index );
+}
+
+/* Opens a file IO pool that contains the data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_ltree_stream_open_pool(
+     libbfio_pool_t **file_io_pool,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_test_ltree_stream_open_pool";
+	int file_io_pool_entry           = 0;
+
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory range.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_append_handle(
+	     *file_io_pool,
+	     &file_io_pool_entry,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file IO handle to pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests reading the lines of the synthetic ltree in blocks of a specific size
+ * Every line is read a second time after seeking its offset
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_ltree_stream_read_lines(
+     uint8_t *data,
+     size_t data_size,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	off64_t line_offsets[ 32 ];
+
+	libbfio_pool_t *file_io_pool        = NULL;
+	libewf_ltree_stream_t *ltree_stream = NULL;
+	uint8_t *line_string                = NULL;
+	static char *function               = "ewf_test_ltree_stream_read_lines";
+	size_t line_string_size             = 0;
+	int line_index                      = 0;
+	int number_of_lines                 = 0;
+	int result                          = 0;
+
+	if( ewf_test_ltree_stream_open_pool(
+	     &file_io_pool,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_ltree_stream_initialize(
+	     &ltree_stream,
+	     0,
+	     0,
+	     (size64_t) data_size,
+	     block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create ltree stream.",
+		 function );
+
+		goto on_error;
+	}
+	while( ewf_test_ltree_stream_lines[ number_of_lines ] != NULL )
+	{
+		number_of_lines++;
+	}
+	for( line_index = 0;
+	     line_index <= number_of_lines;
+	     line_index++ )
+	{
+		if( libewf_ltree_stream_get_offset(
+		     ltree_stream,
+		     &( line_offsets[ line_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offset of line: %d.",
+			 function,
+			 line_index );
+
+			goto on_error;
+		}
+		result = libewf_ltree_stream_read_line(
+		          ltree_stream,
+		          file_io_pool,
+		          &line_string,
+		          &line_string_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read line: %d.",
+			 function,
+			 line_index );
+
+			goto on_error;
+		}
+		/* The end of the ltree data is reached after the last line
+		 */
+		if( line_index == number_of_lines )
+		{
+			if( result != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: unexpected line after the end of the ltree data.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+		}
+		if( ( result != 1 )
+		 || ( line_string_size != ( libcstring_narrow_string_length( ewf_test_ltree_stream_lines[ line_index ] ) + 1 ) )
+		 || ( libcstring_narrow_string_compare(
+		       (char *) line_string,
+		       ewf_test_ltree_stream_lines[ line_index ],
+		       line_string_size ) != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: mismatch in line: %d.",
+			 function,
+			 line_index );
+
+			goto on_error;
+		}
+	}
+	/* Read the lines again in reverse order after seeking their offset
+	 */
+	for( line_index = number_of_lines - 1;
+	     line_index >= 0;
+	     line_index-- )
+	{
+		if( libewf_ltree_stream_set_offset(
+		     ltree_stream,
+		     line_offsets[ line_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set offset of line: %d.",
+			 function,
+			 line_index );
+
+			goto on_error;
+		}
+		result = libewf_ltree_stream_read_line(
+		          ltree_stream,
+		          file_io_pool,
+		          &line_string,
+		          &line_string_size,
+		          error );
+
+		if( ( result != 1 )
+		 || ( line_string_size != ( libcstring_narrow_string_length( ewf_test_ltree_stream_lines[ line_index ] ) + 1 ) )
+		 || ( libcstring_narrow_string_compare(
+		       (char *) line_string,
+		       ewf_test_ltree_stream_lines[ line_index ],
+		       line_string_size ) != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: mismatch in line: %d after seeking its offset.",
+			 function,
+			 line_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_ltree_stream_free(
+	     &ltree_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free ltree stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ltree_stream != NULL )
+	{
+		libewf_ltree_stream_free(
+		 &ltree_stream,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests reading a line of a specific number of characters
+ * Returns 1 if the line was read, 0 if the line was rejected or -1 on error
+ */
+int ewf_test_ltree_stream_read_long_line(
+     size_t number_of_characters,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool        = NULL;
+	libcerror_error_t *line_error       = NULL;
+	libewf_ltree_stream_t *ltree_stream = NULL;
+	uint8_t *data                       = NULL;
+	uint8_t *line_string                = NULL;
+	static char *function               = "ewf_test_ltree_stream_read_long_line";
+	size_t data_index                   = 0;
+	size_t data_size                    = 0;
+	size_t line_string_size             = 0;
+	int result                          = 0;
+
+	/* The data consists of: "rec\r\n", the long line, "\r\n" and a 0-character
+	 */
+	data_size = ( number_of_characters + 8 ) * 2;
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	data_index = ewf_test_ltree_stream_encode_utf16(
+	              "rec\r\n",
+	              data );
+
+	while( data_index < ( ( number_of_characters + 5 ) * 2 ) )
+	{
+		data[ data_index++ ] = (uint8_t) 'a';
+		data[ data_index++ ] = 0;
+	}
+	data_index += ewf_test_ltree_stream_encode_utf16(
+	               "\r\n",
+	               &( data[ data_index ] ) );
+
+	data[ data_index++ ] = 0;
+	data[ data_index++ ] = 0;
+
+	if( ewf_test_ltree_stream_open_pool(
+	     &file_io_pool,
+	     data,
+	     data_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_ltree_stream_initialize(
+	     &ltree_stream,
+	     0,
+	     0,
+	     (size64_t) data_index,
+	     LIBEWF_LTREE_STREAM_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create ltree stream.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_ltree_stream_read_line(
+	          ltree_stream,
+	          file_io_pool,
+	          &line_string,
+	          &line_string_size,
+	          error );
+
+	if( ( result != 1 )
+	 || ( line_string_size != 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in line preceding long line.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_ltree_stream_read_line(
+	          ltree_stream,
+	          file_io_pool,
+	          &line_string,
+	          &line_string_size,
+	          &line_error );
+
+	if( result == -1 )
+	{
+		libcerror_error_free(
+		 &line_error );
+
+		result = 0;
+	}
+	else if( ( result != 1 )
+	      || ( line_string_size != ( number_of_characters + 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in long line.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_ltree_stream_free(
+	     &ltree_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free ltree stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( result );
+
+on_error:
+	if( ltree_stream != NULL )
+	{
+		libewf_ltree_stream_free(
+		 &ltree_stream,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	uint8_t data[ 2048 ];
+
+	libcerror_error_t *error = NULL;
+	size_t block_size        = 0;
+	size_t data_size         = 0;
+	int line_index           = 0;
+	int result               = 0;
+
+	/* The ltree data starts with a byte order mark and ends with a 0-character
+	 */
+	data[ 0 ] = 0xff;
+	data[ 1 ] = 0xfe;
+
+	data_size = 2;
+
+	for( line_index = 0;
+	     ewf_test_ltree_stream_lines[ line_index ] != NULL;
+	     line_index++ )
+	{
+		if( line_index > 0 )
+		{
+			data_size += ewf_test_ltree_stream_encode_utf16(
+			              "\r\n",
+			              &( data[ data_size ] ) );
+		}
+		data_size += ewf_test_ltree_stream_encode_utf16(
+		              ewf_test_ltree_stream_lines[ line_index ],
+		              &( data[ data_size ] ) );
+	}
+	data[ data_size++ ] = 0;
+	data[ data_size++ ] = 0;
+
+	/* Small block sizes split the lines, and the surrogate pairs,
+	 * across block boundaries at every possible position
+	 */
+	for( block_size = 4;
+	     block_size <= 64;
+	     block_size++ )
+	{
+		if( ewf_test_ltree_stream_read_lines(
+		     data,
+		     data_size,
+		     block_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test reading lines with block size: %" PRIzd ".\n",
+			 (ssize_t) block_size );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_ltree_stream_read_lines(
+	     data,
+	     data_size,
+	     LIBEWF_LTREE_STREAM_BLOCK_SIZE,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test reading lines with default block size.\n" );
+
+		goto on_error;
+	}
+	result = ewf_test_ltree_stream_read_long_line(
+	          LIBEWF_LTREE_STREAM_MAXIMUM_LINE_SIZE - 16,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test reading line below the maximum line size.\n" );
+
+		goto on_error;
+	}
+	result = ewf_test_ltree_stream_read_long_line(
+	          LIBEWF_LTREE_STREAM_MAXIMUM_LINE_SIZE,
+	          &error );
+
+	if( result != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test reading line exceeding the maximum line size.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
@@ -526,6 +526,126 @@ int ewf_test_read_chunk_at_offset(
 	return( result );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests libewf_handle_submit_read_random and libewf_handle_get_read_completion
+ * The data read asynchronously is compared with the data read by libewf_handle_read_random
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_submit_read_random(
+     libewf_handle_t *handle,
+     off64_t input_offset,
+     size_t input_size,
+     size_t expected_size )
+{
+	libcerror_error_t *error = NULL;
+	intptr_t *user_data      = NULL;
+	uint8_t *async_buffer    = NULL;
+	uint8_t *buffer          = NULL;
+	ssize_t async_read_count = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing asynchronous read with offset: %" PRIi64 " and size: %" PRIzd "\t",
+	 input_offset,
+	 input_size );
+
+	buffer = (uint8_t *) memory_allocate(
+	                      input_size );
+
+	async_buffer = (uint8_t *) memory_allocate(
+	                            input_size );
+
+	if( ( buffer != NULL )
+	 && ( async_buffer != NULL ) )
+	{
+		result = libewf_handle_submit_read_random(
+		          handle,
+		          async_buffer,
+		          input_size,
+		          input_offset,
+		          NULL,
+		          (intptr_t *) async_buffer,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_get_read_completion(
+		          handle,
+		          &user_data,
+		          &async_read_count,
+		          1,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		read_count = libewf_handle_read_random(
+		              handle,
+		              buffer,
+		              input_size,
+		              input_offset,
+		              &error );
+
+		if( read_count < 0 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( ( user_data != (intptr_t *) async_buffer )
+		 || ( async_read_count != (ssize_t) expected_size )
+		 || ( read_count != async_read_count )
+		 || ( memory_compare(
+		       buffer,
+		       async_buffer,
+		       expected_size ) != 0 ) )
+		{
+			result = 0;
+		}
+	}
+	if( async_buffer != NULL )
+	{
+		memory_free(
+		 async_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( result != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( result == -1 )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* The main program
  */
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
@@ -534,12 +654,24 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
-	libcerror_error_t *error = NULL;
-	libewf_handle_t *handle = NULL;
-	off64_t read_offset     = 0;
-	size64_t media_size     = 0;
-	size64_t read_size      = 0;
-	size32_t chunk_size     = 0;
+	uint64_t statistics[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *handle        = NULL;
+	off64_t read_offset            = 0;
+	size64_t media_size            = 0;
+	size64_t read_size             = 0;
+	uint64_t number_of_allocations = 0;
+	uint64_t number_of_frees       = 0;
+	uint64_t number_of_reuses      = 0;
+	uint64_t trace_chunk_index     = 0;
+	uint64_t trace_duration        = 0;
+	uint64_t trace_start_time      = 0;
+	size32_t chunk_size            = 0;
+	uint8_t trace_stage            = 0;
+	int number_of_trace_events     = 0;
+	int trace_event_index          = 0;
+	int trace_file_io_pool_entry   = 0;
 
 	if( argc < 2 )
 	{
@@ -985,6 +1117,188 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	/* Test: retrieve the chunk data pool statistics after reading
+	 * Expected result: no more buffers and values freed than allocated
+	 */
+	if( libewf_handle_get_chunk_data_pool_statistics(
+	     handle,
+	     &number_of_allocations,
+	     &number_of_reuses,
+	     &number_of_frees,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunk data pool statistics.\n" );
+
+		goto on_error;
+	}
+	if( number_of_frees > number_of_allocations )
+	{
+		fprintf(
+		 stderr,
+		 "Invalid chunk data pool statistics.\n" );
+
+		goto on_error;
+	}
+	/* Test: retrieve the statistics after reading
+	 * Expected result: at least one byte read per chunk read
+	 */
+	if( libewf_handle_get_statistics(
+	     handle,
+	     statistics,
+	     LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve statistics.\n" );
+
+		goto on_error;
+	}
+	if( statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_BYTES_READ ] < statistics[ LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHUNKS_READ ] )
+	{
+		fprintf(
+		 stderr,
+		 "Invalid statistics.\n" );
+
+		goto on_error;
+	}
+	/* Test: trace reading the first chunk
+	 * Expected result: at most the maximum number of trace events with a valid stage
+	 */
+	if( libewf_handle_set_maximum_number_of_trace_events(
+	     handle,
+	     16,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set maximum number of trace events.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_buffer_at_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     chunk_size,
+	     0,
+	     ( media_size < chunk_size ) ? media_size : chunk_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read buffer.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_number_of_trace_events(
+	     handle,
+	     &number_of_trace_events,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve number of trace events.\n" );
+
+		goto on_error;
+	}
+	if( number_of_trace_events > 16 )
+	{
+		fprintf(
+		 stderr,
+		 "Invalid number of trace events.\n" );
+
+		goto on_error;
+	}
+	for( trace_event_index = 0;
+	     trace_event_index < number_of_trace_events;
+	     trace_event_index++ )
+	{
+		if( libewf_handle_get_trace_event(
+		     handle,
+		     trace_event_index,
+		     &trace_stage,
+		     &trace_chunk_index,
+		     &trace_file_io_pool_entry,
+		     &trace_start_time,
+		     &trace_duration,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to retrieve trace event: %d.\n",
+			 trace_event_index );
+
+			goto on_error;
+		}
+		if( ( trace_stage < LIBEWF_TRACE_STAGE_OPEN )
+		 || ( trace_stage > LIBEWF_TRACE_STAGE_WRITE ) )
+		{
+			fprintf(
+			 stderr,
+			 "Invalid trace event: %d stage.\n",
+			 trace_event_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_maximum_number_of_trace_events(
+	     handle,
+	     0,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set maximum number of trace events.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Case 3: test asynchronous read
+	 */
+
+	/* Test: offset: <media_size / 7> size: <3 * chunk_size>
+	 * Expected result: size: <3 * chunk_size> or the remaining media size
+	 */
+	read_offset = (off64_t) ( media_size / 7 );
+	read_size   = 3 * (size64_t) chunk_size;
+
+	if( read_size > ( media_size - read_offset ) )
+	{
+		read_size = media_size - read_offset;
+	}
+	if( ewf_test_submit_read_random(
+	     handle,
+	     read_offset,
+	     (size_t) read_size,
+	     (size_t) read_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test asynchronous read.\n" );
+
+		goto on_error;
+	}
+	if( media_size >= 1024 )
+	{
+		/* Test: offset: <media_size - 1024> size: 4096
+		 * Expected result: size: 1024
+		 */
+		if( ewf_test_submit_read_random(
+		     handle,
+		     (off64_t) ( media_size - 1024 ),
+		     4096,
+		     1024 ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test asynchronous read.\n" );
+
+			goto on_error;
+		}
+	}
+#endif
 	/* Clean up
 	 */
 	if( libewf_handle_close(
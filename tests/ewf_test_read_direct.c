@@ -0,0 +1,548 @@
+/*
+ * Expert Witness Compression Format (EWF) library direct access read testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_definitions.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+
+/* The block size used by the test, a common sector size for direct access
+ */
+#define EWF_TEST_READ_DIRECT_BLOCK_SIZE		EWF_TEST_BUFFER_SIZE
+
+/* The number of blocks read by the test
+ */
+#define EWF_TEST_READ_DIRECT_NUMBER_OF_BLOCKS	4
+
+/* The size of the partial last block of the test file
+ */
+#define EWF_TEST_READ_DIRECT_PARTIAL_SIZE	1000
+
+/* Returns the value of the byte at a specific offset of the test file
+ */
+#define ewf_test_read_direct_get_byte( offset ) \
+	(uint8_t) ( ( offset ) % 251 )
+
+#if defined( LIBCFILE_OPEN_READ_DIRECT )
+
+/* Opens a file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_open(
+     libcfile_file_t **file,
+     const libcstring_system_character_t *filename,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_read_direct_open";
+
+	if( libcfile_file_initialize(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     *file,
+	     filename,
+	     access_flags,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     *file,
+	     filename,
+	     access_flags,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file != NULL )
+	{
+		libcfile_file_free(
+		 file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the test file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_write_file(
+     const libcstring_system_character_t *filename,
+     size_t file_size,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file = NULL;
+	uint8_t *buffer       = NULL;
+	static char *function = "ewf_test_read_direct_write_file";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * file_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < file_size;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = ewf_test_read_direct_get_byte(
+		                           buffer_offset );
+	}
+	if( ewf_test_read_direct_open(
+	     &file,
+	     filename,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               buffer,
+	               file_size,
+	               error );
+
+	if( write_count != (ssize_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_close(
+		 file,
+		 NULL );
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Tests reading a file of a specific size with direct access into a buffer
+ * that is not block aligned
+ * If the truncate size is not 0 the file is truncated after it has been opened,
+ * so that the file ends in a partial block the reader does not know about
+ * Returns 1 if successful, 0 if direct access is not supported or -1 on error
+ */
+int ewf_test_read_direct(
+     const libcstring_system_character_t *filename,
+     size_t file_size,
+     size_t truncate_size,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file          = NULL;
+	libcfile_file_t *truncate_file = NULL;
+	uint8_t *buffer                = NULL;
+	uint8_t *read_buffer           = NULL;
+	static char *function          = "ewf_test_read_direct";
+	size_t buffer_offset           = 0;
+	size_t expected_size           = 0;
+	size_t read_size               = 0;
+	ssize_t read_count             = 0;
+
+	if( ewf_test_read_direct_write_file(
+	     filename,
+	     file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write test file.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_read_direct_open(
+	     &file,
+	     filename,
+	     LIBCFILE_OPEN_READ_DIRECT,
+	     error ) != 1 )
+	{
+		/* The file system does not support direct access
+		 */
+		libcerror_error_free(
+		 error );
+
+		return( 0 );
+	}
+	if( libcfile_file_set_block_size(
+	     file,
+	     EWF_TEST_READ_DIRECT_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set block size.",
+		 function );
+
+		goto on_error;
+	}
+	expected_size = file_size;
+
+	if( truncate_size != 0 )
+	{
+		if( ewf_test_read_direct_open(
+		     &truncate_file,
+		     filename,
+		     LIBCFILE_OPEN_WRITE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file for truncation.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcfile_file_resize(
+		     truncate_file,
+		     (size64_t) truncate_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to truncate file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcfile_file_close(
+		     truncate_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file for truncation.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcfile_file_free(
+		     &truncate_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file for truncation.",
+			 function );
+
+			goto on_error;
+		}
+		expected_size = truncate_size;
+	}
+	read_size = EWF_TEST_READ_DIRECT_NUMBER_OF_BLOCKS * EWF_TEST_READ_DIRECT_BLOCK_SIZE;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* Make sure the buffer is not block aligned
+	 */
+	read_buffer = &( buffer[ 1 ] );
+
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              read_buffer,
+	              read_size,
+	              error );
+
+	if( read_count != (ssize_t) expected_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unexpected read count: %" PRIzd " expected: %" PRIzd ".",
+		 function,
+		 read_count,
+		 (ssize_t) expected_size );
+
+		goto on_error;
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < expected_size;
+	     buffer_offset++ )
+	{
+		if( read_buffer[ buffer_offset ] != ewf_test_read_direct_get_byte( buffer_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: mismatch in data at offset: %" PRIzd ".",
+			 function,
+			 (ssize_t) buffer_offset );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( truncate_file != NULL )
+	{
+		libcfile_file_close(
+		 truncate_file,
+		 NULL );
+		libcfile_file_free(
+		 &truncate_file,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_close(
+		 file,
+		 NULL );
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( LIBCFILE_OPEN_READ_DIRECT ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+#if defined( LIBCFILE_OPEN_READ_DIRECT )
+	libcerror_error_t *error = NULL;
+	size_t file_size         = 0;
+	int result               = 0;
+#endif
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( LIBCFILE_OPEN_READ_DIRECT )
+	file_size = ( ( EWF_TEST_READ_DIRECT_NUMBER_OF_BLOCKS - 1 ) * EWF_TEST_READ_DIRECT_BLOCK_SIZE )
+	          + EWF_TEST_READ_DIRECT_PARTIAL_SIZE;
+
+	/* Test a file that ends in a partial block
+	 */
+	result = ewf_test_read_direct(
+	          argv[ 1 ],
+	          file_size,
+	          0,
+	          &error );
+
+	if( result == 1 )
+	{
+		/* Test a file that is truncated to a partial block after it was opened
+		 */
+		result = ewf_test_read_direct(
+		          argv[ 1 ],
+		          EWF_TEST_READ_DIRECT_NUMBER_OF_BLOCKS * EWF_TEST_READ_DIRECT_BLOCK_SIZE,
+		          file_size,
+		          &error );
+	}
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test direct access read.\n" );
+
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+
+		return( EXIT_FAILURE );
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Direct access not supported.\n" );
+
+		return( 77 );
+	}
+	return( EXIT_SUCCESS );
+#else
+	fprintf(
+	 stderr,
+	 "Direct access not supported.\n" );
+
+	return( 77 );
+#endif
+}
@@ -0,0 +1,913 @@
+/*
+ * Expert Witness Compression Format (EWF) library single files testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_libbfio.h"
+#include "../libewf/libewf_libcdata.h"
+#include "../libewf/libewf_single_file_entry.h"
+#include "../libewf/libewf_single_files.h"
+
+/* The record section of the synthetic ltree
+ */
+static const char *ewf_test_single_files_record_lines[] = {
+	"rec",
+	"tb\tcl\tn",
+	"16384\t1\tcase",
+	"",
+	NULL };
+
+/* The entry section of the synthetic ltree
+ * Every file entry consists of a number of sub entries line followed by a values line
+ * The tree is: root( dir1( file11, dir12( file121 ) ), file2, dir3( file31, file32 ) )
+ */
+static const char *ewf_test_single_files_entry_lines[] = {
+	"entry",
+	"0\t1",
+	"p\tn\tid\tls",
+	"0\t3",
+	"1\t\t1\t0",
+	"0\t2",
+	"1\tdir1\t2\t0",
+	"0\t0",
+	"\tfile11\t3\t110",
+	"0\t1",
+	"1\tdir12\t4\t0",
+	"0\t0",
+	"\tfile121\t5\t1210",
+	"0\t0",
+	"\tfile2\t6\t20",
+	"0\t2",
+	"1\tdir3\t7\t0",
+	"0\t0",
+	"\tfile31\t8\t310",
+	"0\t0",
+	"\tfile32\t9\t320",
+	"",
+	NULL };
+
+/* Encodes an ASCII string as UTF-16 little-endian
+ * Returns the number of bytes written
+ */
+size_t ewf_test_single_files_encode_utf16(
+        const char *string,
+        uint8_t *data )
+{
+	size_t data_index = 0;
+
+	while( *string != 0 )
+	{
+		data[ data_index++ ] = (uint8_t) *string;
+		data[ data_index++ ] = 0;
+
+		string++;
+	}
+	return( data_index );
+}
+
+/* Encodes lines as UTF-16 little-endian separated by "\r\n"
+ * Returns the number of bytes written
+ */
+size_t ewf_test_single_files_encode_lines(
+        const char **lines,
+        uint8_t *data )
+{
+	size_t data_index = 0;
+	int line_index    = 0;
+
+	for( line_index = 0;
+	     lines[ line_index ] != NULL;
+	     line_index++ )
+	{
+		data_index += ewf_test_single_files_encode_utf16(
+		               "\r\n",
+		               &( data[ data_index ] ) );
+
+		data_index += ewf_test_single_files_encode_utf16(
+		               lines[ line_index ],
+		               &( data[ data_index ] ) );
+	}
+	return( data_index );
+}
+
+/* Opens a file IO pool that contains the data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_open_pool(
+     libbfio_pool_t **file_io_pool,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_test_single_files_open_pool";
+	int file_io_pool_entry           = 0;
+
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory range.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_append_handle(
+	     *file_io_pool,
+	     &file_io_pool_entry,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file IO handle to pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Parses the ltree data into single files
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_parse(
+     libewf_single_files_t **single_files,
+     libbfio_pool_t *file_io_pool,
+     size_t data_size,
+     uint8_t read_on_demand,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_single_files_parse";
+	size64_t media_size   = 0;
+	uint8_t format        = 0;
+
+	if( libewf_single_files_initialize(
+	     single_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single files.",
+		 function );
+
+		goto on_error;
+	}
+	( *single_files )->ltree_file_io_pool_entry = 0;
+	( *single_files )->ltree_data_offset        = 0;
+	( *single_files )->ltree_data_size          = (size64_t) data_size;
+
+	if( libewf_single_files_parse(
+	     *single_files,
+	     file_io_pool,
+	     &media_size,
+	     &format,
+	     read_on_demand,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( media_size != 16384 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in media size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *single_files != NULL )
+	{
+		libewf_single_files_free(
+		 single_files,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a file entry node and its single file entry
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_get_sub_node(
+     libcdata_tree_node_t *file_entry_node,
+     int sub_node_index,
+     libcdata_tree_node_t **sub_file_entry_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_single_files_get_sub_node";
+
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     file_entry_node,
+	     sub_node_index,
+	     sub_file_entry_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node: %d.",
+		 function,
+		 sub_node_index );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     *sub_file_entry_node,
+	     (intptr_t **) sub_single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value of sub node: %d.",
+		 function,
+		 sub_node_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Compares a file entry read on demand with the same file entry read at once
+ * Only the sub file entries that were read on demand are compared
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int ewf_test_single_files_compare(
+     libcdata_tree_node_t *lazy_file_entry_node,
+     libcdata_tree_node_t *file_entry_node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *lazy_sub_file_entry_node     = NULL;
+	libcdata_tree_node_t *sub_file_entry_node          = NULL;
+	libewf_single_file_entry_t *lazy_single_file_entry = NULL;
+	libewf_single_file_entry_t *single_file_entry      = NULL;
+	static char *function                              = "ewf_test_single_files_compare";
+	int lazy_number_of_sub_nodes                       = 0;
+	int number_of_sub_nodes                            = 0;
+	int result                                         = 0;
+	int sub_node_index                                 = 0;
+
+	if( libcdata_tree_node_get_value(
+	     lazy_file_entry_node,
+	     (intptr_t **) &lazy_single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve lazy single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     file_entry_node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     lazy_file_entry_node,
+	     &lazy_number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve lazy number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     file_entry_node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( lazy_single_file_entry->type != single_file_entry->type )
+	 || ( lazy_single_file_entry->size != single_file_entry->size )
+	 || ( lazy_single_file_entry->name_size != single_file_entry->name_size ) )
+	{
+		return( 0 );
+	}
+	if( ( single_file_entry->name_size > 0 )
+	 && ( memory_compare(
+	       lazy_single_file_entry->name,
+	       single_file_entry->name,
+	       single_file_entry->name_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( single_file_entry->number_of_unread_sub_entries != 0 )
+	{
+		return( 0 );
+	}
+	/* A file entry that was not visited has no sub nodes yet
+	 */
+	if( lazy_single_file_entry->number_of_unread_sub_entries != 0 )
+	{
+		if( ( lazy_number_of_sub_nodes != 0 )
+		 || ( lazy_single_file_entry->number_of_unread_sub_entries != (uint64_t) number_of_sub_nodes ) )
+		{
+			return( 0 );
+		}
+		return( 1 );
+	}
+	if( lazy_number_of_sub_nodes != number_of_sub_nodes )
+	{
+		return( 0 );
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_sub_node_by_index(
+		     lazy_file_entry_node,
+		     sub_node_index,
+		     &lazy_sub_file_entry_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve lazy sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_sub_node_by_index(
+		     file_entry_node,
+		     sub_node_index,
+		     &sub_file_entry_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		result = ewf_test_single_files_compare(
+		          lazy_sub_file_entry_node,
+		          sub_file_entry_node,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the sub file entries of a file entry and checks the number of sub nodes
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_read_sub_file_entries(
+     libewf_single_files_t *single_files,
+     libbfio_pool_t *file_io_pool,
+     libcdata_tree_node_t *file_entry_node,
+     int expected_number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	static char *function   = "ewf_test_single_files_read_sub_file_entries";
+	int number_of_sub_nodes = 0;
+
+	if( libewf_single_files_read_sub_file_entries(
+	     single_files,
+	     file_io_pool,
+	     file_entry_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     file_entry_node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes != expected_number_of_sub_nodes )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests reading the sub file entries on demand and compares them with the sub file entries read at once
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_read_on_demand(
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool                  = NULL;
+	libcdata_tree_node_t *file_entry_node         = NULL;
+	libcdata_tree_node_t *sub_file_entry_node     = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_files_t *lazy_single_files      = NULL;
+	libewf_single_files_t *single_files           = NULL;
+	static char *function                         = "ewf_test_single_files_read_on_demand";
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+
+	if( ewf_test_single_files_open_pool(
+	     &file_io_pool,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_single_files_parse(
+	     &single_files,
+	     file_io_pool,
+	     data_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_single_files_parse(
+	     &lazy_single_files,
+	     file_io_pool,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse single files on demand.",
+		 function );
+
+		goto on_error;
+	}
+	/* Only the root file entry is read when the ltree is parsed
+	 */
+	file_entry_node = lazy_single_files->root_file_entry_node;
+
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     file_entry_node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of root sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: root sub file entries read before first access.",
+		 function );
+
+		goto on_error;
+	}
+	result = ewf_test_single_files_compare(
+	          file_entry_node,
+	          single_files->root_file_entry_node,
+	          error );
+
+	if( result != 1 )
+	{
+		goto on_mismatch;
+	}
+	/* Reading the root sub file entries only reads the direct sub file entries
+	 */
+	if( ewf_test_single_files_read_sub_file_entries(
+	     lazy_single_files,
+	     file_io_pool,
+	     file_entry_node,
+	     3,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	result = ewf_test_single_files_compare(
+	          file_entry_node,
+	          single_files->root_file_entry_node,
+	          error );
+
+	if( result != 1 )
+	{
+		goto on_mismatch;
+	}
+	/* Reading the sub file entries again does not change the tree
+	 */
+	if( ewf_test_single_files_read_sub_file_entries(
+	     lazy_single_files,
+	     file_io_pool,
+	     file_entry_node,
+	     3,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* Read the sub file entries of: dir1/dir12 before those of: dir3
+	 */
+	if( ewf_test_single_files_get_sub_node(
+	     lazy_single_files->root_file_entry_node,
+	     0,
+	     &file_entry_node,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_single_files_read_sub_file_entries(
+	     lazy_single_files,
+	     file_io_pool,
+	     file_entry_node,
+	     2,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_single_files_get_sub_node(
+	     file_entry_node,
+	     1,
+	     &sub_file_entry_node,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	result = ewf_test_single_files_compare(
+	          lazy_single_files->root_file_entry_node,
+	          single_files->root_file_entry_node,
+	          error );
+
+	if( result != 1 )
+	{
+		goto on_mismatch;
+	}
+	if( ewf_test_single_files_read_sub_file_entries(
+	     lazy_single_files,
+	     file_io_pool,
+	     sub_file_entry_node,
+	     1,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_single_files_get_sub_node(
+	     lazy_single_files->root_file_entry_node,
+	     2,
+	     &file_entry_node,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_single_files_read_sub_file_entries(
+	     lazy_single_files,
+	     file_io_pool,
+	     file_entry_node,
+	     2,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* All the file entries have been visited and should match
+	 */
+	result = ewf_test_single_files_compare(
+	          lazy_single_files->root_file_entry_node,
+	          single_files->root_file_entry_node,
+	          error );
+
+	if( result != 1 )
+	{
+		goto on_mismatch;
+	}
+	if( libewf_single_files_free(
+	     &lazy_single_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free lazy single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_free(
+	     &single_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_mismatch:
+	if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in file entries read on demand.",
+		 function );
+	}
+on_error:
+	if( lazy_single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &lazy_single_files,
+		 NULL );
+	}
+	if( single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	uint8_t data[ 2048 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_size         = 0;
+
+	/* The ltree data starts with a byte order mark followed by the "5" line
+	 * and ends with a 0-character
+	 */
+	data[ 0 ] = 0xff;
+	data[ 1 ] = 0xfe;
+
+	data_size  = 2;
+	data_size += ewf_test_single_files_encode_utf16(
+	              "5",
+	              &( data[ data_size ] ) );
+
+	data_size += ewf_test_single_files_encode_lines(
+	              ewf_test_single_files_record_lines,
+	              &( data[ data_size ] ) );
+
+	data_size += ewf_test_single_files_encode_lines(
+	              ewf_test_single_files_entry_lines,
+	              &( data[ data_size ] ) );
+
+	data[ data_size++ ] = 0;
+	data[ data_size++ ] = 0;
+
+	if( ewf_test_single_files_read_on_demand(
+	     data,
+	     data_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test reading sub file entries on demand with the record values first.\n" );
+
+		goto on_error;
+	}
+	/* The entries must be skipped to find the record values
+	 */
+	data_size  = 2;
+	data_size += ewf_test_single_files_encode_utf16(
+	              "5",
+	              &( data[ data_size ] ) );
+
+	data_size += ewf_test_single_files_encode_lines(
+	              ewf_test_single_files_entry_lines,
+	              &( data[ data_size ] ) );
+
+	data_size += ewf_test_single_files_encode_lines(
+	              ewf_test_single_files_record_lines,
+	              &( data[ data_size ] ) );
+
+	data[ data_size++ ] = 0;
+	data[ data_size++ ] = 0;
+
+	if( ewf_test_single_files_read_on_demand(
+	     data,
+	     data_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test reading sub file entries on demand with the entries first.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
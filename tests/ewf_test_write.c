@@ -47,6 +47,7 @@ int ewf_test_write(
      size64_t maximum_segment_size,
      int8_t compression_level,
      uint8_t compression_flags,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libewf_handle_t *handle = NULL;
@@ -143,6 +144,23 @@ int ewf_test_write(
 
 		goto on_error;
 	}
+	if( number_of_threads > 0 )
+	{
+		if( libewf_handle_set_number_of_compression_threads(
+		     handle,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set number of compression threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	buffer = (uint8_t *) memory_allocate(
 	                      EWF_TEST_BUFFER_SIZE );
 
@@ -336,11 +354,13 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_compression_level    = NULL;
 	libcstring_system_character_t *option_maximum_segment_size = NULL;
 	libcstring_system_character_t *option_media_size           = NULL;
+	libcstring_system_character_t *option_number_of_threads    = NULL;
 	libcerror_error_t *error                                    = NULL;
 	libcstring_system_integer_t option                         = 0;
 	size64_t chunk_size                                        = 0;
 	size64_t maximum_segment_size                              = 0;
 	size64_t media_size                                        = 0;
+	uint64_t number_of_threads                                 = 0;
 	size_t string_length                                       = 0;
 	uint8_t compression_flags                                  = 0;
 	int8_t compression_level                                   = LIBEWF_COMPRESSION_NONE;
@@ -348,7 +368,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "b:B:c:S:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "b:B:c:S:t:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -379,6 +399,11 @@ int main( int argc, char * const argv[] )
 			case (libcstring_system_integer_t) 'S':
 				option_maximum_segment_size = optarg;
 
+				break;
+
+			case (libcstring_system_integer_t) 't':
+				option_number_of_threads = optarg;
+
 				break;
 		}
 	}
@@ -448,6 +473,11 @@ int main( int argc, char * const argv[] )
 			compression_level = LIBEWF_COMPRESSION_BEST;
 			compression_flags = 0;
 		}
+		else if( option_compression_level[ 0 ] == (libcstring_system_character_t) 'a' )
+		{
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+		}
 		else
 		{
 			fprintf(
@@ -493,12 +523,32 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_number_of_threads != NULL )
+	{
+		string_length = libcstring_system_string_length(
+				 option_number_of_threads );
+
+		if( ( libcsystem_string_decimal_copy_to_64_bit(
+		       option_number_of_threads,
+		       string_length + 1,
+		       &number_of_threads,
+		       &error ) != 1 )
+		 || ( number_of_threads > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewf_test_write(
 	     argv[ optind ],
 	     media_size,
 	     maximum_segment_size,
 	     compression_level,
 	     compression_flags,
+	     (int) number_of_threads,
 	     &error ) != 1 )
 	{
 		fprintf(
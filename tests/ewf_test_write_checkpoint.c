@@ -0,0 +1,446 @@
+/*
+ * Expert Witness Compression Format (EWF) library write checkpoint testing program
+ *
+ * Copyright (c) 2006-2012, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_definitions.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+
+/* Tests writing the data of a source file to EWF file(s) with a write checkpoint interval
+ * The write is interrupted once the interrupt offset is reached, the handle is deliberately
+ * not closed so that the EWF file(s) and write journal are left as after a crash
+ * An interrupt offset of 0 represents no interruption
+ * Return 1 if successful or -1 on error
+ */
+int ewf_test_write_checkpoint(
+     const libcstring_system_character_t *source_filename,
+     const libcstring_system_character_t *target_filename,
+     uint32_t checkpoint_interval,
+     size64_t interrupt_offset,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *source_file = NULL;
+	libewf_handle_t *handle      = NULL;
+	uint8_t *buffer              = NULL;
+	static char *function        = "ewf_test_write_checkpoint";
+	size64_t media_size          = 0;
+	size64_t write_offset        = 0;
+	ssize_t read_count           = 0;
+	ssize_t write_count          = 0;
+
+	if( libcfile_file_initialize(
+	     &source_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create source file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     source_file,
+	     source_filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     source_file,
+	     source_filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open source file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     source_file,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve source file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &target_filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &target_filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_write_checkpoint_interval(
+	     handle,
+	     checkpoint_interval,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set write checkpoint interval.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( interrupt_offset == 0 )
+	 || ( interrupt_offset > media_size ) )
+	{
+		interrupt_offset = media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_TEST_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable created buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( write_offset < interrupt_offset )
+	{
+		read_count = libcfile_file_read_buffer(
+		              source_file,
+		              buffer,
+		              EWF_TEST_BUFFER_SIZE,
+		              error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable read buffer from source file.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libewf_handle_write_buffer(
+			       handle,
+			       buffer,
+			       (size_t) read_count,
+			       error );
+
+		if( write_count != read_count )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable write buffer of size: %" PRIzd ".",
+			 function,
+			 read_count );
+
+			goto on_error;
+		}
+		write_offset += write_count;
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libcfile_file_close(
+	     source_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close source file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &source_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free source file.",
+		 function );
+
+		goto on_error;
+	}
+	/* Closing or freeing the handle would finalize the write,
+	 * the open files are closed when the program exits
+	 */
+	if( write_offset < media_size )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( source_file != NULL )
+	{
+		libcfile_file_free(
+		 &source_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t *option_checkpoint_interval = NULL;
+	libcstring_system_character_t *option_interrupt_offset    = NULL;
+	libcerror_error_t *error                                   = NULL;
+	libcstring_system_integer_t option                        = 0;
+	uint64_t checkpoint_interval                              = 0;
+	size64_t interrupt_offset                                 = 0;
+	size_t string_length                                      = 0;
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _LIBCSTRING_SYSTEM_STRING( "B:j:" ) ) ) != (libcstring_system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (libcstring_system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (libcstring_system_integer_t) 'B':
+				option_interrupt_offset = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'j':
+				option_checkpoint_interval = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( optind + 1 ) == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing EWF image filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_checkpoint_interval != NULL )
+	{
+		string_length = libcstring_system_string_length(
+				 option_checkpoint_interval );
+
+		if( ( libcsystem_string_decimal_copy_to_64_bit(
+		       option_checkpoint_interval,
+		       string_length + 1,
+		       &checkpoint_interval,
+		       &error ) != 1 )
+		 || ( checkpoint_interval > (uint64_t) UINT32_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported checkpoint interval.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_interrupt_offset != NULL )
+	{
+		string_length = libcstring_system_string_length(
+				 option_interrupt_offset );
+
+		if( libcsystem_string_decimal_copy_to_64_bit(
+		     option_interrupt_offset,
+		     string_length + 1,
+		     &interrupt_offset,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported interrupt offset.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_write_checkpoint(
+	     argv[ optind ],
+	     argv[ optind + 1 ],
+	     (uint32_t) checkpoint_interval,
+	     interrupt_offset,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test write checkpoint.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
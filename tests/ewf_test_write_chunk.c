@@ -179,7 +179,7 @@ int ewf_test_write_chunk(
 
 	if( chunk_buffer != NULL )
 	{
-		checksum_buffer = &( chunk_buffer[ chunk_buffer_size - 1 ] );
+		checksum_buffer = &( chunk_buffer[ chunk_buffer_size ] );
 	}
 	for( sector_iterator = 0;
 	     sector_iterator < 26;
@@ -199,6 +199,10 @@ int ewf_test_write_chunk(
 
 			goto on_error;
 		}
+		/* The compressed chunk buffer size is overwritten with the compressed data size
+		 */
+		compressed_chunk_buffer_size = chunk_buffer_size * 2;
+
 		process_count = libewf_handle_prepare_write_chunk(
 				 handle,
 				 chunk_buffer,
@@ -333,6 +337,438 @@ on_error:
 	return( -1 );
 }
 
+/* Tests reading the chunks of the EWF file(s) written by ewf_test_write_chunk
+ * Return 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_chunks(
+     const libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t **filenames = NULL;
+	libewf_handle_t *handle                   = NULL;
+	uint8_t *chunk_flags                      = NULL;
+	uint8_t *chunks_buffer                    = NULL;
+	uint8_t *uncompressed_chunk_buffer        = NULL;
+	uint64_t *chunk_indexes                   = NULL;
+	uint32_t *chunk_checksums                 = NULL;
+	size_t *chunk_data_offsets                = NULL;
+	size_t *chunk_data_sizes                  = NULL;
+	static char *function                     = "ewf_test_read_chunks";
+	size64_t media_size                       = 0;
+	size_t chunks_buffer_size                 = 0;
+	size_t uncompressed_chunk_buffer_size     = 0;
+	size_t uncompressed_data_size             = 0;
+	ssize_t process_count                     = 0;
+	uint32_t chunk_size                       = 0;
+	int byte_index                            = 0;
+	int chunk_index                           = 0;
+	int number_of_chunks                      = 0;
+	int number_of_filenames                   = 0;
+	int read_count                            = 0;
+	int result                                = 1;
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     filename,
+	     libcstring_system_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_ENCASE5,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     filename,
+	     libcstring_system_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_ENCASE5,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob filenames.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_chunks = (int) ( ( media_size + chunk_size - 1 ) / chunk_size );
+
+	if( number_of_chunks == 0 )
+	{
+		result = 1;
+
+		goto on_close;
+	}
+	/* The stored chunk data contains a checksum or can be larger than the chunk size
+	 */
+	chunks_buffer_size = number_of_chunks * ( chunk_size * 2 );
+
+	chunks_buffer = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * chunks_buffer_size );
+
+	uncompressed_chunk_buffer_size = chunk_size;
+
+	uncompressed_chunk_buffer = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * uncompressed_chunk_buffer_size );
+
+	chunk_indexes = (uint64_t *) memory_allocate(
+	                              sizeof( uint64_t ) * number_of_chunks );
+
+	chunk_data_offsets = (size_t *) memory_allocate(
+	                                 sizeof( size_t ) * number_of_chunks );
+
+	chunk_data_sizes = (size_t *) memory_allocate(
+	                               sizeof( size_t ) * number_of_chunks );
+
+	chunk_checksums = (uint32_t *) memory_allocate(
+	                                sizeof( uint32_t ) * number_of_chunks );
+
+	chunk_flags = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * number_of_chunks );
+
+	if( ( chunks_buffer == NULL )
+	 || ( uncompressed_chunk_buffer == NULL )
+	 || ( chunk_indexes == NULL )
+	 || ( chunk_data_offsets == NULL )
+	 || ( chunk_data_sizes == NULL )
+	 || ( chunk_checksums == NULL )
+	 || ( chunk_flags == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		chunk_indexes[ chunk_index ] = (uint64_t) chunk_index;
+	}
+	read_count = libewf_handle_read_chunks(
+	              handle,
+	              chunk_indexes,
+	              number_of_chunks,
+	              chunks_buffer,
+	              chunks_buffer_size,
+	              chunk_data_offsets,
+	              chunk_data_sizes,
+	              chunk_checksums,
+	              chunk_flags,
+	              error );
+
+	if( read_count != number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		uncompressed_data_size = uncompressed_chunk_buffer_size;
+
+		/* The stored checksum directly follows the chunk data
+		 */
+		if( ( chunk_flags[ chunk_index ] & LIBEWF_CHUNK_FLAG_IS_COMPRESSED ) == 0 )
+		{
+			chunk_data_sizes[ chunk_index ] += 4;
+		}
+		process_count = libewf_handle_prepare_read_chunk(
+		                 handle,
+		                 &( chunks_buffer[ chunk_data_offsets[ chunk_index ] ] ),
+		                 chunk_data_sizes[ chunk_index ],
+		                 uncompressed_chunk_buffer,
+		                 &uncompressed_data_size,
+		                 (int8_t) ( chunk_flags[ chunk_index ] & LIBEWF_CHUNK_FLAG_IS_COMPRESSED ),
+		                 chunk_checksums[ chunk_index ],
+		                 (int8_t) ( ( chunk_flags[ chunk_index ] & LIBEWF_CHUNK_FLAG_HAS_CHECKSUM ) != 0 ),
+		                 error );
+
+		if( process_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to prepare chunk: %d after reading.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( chunk_flags[ chunk_index ] & LIBEWF_CHUNK_FLAG_IS_COMPRESSED ) == 0 )
+		{
+			memory_copy(
+			 uncompressed_chunk_buffer,
+			 &( chunks_buffer[ chunk_data_offsets[ chunk_index ] ] ),
+			 uncompressed_data_size );
+		}
+		for( byte_index = 0;
+		     byte_index < (int) uncompressed_data_size;
+		     byte_index++ )
+		{
+			if( uncompressed_chunk_buffer[ byte_index ] != (uint8_t) ( 'A' + chunk_index ) )
+			{
+				result = 0;
+
+				break;
+			}
+		}
+	}
+on_close:
+	if( chunk_flags != NULL )
+	{
+		memory_free(
+		 chunk_flags );
+
+		chunk_flags = NULL;
+	}
+	if( chunk_checksums != NULL )
+	{
+		memory_free(
+		 chunk_checksums );
+
+		chunk_checksums = NULL;
+	}
+	if( chunk_data_sizes != NULL )
+	{
+		memory_free(
+		 chunk_data_sizes );
+
+		chunk_data_sizes = NULL;
+	}
+	if( chunk_data_offsets != NULL )
+	{
+		memory_free(
+		 chunk_data_offsets );
+
+		chunk_data_offsets = NULL;
+	}
+	if( chunk_indexes != NULL )
+	{
+		memory_free(
+		 chunk_indexes );
+
+		chunk_indexes = NULL;
+	}
+	if( uncompressed_chunk_buffer != NULL )
+	{
+		memory_free(
+		 uncompressed_chunk_buffer );
+
+		uncompressed_chunk_buffer = NULL;
+	}
+	if( chunks_buffer != NULL )
+	{
+		memory_free(
+		 chunks_buffer );
+
+		chunks_buffer = NULL;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free glob.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( chunk_flags != NULL )
+	{
+		memory_free(
+		 chunk_flags );
+	}
+	if( chunk_checksums != NULL )
+	{
+		memory_free(
+		 chunk_checksums );
+	}
+	if( chunk_data_sizes != NULL )
+	{
+		memory_free(
+		 chunk_data_sizes );
+	}
+	if( chunk_data_offsets != NULL )
+	{
+		memory_free(
+		 chunk_data_offsets );
+	}
+	if( chunk_indexes != NULL )
+	{
+		memory_free(
+		 chunk_indexes );
+	}
+	if( uncompressed_chunk_buffer != NULL )
+	{
+		memory_free(
+		 uncompressed_chunk_buffer );
+	}
+	if( chunks_buffer != NULL )
+	{
+		memory_free(
+		 chunks_buffer );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
@@ -450,6 +886,11 @@ int main( int argc, char * const argv[] )
 			compression_level = LIBEWF_COMPRESSION_BEST;
 			compression_flags = 0;
 		}
+		else if( option_compression_level[ 0 ] == (libcstring_system_character_t) 'a' )
+		{
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+		}
 		else
 		{
 			fprintf(
@@ -509,6 +950,16 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ewf_test_read_chunks(
+	     argv[ optind ],
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read chunks.\n" );
+
+		goto on_error;
+	}
 	return( EXIT_SUCCESS );
 
 on_error:
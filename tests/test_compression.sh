@@ -0,0 +1,61 @@
+#!/bin/bash
+#
+# Expert Witness Compression Format (EWF) library compression backend testing script
+#
+# Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this software.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TMP="tmp";
+
+EWF_TEST_COMPRESSION="ewf_test_compression";
+
+if ! test -x ${EWF_TEST_COMPRESSION};
+then
+	EWF_TEST_COMPRESSION="ewf_test_compression.exe";
+fi
+
+if ! test -x ${EWF_TEST_COMPRESSION};
+then
+	echo "Missing executable: ${EWF_TEST_COMPRESSION}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+mkdir ${TMP};
+
+./${EWF_TEST_COMPRESSION} ${TMP}/compression;
+
+RESULT=$?;
+
+rm -rf ${TMP};
+
+echo -n "Testing compression backends ";
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	echo " (FAIL)";
+else
+	echo " (PASS)";
+fi
+
+exit ${RESULT};
+
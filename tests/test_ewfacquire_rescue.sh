@@ -0,0 +1,172 @@
+#!/bin/bash
+#
+# ewfacquire rescue testing script
+#
+# Copyright (c) 2006-2012, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TMP="tmp";
+
+CMP="cmp";
+DD="dd";
+GREP="grep";
+PRINTF="printf";
+
+# The size of the media and the offset from which the first pass did not read the media
+MEDIA_SIZE=1048576;
+RESCUE_OFFSET=524288;
+
+test_write_rescue()
+{ 
+	mkdir ${TMP};
+
+	# The input contains random data, the first pass reads the second half
+	# of the input as zero bytes as if the device failed to return it
+	${DD} if=/dev/urandom of=${TMP}/input.raw bs=512 count=`expr ${MEDIA_SIZE} / 512` 2> /dev/null;
+
+	RESULT=$?;
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${DD} if=${TMP}/input.raw of=${TMP}/first_pass.raw bs=512 count=`expr ${RESCUE_OFFSET} / 512` 2> /dev/null;
+		${DD} if=/dev/zero bs=512 count=`expr \( ${MEDIA_SIZE} - ${RESCUE_OFFSET} \) / 512` 2> /dev/null >> ${TMP}/first_pass.raw;
+
+		if ${CMP} -s ${TMP}/input.raw ${TMP}/first_pass.raw;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFACQUIRE} -q -u \
+		-t ${TMP}/rescue \
+		-F ${TMP}/rescue.map \
+		-c none \
+		-f encase6 \
+		-b 64 \
+		${TMP}/first_pass.raw > /dev/null
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# Mark the second half of the media as not trimmed to have it rescued
+		${PRINTF} "0x00000000     *\n0x00000000  0x%08x  +\n0x%08x  0x%08x  *\n" \
+		 ${RESCUE_OFFSET} ${RESCUE_OFFSET} `expr ${MEDIA_SIZE} - ${RESCUE_OFFSET}` > ${TMP}/rescue.map;
+
+		${EWFACQUIRE} -q -u \
+		-t ${TMP}/rescue.E01 \
+		-F ${TMP}/rescue.map \
+		${TMP}/input.raw > ${TMP}/rescue.log
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		if ! test -f ${TMP}/rescue.d01;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# The image read back including the delta segment file must match the input
+		${EWFEXPORT} -q -u \
+		-t ${TMP}/export \
+		-f raw \
+		${TMP}/rescue.E01 ${TMP}/rescue.d01 > ${TMP}/export.log 2>&1
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		if ! ${CMP} -s ${TMP}/input.raw ${TMP}/export.raw;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# The digest hash calculated after rescue must match the data read back
+		MD5_HASH=`${GREP} "MD5 hash calculated over data" ${TMP}/export.log`;
+
+		if test -z "${MD5_HASH}";
+		then
+			RESULT=${EXIT_FAILURE};
+		elif ! ${GREP} -q "${MD5_HASH}" ${TMP}/rescue.log;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing ewfacquire rescue with delta segment file";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+EWFACQUIRE="../ewftools/ewfacquire";
+
+if ! test -x ${EWFACQUIRE};
+then
+	EWFACQUIRE="../ewftools/ewfacquire.exe"
+fi
+
+if ! test -x ${EWFACQUIRE};
+then
+	echo "Missing executable: ${EWFACQUIRE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+EWFEXPORT="../ewftools/ewfexport";
+
+if ! test -x ${EWFEXPORT};
+then
+	EWFEXPORT="../ewftools/ewfexport.exe";
+fi
+
+if ! test -x ${EWFEXPORT};
+then
+	echo "Missing executable: ${EWFEXPORT}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+if ! test_write_rescue
+then
+	exit ${EXIT_FAILURE};
+fi
+
+exit ${EXIT_SUCCESS};
+
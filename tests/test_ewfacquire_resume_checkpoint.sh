@@ -0,0 +1,221 @@
+#!/bin/bash
+#
+# ewfacquire resume from write checkpoint testing script
+#
+# Copyright (c) 2006-2012, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this software.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TMP="tmp";
+
+CMP="cmp";
+DD="dd";
+GREP="grep";
+
+# The size of the media, 64 chunks of 32 KiB
+MEDIA_SIZE=2097152;
+
+# The write checkpoint interval in number of chunks
+CHECKPOINT_INTERVAL=8;
+
+test_write_resume_checkpoint()
+{ 
+	INTERRUPT_OFFSET=$1;
+	RESUME_OFFSET=$2;
+
+	mkdir ${TMP};
+
+	${DD} if=/dev/urandom of=${TMP}/input.raw bs=512 count=`expr ${MEDIA_SIZE} / 512` 2> /dev/null;
+
+	RESULT=$?;
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# Leave the image and write journal as if the write was interrupted
+		${EWF_TEST_WRITE_CHECKPOINT} \
+		-B ${INTERRUPT_OFFSET} \
+		-j ${CHECKPOINT_INTERVAL} \
+		${TMP}/input.raw ${TMP}/resume
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		if ! test -f ${TMP}/resume.journal;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+${EWFACQUIRE} -q -R -j ${CHECKPOINT_INTERVAL} ${TMP}/input.raw > ${TMP}/acquire.log 2>&1 <<EOI
+${TMP}/resume.E01
+
+
+yes
+EOI
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# The acquiry must resume from the last checkpoint
+		if ! ${GREP} -q "Resuming acquire at offset: ${RESUME_OFFSET}\." ${TMP}/acquire.log;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# The write journal is removed when the acquiry is completed
+		if test -f ${TMP}/resume.journal;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFVERIFY} -q ${TMP}/resume.E01 > /dev/null
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFEXPORT} -q -u \
+		-t ${TMP}/export \
+		-f raw \
+		${TMP}/resume.E01 > ${TMP}/export.log 2>&1
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		if ! ${CMP} -s ${TMP}/input.raw ${TMP}/export.raw;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# The MD5 calculated by the resumed acquiry must match the data read back
+		MD5_HASH=`${GREP} "MD5 hash calculated over data" ${TMP}/export.log`;
+
+		if test -z "${MD5_HASH}";
+		then
+			RESULT=${EXIT_FAILURE};
+		elif ! ${GREP} -q "${MD5_HASH}" ${TMP}/acquire.log;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing ewfacquire resume from checkpoint after interruption at offset: ${INTERRUPT_OFFSET}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+EWF_TEST_WRITE_CHECKPOINT="./ewf_test_write_checkpoint";
+
+if ! test -x ${EWF_TEST_WRITE_CHECKPOINT};
+then
+	EWF_TEST_WRITE_CHECKPOINT="./ewf_test_write_checkpoint.exe";
+fi
+
+if ! test -x ${EWF_TEST_WRITE_CHECKPOINT};
+then
+	echo "Missing executable: ${EWF_TEST_WRITE_CHECKPOINT}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+EWFACQUIRE="../ewftools/ewfacquire";
+
+if ! test -x ${EWFACQUIRE};
+then
+	EWFACQUIRE="../ewftools/ewfacquire.exe"
+fi
+
+if ! test -x ${EWFACQUIRE};
+then
+	echo "Missing executable: ${EWFACQUIRE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+EWFEXPORT="../ewftools/ewfexport";
+
+if ! test -x ${EWFEXPORT};
+then
+	EWFEXPORT="../ewftools/ewfexport.exe";
+fi
+
+if ! test -x ${EWFEXPORT};
+then
+	echo "Missing executable: ${EWFEXPORT}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+EWFVERIFY="../ewftools/ewfverify";
+
+if ! test -x ${EWFVERIFY};
+then
+	EWFVERIFY="../ewftools/ewfverify.exe";
+fi
+
+if ! test -x ${EWFVERIFY};
+then
+	echo "Missing executable: ${EWFVERIFY}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+# Interrupted directly after the checkpoint of chunk 24, without the write
+# journal the last chunks section would be discarded and resumed from chunk 16
+if ! test_write_resume_checkpoint 786432 786432
+then
+	exit ${EXIT_FAILURE};
+fi
+
+# Interrupted in the middle of the chunks section following the checkpoint of chunk 24
+if ! test_write_resume_checkpoint 1000000 786432
+then
+	exit ${EXIT_FAILURE};
+fi
+
+exit ${EXIT_SUCCESS};
+
@@ -0,0 +1,213 @@
+#!/bin/bash
+#
+# ewfacquire striped image testing script
+#
+# Copyright (c) 2006-2012, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this software.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TMP="tmp";
+
+AWK="awk";
+CMP="cmp";
+DD="dd";
+DU="du";
+LS="ls";
+
+# The size of the media, 106 chunks of 32 KiB, written to 4 segment files
+MEDIA_SIZE=3473408;
+
+# The maximum segment file size, which is also the preallocated size
+MAXIMUM_SEGMENT_SIZE=1048576;
+
+# The allocation slack allowed beyond the end of a segment file
+ALLOCATION_SLACK=65536;
+
+test_write_stripe()
+{ 
+	NUMBER_OF_STRIPES=$1;
+
+	mkdir ${TMP};
+	mkdir ${TMP}/target;
+
+	STRIPE_OPTIONS="";
+	STRIPE_INDEX=1;
+
+	while [ ${STRIPE_INDEX} -le ${NUMBER_OF_STRIPES} ];
+	do
+		mkdir ${TMP}/stripe${STRIPE_INDEX};
+
+		STRIPE_OPTIONS="${STRIPE_OPTIONS} -X ${TMP}/stripe${STRIPE_INDEX}/image";
+		STRIPE_INDEX=`expr ${STRIPE_INDEX} + 1`;
+	done
+
+	${DD} if=/dev/urandom of=${TMP}/input.raw bs=512 count=`expr ${MEDIA_SIZE} / 512` 2> /dev/null;
+
+	RESULT=$?;
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFACQUIRE} -q -u -a -c none -S ${MAXIMUM_SEGMENT_SIZE} \
+		-t ${TMP}/target/image \
+		${STRIPE_OPTIONS} \
+		${TMP}/input.raw > ${TMP}/acquire.log 2>&1
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# The segment files are listed at the end of the acquiry
+		SEGMENT_FILES=`${AWK} '/^Segment files written:/ { list = 1; next } list && NF == 0 { list = 0 } list { print $1 }' ${TMP}/acquire.log`;
+
+		NUMBER_OF_SEGMENT_FILES=`echo ${SEGMENT_FILES} | ${AWK} '{ print NF }'`;
+		NUMBER_OF_FILES=`${LS} ${TMP}/target ${TMP}/stripe* | ${AWK} '/\.E[0-9][0-9]$/ { count++ } END { print count + 0 }'`;
+
+		if [ ${NUMBER_OF_SEGMENT_FILES} -le ${NUMBER_OF_STRIPES} ];
+		then
+			RESULT=${EXIT_FAILURE};
+		elif [ ${NUMBER_OF_SEGMENT_FILES} -ne ${NUMBER_OF_FILES} ];
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		# The preallocated storage space beyond the end of each segment file must be released
+		for SEGMENT_FILE in ${SEGMENT_FILES};
+		do
+			if ! test -f ${SEGMENT_FILE};
+			then
+				RESULT=${EXIT_FAILURE};
+
+				break;
+			fi
+			FILE_SIZE=`${LS} -l ${SEGMENT_FILE} | ${AWK} '{ print $5 }'`;
+			ALLOCATED_SIZE=`${DU} -k ${SEGMENT_FILE} | ${AWK} '{ print $1 * 1024 }'`;
+
+			if [ ${FILE_SIZE} -gt ${MAXIMUM_SEGMENT_SIZE} ];
+			then
+				RESULT=${EXIT_FAILURE};
+
+				break;
+			fi
+			if [ ${ALLOCATED_SIZE} -gt `expr ${FILE_SIZE} + ${ALLOCATION_SLACK}` ];
+			then
+				RESULT=${EXIT_FAILURE};
+
+				break;
+			fi
+		done
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFVERIFY} -q ${SEGMENT_FILES} > ${TMP}/verify.log 2>&1
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFEXPORT} -q -u \
+		-t ${TMP}/export \
+		-f raw \
+		${SEGMENT_FILES} > /dev/null 2>&1
+
+		RESULT=$?;
+	fi
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		if ! ${CMP} -s ${TMP}/input.raw ${TMP}/export.raw;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing ewfacquire with preallocation and ${NUMBER_OF_STRIPES} stripe target(s)";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+EWFACQUIRE="../ewftools/ewfacquire";
+
+if ! test -x ${EWFACQUIRE};
+then
+	EWFACQUIRE="../ewftools/ewfacquire.exe"
+fi
+
+if ! test -x ${EWFACQUIRE};
+then
+	echo "Missing executable: ${EWFACQUIRE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+EWFEXPORT="../ewftools/ewfexport";
+
+if ! test -x ${EWFEXPORT};
+then
+	EWFEXPORT="../ewftools/ewfexport.exe";
+fi
+
+if ! test -x ${EWFEXPORT};
+then
+	echo "Missing executable: ${EWFEXPORT}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+EWFVERIFY="../ewftools/ewfverify";
+
+if ! test -x ${EWFVERIFY};
+then
+	EWFVERIFY="../ewftools/ewfverify.exe";
+fi
+
+if ! test -x ${EWFVERIFY};
+then
+	echo "Missing executable: ${EWFVERIFY}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+if ! test_write_stripe 1
+then
+	exit ${EXIT_FAILURE};
+fi
+
+if ! test_write_stripe 2
+then
+	exit ${EXIT_FAILURE};
+fi
+
+exit ${EXIT_SUCCESS};
+
@@ -27,10 +27,20 @@ EXIT_IGNORE=77;
 INPUT="input";
 TMP="tmp";
 
+AWK="awk";
+CMP="cmp";
+DD="dd";
+DU="du";
 LS="ls";
 TR="tr";
 WC="wc";
 
+# The chunk size used by the sparse export test, the default EWF chunk size
+CHUNK_SIZE=32768;
+
+# The allocation slack allowed for the sparse raw output
+ALLOCATION_SLACK=65536;
+
 test_export_raw()
 { 
 	INPUT_FILE=$1;
@@ -125,6 +135,122 @@ test_export_unattended()
 	return ${RESULT};
 }
 
+test_export_sparse()
+{ 
+	CHUNKS=$1;
+
+	mkdir ${TMP};
+
+	# The input contains a chunk of random data for every D and a chunk of 0-byte values for every 0
+	EXPECTED_SPARSE_BYTES=0;
+	LAST_CHUNK="";
+
+	for CHUNK in `echo ${CHUNKS} | ${AWK} '{ gsub( /./, "& " ); print }'`;
+	do
+		if test ${CHUNK} = "0";
+		then
+			${DD} if=/dev/zero bs=${CHUNK_SIZE} count=1 2> /dev/null;
+
+			EXPECTED_SPARSE_BYTES=`expr ${EXPECTED_SPARSE_BYTES} + ${CHUNK_SIZE}`;
+		else
+			${DD} if=/dev/urandom bs=${CHUNK_SIZE} count=1 2> /dev/null;
+		fi
+		LAST_CHUNK=${CHUNK};
+	done > ${TMP}/input.raw
+
+	# The last byte of the output is written so that the output has the size of the media
+	if test ${LAST_CHUNK} = "0";
+	then
+		EXPECTED_SPARSE_BYTES=`expr ${EXPECTED_SPARSE_BYTES} - 1`;
+	fi
+
+	${EWFACQUIRE} -q -u -c deflate:none \
+	-t ${TMP}/image \
+	${TMP}/input.raw > /dev/null 2>&1
+
+	RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${EWFEXPORT} -q -u \
+		-f raw \
+		-t ${TMP}/export \
+		${TMP}/image.E01 > /dev/null 2>&1
+
+		RESULT=$?;
+	fi
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${EWFEXPORT} -q -u -z \
+		-f raw \
+		-t ${TMP}/sparse \
+		${TMP}/image.E01 > ${TMP}/sparse.log 2>&1
+
+		RESULT=$?;
+	fi
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		# The sparse output must be identical to the normal output
+		if ! ${CMP} -s ${TMP}/export.raw ${TMP}/sparse.raw;
+		then
+			RESULT=${EXIT_FAILURE};
+		elif ! ${CMP} -s ${TMP}/input.raw ${TMP}/sparse.raw;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		SPARSE_BYTES=`${AWK} '/^Sparse output: skipped writing/ { print $5 }' ${TMP}/sparse.log`;
+
+		if test "${SPARSE_BYTES}" != "${EXPECTED_SPARSE_BYTES}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		# The skipped blocks must be holes in the sparse output
+		FILE_SIZE=`${LS} -l ${TMP}/sparse.raw | ${AWK} '{ print $5 }'`;
+		ALLOCATED_SIZE=`${DU} -k ${TMP}/sparse.raw | ${AWK} '{ print $1 * 1024 }'`;
+
+		if test ${ALLOCATED_SIZE} -gt `expr ${FILE_SIZE} - ${EXPECTED_SPARSE_BYTES} + ${ALLOCATION_SLACK}`;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing ewfexport to sparse raw of chunks: ${CHUNKS} ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+EWFACQUIRE="../ewftools/ewfacquire";
+
+if ! test -x ${EWFACQUIRE};
+then
+	EWFACQUIRE="../ewftools/ewfacquire.exe"
+fi
+
+if ! test -x ${EWFACQUIRE};
+then
+	echo "Missing executable: ${EWFACQUIRE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
 EWFEXPORT="../ewftools/ewfexport";
 
 if ! test -x ${EWFEXPORT};
@@ -139,20 +265,28 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+for CHUNKS in D00D0000D000000D 0D000D00;
+do
+	if ! test_export_sparse "${CHUNKS}";
+	then
+		exit ${EXIT_FAILURE};
+	fi
+done
+
 if ! test -d ${INPUT};
 then
-	echo "No ${INPUT} directory found, to test ewfexport create ${INPUT} directory and place EWF test files in directory.";
+	echo "No ${INPUT} directory found, to test ewfexport of EWF test files create ${INPUT} directory and place EWF test files in directory.";
 
-	exit ${EXIT_IGNORE};
+	exit ${EXIT_SUCCESS};
 fi
 
 RESULT=`${LS} ${INPUT}/*.[esE]01 | ${TR} ' ' '\n' | ${WC} -l`;
 
 if test ${RESULT} -eq 0;
 then
-	echo "No files found in ${INPUT} directory, to test ewfexport place EWF test files in directory.";
+	echo "No files found in ${INPUT} directory, to test ewfexport of EWF test files place EWF test files in directory.";
 
-	exit ${EXIT_IGNORE};
+	exit ${EXIT_SUCCESS};
 fi
 
 for FILENAME in `${LS} ${INPUT}/*.[esE]01 | ${TR} ' ' '\n'`;
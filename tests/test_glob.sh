@@ -62,13 +62,19 @@ test_glob()
 	BASENAME=$1;
 	SCHEMA=$2;
 	FILENAMES=$3;
+	FILES=$4;
+
+	if test -z "${FILES}";
+	then
+		FILES=${FILENAMES};
+	fi
 
 	mkdir ${TMP};
 	cd ${TMP};
 
 	echo ${FILENAMES} > input;
 
-	touch ${FILENAMES};
+	touch ${FILES};
 
 	../${EWF_TEST_GLOB} ${BASENAME} > output;
 
@@ -436,6 +442,18 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+# Missing segment files and files with a similar name in the directory
+
+if ! test_glob "PREFIX.E01" ".E01" "PREFIX.E01 PREFIX.E02" "PREFIX.E01 PREFIX.E02 PREFIX.E04 PREFIX.E03.tmp PREFIX.E3 OTHER.E03";
+then
+	exit ${EXIT_FAILURE};
+fi
+
+if ! test_glob "../${TMP}/PREFIX.E01" ".E01" "../${TMP}/PREFIX.E01 ../${TMP}/PREFIX.E02 ../${TMP}/PREFIX.E03" "PREFIX.E01 PREFIX.E02 PREFIX.E03";
+then
+	exit ${EXIT_FAILURE};
+fi
+
 # .s01
 
 if ! test_glob "PREFIX.s01" ".s01" "PREFIX.s01";
@@ -0,0 +1,56 @@
+#!/bin/bash
+#
+# Expert Witness Compression Format (EWF) library ltree stream testing script
+#
+# Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this software.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+EWF_TEST_LTREE_STREAM="ewf_test_ltree_stream";
+
+if ! test -x ${EWF_TEST_LTREE_STREAM};
+then
+	EWF_TEST_LTREE_STREAM="ewf_test_ltree_stream.exe";
+fi
+
+if ! test -x ${EWF_TEST_LTREE_STREAM};
+then
+	echo "Missing executable: ${EWF_TEST_LTREE_STREAM}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+./${EWF_TEST_LTREE_STREAM};
+
+RESULT=$?;
+
+echo -n "Testing reading the ltree data in blocks ";
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	echo " (FAIL)";
+
+	exit ${EXIT_FAILURE};
+fi
+echo " (PASS)";
+
+exit ${EXIT_SUCCESS};
+
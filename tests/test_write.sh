@@ -53,6 +53,32 @@ test_write()
 	return ${RESULT};
 }
 
+test_write_compression_threads()
+{ 
+	MEDIA_SIZE=$1;
+	MAXIMUM_SEGMENT_SIZE=$2;
+	COMPRESSION_LEVEL=$3;
+	NUMBER_OF_THREADS=$4;
+
+	mkdir ${TMP};
+
+	./${EWF_TEST_WRITE} -B ${MEDIA_SIZE} -c `echo ${COMPRESSION_LEVEL} | ${CUT} -c 1` -S ${MAXIMUM_SEGMENT_SIZE} -t ${NUMBER_OF_THREADS} ${TMP}/write;
+
+	RESULT=$?;
+
+	rm -rf ${TMP};
+
+	echo -n "Testing write with media size: ${MEDIA_SIZE}, maximum segment size: ${MAXIMUM_SEGMENT_SIZE}, compression level: ${COMPRESSION_LEVEL} and ${NUMBER_OF_THREADS} compression threads ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 test_write_chunk()
 { 
 	MEDIA_SIZE=$1;
@@ -106,7 +132,7 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
-for COMPRESSION_LEVEL in none empty-block fast best;
+for COMPRESSION_LEVEL in none empty-block fast best adaptive;
 do
 	if ! test_write 0 0 ${COMPRESSION_LEVEL}
 	then
@@ -128,6 +154,16 @@ do
 		exit ${EXIT_FAILURE};
 	fi
 
+	if ! test_write_compression_threads 0 10000 ${COMPRESSION_LEVEL} 4
+	then
+		exit ${EXIT_FAILURE};
+	fi
+
+	if ! test_write_compression_threads 100000 10000 ${COMPRESSION_LEVEL} 4
+	then
+		exit ${EXIT_FAILURE};
+	fi
+
 	echo "";
 
 	if ! test_write_chunk 0 0 ${COMPRESSION_LEVEL}